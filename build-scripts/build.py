@@ -1,11 +1,25 @@
 import sys
 from engine import get_engine_project
 from editor import get_editor_project
+from packer import get_packer_project
+from bench import get_bench_project
+from logdecoder import get_log_decoder_project
 from timer_helpers import end_timer, start_timer
 
 # can be called from 'Krystal' or 'KrystalEditor'
 if __name__ == '__main__':
   start_timer()
+  # tools are only built when asked for, e.g. 'build.py Packer'
+  tools = {"Packer": get_packer_project, "Bench": get_bench_project, "LogDecoder": get_log_decoder_project}
+  tool = next((name for name in tools if len(sys.argv) >= 2 and name in sys.argv[1]), None)
+  if tool is not None:
+    returncode = get_engine_project().build()
+    if returncode == 0:
+      print("\n")
+      returncode = tools[tool]().build()
+    end_timer()
+    sys.exit(returncode)
+
   code = get_editor_project() if len(sys.argv) >= 2 and (
     "KrystalEditor" in sys.argv[1] or "B:\\" in sys.argv[1]
     ) else get_engine_project()
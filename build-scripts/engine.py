@@ -27,6 +27,7 @@ def get_engine_project():
   code.linker_settings = linker_settings
   code.linker_settings.extend([f"OUT:{code.build_output_dir}Krystal.lib", f"LIBPATH:\"{THIRD_PARTY_ROOT}freetype\""])
   code.custom_source_files = {
+    "Base": ["Base/**/*.cpp"],
     "Core": ["Core/**/*.cpp"],
     "Debug": ["Debug/**/*.cpp"],
     "Events": ["Events/**/*.cpp"],
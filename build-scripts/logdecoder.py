@@ -0,0 +1,28 @@
+from project import PROJECT_TYPE_EXE, Project
+from shared_settings import ignore_includes, compiler_settings, disabled_warnings, defines, linker_settings
+
+def get_log_decoder_project():
+  code: Project = Project()
+  code.name = "LOG_DECODER"
+  code.type = PROJECT_TYPE_EXE
+  code.src_root = "K:/tools/LogDecoder/"
+  code.third_party_root = "K:/src/ThirdParty/"
+  code.include_dirs = [
+    "K:/include/",
+    ]
+  code.build_output_dir = "K:/build/"
+  code.build_object_output_dir = code.build_output_dir + "obj/logdecoder/"
+  code.disabled_warnings = disabled_warnings
+  code.compiler_settings = compiler_settings
+  code.ignore_includes = ignore_includes
+  code.defines = defines
+  code.ignore_files = []
+  code.linker_settings = list(linker_settings)
+  code.linker_settings.extend([f"OUT:{code.build_output_dir}KrystalLogDecoder.exe", "DEBUG:FULL", "LIBPATH:\"K:\\build\""])
+  code.linked_libraries = ["Winmm.lib", "user32.lib", "gdi32.lib", "OpenGL32.lib", "Krystal.lib"]
+  code.custom_source_files = {
+    "All": ["**/*.cpp"],
+  }
+  code.third_party_source_files = {}
+
+  return code
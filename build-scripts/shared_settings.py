@@ -15,6 +15,7 @@ defines = {
   "KRYS_ENABLE_DEBUG_BREAK":"1",
   "KRYS_ENABLE_PERFORMANCE_CHECKS":"1",
   "KRYS_ENABLE_PROFILING":"1",
+  "KRYS_ENABLE_MEMORY_TRACKING":"1",
   "KRYS_ENABLE_TESTS":"1",
   "_ITERATOR_DEBUG_LEVEL":"2"
 }
@@ -26,7 +27,7 @@ ignore_includes = [
   "winapifamily.h", "hidusage.h", "windows.h",
   "signal.h", "TargetConditionals.h", "dlfcn.h",
   "string.h", "inttypes.h", "limits.h", "stdarg.h", 
-  "math.h", "assert.h", "emmintrin.h", "intrin.h",
+  "math.h", "assert.h", "emmintrin.h", "intrin.h", "immintrin.h", "x86intrin.h",
   "arm_neon.h", "fcntl.h", "sys/stat.h", "unistd.h",
   "machine/endian.h", "sys/byteorder.h", "endian.h"
 ]
@@ -65,6 +66,11 @@ ignore_includes = [
 # | KRYS_ENABLE_ASSERTS            | Runtime asserts that trigger a break point on fail.
 # | KRYS_ENABLE_LOGGING            | Turn on logging.
 # | KRYS_ENABLE_PERFORMANCE_CHECKS | Log performance stats.
+# | KRYS_ENABLE_MEMORY_TRACKING    | Track memory per subsystem and report leaks at shutdown.
+# | KRYS_ENABLE_MEMORY_TRACKING_NEW| Also route the global operator new/delete through the tracker.
+# | KRYS_ENABLE_LOCK_PROFILING     | Record wait/hold times and contention for InstrumentedLocks.
+# | KRYS_LOG_MIN_LEVEL             | Log levels below this (0 = Debug .. 4 = Fatal) are compiled out.
+# | KRYS_LOG_DISABLED_CATEGORIES   | Bitmask of log categories that are compiled out.
 # ----------- CUSTOM DEFINES ------------
 
 # ------------ LINKED LIBS --------------
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Detection.hpp"
+
+/// @brief Lets a function use instructions beyond the build's baseline. Only call it after checking the CPU
+/// supports them. MSVC allows any intrinsic anywhere, so there it does nothing.
+#if defined(KRYS_COMPILER_VISUAL_STUDIO)
+  #define KRYS_TARGET(features)
+#else
+  #define KRYS_TARGET(features) __attribute__((target(features)))
+#endif
+
+namespace Krys::CPU
+{
+  /// @brief Check if the CPU supports SSSE3, e.g. `pshufb` byte shuffles.
+  NO_DISCARD bool HasSSSE3() noexcept;
+
+  /// @brief Check if the CPU supports AVX2 and the OS saves the registers it uses.
+  NO_DISCARD bool HasAVX2() noexcept;
+}
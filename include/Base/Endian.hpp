@@ -1,6 +1,8 @@
 #pragma once
 
 #include <bit>
+#include <cstring>
+#include <span>
 #include <type_traits>
 
 #include "Base/Attributes.hpp"
@@ -101,4 +103,64 @@ namespace Krys::Endian
       // from == Big && to == Little or vice versa.
       return SwapEndian(value);
   }
-}
\ No newline at end of file
+
+  namespace Impl
+  {
+    /// @brief Reverse the bytes of each of `count` 2, 4 or 8 byte elements from `source` into `destination`,
+    /// which may be the same memory. Uses AVX2 or SSSE3 byte shuffles when the CPU has them.
+    void SwapBytes16(const void *source, void *destination, size_t count) noexcept;
+    void SwapBytes32(const void *source, void *destination, size_t count) noexcept;
+    void SwapBytes64(const void *source, void *destination, size_t count) noexcept;
+
+    NO_DISCARD constexpr Type Resolve(Type type) noexcept
+    {
+      if (type != Type::System)
+        return type;
+      return IsLittleEndian() ? Type::Little : Type::Big;
+    }
+  }
+
+  /// @brief Check if converting `T` from `SourceEndianness` to `DestinationEndianness` changes its bytes.
+  template <IsArithmeticT T, Endian::Type SourceEndianness, Endian::Type DestinationEndianness>
+  NO_DISCARD constexpr bool NeedsSwap() noexcept
+  {
+    return sizeof(T) > 1 && Impl::Resolve(SourceEndianness) != Impl::Resolve(DestinationEndianness);
+  }
+
+  /// @brief Convert `count` values from one endian representation to another. `destination` may be
+  /// unaligned, and may be the same memory as `source`.
+  template <IsArithmeticT T, Endian::Type SourceEndianness, Endian::Type DestinationEndianness>
+  void ConvertArray(const T *source, void *destination, size_t count) noexcept
+  {
+    if constexpr (!NeedsSwap<T, SourceEndianness, DestinationEndianness>())
+    {
+      if (count != 0 && source != destination)
+        std::memmove(destination, source, count * sizeof(T));
+    }
+    else if constexpr (sizeof(T) == 2)
+      Impl::SwapBytes16(source, destination, count);
+    else if constexpr (sizeof(T) == 4)
+      Impl::SwapBytes32(source, destination, count);
+    else
+    {
+      static_assert(sizeof(T) == 8, "Unsupported type size.");
+      Impl::SwapBytes64(source, destination, count);
+    }
+  }
+
+  /// @brief Convert `source` from one endian representation to another into `destination`, which must be at
+  /// least as large. The two may be the same memory.
+  template <IsArithmeticT T, Endian::Type SourceEndianness, Endian::Type DestinationEndianness>
+  void ConvertArray(std::span<const T> source, std::span<T> destination) noexcept
+  {
+    ConvertArray<T, SourceEndianness, DestinationEndianness>(source.data(), destination.data(),
+                                                             source.size());
+  }
+
+  /// @brief Convert `values` from one endian representation to another in place.
+  template <IsArithmeticT T, Endian::Type SourceEndianness, Endian::Type DestinationEndianness>
+  void ConvertArray(std::span<T> values) noexcept
+  {
+    ConvertArray<T, SourceEndianness, DestinationEndianness>(values.data(), values.data(), values.size());
+  }
+}
@@ -1,9 +1,11 @@
 #pragma once
 
+#include "Base/Attributes.hpp"
 #include "Base/Pointers.hpp"
 #include "Base/Types.hpp"
 #include "Core/ApplicationContext.hpp"
 #include "Core/ApplicationSettings.hpp"
+#include "Debug/FrameStats.hpp"
 
 namespace Krys
 {
@@ -39,6 +41,12 @@ namespace Krys
     /// @brief Runs the application. Will not return until the app stops running.
     void Run() noexcept;
 
+    /// @brief Get the frame timing statistics collected by `Run`.
+    NO_DISCARD const Debug::FrameStats &GetFrameStats() const noexcept
+    {
+      return _frameStats;
+    }
+
     /// @brief Create a new `Application`.
     /// @tparam TApplication The derived `Application` type.
     /// @param argc Command line argument count.
@@ -56,6 +64,7 @@ namespace Krys
   protected:
     bool _running;
     Unique<ApplicationContext> _context;
+    Debug::FrameStats _frameStats;
 
     static Unique<ApplicationContext> CreateApplicationContext(int argc, char **argv,
                                                                const ApplicationSettings &settings) noexcept;
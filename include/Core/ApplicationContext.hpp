@@ -18,6 +18,7 @@
 #include "Graphics/Scene/SceneGraphManager.hpp"
 #include "Graphics/Textures/TextureManager.hpp"
 #include "Graphics/Fonts/FontManager.hpp"
+#include "IO/AssetCache.hpp"
 #include "IO/Input/InputManager.hpp"
 
 namespace Krys
@@ -75,6 +76,9 @@ namespace Krys
     /// @brief Get the current 'FontManager'.
     Ptr<Gfx::FontManager> GetFontManager() const noexcept;
 
+    /// @brief Get the 'AssetCache', or null if it's disabled.
+    Ptr<IO::AssetCache> GetAssetCache() const noexcept;
+
     /// @brief Get the command line arguments.
     const List<string> &GetCLIArgs() const noexcept;
 
@@ -82,6 +86,8 @@ namespace Krys
     const ApplicationSettings &GetSettings() const noexcept;
 
   private:
+    /// @brief Declared first so it's destroyed last, after the managers storing artifacts in it.
+    Unique<IO::AssetCache> _assetCache;
     Unique<EventManager> _eventManager;
     Unique<WindowManager> _windowManager;
     Unique<InputManager> _inputManager;
@@ -26,5 +26,35 @@ namespace Krys
 
     /// @brief The framerate to update physics at.
     float PhysicsFrameRate {30.0f};
+
+    /// @brief Where frame timing statistics are written on exit when performance checks are enabled. Leave
+    /// empty to disable.
+    string FrameStatsPath {"frame-stats.txt"};
+
+    /// @brief If set, every frame advances time by this many milliseconds instead of the measured frame time,
+    /// so updates and event timers are repeatable. Leave at zero to use real time.
+    float FixedFrameTimeMs {0.0f};
+
+    /// @brief Where to write log messages in the `Logger`'s binary format instead of as text. Leave empty to
+    /// disable. Read the file back with the KrystalLogDecoder tool.
+    string BinaryLogPath {};
+
+    /// @brief Where to record the events raised during the session. Leave empty to disable.
+    string EventRecordingPath {};
+
+    /// @brief A recording to replay through an `EventReplayDevice`. Leave empty to disable.
+    string EventReplayPath {};
+
+    /// @brief Where the `IO::AssetCache` keeps cooked textures and models that have no up to date cooked file
+    /// next to their source. Leave empty to disable, in which case they're written next to their source
+    /// instead, which is how the cooked files a pack ships with are made.
+    string AssetCacheDirectory {"cache"};
+
+    /// @brief A pack mounted at the root of the `IO::VFS` on startup, if it exists. Leave empty to disable.
+    string PackPath {"data.kpak"};
+
+    /// @brief A directory mounted at the root of the `IO::VFS` after the pack, so loose files override what's
+    /// packed while iterating on them. Leave empty to disable.
+    string DataDirectory {"."};
   };
 }
\ No newline at end of file
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Types.hpp"
+#include "MTL/Histogram.hpp"
+
+namespace Krys::Debug
+{
+  /// @brief Parts of the frame that are timed separately. `Frame` is the whole frame, including pacing.
+  enum class FramePhase : uint8
+  {
+    Poll,
+    Events,
+    FixedUpdate,
+    Update,
+    Render,
+    Swap,
+    Frame,
+    Count
+  };
+
+  NO_DISCARD constexpr inline stringview ToString(FramePhase phase) noexcept
+  {
+    switch (phase)
+    {
+      case FramePhase::Poll:        return "Poll";
+      case FramePhase::Events:      return "Events";
+      case FramePhase::FixedUpdate: return "FixedUpdate";
+      case FramePhase::Update:      return "Update";
+      case FramePhase::Render:      return "Render";
+      case FramePhase::Swap:        return "Swap";
+      case FramePhase::Frame:       return "Frame";
+      default:                      return "Unknown";
+    }
+  }
+
+  /// @brief Distribution of a timing, in milliseconds.
+  struct TimingSummary
+  {
+    float64 P50 {0.0};
+    float64 P95 {0.0};
+    float64 P99 {0.0};
+    float64 Max {0.0};
+    float64 Mean {0.0};
+    uint64 Count {0};
+  };
+
+  /// @brief Streaming frame timing statistics, fed by the frame loop.
+  /// @details Every phase is recorded into a histogram with microsecond resolution, so percentiles are
+  /// available at any point without storing individual samples. Also tracks frame pacing jitter (the change
+  /// in frame time between consecutive frames), how many fixed updates each frame had to run to catch up, and
+  /// the latency from input being polled to the frame that handled it being presented.
+  class FrameStats
+  {
+  public:
+    /// @brief Fixed step counts above this are grouped together.
+    static constexpr uint32 MaxTrackedFixedSteps = 8;
+
+    FrameStats() noexcept;
+
+    /// @brief Records how long a phase of the current frame took.
+    void Record(FramePhase phase, int64 ticks) noexcept;
+
+    /// @brief Records the time from the oldest input handled this frame being polled to the frame being
+    /// presented. Only frames that handled input should record this.
+    void RecordInputLatency(int64 ticks) noexcept;
+
+    /// @brief Completes the current frame.
+    /// @param frameTicks How long the whole frame took, including any pacing.
+    /// @param fixedSteps How many fixed updates ran during the frame.
+    void EndFrame(int64 frameTicks, uint32 fixedSteps) noexcept;
+
+    /// @brief Discards everything recorded so far.
+    void Reset() noexcept;
+
+    NO_DISCARD TimingSummary GetSummary(FramePhase phase) const noexcept;
+
+    /// @brief Get the distribution of the absolute change in frame time between consecutive frames.
+    NO_DISCARD TimingSummary GetJitter() const noexcept;
+
+    /// @brief Get the distribution of input-to-present latency, see `RecordInputLatency`.
+    NO_DISCARD TimingSummary GetInputLatency() const noexcept;
+
+    /// @brief Get the number of frames that ran exactly `steps` fixed updates. The last bucket,
+    /// `MaxTrackedFixedSteps`, counts every frame that ran at least that many.
+    NO_DISCARD uint64 GetFramesWithFixedSteps(uint32 steps) const noexcept;
+
+    /// @brief Get the number of frames that had to run more than one fixed update to catch up.
+    NO_DISCARD uint64 GetCatchUpFrames() const noexcept;
+
+    NO_DISCARD uint32 GetMaxFixedSteps() const noexcept;
+
+    /// @brief Get a human readable report of all the stats.
+    NO_DISCARD string ToString() const noexcept;
+
+    /// @brief Write the report returned by `ToString` to `path`.
+    /// @returns True if the write was successful.
+    bool WriteToFile(const stringview &path) const noexcept;
+
+  private:
+    NO_DISCARD uint64 ToMicroseconds(int64 ticks) const noexcept;
+    NO_DISCARD static TimingSummary Summarise(const MTL::Histogram<> &histogram) noexcept;
+
+    Array<MTL::Histogram<>, static_cast<size_t>(FramePhase::Count)> _phases;
+    MTL::Histogram<> _jitter;
+    MTL::Histogram<> _inputLatency;
+    Array<uint64, MaxTrackedFixedSteps + 1> _fixedSteps {};
+    uint32 _maxFixedSteps {0};
+    uint64 _lastFrameUs {0};
+    bool _hasLastFrame {false};
+    float64 _ticksToMicroseconds;
+  };
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Macros.hpp"
+#include "Base/Types.hpp"
+
+#include <atomic>
+#include <mutex>
+
+namespace Krys::Debug
+{
+  /// @brief A place in the code that acquired a lock.
+  struct LockSite
+  {
+    const char *File {nullptr};
+    const char *Function {nullptr};
+    uint32 Line {0};
+
+    bool operator==(const LockSite &) const noexcept = default;
+  };
+
+  /// @brief How often one call site had to wait for a lock held by another.
+  struct LockContentionSite
+  {
+    LockSite Waiter;
+    LockSite Holder;
+    uint64 Count {0};
+    int64 WaitTicks {0};
+  };
+
+  /// @brief Aggregated timings for a single named lock. All times are in ticks (see `Platform::GetTicks`).
+  class LockStats
+  {
+  public:
+    NO_COPY_MOVE(LockStats)
+
+    explicit LockStats(const string &name) noexcept : _name(name)
+    {
+    }
+
+    void RecordAcquire(int64 waitTicks, bool contended) noexcept;
+    void RecordRelease(int64 holdTicks) noexcept;
+
+    /// @brief Records a contended acquire against the pair of call sites involved. Only called on the slow
+    /// path, so it's fine for it to take a mutex.
+    void RecordContention(const LockSite &waiter, const LockSite &holder, int64 waitTicks) noexcept;
+
+    NO_DISCARD const string &GetName() const noexcept
+    {
+      return _name;
+    }
+
+    NO_DISCARD uint64 GetAcquisitions() const noexcept
+    {
+      return _acquisitions.load(std::memory_order_relaxed);
+    }
+
+    NO_DISCARD uint64 GetContentions() const noexcept
+    {
+      return _contentions.load(std::memory_order_relaxed);
+    }
+
+    NO_DISCARD int64 GetTotalWaitTicks() const noexcept
+    {
+      return _totalWaitTicks.load(std::memory_order_relaxed);
+    }
+
+    NO_DISCARD int64 GetMaxWaitTicks() const noexcept
+    {
+      return _maxWaitTicks.load(std::memory_order_relaxed);
+    }
+
+    NO_DISCARD int64 GetTotalHoldTicks() const noexcept
+    {
+      return _totalHoldTicks.load(std::memory_order_relaxed);
+    }
+
+    NO_DISCARD int64 GetMaxHoldTicks() const noexcept
+    {
+      return _maxHoldTicks.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Get a snapshot of the contended call sites, most contended first.
+    NO_DISCARD List<LockContentionSite> GetContentionSites() const noexcept;
+
+  private:
+    string _name;
+    std::atomic<uint64> _acquisitions {0};
+    std::atomic<uint64> _contentions {0};
+    std::atomic<int64> _totalWaitTicks {0};
+    std::atomic<int64> _maxWaitTicks {0};
+    std::atomic<int64> _totalHoldTicks {0};
+    std::atomic<int64> _maxHoldTicks {0};
+
+    mutable std::mutex _sitesMutex;
+    List<LockContentionSite> _sites;
+  };
+
+  /// @brief Registry of every instrumented lock, so contention can be reported in one place.
+  class LockProfiler
+  {
+  public:
+    STATIC_CLASS(LockProfiler)
+
+    /// @brief Get the stats for the lock called `name`, creating them if needed. Locks with the same name
+    /// share stats. The returned reference stays valid for the lifetime of the program.
+    NO_DISCARD static LockStats &Register(const string &name) noexcept;
+
+    /// @brief Calls `func` for every registered lock.
+    static void ForEach(const Func<void(const LockStats &)> &func) noexcept;
+
+    /// @brief Get a human readable report of every lock, sorted by total wait time.
+    NO_DISCARD static string ToString() noexcept;
+
+    /// @brief Logs the report returned by `ToString`.
+    static void LogReport() noexcept;
+  };
+}
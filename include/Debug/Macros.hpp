@@ -26,6 +26,19 @@
   #define KRYS_SCOPED_PROFILER(name)
 #endif
 
+#ifdef KRYS_ENABLE_MEMORY_TRACKING
+  #include "Debug/MemoryTracker.hpp"
+  #define UNIQUE_MEMORY_SCOPE_NAME(prefix) CONCATENATE(prefix, __LINE__)
+  #define KRYS_MEMORY_SCOPE(tag)                                                                             \
+    Krys::Debug::MemoryScope UNIQUE_MEMORY_SCOPE_NAME(memoryScope_)(Krys::Debug::MemoryTag::tag)
+  #define KRYS_MEMORY_END_FRAME() Krys::Debug::MemoryTracker::EndFrame()
+  #define KRYS_MEMORY_REPORT_LEAKS() Krys::Debug::MemoryTracker::ReportLeaks()
+#else
+  #define KRYS_MEMORY_SCOPE(tag)
+  #define KRYS_MEMORY_END_FRAME()
+  #define KRYS_MEMORY_REPORT_LEAKS()
+#endif
+
 #ifdef KRYS_ENABLE_ASSERTS
   #define KRYS_ASSERT(condition, format, ...)                                                                \
     do                                                                                                       \
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Macros.hpp"
+#include "Base/Types.hpp"
+
+#include <new>
+
+namespace Krys::Debug
+{
+  /// @brief Subsystem an allocation is attributed to.
+  enum class MemoryTag : uint8
+  {
+    General,
+    Images,
+    Meshes,
+    Textures,
+    Fonts,
+    Events,
+    IO,
+    Count
+  };
+
+  NO_DISCARD constexpr inline stringview ToString(MemoryTag tag) noexcept
+  {
+    switch (tag)
+    {
+      case MemoryTag::General:  return "General";
+      case MemoryTag::Images:   return "Images";
+      case MemoryTag::Meshes:   return "Meshes";
+      case MemoryTag::Textures: return "Textures";
+      case MemoryTag::Fonts:    return "Fonts";
+      case MemoryTag::Events:   return "Events";
+      case MemoryTag::IO:       return "IO";
+      default:                  return "Unknown";
+    }
+  }
+
+  struct MemoryStats
+  {
+    /// @brief Bytes currently allocated.
+    uint64 CurrentBytes {0};
+
+    /// @brief Highest value `CurrentBytes` has reached.
+    uint64 PeakBytes {0};
+
+    /// @brief Allocations that haven't been freed yet.
+    uint64 LiveAllocations {0};
+
+    /// @brief Allocations made since startup.
+    uint64 TotalAllocations {0};
+
+    /// @brief Allocations made during the last completed frame.
+    uint64 FrameAllocations {0};
+  };
+
+  /// @brief Tracks how much memory each subsystem is using.
+  /// @details Counters are updated with relaxed atomics so tracking is cheap enough to leave on in release
+  /// builds. Memory is attributed to a tag either explicitly (`Allocate`, `TrackingAllocator`) or, when the
+  /// global `operator new` is hooked, to the calling thread's current tag (see `MemoryScope`).
+  class MemoryTracker
+  {
+  public:
+    STATIC_CLASS(MemoryTracker)
+
+    /// @brief Allocates tracked memory. Must be released with `Free`.
+    /// @returns The allocation, or `nullptr` if the system is out of memory.
+    NO_DISCARD static void *Allocate(size_t bytes, size_t alignment, MemoryTag tag) noexcept;
+
+    /// @brief Releases memory returned by `Allocate`. Does nothing if `memory` is `nullptr`.
+    static void Free(void *memory) noexcept;
+
+    /// @brief Records an allocation made outside of the tracker, e.g. by a third party library.
+    static void RecordAllocation(MemoryTag tag, size_t bytes) noexcept;
+
+    /// @brief Records the release of memory previously passed to `RecordAllocation`.
+    static void RecordFree(MemoryTag tag, size_t bytes) noexcept;
+
+    NO_DISCARD static MemoryStats GetStats(MemoryTag tag) noexcept;
+
+    /// @brief Get the stats summed across all tags. `PeakBytes` is the sum of each tag's peak.
+    NO_DISCARD static MemoryStats GetTotalStats() noexcept;
+
+    /// @brief Get the tag that untagged allocations on the calling thread are attributed to.
+    NO_DISCARD static MemoryTag GetCurrentTag() noexcept;
+
+    /// @brief Marks the end of a frame, resetting the per-frame allocation counts.
+    static void EndFrame() noexcept;
+
+    /// @brief Logs the stats for each tag that has been used.
+    static void LogStats() noexcept;
+
+    /// @brief Logs every tag that still has live allocations.
+    /// @returns True if there were no live allocations.
+    static bool ReportLeaks() noexcept;
+
+  private:
+    friend class MemoryScope;
+
+    static void SetCurrentTag(MemoryTag tag) noexcept;
+  };
+
+  /// @brief Attributes allocations made on the calling thread through the global `operator new` to `tag`,
+  /// for as long as the scope is alive.
+  class MemoryScope
+  {
+  public:
+    NO_COPY_MOVE(MemoryScope)
+
+    explicit MemoryScope(MemoryTag tag) noexcept : _previous(MemoryTracker::GetCurrentTag())
+    {
+      MemoryTracker::SetCurrentTag(tag);
+    }
+
+    ~MemoryScope() noexcept
+    {
+      MemoryTracker::SetCurrentTag(_previous);
+    }
+
+  private:
+    MemoryTag _previous;
+  };
+
+  /// @brief Standard allocator that attributes everything it allocates to `Tag`.
+  template <typename T, MemoryTag Tag>
+  class TrackingAllocator
+  {
+  public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+      using other = TrackingAllocator<U, Tag>;
+    };
+
+    constexpr TrackingAllocator() noexcept = default;
+
+    template <typename U>
+    constexpr TrackingAllocator(const TrackingAllocator<U, Tag> &) noexcept
+    {
+    }
+
+    NO_DISCARD T *allocate(size_t count)
+    {
+      void *memory = MemoryTracker::Allocate(count * sizeof(T), alignof(T), Tag);
+      if (memory == nullptr)
+        throw std::bad_alloc();
+      return static_cast<T *>(memory);
+    }
+
+    void deallocate(T *memory, size_t) noexcept
+    {
+      MemoryTracker::Free(memory);
+    }
+
+    template <typename U>
+    constexpr bool operator==(const TrackingAllocator<U, Tag> &) const noexcept
+    {
+      return true;
+    }
+  };
+
+#ifdef KRYS_ENABLE_MEMORY_TRACKING
+  /// @brief A `List` whose memory is attributed to `Tag`. A plain `List` when memory tracking is disabled.
+  template <typename T, MemoryTag Tag>
+  using TrackedList = std::vector<T, TrackingAllocator<T, Tag>>;
+#else
+  template <typename T, MemoryTag>
+  using TrackedList = List<T>;
+#endif
+}
+
@@ -1,29 +1,44 @@
 #pragma once
 
 #include "Base/Macros.hpp"
+#include "Base/Pointers.hpp"
 #include "Base/Types.hpp"
-#include "Events/Event.hpp"
+#include "Events/EventQueue.hpp"
 
 namespace Krys
 {
-  class EventManager;
-
   /// @brief Dispatches events to registered handlers.
+  /// @details Events and handlers are grouped by type into `EventQueue`s, stored in a flat array indexed by
+  /// `EventTypeIndex`. Dispatching is batched per type, so there's no lookup or cast per event.
   class EventDispatcher
   {
-    friend class EventManager;
-
   public:
     NO_COPY(EventDispatcher)
 
     /// @brief Constructs an `EventDispatcher`.
     EventDispatcher() noexcept = default;
 
-    /// @brief Dispatches an event to all registered handlers for the event's type.
-    /// @param event The event to dispatch.
-    void Dispatch(const Event &event) const noexcept;
+    /// @brief Get the queue for `TEvent`, creating it if needed.
+    template <typename TEvent>
+    NO_DISCARD EventQueue<TEvent> &GetQueue() noexcept
+    {
+      const EventTypeIndex index = GetEventTypeIndex<TEvent>();
+      if (index >= _queues.size())
+        _queues.resize(index + 1);
+
+      auto &queue = _queues[index];
+      if (!queue)
+        queue = CreateUnique<EventQueue<TEvent>>();
+      return static_cast<EventQueue<TEvent> &>(*queue);
+    }
+
+    /// @brief Dispatches all pending events to the registered handlers for their type. Event types are
+    /// dispatched one at a time, so events are only ordered relative to other events of the same type.
+    /// @returns True if any events were dispatched.
+    bool Dispatch() noexcept;
 
   private:
-    Map<EventType, List<Func<bool(const Event &)>>, EventTypeHasher> _handlers;
+    /// @brief Indexed by `EventTypeIndex`. Null for types that have never been queued or handled.
+    List<Unique<EventQueueBase>> _queues;
   };
-}
\ No newline at end of file
+}
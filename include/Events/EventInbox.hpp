@@ -0,0 +1,156 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Macros.hpp"
+#include "Base/Pointers.hpp"
+#include "Base/Types.hpp"
+#include "Events/EventDispatcher.hpp"
+#include "Utils/Locks/ScopedLock.hpp"
+#include "Utils/Locks/SpinLock.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Krys
+{
+  namespace Impl
+  {
+    /// @brief Written in front of every event in an `EventStagingArena`, so the consumer can move the event
+    /// into its typed queue without knowing the type.
+    struct StagedEvent
+    {
+      void (*Deliver)(EventDispatcher &dispatcher, void *event) noexcept;
+      void (*Destroy)(void *event) noexcept;
+
+      /// @brief Size of the event that follows, padded to the arena's alignment.
+      uint32 Size;
+    };
+
+    /// @brief Alignment of every entry in an `EventStagingArena`, which is what `new` guarantees for blocks.
+    constexpr size_t EventStagingAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    NO_DISCARD constexpr size_t AlignToEventStaging(size_t size) noexcept
+    {
+      return (size + EventStagingAlignment - 1) & ~(EventStagingAlignment - 1);
+    }
+
+    /// @brief Append only storage for type erased events. Made of fixed size blocks so events never move
+    /// once constructed, and blocks are kept after being drained so a steady stream of events stops
+    /// allocating once the arena has grown to its peak size.
+    class EventStagingArena
+    {
+    public:
+      NO_COPY_MOVE(EventStagingArena)
+
+      static constexpr size_t BlockSize = 16 * 1'024;
+
+      EventStagingArena() noexcept = default;
+
+      ~EventStagingArena() noexcept
+      {
+        Drain(nullptr);
+      }
+
+      template <typename TEvent, typename... Args>
+      void Push(Args &&...args) noexcept
+      {
+        static_assert(alignof(TEvent) <= EventStagingAlignment, "Over-aligned events can't be posted.");
+        static_assert(EventOffset + sizeof(TEvent) <= BlockSize, "Event is too large to be posted.");
+
+        constexpr size_t EventSize = AlignToEventStaging(sizeof(TEvent));
+        byte *entry = Allocate(EventOffset + EventSize);
+        new (entry) StagedEvent {&DeliverEvent<TEvent>, &DestroyEvent<TEvent>,
+                                 static_cast<uint32>(EventSize)};
+        new (entry + EventOffset) TEvent(std::forward<Args>(args)...);
+      }
+
+      /// @brief Moves every event, in the order they were pushed, into `dispatcher` and resets the arena.
+      /// @param dispatcher The dispatcher to deliver to. If null the events are discarded.
+      void Drain(EventDispatcher *dispatcher) noexcept;
+
+      NO_DISCARD bool IsEmpty() const noexcept
+      {
+        return _blocks.empty() || _blocks[0].Used == 0;
+      }
+
+    private:
+      struct Block
+      {
+        Unique<byte[]> Data;
+        size_t Used {0};
+      };
+
+      static constexpr size_t EventOffset = AlignToEventStaging(sizeof(StagedEvent));
+
+      template <typename TEvent>
+      static void DeliverEvent(EventDispatcher &dispatcher, void *event) noexcept
+      {
+        auto &typed = *static_cast<TEvent *>(event);
+        dispatcher.GetQueue<TEvent>().Push(std::move(typed));
+        typed.~TEvent();
+      }
+
+      template <typename TEvent>
+      static void DestroyEvent(void *event) noexcept
+      {
+        static_cast<TEvent *>(event)->~TEvent();
+      }
+
+      NO_DISCARD byte *Allocate(size_t size) noexcept;
+
+      List<Block> _blocks;
+      size_t _current {0};
+    };
+
+    /// @brief Staging buffers for a single producer thread. The producer writes to one arena while the
+    /// consumer drains the other, so the lock is only held long enough to construct an event or flip arenas.
+    struct EventProducer
+    {
+      Concurrency::SpinLock Lock;
+      EventStagingArena Arenas[2];
+      uint8 Active {0};
+
+      /// @brief Set when the owning thread exits, so the inbox can drop the producer once it's drained.
+      std::atomic<bool> Retired {false};
+    };
+  }
+
+  /// @brief Multi-producer, single-consumer inbox that lets any thread post events to an `EventManager`.
+  /// @details Each posting thread gets its own staging buffers the first time it posts, which is the only
+  /// time the inbox itself is locked. After that, posting only touches the calling thread's buffers.
+  /// The consumer drains every producer in one batch.
+  ///
+  /// Events posted by a single thread are delivered in the order they were posted. There is no ordering
+  /// between different threads, or between posted events and events enqueued directly on the main thread.
+  class EventInbox
+  {
+  public:
+    NO_COPY_MOVE(EventInbox)
+
+    EventInbox() noexcept;
+
+    /// @brief Construct an event in the calling thread's staging buffer. Safe to call from any thread.
+    template <typename TEvent, typename... Args>
+    void Post(Args &&...args) noexcept
+    {
+      auto &producer = GetThreadProducer();
+      Concurrency::ScopedLock<Concurrency::SpinLock> lock(producer.Lock);
+      producer.Arenas[producer.Active].Push<TEvent>(std::forward<Args>(args)...);
+    }
+
+    /// @brief Moves every posted event into `dispatcher`. Must only be called by one thread at a time.
+    void Drain(EventDispatcher &dispatcher) noexcept;
+
+  private:
+    NO_DISCARD Impl::EventProducer &GetThreadProducer() noexcept;
+
+    /// @brief Distinguishes inboxes in the per-thread producer cache, since addresses can be reused.
+    uint64 _id;
+
+    std::mutex _registryMutex;
+    List<Ref<Impl::EventProducer>> _producers;
+  };
+}
@@ -3,11 +3,18 @@
 #include "Base/Attributes.hpp"
 #include "Base/Pointers.hpp"
 #include "Base/Types.hpp"
+#include "Debug/Macros.hpp"
 #include "Events/EventDispatcher.hpp"
+#include "Events/EventInbox.hpp"
+#include "Events/EventRecorder.hpp"
+#include "Events/EventTimerWheel.hpp"
 
 namespace Krys
 {
   /// @brief Provides basic event queuing and dispatch functionality.
+  /// @details Events are queued by value in a contiguous queue per event type. Ordering is preserved between
+  /// events of the same type, but not across types. Everything except `Post` must be called from the main
+  /// thread.
   class EventManager
   {
   public:
@@ -18,11 +25,117 @@ namespace Krys
 
     /// @brief Add an event to the queue.
     /// @param event The event to add.
-    void Enqueue(Unique<Event> event) noexcept;
+    template <typename TEvent>
+    void Enqueue(TEvent event) noexcept
+    {
+      static_assert(std::is_base_of_v<Event, TEvent>, "Must be derived from Krys::Event");
+      if (_recorder && _pollingInput)
+        _recorder->Record(_frame, event);
+      _dispatcher.GetQueue<TEvent>().Push(std::move(event));
+    }
+
+    /// @brief Construct an event in place at the back of the queue.
+    /// @param args The arguments to construct `TEvent` with.
+    template <typename TEvent, typename... Args>
+    void Emplace(Args &&...args) noexcept
+    {
+      static_assert(std::is_base_of_v<Event, TEvent>, "Must be derived from Krys::Event");
+      if (_recorder && _pollingInput)
+        Enqueue(TEvent(std::forward<Args>(args)...));
+      else
+        _dispatcher.GetQueue<TEvent>().Emplace(std::forward<Args>(args)...);
+    }
+
+    /// @brief Construct an event from any thread. Posted events are picked up by the next call to
+    /// `ProcessEvents`, in the order they were posted by each thread. See `EventInbox`.
+    /// @param args The arguments to construct `TEvent` with.
+    template <typename TEvent, typename... Args>
+    void Post(Args &&...args) noexcept
+    {
+      static_assert(std::is_base_of_v<Event, TEvent>, "Must be derived from Krys::Event");
+      _inbox.Post<TEvent>(std::forward<Args>(args)...);
+    }
 
-    /// @brief Processes all queued events.
+    /// @brief Raise an event once, after a delay.
+    /// @param delayMs How long to wait, in milliseconds. The event is raised by the first call to
+    /// `ProcessEvents` after that.
+    /// @param args The arguments to construct `TEvent` with.
+    /// @returns An id that can be passed to `CancelTimer`.
+    template <typename TEvent, typename... Args>
+    TimerId Schedule(uint32 delayMs, Args &&...args) noexcept
+    {
+      static_assert(std::is_base_of_v<Event, TEvent>, "Must be derived from Krys::Event");
+      const uint64 now = GetTimeMs();
+      return _timers.Schedule(TEvent(std::forward<Args>(args)...), now, now + delayMs, 0);
+    }
+
+    /// @brief Raise an event repeatedly, every `intervalMs` milliseconds, until it's cancelled.
+    /// @param args The arguments to construct `TEvent` with. Every raised event is a copy.
+    /// @returns An id that can be passed to `CancelTimer`.
+    template <typename TEvent, typename... Args>
+    TimerId SchedulePeriodic(uint32 intervalMs, Args &&...args) noexcept
+    {
+      static_assert(std::is_base_of_v<Event, TEvent>, "Must be derived from Krys::Event");
+      KRYS_ASSERT(intervalMs > 0, "Interval must be greater than zero");
+      const uint64 now = GetTimeMs();
+      return _timers.Schedule(TEvent(std::forward<Args>(args)...), now, now + intervalMs, intervalMs);
+    }
+
+    /// @brief Stop a scheduled event from being raised again.
+    /// @returns False if the timer doesn't exist, e.g. because it was a one-off that has already fired.
+    bool CancelTimer(TimerId id) noexcept;
+
+    /// @brief Set how events of type `TEvent` are combined when queued. Coalescing is applied at enqueue
+    /// time, so e.g. a flood of `MouseMoveEvent`s can be dispatched as a single event per frame.
+    /// `EventCoalescing::Accumulate` requires `TEvent` to have an `Accumulate(const TEvent &)` method.
+    template <typename TEvent>
+    void SetCoalescing(EventCoalescing coalescing) noexcept
+    {
+      static_assert(std::is_base_of_v<Event, TEvent>, "Must be derived from Krys::Event");
+      KRYS_ASSERT(coalescing != EventCoalescing::Accumulate || AccumulatingEvent<TEvent>,
+                  "Event type can't be accumulated");
+      _dispatcher.GetQueue<TEvent>().SetCoalescing(coalescing);
+    }
+
+    /// @brief Processes all queued, posted and due events, including any queued by handlers while processing.
+    /// Each call completes a frame.
     void ProcessEvents() noexcept;
 
+    /// @brief Get the number of times `ProcessEvents` has completed. Events enqueued before the next call
+    /// belong to this frame.
+    NO_DISCARD uint64 GetFrame() const noexcept
+    {
+      return _frame;
+    }
+
+    /// @brief Capture every event enqueued between `BeginInput` and `EndInput` with `recorder`.
+    /// @param recorder The recorder to use, or `nullptr` to stop capturing. Must outlive its use here.
+    void SetRecorder(Ptr<EventRecorder> recorder) noexcept
+    {
+      _recorder = recorder;
+    }
+
+    /// @brief Mark the start of polling the window and input devices. Events enqueued until `EndInput` come
+    /// from the user, so they're what the recorder captures. Anything game code raises at other times is
+    /// raised again when a recording is replayed, so recording it too would deliver it twice.
+    void BeginInput() noexcept
+    {
+      _pollingInput = true;
+    }
+
+    void EndInput() noexcept
+    {
+      _pollingInput = false;
+    }
+
+    /// @brief Advance the clock that timers run on by `frameTimeMs` per frame instead of following real time,
+    /// so they fire on the same frames every run. See `ApplicationSettings::FixedFrameTimeMs`.
+    /// @param frameTimeMs The time per frame, or zero to use real time.
+    void SetFixedFrameTime(float frameTimeMs) noexcept
+    {
+      _fixedFrameTimeMs = frameTimeMs;
+    }
+
     /// @brief Register an event handler for `TEvent`. The event handler must return true or false depending
     /// on whether the event should propagate to other handlers.
     /// @attention Be careful with adding event handlers that themselves dispatch events.
@@ -30,20 +143,25 @@ namespace Krys
     void RegisterHandler(Func<bool(const TEvent &)> handler) noexcept
     {
       static_assert(std::is_base_of_v<Event, TEvent>, "Must be derived from Krys::Event");
-      const auto lambda = [handler](const Event &event) -> bool
-      {
-        return handler(static_cast<const TEvent &>(event));
-      };
-
-      EventType typeId = TEvent::GetStaticType();
-      _dispatcher._handlers[typeId].push_back(lambda);
+      _dispatcher.GetQueue<TEvent>().AddHandler(std::move(handler));
     }
 
   private:
-    /// @brief Pending event queue.
-    Queue<Unique<Event>> _events;
+    /// @brief The time timers are scheduled and raised by, in milliseconds.
+    NO_DISCARD uint64 GetTimeMs() const noexcept;
 
-    /// @brief Dispatches events.
+    /// @brief Pending events and their handlers.
     EventDispatcher _dispatcher;
+
+    /// @brief Events posted from other threads, waiting to be moved into the dispatcher.
+    EventInbox _inbox;
+
+    /// @brief Delayed and periodic events.
+    EventTimerWheel _timers;
+
+    Ptr<EventRecorder> _recorder {nullptr};
+    uint64 _frame {0};
+    float _fixedFrameTimeMs {0.0f};
+    bool _pollingInput {false};
   };
-}
\ No newline at end of file
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Macros.hpp"
+#include "Base/Types.hpp"
+#include "Events/Event.hpp"
+
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+namespace Krys
+{
+  /// @brief Dense, zero based index for an event type. Assigned the first time a type is used, so it's only
+  /// stable for the lifetime of the program. Use `EventType` for anything that needs to be persisted.
+  typedef uint32 EventTypeIndex;
+
+  namespace Impl
+  {
+    NO_DISCARD inline EventTypeIndex NextEventTypeIndex() noexcept
+    {
+      static std::atomic<EventTypeIndex> next {0};
+      return next.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  /// @brief Get the dense index for `TEvent`.
+  template <typename TEvent>
+  NO_DISCARD EventTypeIndex GetEventTypeIndex() noexcept
+  {
+    static_assert(std::is_base_of_v<Event, TEvent>, "Must be derived from Krys::Event");
+    static const EventTypeIndex index = Impl::NextEventTypeIndex();
+    return index;
+  }
+
+  /// @brief How events of the same type are combined when they're queued, before they're dispatched.
+  enum class EventCoalescing : uint8
+  {
+    /// @brief Every event is dispatched.
+    None,
+
+    /// @brief Only the most recently queued event is dispatched.
+    KeepLatest,
+
+    /// @brief Events are merged into the pending one with `TEvent::Accumulate`, e.g. to sum movement deltas.
+    Accumulate
+  };
+
+  template <typename TEvent>
+  concept AccumulatingEvent = requires(TEvent &pending, const TEvent &next) { pending.Accumulate(next); };
+
+  /// @brief Type erased interface for an `EventQueue`, so queues for every event type can live in one array.
+  class EventQueueBase
+  {
+  public:
+    NO_COPY(EventQueueBase)
+
+    virtual ~EventQueueBase() noexcept = default;
+
+    /// @brief Dispatches every pending event to the registered handlers, in the order they were queued.
+    virtual void Dispatch() noexcept = 0;
+
+    /// @brief Check if there are any pending events.
+    NO_DISCARD virtual bool IsEmpty() const noexcept = 0;
+
+  protected:
+    EventQueueBase() noexcept = default;
+  };
+
+  /// @brief Contiguous queue of pending events of a single type, along with the handlers for that type.
+  /// Events are stored by value, and the storage is reused between frames, so queuing an event doesn't
+  /// allocate once the queue has grown to the peak number of events per frame. Coalescing only ever combines
+  /// an event with the last one still waiting to be dispatched.
+  template <typename TEvent>
+  class EventQueue final : public EventQueueBase
+  {
+  public:
+    EventQueue() noexcept = default;
+
+    void Push(TEvent &&event) noexcept
+    {
+      if (_coalescing == EventCoalescing::None || _pending.empty())
+        _pending.emplace_back(std::move(event));
+      else
+        Coalesce(std::move(event));
+    }
+
+    template <typename... Args>
+    void Emplace(Args &&...args) noexcept
+    {
+      if (_coalescing == EventCoalescing::None)
+        _pending.emplace_back(std::forward<Args>(args)...);
+      else
+        Push(TEvent(std::forward<Args>(args)...));
+    }
+
+    /// @brief Set how events are combined from now on. Events that are already queued aren't affected.
+    void SetCoalescing(EventCoalescing coalescing) noexcept
+    {
+      _coalescing = coalescing;
+    }
+
+    void AddHandler(Func<bool(const TEvent &)> handler) noexcept
+    {
+      _handlers.emplace_back(std::move(handler));
+    }
+
+    /// @copydoc EventQueueBase::Dispatch
+    /// @note Events of this type queued by a handler are dispatched on the next call, not this one.
+    void Dispatch() noexcept override
+    {
+      std::swap(_pending, _dispatching);
+
+      for (const auto &event : _dispatching)
+        for (const auto &handler : _handlers)
+          if (handler(event))
+            break;
+
+      _dispatching.clear();
+    }
+
+    NO_DISCARD bool IsEmpty() const noexcept override
+    {
+      return _pending.empty();
+    }
+
+  private:
+    void Coalesce(TEvent &&event) noexcept
+    {
+      if constexpr (AccumulatingEvent<TEvent>)
+      {
+        if (_coalescing == EventCoalescing::Accumulate)
+        {
+          _pending.back().Accumulate(event);
+          return;
+        }
+      }
+
+      _pending.back() = std::move(event);
+    }
+
+    EventCoalescing _coalescing {EventCoalescing::None};
+    List<TEvent> _pending;
+    List<TEvent> _dispatching;
+    List<Func<bool(const TEvent &)>> _handlers;
+  };
+}
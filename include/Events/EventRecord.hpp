@@ -0,0 +1,164 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Macros.hpp"
+#include "Base/Types.hpp"
+#include "Events/Event.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace Krys
+{
+  /// @brief Appends the fields of a recorded event to a buffer. Numbers are written little endian, and
+  /// unsigned integers can be written as LEB128 varints to keep recordings small.
+  class EventRecordWriter
+  {
+  public:
+    NO_COPY_MOVE(EventRecordWriter)
+
+    explicit EventRecordWriter(List<byte> &buffer) noexcept : _buffer(buffer)
+    {
+    }
+
+    template <typename T>
+    REQUIRES(std::is_arithmetic_v<T> || std::is_enum_v<T>)
+    void Write(T value) noexcept
+    {
+      if constexpr (std::is_enum_v<T>)
+        Write(static_cast<std::underlying_type_t<T>>(value));
+      else
+      {
+        auto bytes = std::bit_cast<Array<byte, sizeof(T)>>(value);
+        if constexpr (std::endian::native == std::endian::big)
+          std::reverse(bytes.begin(), bytes.end());
+        _buffer.insert(_buffer.end(), bytes.begin(), bytes.end());
+      }
+    }
+
+    void WriteVarint(uint64 value) noexcept
+    {
+      while (value >= 0x80)
+      {
+        _buffer.push_back(static_cast<byte>(value | 0x80));
+        value >>= 7;
+      }
+      _buffer.push_back(static_cast<byte>(value));
+    }
+
+    void WriteBytes(const byte *data, size_t size) noexcept
+    {
+      _buffer.insert(_buffer.end(), data, data + size);
+    }
+
+  private:
+    List<byte> &_buffer;
+  };
+
+  /// @brief Reads back what an `EventRecordWriter` wrote. Reading past the end yields zeroes and marks the
+  /// reader as failed rather than asserting, since recordings come from disk.
+  class EventRecordReader
+  {
+  public:
+    NO_COPY_MOVE(EventRecordReader)
+
+    EventRecordReader(const byte *data, size_t size) noexcept : _data(data), _size(size)
+    {
+    }
+
+    template <typename T>
+    REQUIRES(std::is_arithmetic_v<T> || std::is_enum_v<T>)
+    NO_DISCARD T Read() noexcept
+    {
+      if constexpr (std::is_enum_v<T>)
+        return static_cast<T>(Read<std::underlying_type_t<T>>());
+      else
+      {
+        Array<byte, sizeof(T)> bytes {};
+        if (!Take(bytes.data(), sizeof(T)))
+          return T {};
+        if constexpr (std::endian::native == std::endian::big)
+          std::reverse(bytes.begin(), bytes.end());
+        return std::bit_cast<T>(bytes);
+      }
+    }
+
+    NO_DISCARD uint64 ReadVarint() noexcept
+    {
+      uint64 value = 0;
+      for (uint32 shift = 0; shift < 64; shift += 7)
+      {
+        byte next {0};
+        if (!Take(&next, 1))
+          return 0;
+
+        value |= (std::to_integer<uint64>(next) & 0x7F) << shift;
+        if ((next & byte {0x80}) == byte {0})
+          return value;
+      }
+
+      _failed = true;
+      return 0;
+    }
+
+    /// @brief Advance past `size` bytes without reading them.
+    void Skip(size_t size) noexcept
+    {
+      if (size > _size - _offset)
+      {
+        _failed = true;
+        _offset = _size;
+        return;
+      }
+      _offset += size;
+    }
+
+    NO_DISCARD const byte *GetCurrent() const noexcept
+    {
+      return _data + _offset;
+    }
+
+    NO_DISCARD size_t GetRemaining() const noexcept
+    {
+      return _size - _offset;
+    }
+
+    NO_DISCARD bool HasFailed() const noexcept
+    {
+      return _failed;
+    }
+
+  private:
+    bool Take(byte *destination, size_t size) noexcept
+    {
+      if (_failed || size > _size - _offset)
+      {
+        _failed = true;
+        return false;
+      }
+
+      std::memcpy(destination, _data + _offset, size);
+      _offset += size;
+      return true;
+    }
+
+    const byte *_data;
+    size_t _size;
+    size_t _offset {0};
+    bool _failed {false};
+  };
+
+  /// @brief An event that can be written to and read back from a recording. Events that don't satisfy this
+  /// are ignored by `EventRecorder`.
+  template <typename TEvent>
+  concept RecordableEvent =
+    std::is_base_of_v<Event, TEvent> && requires(const TEvent &event, EventRecordWriter &writer,
+                                                 EventRecordReader &reader) {
+      event.Serialize(writer);
+      { TEvent::Deserialize(reader) } -> std::same_as<TEvent>;
+    };
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Macros.hpp"
+#include "Base/Types.hpp"
+#include "Events/EventRecord.hpp"
+
+#include <fstream>
+
+namespace Krys
+{
+  /// @brief Identifies an event recording file.
+  constexpr Array<char, 4> EventRecordingMagic = {'K', 'R', 'E', 'C'};
+  constexpr uint16 EventRecordingVersion = 1;
+
+  /// @brief Captures events entering an `EventManager` into a compact binary file, so a session can be
+  /// replayed later with `EventReplayDevice`.
+  /// @details The file starts with `EventRecordingMagic` and `EventRecordingVersion`, followed by one entry
+  /// per event:
+  /// - varint: frames since the previous entry.
+  /// - varint: microseconds since the previous entry.
+  /// - uint32: the `EventType`.
+  /// - varint: payload size, followed by the payload written by `TEvent::Serialize`.
+  ///
+  /// Only `RecordableEvent`s raised while the window and input devices are polled are captured (see
+  /// `EventManager::BeginInput`). Events raised by game code, handlers or timers, and events posted from
+  /// other threads, aren't recorded, since replaying the session raises them again.
+  class EventRecorder
+  {
+  public:
+    NO_COPY_MOVE(EventRecorder)
+
+    EventRecorder() noexcept = default;
+
+    ~EventRecorder() noexcept
+    {
+      Stop();
+    }
+
+    /// @brief Start recording to `path`, replacing any existing file.
+    /// @returns False if the file couldn't be opened.
+    bool Start(const stringview &path) noexcept;
+
+    /// @brief Write everything recorded so far and close the file.
+    void Stop() noexcept;
+
+    NO_DISCARD bool IsRecording() const noexcept
+    {
+      return _file.is_open();
+    }
+
+    /// @brief Records `event` if it's a `RecordableEvent`. Does nothing otherwise.
+    /// @param frame The frame the event was raised on. See `EventManager::GetFrame`.
+    template <typename TEvent>
+    void Record(uint64 frame, const TEvent &event) noexcept
+    {
+      if constexpr (RecordableEvent<TEvent>)
+      {
+        if (!IsRecording())
+          return;
+
+        _payload.clear();
+        EventRecordWriter payload(_payload);
+        event.Serialize(payload);
+        WriteEntry(frame, TEvent::GetStaticType());
+      }
+    }
+
+  private:
+    /// @brief Writes the entry header followed by `_payload`.
+    void WriteEntry(uint64 frame, EventType type) noexcept;
+
+    void Flush() noexcept;
+
+    std::ofstream _file;
+    List<byte> _buffer;
+    List<byte> _payload;
+    uint64 _lastFrame {0};
+    int64 _startTicks {0};
+    uint64 _lastMicroseconds {0};
+  };
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Macros.hpp"
+#include "Base/Types.hpp"
+#include "Events/EventDispatcher.hpp"
+
+#include <utility>
+
+namespace Krys
+{
+  /// @brief Identifies a scheduled event so it can be cancelled. Never zero for a valid timer.
+  typedef uint64 TimerId;
+
+  /// @brief Hashed timer wheel that raises events after a delay, or periodically.
+  /// @details Time is split into 1 millisecond ticks, and each timer lives in the slot for the tick it's due
+  /// on, modulo the number of slots. Advancing the wheel only visits the slots for the ticks that have passed
+  /// since the last advance, so the cost depends on elapsed time rather than the number of pending timers.
+  /// Timers more than one revolution away simply stay in their slot until they're due.
+  class EventTimerWheel
+  {
+  public:
+    NO_COPY(EventTimerWheel)
+
+    static constexpr uint32 SlotCount = 256;
+
+    EventTimerWheel() noexcept = default;
+
+    /// @brief Raise a copy of `event` at `dueMs`, and every `intervalMs` after that if it's not zero.
+    /// @param nowMs The current time. Timers that are already due fire on the next advance.
+    template <typename TEvent>
+    TimerId Schedule(TEvent event, uint64 nowMs, uint64 dueMs, uint32 intervalMs) noexcept
+    {
+      auto fire = [event = std::move(event)](EventDispatcher &dispatcher, bool last) mutable
+      {
+        if (last)
+          dispatcher.GetQueue<TEvent>().Push(std::move(event));
+        else
+          dispatcher.GetQueue<TEvent>().Push(TEvent(event));
+      };
+
+      return Insert(Timer {++_lastId, dueMs > nowMs ? dueMs : nowMs, intervalMs, std::move(fire)});
+    }
+
+    /// @brief Stop a timer from firing again.
+    /// @returns False if the timer doesn't exist, e.g. because it already fired.
+    bool Cancel(TimerId id) noexcept;
+
+    /// @brief Queue the events for every timer due at or before `nowMs` into `dispatcher`. A periodic timer
+    /// that fell more than one interval behind fires once, then carries on from its original schedule.
+    void Advance(uint64 nowMs, EventDispatcher &dispatcher) noexcept;
+
+    NO_DISCARD size_t GetPendingCount() const noexcept
+    {
+      return _pendingCount;
+    }
+
+  private:
+    struct Timer
+    {
+      TimerId Id;
+      uint64 DueMs;
+      uint32 IntervalMs;
+
+      /// @brief Queues the event. `last` is true for the final firing, so the event can be moved.
+      Func<void(EventDispatcher &, bool)> Fire;
+    };
+
+    TimerId Insert(Timer &&timer) noexcept;
+
+    Array<List<Timer>, SlotCount> _slots;
+
+    /// @brief Timers that fired during the current advance and need to be rescheduled.
+    List<Timer> _periodic;
+
+    /// @brief The last tick that has been advanced to. Every slot for a tick at or before this has been
+    /// visited, so timers due by then are moved forward a tick when they're inserted.
+    uint64 _currentMs {0};
+    bool _started {false};
+
+    TimerId _lastId {0};
+    size_t _pendingCount {0};
+  };
+}
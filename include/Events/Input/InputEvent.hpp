@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Types.hpp"
+#include "Events/Event.hpp"
+
+namespace Krys
+{
+  /// @brief Base class for events raised by input devices.
+  ///
+  /// Every input event is stamped with the time it was polled from the OS, so the latency between input
+  /// arriving and the frame that reacts to it being presented can be measured.
+  class InputEvent : public Event
+  {
+  public:
+    /// @brief Gets the time the input was polled, in ticks (see `Platform::GetTicks`).
+    NO_DISCARD int64 GetTimestamp() const noexcept;
+
+  protected:
+    /// @brief Constructs an `InputEvent`, stamped with the current time.
+    InputEvent() noexcept;
+
+  private:
+    int64 _timestamp;
+  };
+}
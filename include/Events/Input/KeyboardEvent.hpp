@@ -1,13 +1,14 @@
 #pragma once
 
 #include "Base/Attributes.hpp"
-#include "Events/Event.hpp"
+#include "Events/EventRecord.hpp"
+#include "Events/Input/InputEvent.hpp"
 #include "IO/Input/Keys.hpp"
 
 namespace Krys
 {
   /// @brief Represents an interaction with a keyboard.
-  class KeyboardEvent : public Event
+  class KeyboardEvent : public InputEvent
   {
   public:
     KRYS_EVENT_CLASS_TYPE("keyboard-event")
@@ -23,6 +24,12 @@ namespace Krys
     /// @brief Gets the state of the key.
     NO_DISCARD KeyState GetState() const noexcept;
 
+    /// @brief Writes the event to a recording. See `EventRecorder`.
+    void Serialize(EventRecordWriter &writer) const noexcept;
+
+    /// @brief Reads an event written by `Serialize`.
+    NO_DISCARD static KeyboardEvent Deserialize(EventRecordReader &reader) noexcept;
+
   private:
     Key _key;
     KeyState _state;
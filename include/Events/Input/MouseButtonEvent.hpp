@@ -1,12 +1,13 @@
 #pragma once
 
-#include "Events/Event.hpp"
+#include "Events/EventRecord.hpp"
+#include "Events/Input/InputEvent.hpp"
 #include "IO/Input/Buttons.hpp"
 
 namespace Krys
 {
   /// @brief Represents a mouse button interaction.
-  class MouseButtonEvent : public Event
+  class MouseButtonEvent : public InputEvent
   {
   public:
     KRYS_EVENT_CLASS_TYPE("mouse-button-event")
@@ -30,6 +31,12 @@ namespace Krys
     /// @returns `true` if the button is in the state `MouseButtonState::Released`.
     NO_DISCARD bool WasReleased() const noexcept;
 
+    /// @brief Writes the event to a recording. See `EventRecorder`.
+    void Serialize(EventRecordWriter &writer) const noexcept;
+
+    /// @brief Reads an event written by `Serialize`.
+    NO_DISCARD static MouseButtonEvent Deserialize(EventRecordReader &reader) noexcept;
+
   private:
     MouseButton _button;
     MouseButtonState _state;
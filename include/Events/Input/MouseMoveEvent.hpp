@@ -1,12 +1,13 @@
 #pragma once
 
 #include "Base/Attributes.hpp"
-#include "Events/Event.hpp"
+#include "Events/EventRecord.hpp"
+#include "Events/Input/InputEvent.hpp"
 
 namespace Krys
 {
   /// @brief Represents a mouse movement.
-  class MouseMoveEvent : public Event
+  class MouseMoveEvent : public InputEvent
   {
   public:
     KRYS_EVENT_CLASS_TYPE("mouse-move-event")
@@ -32,6 +33,16 @@ namespace Krys
     /// @note The origin is the top-left corner of the window, minus the title bar.
     NO_DISCARD float GetClientY() const noexcept;
 
+    /// @brief Merges a later movement into this one. Deltas are summed and the cursor position is taken from
+    /// `next`. Used when the event is coalesced with `EventCoalescing::Accumulate`.
+    void Accumulate(const MouseMoveEvent &next) noexcept;
+
+    /// @brief Writes the event to a recording. See `EventRecorder`.
+    void Serialize(EventRecordWriter &writer) const noexcept;
+
+    /// @brief Reads an event written by `Serialize`.
+    NO_DISCARD static MouseMoveEvent Deserialize(EventRecordReader &reader) noexcept;
+
   private:
     float _deltaX, _deltaY;
     float _clientX, _clientY;
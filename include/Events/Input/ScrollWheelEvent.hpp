@@ -1,12 +1,13 @@
 #pragma once
 
 #include "Base/Attributes.hpp"
-#include "Events/Event.hpp"
+#include "Events/EventRecord.hpp"
+#include "Events/Input/InputEvent.hpp"
 
 namespace Krys
 {
   /// @brief Represents a user interaction with a mouse scroll wheel.
-  class ScrollWheelEvent : public Event
+  class ScrollWheelEvent : public InputEvent
   {
   public:
     KRYS_EVENT_CLASS_TYPE("scroll-wheel-event")
@@ -20,6 +21,16 @@ namespace Krys
     /// from the user), and negative values indicate scrolling backward (toward the user).
     NO_DISCARD float Delta() const noexcept;
 
+    /// @brief Merges a later scroll into this one by summing the deltas. Used when the event is coalesced with
+    /// `EventCoalescing::Accumulate`.
+    void Accumulate(const ScrollWheelEvent &next) noexcept;
+
+    /// @brief Writes the event to a recording. See `EventRecorder`.
+    void Serialize(EventRecordWriter &writer) const noexcept;
+
+    /// @brief Reads an event written by `Serialize`.
+    NO_DISCARD static ScrollWheelEvent Deserialize(EventRecordReader &reader) noexcept;
+
   private:
     float _delta;
   };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Events/Event.hpp"
+#include "Events/EventRecord.hpp"
 
 namespace Krys
 {
@@ -16,5 +17,16 @@ namespace Krys
 
     /// @brief Constructs a `QuitEvent`.
     QuitEvent() noexcept = default;
+
+    /// @brief Writes the event to a recording. See `EventRecorder`.
+    void Serialize(EventRecordWriter &) const noexcept
+    {
+    }
+
+    /// @brief Reads an event written by `Serialize`.
+    NO_DISCARD static QuitEvent Deserialize(EventRecordReader &) noexcept
+    {
+      return QuitEvent();
+    }
   };
 }
\ No newline at end of file
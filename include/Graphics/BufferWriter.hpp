@@ -2,6 +2,8 @@
 
 #include "Base/Types.hpp"
 
+#include <span>
+
 namespace Krys::Gfx
 {
   /// @brief A writer for a buffer.
@@ -26,9 +28,20 @@ namespace Krys::Gfx
 
     /// @brief Write a list of data to the buffer at the current offset.
     /// @tparam S Type of data to write.
+    /// @tparam TAllocator Allocator of the list, e.g. a `Debug::TrackingAllocator`.
+    /// @param data The data to write.
+    template <typename S, typename TAllocator>
+    void Write(const std::vector<S, TAllocator> &data) noexcept
+    {
+      Write(std::span<const S>(data));
+    }
+
+    /// @brief Write a contiguous range of data, e.g. a view into a mapped file, to the buffer at the current
+    /// offset.
+    /// @tparam S Type of data to write.
     /// @param data The data to write.
     template <typename S>
-    void Write(const List<S> &data) noexcept
+    void Write(std::span<const S> data) noexcept
     {
       _buffer.Write(data.data(), data.size() * sizeof(S), _offset);
       _offset += data.size() * sizeof(S);
@@ -3,10 +3,13 @@
 #include "Base/Attributes.hpp"
 #include "Base/Concepts.hpp"
 #include "Base/Types.hpp"
+#include "Debug/MemoryTracker.hpp"
 #include "Graphics/Buffer.hpp"
 #include "Graphics/VertexLayout.hpp"
 #include "Graphics/PrimitiveType.hpp"
 
+#include <span>
+
 namespace Krys::Gfx
 {
   class Mesh
@@ -15,14 +18,18 @@ namespace Krys::Gfx
     using vertex_t = VertexData;
     using index_t = uint32;
 
+    /// @brief Copies of the vertices and indices kept on the CPU, attributed to `MemoryTag::Meshes`.
+    using vertex_list_t = Debug::TrackedList<vertex_t, Debug::MemoryTag::Meshes>;
+    using index_list_t = Debug::TrackedList<index_t, Debug::MemoryTag::Meshes>;
+
     virtual ~Mesh() noexcept = default;
 
     virtual void Bind() noexcept = 0;
     virtual void Unbind() noexcept = 0;
 
     NO_DISCARD MeshHandle GetHandle() const noexcept;
-    NO_DISCARD const List<vertex_t> &GetVertices() const noexcept;
-    NO_DISCARD const List<index_t> &GetIndices() const noexcept;
+    NO_DISCARD const vertex_list_t &GetVertices() const noexcept;
+    NO_DISCARD const index_list_t &GetIndices() const noexcept;
     NO_DISCARD const VertexLayout &GetLayout() const noexcept;
     NO_DISCARD VertexBufferHandle GetVertexBuffer() const noexcept;
     NO_DISCARD IndexBufferHandle GetIndexBuffer() const noexcept;
@@ -35,11 +42,12 @@ namespace Krys::Gfx
     virtual void SetIndices(const List<index_t> &indices) noexcept = 0;
 
   protected:
-    Mesh(MeshHandle handle, const List<vertex_t> &vertices, const List<index_t> &indices, const VertexLayout &layout) noexcept;
+    Mesh(MeshHandle handle, std::span<const vertex_t> vertices, std::span<const index_t> indices,
+         const VertexLayout &layout) noexcept;
 
     MeshHandle _handle;
-    List<vertex_t> _vertices;
-    List<index_t> _indices;
+    vertex_list_t _vertices;
+    index_list_t _indices;
     VertexLayout _layout;
     VertexBufferHandle _vbo;
     IndexBufferHandle _ebo;
@@ -27,12 +27,13 @@ namespace Krys::Gfx
 
     /// @brief Create a mesh.
     /// @param name The name of the mesh.
-    /// @param vertices The vertices of the mesh.
+    /// @param vertices The vertices of the mesh. Uploaded straight from the span, so it can point into a
+    /// mapped file.
     /// @param indices The indices of the mesh.
     /// @param layout The layout of the vertices.
     /// @return A handle to the mesh.
-    NO_DISCARD MeshHandle CreateMesh(const string &name, const List<VertexData> &vertices,
-                                     const List<uint32> &indices,
+    NO_DISCARD MeshHandle CreateMesh(const string &name, std::span<const VertexData> vertices,
+                                     std::span<const uint32> indices,
                                      const VertexLayout &layout = VertexLayout::Default()) noexcept;
 
     /// @brief Get a mesh by handle.
@@ -55,7 +56,7 @@ namespace Krys::Gfx
     };
 
     NO_DISCARD virtual Unique<Mesh>
-      CreateMeshImpl(MeshHandle handle, const List<VertexData> &vertices, const List<uint32> &indices,
+      CreateMeshImpl(MeshHandle handle, std::span<const VertexData> vertices, std::span<const uint32> indices,
                      const VertexLayout &layout = VertexLayout::Default()) noexcept = 0;
 
     Ptr<GraphicsContext> _context {nullptr};
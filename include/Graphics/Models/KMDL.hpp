@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Pointers.hpp"
+#include "Base/Types.hpp"
+#include "Graphics/Colour.hpp"
+#include "Graphics/Models/ModelLoaderFlags.hpp"
+#include "Graphics/VertexLayout.hpp"
+#include "IO/VFS/VirtualFile.hpp"
+
+#include <span>
+
+namespace Krys::Gfx
+{
+  /// @brief A material as described by the model file. Textures are referenced by path, so they go through
+  /// `TextureManager::LoadTexture` (and its own cooked textures) when the model is created.
+  struct KMDLMaterial
+  {
+    Colour Ambient;
+    Colour Diffuse;
+    Colour Specular;
+    Colour Emissive;
+    float Shininess {32};
+
+    string AmbientMap;
+    string DiffuseMap;
+    string SpecularMap;
+    string EmissiveMap;
+  };
+
+  struct KMDLRenderable
+  {
+    string Name;
+
+    /// @brief Index into `KMDLModel::Materials`, or -1 for the default material.
+    int32 Material {-1};
+
+    std::span<const VertexData> Vertices {};
+    std::span<const uint32> Indices {};
+  };
+
+  struct KMDLModel
+  {
+    /// @brief `HashBytes` of the source file and its material libraries.
+    uint64 SourceHash {0};
+
+    /// @brief The flags the source was loaded with, which decide what the vertices hold.
+    ModelLoaderFlags Flags {ModelLoaderFlags::None};
+
+    List<KMDLMaterial> Materials;
+    List<KMDLRenderable> Renderables;
+
+    /// @brief The file the renderables point into when the model was loaded from disk.
+    IO::VirtualFile File;
+
+    /// @brief What the renderables point into when the model was parsed from its source instead.
+    List<List<VertexData>> VertexStorage;
+    List<List<uint32>> IndexStorage;
+  };
+
+  /// @brief Reads and writes Krystal's cooked model format.
+  /// @details A cooked model holds a model's meshes exactly as they're uploaded: the final vertex and index
+  /// arrays of each renderable, after triangulation, normal generation and deduplication, plus the
+  /// materials they use. Names and materials come first, then every array, each aligned so it can be used in
+  /// place once the file is mapped.
+  class KMDL
+  {
+  public:
+    /// @brief Cooked models sit next to their source, with this appended to its path.
+    static constexpr stringview Extension = ".kmdl";
+
+    KMDL() = default;
+    ~KMDL() = default;
+
+    /// @brief Opens the cooked model at `path` through the `IO::VFS`. The arrays are validated, but not
+    /// copied.
+    /// @return A unique pointer to the loaded model, or nullptr if the loading failed.
+    NO_DISCARD Unique<KMDLModel> Load(const string &path) noexcept;
+
+    /// @brief Loads a cooked model from memory. `data` must outlive the returned model, and be aligned to
+    /// at least `alignof(VertexData)`.
+    NO_DISCARD Unique<KMDLModel> Load(std::span<const byte> data) noexcept;
+
+    /// @brief Writes `model` to `path`.
+    /// @return True if the write was successful.
+    bool Save(const string &path, const KMDLModel &model) noexcept;
+
+    /// @brief Writes `model` to `buffer`, replacing its contents, e.g. to store it in an `IO::AssetCache`.
+    /// @return True if the write was successful.
+    bool Save(List<byte> &buffer, const KMDLModel &model) noexcept;
+  };
+}
@@ -6,8 +6,10 @@
 #include "Base/Types.hpp"
 #include "Graphics/Materials/MaterialManager.hpp"
 #include "Graphics/MeshManager.hpp"
+#include "Graphics/Models/KMDL.hpp"
 #include "Graphics/Models/ModelLoaderFlags.hpp"
 #include "Graphics/Models/Model.hpp"
+#include "IO/AssetCache.hpp"
 #include "MTL/Vectors/Vec3.hpp"
 
 namespace Krys::Gfx {
@@ -15,21 +17,35 @@ namespace Krys::Gfx {
   public:
     NO_COPY_MOVE(ModelManager)
 
+    /// @param assetCache Where cooked models are kept. Can be null, in which case they're written next to
+    /// their source instead.
     ModelManager(Ptr<MaterialManager> materialManager, Ptr<MeshManager> meshManager,
-                 Ptr<TextureManager> textureManager) noexcept;
+                 Ptr<TextureManager> textureManager, Ptr<IO::AssetCache> assetCache) noexcept;
     ~ModelManager() noexcept = default;
 
 
     /// @brief Load a model from a file.
     /// @param path The path to the model file.
+    /// @note If a cooked model (`path` + `KMDL::Extension`, e.g. from a mounted pack) or the asset cache
+    /// holds `path` cooked from the current contents of it and its material libraries with the same `flags`,
+    /// its meshes are uploaded straight from the mapped file instead. Otherwise one is stored in the asset
+    /// cache, or next to `path` without one, so later runs can skip parsing.
     NO_DISCARD Expected<Model> LoadModel(const stringview &path,
                                          ModelLoaderFlags flags = ModelLoaderFlags::None) noexcept;
 
   protected:
+    /// @brief Parse the OBJ file at `path` into its final vertex and index arrays.
+    NO_DISCARD Expected<Unique<KMDLModel>> ParseModel(const stringview &path,
+                                                      ModelLoaderFlags flags) const noexcept;
+
+    /// @brief Create the materials and meshes of `model`.
+    NO_DISCARD Model CreateModel(const stringview &path, const KMDLModel &model) noexcept;
+
       NO_DISCARD Vec3 GenerateNormal(const Vec3 &v0, const Vec3 &v1, const Vec3 &v2) const noexcept;
 
     Ptr<MaterialManager> _materialManager;
     Ptr<MeshManager> _meshManager;
     Ptr<TextureManager> _textureManager;
+    Ptr<IO::AssetCache> _assetCache;
   };
 }
\ No newline at end of file
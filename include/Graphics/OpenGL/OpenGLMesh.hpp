@@ -19,8 +19,8 @@ namespace Krys::Gfx::OpenGL
     using vertex_t = Mesh::vertex_t;
     using index_t = Mesh::index_t;
 
-    OpenGLMesh(MeshHandle handle, const List<vertex_t> &vertices, const List<index_t> &indices, const VertexLayout &layout,
-               Ptr<OpenGLGraphicsContext> ctx) noexcept;
+    OpenGLMesh(MeshHandle handle, std::span<const vertex_t> vertices, std::span<const index_t> indices,
+               const VertexLayout &layout, Ptr<OpenGLGraphicsContext> ctx) noexcept;
 
     ~OpenGLMesh() noexcept override;
 
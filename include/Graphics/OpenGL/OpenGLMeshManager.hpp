@@ -13,8 +13,8 @@ namespace Krys::Gfx::OpenGL
   public:
     OpenGLMeshManager(Ptr<GraphicsContext> context) noexcept;
 
-    NO_DISCARD Unique<Mesh> CreateMeshImpl(MeshHandle handle, const List<VertexData> &vertices,
-                                           const List<uint32> &indices,
+    NO_DISCARD Unique<Mesh> CreateMeshImpl(MeshHandle handle, std::span<const VertexData> vertices,
+                                           std::span<const uint32> indices,
                                            const VertexLayout &layout) noexcept override;
   };
 }
\ No newline at end of file
@@ -12,7 +12,7 @@ namespace Krys::Gfx::OpenGL
   {
   public:
   OpenGLTexture(TextureHandle handle, const TextureDescriptor &descriptor, OpenGLSampler &sampler,
-                      const List<byte> &data) noexcept;
+                      std::span<const byte> data) noexcept;
 
   ~OpenGLTexture() noexcept override;
 
@@ -11,7 +11,10 @@ namespace Krys::Gfx::OpenGL
   class OpenGLTextureManager : public TextureManager
   {
   public:
-    OpenGLTextureManager() noexcept = default;
+    explicit OpenGLTextureManager(Ptr<IO::AssetCache> assetCache) noexcept : TextureManager(assetCache)
+    {
+    }
+
     ~OpenGLTextureManager() noexcept override = default;
 
   protected:
@@ -20,6 +23,6 @@ namespace Krys::Gfx::OpenGL
 
     NO_DISCARD virtual Unique<Texture> CreateTextureImpl(TextureHandle handle,
                                                          const TextureDescriptor &descriptor,
-                                                         const List<byte> &data = {}) noexcept override;
+                                                         std::span<const byte> data = {}) noexcept override;
   };
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Types.hpp"
+#include "Graphics/Textures/TextureCompression.hpp"
+
+#include <span>
+
+/// @brief CPU encoder (and reference decoder) for the BCn block compressed texture formats.
+/// @details Images are split into 4x4 pixel blocks, padded by repeating the last row/column. Each block is
+/// fitted independently, with the block's pixels held as vectors of floats so the endpoint searches and
+/// index selection run four pixels at a time. Images with enough blocks are split into bands of block rows
+/// across threads.
+namespace Krys::Gfx::BlockCompression
+{
+  /// @brief Size in bytes of one compressed 4x4 block of `format`.
+  NO_DISCARD constexpr uint32 GetBlockSize(TextureCompression format) noexcept
+  {
+    return format == TextureCompression::BC1 || format == TextureCompression::BC4 ? 8 : 16;
+  }
+
+  /// @brief Size in bytes of a `width` by `height` image compressed as `format`.
+  NO_DISCARD constexpr size_t GetCompressedSize(TextureCompression format, uint32 width,
+                                                uint32 height) noexcept
+  {
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * GetBlockSize(format);
+  }
+
+  /// @brief Compress `pixels`, rows of `width` pixels with `channels` bytes each, into blocks of `format`.
+  /// @details One channel images are treated as grey and two channel images as red and green. BC4 compresses
+  /// the first channel and BC5 the first two; BC1 ignores alpha, and images without it are opaque in BC3/BC7.
+  /// @returns The blocks in row order, or nothing if `format` is `None` or the image is empty.
+  NO_DISCARD List<byte> Compress(std::span<const byte> pixels, uint32 width, uint32 height, uint32 channels,
+                                 TextureCompression format, CompressionQuality quality) noexcept;
+
+  /// @brief Decompress blocks of `format` into RGBA pixels, as a GPU would sample them. BC4 fills red and
+  /// BC5 red and green, with the other channels 0 and alpha 255.
+  NO_DISCARD List<byte> Decompress(std::span<const byte> blocks, uint32 width, uint32 height,
+                                   TextureCompression format) noexcept;
+}
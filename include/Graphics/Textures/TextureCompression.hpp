@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Base/Types.hpp"
+
+namespace Krys::Gfx
+{
+  enum class TextureCompression : uint32
+  {
+    /// @brief Pixels are stored as they are, at 1 to 4 bytes per pixel.
+    None,
+
+    /// @brief Opaque colour at 4 bits per pixel. Any alpha channel is dropped.
+    BC1,
+
+    /// @brief Colour (as BC1) plus a separately compressed alpha channel, at 8 bits per pixel.
+    BC3,
+
+    /// @brief A single channel at 4 bits per pixel, e.g. roughness or height maps.
+    BC4,
+
+    /// @brief Two independent channels at 8 bits per pixel, e.g. tangent space normal maps.
+    BC5,
+
+    /// @brief Colour and alpha at 8 bits per pixel, with much less banding and blockiness than BC1/BC3.
+    /// @note The slowest format to encode by far.
+    BC7
+  };
+
+  /// @brief Trades encoding time for quality when compressing textures.
+  enum class CompressionQuality : uint32
+  {
+    /// @brief Endpoints from the block's bounding box. Suitable for previews and hot reloading.
+    Fast,
+
+    /// @brief Endpoints fitted along the block's principal axis, then refined once. BC7 also tries splitting
+    /// blocks that don't fit one line well in two.
+    Balanced,
+
+    /// @brief Further refinement, and more BC7 partitions are tried. Intended for offline cooking.
+    Best
+  };
+}
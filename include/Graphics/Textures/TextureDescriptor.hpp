@@ -2,6 +2,7 @@
 
 #include "Base/Types.hpp"
 #include "Graphics/Handles.hpp"
+#include "Graphics/Textures/TextureCompression.hpp"
 #include "Graphics/Textures/TextureType.hpp"
 
 namespace Krys::Gfx
@@ -13,5 +14,13 @@ namespace Krys::Gfx
     uint32 Width {0}, Height {0}, Channels {0};
     SamplerHandle Sampler;
     bool IsBindless {false};
+
+    /// @brief Block compression to store the texture with. Data passed to `TextureManager::CreateTexture`
+    /// must already be compressed, with every mip level (if the sampler uses mipmaps) one after another,
+    /// largest first. `TextureManager::LoadTexture` compresses the loaded image itself.
+    TextureCompression Compression {TextureCompression::None};
+
+    /// @brief How hard `TextureManager::LoadTexture` works to preserve quality when compressing.
+    CompressionQuality Quality {CompressionQuality::Balanced};
   };
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "Graphics/Handles.hpp"
 #include "Graphics/Textures/Sampler.hpp"
 #include "Graphics/Textures/Texture.hpp"
+#include "IO/AssetCache.hpp"
 #include "IO/Images.hpp"
 
 namespace Krys::Gfx
@@ -38,9 +39,10 @@ namespace Krys::Gfx
 
     /// @brief Create a texture.
     /// @param descriptor The descriptor of the texture.
-    /// @param data Optional data to initialise the texture with.
+    /// @param data Optional data to initialise the texture with. If the sampler uses mipmaps, the rest of the
+    /// mip chain can follow the full size image, largest first; otherwise it's generated on the GPU.
     NO_DISCARD TextureHandle CreateTexture(const TextureDescriptor &descriptor,
-                                           const List<byte> &data = {}) noexcept;
+                                           std::span<const byte> data = {}) noexcept;
 
     /// @brief Create a texture from a flat colour.
     /// @param name The descriptor of the texture.
@@ -52,6 +54,10 @@ namespace Krys::Gfx
     /// @param descriptor The descriptor of the texture. Can be left empty to use defaults.
     /// @note The width, height and channels with automatically be set using the loaded image data, if you set
     /// them they will be overridden.
+    /// @note If a cooked texture (`path` + `IO::KTEX::Extension`, e.g. from a mounted pack) or the asset
+    /// cache holds `path` cooked from its current contents with the compression and mipmaps asked for, it's
+    /// uploaded from the mapped file instead of decoding `path`. Otherwise one is stored in the asset cache,
+    /// or next to `path` without one, so later runs can skip decoding, mip generation and compression.
     NO_DISCARD TextureHandle LoadTexture(const string &path,
                                          const TextureDescriptor &descriptor = {}) noexcept;
 
@@ -69,7 +75,11 @@ namespace Krys::Gfx
     NO_DISCARD TextureHandleMap<Texture *> &GetTextures() noexcept;
 
   protected:
-    TextureManager() noexcept = default;
+    /// @param assetCache Where cooked textures are kept. Can be null, in which case they're written next to
+    /// their source instead.
+    explicit TextureManager(Ptr<IO::AssetCache> assetCache) noexcept : _assetCache(assetCache)
+    {
+    }
 
     /// @brief Implementation-specific creation of a sampler.
     /// @param handle The handle of the sampler.
@@ -83,7 +93,7 @@ namespace Krys::Gfx
     /// @param data Optional data to initialise the texture with.
     NO_DISCARD virtual Unique<Texture> CreateTextureImpl(TextureHandle handle,
                                                          const TextureDescriptor &descriptor,
-                                                         const List<byte> &data = {}) noexcept = 0;
+                                                         std::span<const byte> data = {}) noexcept = 0;
 
     /// @brief Optional hook for implementation. Called when a sampler is destroyed (ref count hits zero).
     virtual void OnDestroy(SamplerHandle handle) noexcept;
@@ -108,5 +118,7 @@ namespace Krys::Gfx
     TextureHandleMap<Texture *> _textures;
     TextureHandleManager _textureHandles;
     Map<string, LoadedResource<Texture>> _loadedTextures;
+
+    Ptr<IO::AssetCache> _assetCache;
   };
 }
\ No newline at end of file
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Macros.hpp"
+#include "Base/Types.hpp"
+#include "IO/Readers/MappedFile.hpp"
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <span>
+
+namespace Krys::IO
+{
+  /// @brief Identifies an artifact by everything it was derived from. See `AssetCache::MakeKey`.
+  struct AssetKey
+  {
+    uint64 Hash {0};
+
+    NO_DISCARD constexpr bool operator==(const AssetKey &other) const noexcept = default;
+  };
+
+  struct AssetCacheStats
+  {
+    /// @brief Loads that found their artifact.
+    uint64 Hits {0};
+
+    /// @brief Loads that didn't, so the importer had to do the work.
+    uint64 Misses {0};
+
+    uint64 Stores {0};
+    uint64 Evictions {0};
+
+    /// @brief Artifacts read ahead by `Warm`.
+    uint64 Prefetched {0};
+
+    /// @brief Total size of the artifacts on disk, in bytes.
+    uint64 Size {0};
+    size_t Entries {0};
+  };
+
+  /// @brief Content-addressed store for data derived from assets, e.g. mip chains, compressed textures,
+  /// cooked meshes, glyph atlases and preprocessed shaders.
+  /// @details Artifacts are files in one directory, named after their key, with an index file recording
+  /// their sizes and when they were last used. Keys are hashes of everything that decides an artifact's
+  /// contents, so an artifact never goes stale and is never modified: a changed source or setting is simply
+  /// a different key. Artifacts are written to a temporary file and renamed into place, so readers in any
+  /// thread or process only ever see complete files. When the cache grows past its size limit the least
+  /// recently used artifacts are deleted. The index is only a record of use; it's reconciled with the
+  /// directory when the cache is opened, so a lost or outdated index costs nothing but LRU order.
+  class AssetCache
+  {
+  public:
+    NO_COPY_MOVE(AssetCache)
+
+    static constexpr uint64 DefaultMaxSize = uint64 {2} << 30;
+
+    /// @brief Opens (creating it if needed) the cache in `directory`, which holds at most `maxSize` bytes
+    /// of artifacts.
+    explicit AssetCache(const stringview &directory, uint64 maxSize = DefaultMaxSize) noexcept;
+
+    /// @brief Saves the index.
+    ~AssetCache() noexcept;
+
+    /// @brief Build the key of an artifact.
+    /// @param importer Name of what produces the artifact, so different importers of the same source don't
+    /// collide.
+    /// @param version Bump whenever the importer's output changes, to stop using artifacts from before.
+    /// @param source The bytes of the source asset.
+    /// @param settings The import settings, serialised without padding.
+    NO_DISCARD static AssetKey MakeKey(stringview importer, uint32 version, std::span<const byte> source,
+                                       std::span<const byte> settings = {}) noexcept;
+
+    /// @brief Map the artifact for `key`, counting a hit or a miss. The mapping stays valid even if the
+    /// artifact is evicted while it's open.
+    /// @returns A file that isn't open if there is no artifact for `key`.
+    NO_DISCARD MappedFile Load(AssetKey key) noexcept;
+
+    /// @brief Check for an artifact without counting a hit or a miss.
+    NO_DISCARD bool Contains(AssetKey key) const noexcept;
+
+    /// @brief Store `data` as the artifact for `key`, then evict artifacts if the cache is over its limit.
+    /// @returns False if the artifact couldn't be written.
+    bool Store(AssetKey key, std::span<const byte> data) noexcept;
+
+    /// @brief Read the artifacts for `keys` on worker threads, so loading them later doesn't wait on the
+    /// disk. Keys without an artifact are skipped. The cache must outlive the returned future.
+    /// @returns The number of artifacts that were read.
+    NO_DISCARD std::future<size_t> Warm(List<AssetKey> keys) noexcept;
+
+    /// @brief Write the index, which is also done when the cache is destroyed.
+    bool SaveIndex() noexcept;
+
+    NO_DISCARD AssetCacheStats GetStats() const noexcept;
+
+    NO_DISCARD const string &GetDirectory() const noexcept;
+
+  private:
+    struct Entry
+    {
+      uint64 Size;
+
+      /// @brief Value of `_clock` when the artifact was last stored or loaded.
+      uint64 LastUse;
+    };
+
+    NO_DISCARD string GetPath(AssetKey key) const noexcept;
+
+    void LoadIndex() noexcept;
+
+    /// @brief Delete the least recently used artifacts, apart from `keep`, until the cache fits its limit.
+    /// Must be called with `_mutex` held.
+    void Evict(AssetKey keep) noexcept;
+
+    string _directory;
+    uint64 _maxSize;
+
+    mutable std::mutex _mutex;
+    Map<uint64, Entry> _entries;
+    uint64 _size {0};
+    uint64 _clock {0};
+
+    /// @brief Makes temporary file names unique across threads and processes sharing the directory.
+    uint64 _instance;
+    std::atomic<uint64> _tempCount {0};
+
+    std::atomic<uint64> _hits {0};
+    std::atomic<uint64> _misses {0};
+    std::atomic<uint64> _stores {0};
+    std::atomic<uint64> _evictions {0};
+    std::atomic<uint64> _prefetched {0};
+  };
+}
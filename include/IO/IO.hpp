@@ -46,8 +46,8 @@ namespace Krys::IO
   /// @return True if the path is a regular file.
   NO_DISCARD bool IsFile(const stringview &path) noexcept;
 
-  /// @brief Get the contents of a file as text.
-  /// @param path The path to the file to read.
+  /// @brief Get the contents of a file as text. Line endings are left as they are in the file.
+  /// @param path The path to the file to read, which is looked up through the `VFS`.
   /// @return The contents of the file.
   NO_DISCARD string ReadFileText(const stringview &path) noexcept;
 
@@ -57,4 +57,9 @@ namespace Krys::IO
   bool WriteFileText(const stringview &path, const stringview &content) noexcept;
 
   NO_DISCARD uintmax_t GetFileSize(const stringview &path) noexcept;
+
+  /// @brief Get when a file was last modified, as ticks of the filesystem clock. Only meaningful when
+  /// compared with other values from this function.
+  /// @returns 0 if the file doesn't exist.
+  NO_DISCARD int64 GetLastWriteTime(const stringview &path) noexcept;
 }
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "Base/Types.hpp"
+#include "Debug/MemoryTracker.hpp"
+
+namespace Krys::IO
+{
+  /// @brief Decoded pixels. The memory is attributed to `MemoryTag::Images`, so it shows up in the memory
+  /// stats whether or not the global `operator new` is hooked.
+  using ImageData = Debug::TrackedList<byte, Debug::MemoryTag::Images>;
+}
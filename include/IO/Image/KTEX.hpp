@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Pointers.hpp"
+#include "Base/Types.hpp"
+#include "IO/VFS/VirtualFile.hpp"
+
+#include <span>
+
+namespace Krys::IO
+{
+  struct KTEXLevel
+  {
+    uint32 Width;
+    uint32 Height;
+
+    /// @brief Offset of the level from the start of the file.
+    uint64 Offset;
+    uint64 Size;
+  };
+
+  struct KTEXImage
+  {
+    uint32 Width;
+    uint32 Height;
+    uint8 Channels;
+
+    /// @brief How the levels are block compressed, as a `Gfx::TextureCompression`. 0 if they're pixels.
+    uint8 Format {0};
+
+    /// @brief The `Gfx::CompressionQuality` the levels were compressed with. Ignored if `Format` is 0.
+    uint8 Quality {0};
+
+    /// @brief `HashBytes` of the file the texture was cooked from, so a stale cooked texture can be detected.
+    uint64 SourceHash {0};
+
+    /// @brief Largest first. The first level is the full size image, any others are its mip chain.
+    List<KTEXLevel> Levels;
+
+    /// @brief Every level back to back, largest first. Points into `File` when the image was loaded.
+    std::span<const byte> Data;
+
+    /// @brief The file `Data` points into.
+    VirtualFile File;
+
+    NO_DISCARD std::span<const byte> GetLevel(size_t index) const noexcept
+    {
+      return Data.subspan(static_cast<size_t>(Levels[index].Offset - Levels[0].Offset),
+                          static_cast<size_t>(Levels[index].Size));
+    }
+  };
+
+  /// @brief Reads and writes Krystal's cooked texture format.
+  /// @details A cooked texture is a texture as the GPU wants it: decoded, with its mip chain precomputed and
+  /// optionally block compressed. A small header and level table are followed by the levels back to back,
+  /// largest first. The levels start on a page boundary, so once the file is mapped they can be uploaded
+  /// straight from the mapping without being decoded or copied.
+  class KTEX
+  {
+  public:
+    /// @brief Cooked textures sit next to their source, with this appended to its path.
+    static constexpr stringview Extension = ".ktex";
+
+    /// @brief Offset the first level is aligned to.
+    static constexpr uint64 DataAlignment = 4096;
+
+    KTEX() = default;
+    ~KTEX() = default;
+
+    /// @brief Opens the cooked texture at `path` through the `VFS`. The levels are validated but not
+    /// touched, so loading is cheap regardless of the texture's size.
+    /// @return A unique pointer to the loaded image, or nullptr if the loading failed.
+    NO_DISCARD Unique<KTEXImage> Load(const string &path) noexcept;
+
+    /// @brief Loads a cooked texture from memory. `data` must outlive the returned image.
+    NO_DISCARD Unique<KTEXImage> Load(std::span<const byte> data) noexcept;
+
+    /// @brief Writes `image` to `path`. The level offsets are laid out here, so only the sizes of
+    /// `image.Levels` need to be set, and `image.Data` must hold the levels back to back.
+    /// @return True if the write was successful.
+    bool Save(const string &path, const KTEXImage &image) noexcept;
+
+    /// @brief Writes `image` to `buffer`, replacing its contents, e.g. to store it in an `AssetCache`.
+    /// @return True if the write was successful.
+    bool Save(List<byte> &buffer, const KTEXImage &image) noexcept;
+  };
+}
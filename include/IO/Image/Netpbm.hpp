@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Types.hpp"
+#include "IO/Readers/BufferedReader.hpp"
+#include "IO/Readers/MemoryReader.hpp"
+
+#include <span>
+
+/// @brief Parsing shared by the Netpbm formats (PBM, PGM, PPM and PAM).
+/// @details Samples are decoded straight from an in-memory view of the file. Samples with a maximum value of
+/// 255 or less are scaled to bytes in [0, 255]; anything larger is kept at 16 bits, scaled to [0, 65535] and
+/// stored in the system's byte order.
+namespace Krys::IO::Netpbm
+{
+  /// @brief The size in bytes of one decoded sample for images with `maxValue`.
+  NO_DISCARD constexpr size_t GetSampleSize(uint16 maxValue) noexcept
+  {
+    return maxValue > 255 ? 2 : 1;
+  }
+
+  /// @brief Get everything from `reader`'s position onwards as one span. In-memory sources are returned as
+  /// they are, anything else is read into `storage` first.
+  NO_DISCARD std::span<const byte> GetInput(BufferedReader &reader, List<byte> &storage) noexcept;
+
+  /// @brief Skip whitespace and '#' comments.
+  void SkipWhitespace(MemoryReader &reader) noexcept;
+
+  /// @brief Skip any whitespace and comments, then read a decimal number.
+  NO_DISCARD Expected<uint32> ReadNumber(MemoryReader &reader) noexcept;
+
+  /// @brief Read whitespace separated decimal samples until `samples` is full.
+  NO_DISCARD Expected<void> ReadASCIISamples(MemoryReader &reader, uint16 maxValue,
+                                             std::span<byte> samples) noexcept;
+
+  /// @brief Read big-endian binary samples until `samples` is full.
+  NO_DISCARD Expected<void> ReadBinarySamples(MemoryReader &reader, uint16 maxValue,
+                                              std::span<byte> samples) noexcept;
+
+  /// @brief Read '0'/'1' pixels until `pixels` is full. 1 is black and 0 is white. The digits don't need
+  /// to be separated.
+  NO_DISCARD Expected<void> ReadASCIIBits(MemoryReader &reader, std::span<byte> pixels) noexcept;
+
+  /// @brief Read packed rows of 1-bit pixels, most significant bit first. Each row starts on a new byte.
+  /// 1 is black and 0 is white.
+  NO_DISCARD Expected<void> ReadBinaryBits(MemoryReader &reader, uint32 width, uint32 height,
+                                           std::span<byte> pixels) noexcept;
+}
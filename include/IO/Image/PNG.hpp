@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Pointers.hpp"
+#include "Base/Types.hpp"
+#include "IO/Image/ImageData.hpp"
+
+#include <span>
+
+namespace Krys::IO
+{
+  struct PNGImage
+  {
+    uint32 Width;
+    uint32 Height;
+
+    /// @brief 1 (grey), 2 (grey and alpha), 3 (RGB) or 4 (RGBA). Palettes are expanded to RGB, or to RGBA if
+    /// they have transparency, and a transparent colour adds an alpha channel.
+    uint8 Channels;
+
+    /// @brief 8-bit pixels, one row after another. 16-bit images keep the top byte of each sample.
+    ImageData Data;
+  };
+
+  /// @brief Decodes PNG images.
+  /// @details Supports every colour type and bit depth, palettes with transparency and Adam7 interlacing.
+  /// The image data is inflated with `InflateZlib` into one buffer, then each row is unfiltered, using SSE2
+  /// for 3 and 4 byte pixels and AVX2 for the Up filter when the CPU has them. 8-bit images that need no
+  /// conversion, which is most textures, are unfiltered straight into the image. The checksums aren't
+  /// verified, but corrupt files are rejected without reading or writing out of bounds.
+  class PNG
+  {
+  public:
+    PNG() = default;
+    ~PNG() = default;
+
+    /// @brief Check if `data` starts with the PNG signature.
+    NO_DISCARD static bool IsPNG(std::span<const byte> data) noexcept;
+
+    /// @brief Loads the PNG image at `path` through the `VFS`.
+    /// @param flipVertically Store the bottom row first instead of the top row.
+    NO_DISCARD Unique<PNGImage> Load(const string &path, bool flipVertically = false) noexcept;
+
+    /// @brief Loads a PNG image from memory.
+    /// @param flipVertically Store the bottom row first instead of the top row.
+    NO_DISCARD Unique<PNGImage> Load(std::span<const byte> data, bool flipVertically = false) noexcept;
+
+    /// @brief Loads several PNG images at once, e.g. the faces of a cubemap, spread across threads.
+    /// @details A DEFLATE stream can only be decoded from start to end, so a single image is decoded on one
+    /// thread, and the speed up comes from decoding different images at the same time.
+    /// @returns The images in the order of `paths`, with nullptr for any that failed to load.
+    NO_DISCARD static List<Unique<PNGImage>> LoadMany(std::span<const string> paths,
+                                                      bool flipVertically = false) noexcept;
+  };
+}
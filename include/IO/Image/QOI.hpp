@@ -0,0 +1,168 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Pointers.hpp"
+#include "Base/Types.hpp"
+#include "IO/Image/ImageData.hpp"
+
+#include <array>
+#include <span>
+
+namespace Krys::IO
+{
+  enum class QOIColourSpace : uint8
+  {
+    /// @brief sRGB colour with linear alpha.
+    SRGB = 0,
+
+    /// @brief Every channel is linear.
+    Linear = 1
+  };
+
+  struct QOIHeader
+  {
+    uint32 Width;
+    uint32 Height;
+
+    /// @brief 3 (RGB) or 4 (RGBA).
+    uint8 Channels;
+
+    /// @brief Informational only, the pixels are stored as they are either way.
+    QOIColourSpace ColourSpace {QOIColourSpace::SRGB};
+  };
+
+  struct QOIImage
+  {
+    uint32 Width;
+    uint32 Height;
+
+    /// @brief 3 (RGB) or 4 (RGBA).
+    uint8 Channels;
+    QOIColourSpace ColourSpace;
+
+    /// @brief 8-bit pixels, one row after another.
+    ImageData Data;
+  };
+
+  /// @brief Decodes the pixels of a QOI image a piece at a time into buffers the caller owns, e.g. a row at a
+  /// time straight into where the image is going.
+  class QOIDecoder
+  {
+  public:
+    QOIDecoder() noexcept = default;
+    ~QOIDecoder() noexcept = default;
+
+    /// @brief Read the header at the start of `data`, which must outlive the decoder, and start from the
+    /// first pixel.
+    NO_DISCARD Expected<QOIHeader> Begin(std::span<const byte> data) noexcept;
+
+    /// @brief Decode the next `pixels.size() / channels` pixels into `pixels`.
+    /// @param channels 3 or 4, whatever the image has. Alpha is dropped or added as opaque to match.
+    /// @returns An error if the data is corrupt or the image has fewer pixels left.
+    NO_DISCARD Expected<void> Decode(std::span<byte> pixels, uint8 channels) noexcept;
+
+    NO_DISCARD uint64 GetRemainingPixels() const noexcept
+    {
+      return _remaining;
+    }
+
+  private:
+    template <uint8 TChannels>
+    NO_DISCARD Expected<void> DecodePixels(byte *pixels, size_t count) noexcept;
+
+    std::span<const byte> _data;
+    size_t _position {0};
+    uint64 _remaining {0};
+
+    /// @brief The last pixel, how many more times it repeats, and the pixels seen recently enough to be
+    /// referenced, each packed as R | G << 8 | B << 16 | A << 24.
+    uint32 _pixel {0};
+    uint32 _run {0};
+    std::array<uint32, 64> _index {};
+  };
+
+  /// @brief Encodes pixels into a QOI image a piece at a time into buffers the caller owns, e.g. a row at a
+  /// time as they are produced, so the whole image never has to be held encoded.
+  /// @details `Begin` writes the header, each `Encode` appends the next pixels, and `End` finishes the
+  /// image. Runs of equal pixels carry over from one piece to the next, so the output is the same however
+  /// the pixels are split.
+  class QOIEncoder
+  {
+  public:
+    QOIEncoder() noexcept = default;
+    ~QOIEncoder() noexcept = default;
+
+    /// @brief Largest size `Encode` can produce from `count` pixels.
+    NO_DISCARD static constexpr size_t GetMaxEncodedSize(size_t count, uint8 channels) noexcept
+    {
+      return count * (channels + size_t {1}) + 1;
+    }
+
+    /// @brief Write the header of `header`, which needs `QOI::HeaderSize` bytes, and start a new image.
+    /// @returns The number of bytes written.
+    size_t Begin(const QOIHeader &header, std::span<byte> output) noexcept;
+
+    /// @brief Encode whole pixels with the header's channels into `output`, which must hold at least
+    /// `GetMaxEncodedSize` bytes for them.
+    /// @returns The number of bytes written.
+    size_t Encode(std::span<const byte> pixels, std::span<byte> output) noexcept;
+
+    /// @brief Finish the image, which needs `QOI::EndSize` bytes.
+    /// @returns The number of bytes written.
+    size_t End(std::span<byte> output) noexcept;
+
+  private:
+    template <uint8 TChannels>
+    NO_DISCARD size_t EncodePixels(const byte *pixels, size_t count, byte *output) noexcept;
+
+    uint8 _channels {4};
+    uint32 _pixel {0};
+    uint32 _run {0};
+    std::array<uint32, 64> _index {};
+  };
+
+  /// @brief Reads and writes "Quite OK Image" files, a simple lossless format that encodes and decodes many
+  /// times faster than PNG for a somewhat larger file. Meant for intermediate images such as captures, baked
+  /// lightmaps and thumbnails, rather than shipped assets.
+  class QOI
+  {
+  public:
+    static constexpr stringview Extension = ".qoi";
+
+    /// @brief Size of the header in front of the pixels.
+    static constexpr size_t HeaderSize = 14;
+
+    /// @brief Most that `QOIEncoder::End` writes: the last run and the end marker.
+    static constexpr size_t EndSize = 9;
+
+    QOI() = default;
+    ~QOI() = default;
+
+    /// @brief Check if `data` starts with the QOI magic number.
+    NO_DISCARD static bool IsQOI(std::span<const byte> data) noexcept;
+
+    /// @brief Loads the QOI image at `path` through the `VFS`.
+    /// @param flipVertically Store the bottom row first instead of the top row.
+    /// @param channels 3 or 4 to convert to, or 0 to keep the image's own.
+    NO_DISCARD Unique<QOIImage> Load(const string &path, bool flipVertically = false,
+                                     uint8 channels = 0) noexcept;
+
+    /// @brief Loads a QOI image from memory.
+    /// @param flipVertically Store the bottom row first instead of the top row.
+    /// @param channels 3 or 4 to convert to, or 0 to keep the image's own.
+    NO_DISCARD Unique<QOIImage> Load(std::span<const byte> data, bool flipVertically = false,
+                                     uint8 channels = 0) noexcept;
+
+    /// @brief Encode `pixels`, described by `header`, into memory.
+    /// @param flipVertically `pixels` has the bottom row first.
+    NO_DISCARD static List<byte> Encode(const QOIHeader &header, std::span<const byte> pixels,
+                                        bool flipVertically = false) noexcept;
+
+    /// @brief Writes `pixels`, described by `header`, to `path`. The pixels are encoded in pieces and
+    /// written as they go.
+    /// @param flipVertically `pixels` has the bottom row first.
+    /// @return True if the write was successful.
+    bool Save(const string &path, const QOIHeader &header, std::span<const byte> pixels,
+              bool flipVertically = false) noexcept;
+  };
+}
@@ -5,12 +5,17 @@
 #include "Base/Types.hpp"
 #include "Debug/Macros.hpp"
 #include "IO/Image/BMP.hpp"
-
+#include "IO/Image/ImageData.hpp"
+#include "IO/Image/PNG.hpp"
+#include "IO/Image/QOI.hpp"
 #include "IO/IO.hpp"
+#include "IO/Readers/BufferedReader.hpp"
+#include "IO/VFS/VFS.hpp"
 
 #include "stb_image.h"
 
 #include <concepts>
+#include <span>
 
 namespace Krys::IO::Impl
 {
@@ -25,9 +30,6 @@ namespace Krys::IO::Impl
 
 namespace Krys::IO
 {
-  /// @brief Represents image data.
-  using ImageData = List<byte>;
-
   /// @brief Represents an image.
   struct Image
   {
@@ -44,25 +46,76 @@ namespace Krys::IO
     uint8 Channels;
   };
 
-  /// @brief Represents a mip level of an image.
-  struct MipLevelData
+  /// @brief Filters used to shrink one mip level into the next.
+  enum class MipFilter
   {
-    /// @brief Image data.
-    ImageData Data;
+    /// @brief Averages the source pixels covered by each output pixel. Fast, but slightly soft.
+    Box,
+
+    /// @brief Kaiser-windowed sinc with 3 lobes. Sharper than a box, with little ringing.
+    Kaiser,
+
+    /// @brief Lanczos-3 windowed sinc. The sharpest, but can ring around hard edges.
+    Lanczos,
+  };
+
+  struct MipmapSettings
+  {
+    MipFilter Filter {MipFilter::Box};
+
+    /// @brief The colour channels are sRGB encoded, so they are filtered in linear light. Alpha (the last
+    /// channel of 2 and 4 channel images) is always filtered as it is.
+    bool SRGB {false};
+  };
 
+  /// @brief Where a mip level is stored in its `MipChain`.
+  struct MipLevel
+  {
     /// @brief Width of level (in pixels).
     uint32 Width;
 
     /// @brief Height of level (in pixels).
     uint32 Height;
+
+    /// @brief Offset of the level's pixels in `MipChain::Data`.
+    size_t Offset;
+
+    /// @brief Size of the level's pixels in bytes.
+    size_t Size;
   };
 
-  /// @brief Generates mipmaps down to a 1x1 pixel.
-  /// @details The supplied level will always be the first entry in the returned collection.
-  /// The algorithm used is a simple downsize by averaging the values of a 2x2 kernel.
-  /// @return Collection of MipLevelData objects where each subsequent entry is half the size of the preceding
-  /// one.
-  List<MipLevelData> GenerateMipmaps(const Image &image) noexcept;
+  /// @brief The mip levels below an image, packed into one allocation.
+  struct MipChain
+  {
+    /// @brief Levels 1 and down, one after another. Level 0 is the source image, which isn't copied.
+    ImageData Data;
+
+    /// @brief Levels 1 and down, each half the size of the one before (rounded down) until 1x1.
+    List<MipLevel> Levels;
+
+    /// @brief Number of channels, the same as the source image.
+    uint8 Channels;
+
+    /// @brief Get the pixels of `Levels[index]`.
+    NO_DISCARD std::span<const byte> GetLevel(size_t index) const noexcept
+    {
+      return std::span<const byte>(Data).subspan(Levels[index].Offset, Levels[index].Size);
+    }
+  };
+
+  /// @brief Generates the mip levels of `image` down to a 1x1 pixel.
+  /// @details Each level is filtered from the one above it with a separable filter. Sizes that aren't a power
+  /// of two, including odd sizes, are handled by weighting source pixels by how much of each output pixel
+  /// they cover, so no rows or columns are dropped. Large levels are split into bands of rows across
+  /// threads.
+  NO_DISCARD MipChain GenerateMipmaps(const Image &image, const MipmapSettings &settings = {}) noexcept;
+
+  /// @brief Saves `image` to `path` in the format its extension names. Only QOI (".qoi") can be written,
+  /// which suits intermediate images like captures and baked lightmaps.
+  /// @param flipVertically `image` has the bottom row first, as `LoadImage` stores it by default, so it's
+  /// saved the right way up.
+  NO_DISCARD Expected<void> SaveImage(const string &path, const Image &image,
+                                      bool flipVertically = true) noexcept;
 
   template <typename T>
   concept LoadImageSettings = requires(T) {
@@ -76,37 +129,83 @@ namespace Krys::IO
     static constexpr uint8 DesiredChannels = 0;
   };
 
-  /// @brief Loads an image into memory and frees it when the object is destroyed.
-  /// Useful for loading textures into the GPU.
+  /// @brief Decodes an image already opened from `path`, e.g. one whose contents were also needed for
+  /// something else. `path` is only used to recognise formats by their extension.
   /// @tparam Settings The settings to use when loading the image.
   template <LoadImageSettings Settings = DefaultLoadImageSettings>
-  NO_DISCARD Expected<Image> LoadImage(const string &path) noexcept
+  NO_DISCARD Expected<Image> LoadImage(const VirtualFile &file, const string &path) noexcept
   {
     KRYS_SCOPED_PROFILER("IO::LoadImage");
+    KRYS_MEMORY_SCOPE(Images);
 
-    if (!IO::PathExists(path))
+    if (!file.IsOpen())
       return Unexpected<string>("File does not exist");
 
-    // if (path.ends_with(".bmp"))
-    // {
-    //   IO::BMP bmp;
-    //   auto image = bmp.Load(path);
-    //   if (!image)
-    //     return Unexpected<string>("Failed to load BMP image");
-
-    // Image result;
-    // result.Width = image->Width;
-    // result.Height = image->Height;
-    // result.Channels = image->Channels;
-    // result.Data = std::move(image->Data);
-    // return result;
-    // }
+    // stb can't read QOI, so it's handled whatever the requested channels, as long as it can decode to them.
+    if (GetExtension(path) == IO::QOI::Extension)
+    {
+      if constexpr (Settings::DesiredChannels != 0 && Settings::DesiredChannels < 3)
+        return Unexpected<string>("QOI images can only be loaded with 3 or 4 channels");
+      else
+      {
+        IO::QOI qoi;
+        auto image = qoi.Load(file.GetSpan(), Settings::FlipImageVerticallyOnLoad, Settings::DesiredChannels);
+        if (!image)
+          return Unexpected<string>("Failed to load QOI image");
+
+        Image result;
+        result.Width = image->Width;
+        result.Height = image->Height;
+        result.Channels = image->Channels;
+        result.Data = std::move(image->Data);
+        return result;
+      }
+    }
+
+    // Bitmaps and PNGs are recognised by their contents rather than their extension. Their decoders only
+    // produce the file's own channels, so anything asking for a specific channel count still goes through
+    // stb.
+    if constexpr (Settings::DesiredChannels == 0)
+    {
+      if (IO::PNG::IsPNG(file.GetSpan()))
+      {
+        IO::PNG png;
+        auto image = png.Load(file.GetSpan(), Settings::FlipImageVerticallyOnLoad);
+        if (!image)
+          return Unexpected<string>("Failed to load PNG image");
+
+        Image result;
+        result.Width = image->Width;
+        result.Height = image->Height;
+        result.Channels = image->Channels;
+        result.Data = std::move(image->Data);
+        return result;
+      }
+
+      BufferedReader reader(CreateUnique<MemoryReadSource>(file.GetSpan()));
+      if (reader.IsOpen() && IO::BMP::IsBMP(reader))
+      {
+        IO::BMP bmp;
+        auto image = bmp.Load(reader, Settings::FlipImageVerticallyOnLoad);
+        if (!image)
+          return Unexpected<string>("Failed to load BMP image");
+
+        Image result;
+        result.Width = image->Width;
+        result.Height = image->Height;
+        result.Channels = image->Channels;
+        result.Data = std::move(image->Data);
+        return result;
+      }
+    }
 
     stbi_set_flip_vertically_on_load(Settings::FlipImageVerticallyOnLoad);
 
     int width, height, channels;
     using AutoFree = Unique<stbi_uc[], Impl::stbiCustomDeleter>;
-    AutoFree data(stbi_load(path.c_str(), &width, &height, &channels, Settings::DesiredChannels));
+    AutoFree data(stbi_load_from_memory(reinterpret_cast<const stbi_uc *>(file.GetData()),
+                                        static_cast<int>(file.GetSize()), &width, &height, &channels,
+                                        Settings::DesiredChannels));
     if (data == nullptr)
       return Unexpected<string>(stbi_failure_reason());
 
@@ -119,4 +218,13 @@ namespace Krys::IO
 
     return result;
   }
+
+  /// @brief Loads an image into memory and frees it when the object is destroyed.
+  /// Useful for loading textures into the GPU.
+  /// @tparam Settings The settings to use when loading the image.
+  template <LoadImageSettings Settings = DefaultLoadImageSettings>
+  NO_DISCARD Expected<Image> LoadImage(const string &path) noexcept
+  {
+    return LoadImage<Settings>(VFS::Open(path), path);
+  }
 }
\ No newline at end of file
@@ -26,4 +26,7 @@ namespace Krys
   };
 
   ENUM_CLASS_BITWISE_OPERATORS(MouseButton, uint16)
+
+  /// @brief The number of distinct bits used by `MouseButton`, including `MouseButton::UNKNOWN`.
+  constexpr uint32 MouseButtonCount = 6;
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Macros.hpp"
+#include "Base/Types.hpp"
+#include "Events/EventManager.hpp"
+#include "Events/EventRecord.hpp"
+#include "IO/Input/HID.hpp"
+
+namespace Krys
+{
+  /// @brief Feeds the events captured by an `EventRecorder` back into an `EventManager`.
+  /// @details Events are replayed by frame rather than by time: everything recorded on frame N is raised
+  /// when the device is polled on frame N (see `EventManager::GetFrame`), so a session replays identically
+  /// regardless of how fast frames run. Pair it with `ApplicationSettings::FixedFrameTimeMs` for fully
+  /// repeatable runs, and make it the only device with `InputManager::SetExclusiveDevice` so live input
+  /// doesn't mix in; `Application` does both when `ApplicationSettings::EventReplayPath` is set. Nothing
+  /// here is platform specific, so it can drive a headless build.
+  ///
+  /// The built-in input events and `QuitEvent` are registered by default. Custom `RecordableEvent`s need to
+  /// be registered with `RegisterEvent` before they can be replayed; unknown events are skipped.
+  class EventReplayDevice : public HID
+  {
+  public:
+    EventReplayDevice() noexcept;
+
+    /// @brief Load a recording, replacing any previously loaded one. Playback starts from the beginning.
+    /// @returns False if the file couldn't be read or isn't a recording.
+    bool Load(const stringview &path) noexcept;
+
+    /// @brief Allow `TEvent` to be replayed.
+    template <RecordableEvent TEvent>
+    void RegisterEvent() noexcept
+    {
+      _decoders[TEvent::GetStaticType()] = [](EventManager &eventManager, EventRecordReader &reader)
+      { eventManager.Enqueue(TEvent::Deserialize(reader)); };
+    }
+
+    /// @brief Raises every recorded event up to and including the current frame.
+    void PollDevice(Ptr<EventManager> eventManager) noexcept override;
+
+    /// @brief Check if every recorded event has been replayed.
+    NO_DISCARD bool IsFinished() const noexcept
+    {
+      return _offset >= _data.size();
+    }
+
+  private:
+    /// @brief Reads the frame of the entry at `_offset` into `_nextFrame`.
+    void ReadNextFrame() noexcept;
+
+    List<byte> _data;
+    size_t _offset {0};
+    uint64 _nextFrame {0};
+    Map<EventType, Func<void(EventManager &, EventRecordReader &)>, EventTypeHasher> _decoders;
+  };
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Macros.hpp"
+#include "Base/Types.hpp"
+#include "IO/Input/Buttons.hpp"
+#include "IO/Input/Keyboard.hpp"
+#include "IO/Input/Keys.hpp"
+#include "IO/Input/Mouse.hpp"
+#include "Utils/StringId.hpp"
+
+namespace Krys
+{
+  typedef StringId ActionId;
+  typedef StringIdHasher ActionIdHasher;
+
+  /// @brief Dense index of an action added with `InputActionMap::AddAction`.
+  typedef uint32 InputAction;
+
+  /// @brief Maps keys and mouse buttons to named actions, e.g. "jump", so game code doesn't need to know
+  /// which inputs are bound.
+  /// @details Bindings are stored as precomputed tables from each key and button to the bitmask of actions
+  /// it triggers, so applying an input event is a single table lookup. Several inputs can be bound to the
+  /// same action; the action is down while any of them are. Action state is updated by the `InputManager`
+  /// and follows the same frame semantics as `Keyboard`.
+  class InputActionMap
+  {
+    friend class InputManager;
+
+  public:
+    NO_COPY(InputActionMap)
+
+    static constexpr uint32 MaxActions = 64;
+
+    /// @brief Constructs an `InputActionMap`.
+    /// @param keyboard The keyboard to resynchronise with when bindings change.
+    /// @param mouse The mouse to resynchronise with when bindings change.
+    InputActionMap(const Keyboard &keyboard, const Mouse &mouse) noexcept;
+
+    /// @brief Add an action, or get the existing one with the same id.
+    NO_DISCARD InputAction AddAction(ActionId id) noexcept;
+
+    /// @brief Get a previously added action.
+    NO_DISCARD Nullable<InputAction> FindAction(ActionId id) const noexcept;
+
+    /// @brief Trigger `action` with `key`.
+    void Bind(InputAction action, Key key) noexcept;
+
+    /// @brief Trigger `action` with `button`.
+    void Bind(InputAction action, MouseButton button) noexcept;
+
+    /// @brief Remove every key and button bound to `action`.
+    void ClearBindings(InputAction action) noexcept;
+
+    /// @brief Checks if the action started this frame.
+    NO_DISCARD bool IsActionPressed(InputAction action) const noexcept;
+
+    /// @brief Checks if the action was already down last frame and still is.
+    NO_DISCARD bool IsActionHeld(InputAction action) const noexcept;
+
+    /// @brief Checks if the action ended this frame.
+    NO_DISCARD bool WasActionReleased(InputAction action) const noexcept;
+
+    /// @brief Checks if any input bound to the action is currently down.
+    NO_DISCARD bool IsActionDown(InputAction action) const noexcept;
+
+  private:
+    /// @brief Starts a new frame, making the current state the previous one.
+    void BeginFrame() noexcept;
+
+    /// @brief Applies a change in whether `key` is down.
+    void OnKey(Key key, bool down) noexcept;
+
+    /// @brief Applies a change in whether `button` is down.
+    void OnButton(MouseButton button, bool down) noexcept;
+
+    void Press(uint64 actions) noexcept;
+    void Release(uint64 actions) noexcept;
+
+    /// @brief Recomputes which actions are down from the devices, after the bindings have changed.
+    void Resync() noexcept;
+
+    NO_DISCARD static uint32 GetButtonIndex(MouseButton button) noexcept;
+
+    const Keyboard &_keyboard;
+    const Mouse &_mouse;
+
+    List<ActionId> _actions;
+    Array<uint64, KeyCount> _keyActions {};
+    Array<uint64, MouseButtonCount> _buttonActions {};
+
+    /// @brief How many bound inputs are holding each action down.
+    Array<uint8, MaxActions> _downCount {};
+    uint64 _down {0}, _previous {0};
+    uint64 _pressed {0}, _released {0};
+  };
+}
@@ -5,9 +5,11 @@
 #include "Base/Pointers.hpp"
 #include "Base/Types.hpp"
 #include "IO/Input/HID.hpp"
+#include "IO/Input/InputActions.hpp"
 #include "IO/Input/Keyboard.hpp"
 #include "IO/Input/Mouse.hpp"
 #include "Events/EventManager.hpp"
+#include "Events/Input/InputEvent.hpp"
 
 namespace Krys
 {
@@ -24,7 +26,8 @@ namespace Krys
     /// @brief Base destructor. Frees registered devices.
     virtual ~InputManager() noexcept;
 
-    /// @brief Polls all registered devices for input.
+    /// @brief Resets the per-frame mouse and keyboard state and polls all registered devices for input. The
+    /// state is updated as the resulting events are dispatched by the `EventManager`.
     void PollDevices() noexcept;
 
     /// @brief Registers an input device.
@@ -37,17 +40,29 @@ namespace Krys
     /// @brief Get the keyboard.
     NO_DISCARD const Keyboard &GetKeyboard() const noexcept;
 
+    /// @brief Get the action map, to add actions and bind inputs to them.
+    NO_DISCARD InputActionMap &GetActions() noexcept;
+
+    /// @brief Get the action map.
+    NO_DISCARD const InputActionMap &GetActions() const noexcept;
+
+    /// @brief Get the poll time of the oldest input event handled this frame, in ticks, or nothing if there
+    /// was no input. Comparing it with the time the frame is presented gives the input latency.
+    NO_DISCARD Nullable<int64> GetOldestInputTimestamp() const noexcept;
+
+    /// @brief Only poll the device registered as `id`, and ignore every other device, including the
+    /// platform's own mouse and keyboard. Used while replaying a recording, so live input can't mix into it.
+    /// @param id The device to keep, or nothing to go back to polling everything.
+    void SetExclusiveDevice(Nullable<DeviceId> id) noexcept;
+
     /// @brief Get a registered device by id.
     /// @param id The previously registered id of the device.
     /// @returns The device, or `nullptr` if it wasn't found.
     NO_DISCARD Ptr<HID> GetDevice(const DeviceId id) const noexcept;
 
   private:
-    /// @brief Clear the mouse state. Needs to be called prior to processing this frame's events.
-    void ResetMouse() noexcept;
-
-    /// @brief Clear the keyboard state. Needs to be called prior to processing this frame's events.
-    void ResetKeyboard() noexcept;
+    /// @brief Tracks the oldest input of the frame.
+    void OnInput(const InputEvent &event) noexcept;
 
   protected:
     /// @brief The currently active mouse.
@@ -56,13 +71,19 @@ namespace Krys
     /// @brief The currently active keyboard.
     Keyboard _keyboard;
 
+    /// @brief Actions driven by the mouse and keyboard.
+    InputActionMap _actions;
+
+    /// @brief See `GetOldestInputTimestamp`.
+    Nullable<int64> _oldestInputTimestamp;
+
     /// @brief Additional devices registered for polling.
     Map<DeviceId, Unique<HID>, DeviceIdHasher> _customInputDevices;
 
+    /// @brief See `SetExclusiveDevice`. Platform implementations drop their own input while this is set.
+    Nullable<DeviceId> _exclusiveDevice;
+
     /// @brief The `EventManager` to dispatch events to.
     Ptr<EventManager> _eventManager;
-
-    /// @brief Contains pending events for the current frame.
-    Queue<Unique<Event>> _events;
   };
 }
\ No newline at end of file
@@ -4,16 +4,25 @@
 #include "Base/Types.hpp"
 #include "IO/Input/Keys.hpp"
 
+#include <bitset>
+
 namespace Krys
 {
   class InputManager;
 
+  /// @brief One bit per `Key`.
+  typedef std::bitset<KeyCount> KeyBits;
+
   /// @brief Manages the state of keyboard input for the current frame.
   ///
   /// The `Keyboard` class provides methods to query the current state of keys,
   /// including whether a key was pressed, held, or released during the current frame.
   /// Key states are updated by the `InputManager` each frame, allowing for accurate
   /// per-frame input handling.
+  ///
+  /// State is kept in fixed bitsets. Which keys are down is double buffered, so the previous frame can be
+  /// compared against, and presses and releases are latched separately so a tap that starts and ends within
+  /// one frame isn't lost.
   class Keyboard
   {
     friend class InputManager;
@@ -27,7 +36,7 @@ namespace Krys
     /// @returns `true` if the key is in the state `KeyState::Pressed`.
     NO_DISCARD bool IsKeyPressed(Key key) const noexcept;
 
-    /// @brief Checks if a key is being held this frame.
+    /// @brief Checks if a key is being held this frame, i.e. it was already down last frame and still is.
     /// @param key The key to check.
     /// @returns `true` if the key is in the state `KeyState::Held`.
     NO_DISCARD bool IsKeyHeld(Key key) const noexcept;
@@ -37,7 +46,21 @@ namespace Krys
     /// @returns `true` if the key is in the state `KeyState::Released`.
     NO_DISCARD bool WasKeyReleased(Key key) const noexcept;
 
+    /// @brief Checks if a key is currently down, regardless of when it was pressed.
+    /// @param key The key to check.
+    NO_DISCARD bool IsKeyDown(Key key) const noexcept;
+
+    /// @brief Get every key that is currently down.
+    NO_DISCARD const KeyBits &GetDownKeys() const noexcept;
+
   private:
-    Set<Key> _pressed, _held, _released;
+    /// @brief Starts a new frame, making the current state the previous one.
+    void BeginFrame() noexcept;
+
+    /// @brief Applies a key event to the current frame.
+    void Update(Key key, KeyState state) noexcept;
+
+    KeyBits _down, _previous;
+    KeyBits _pressed, _released;
   };
-}
\ No newline at end of file
+}
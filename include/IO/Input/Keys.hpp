@@ -131,6 +131,9 @@ namespace Krys
     DOWN_ARROW,
     UP_ARROW,
   };
+
+  /// @brief The number of keys in `Key`. Must be kept in sync with the last key.
+  constexpr uint32 KeyCount = static_cast<uint32>(Key::UP_ARROW) + 1;
 }
 
 template <>
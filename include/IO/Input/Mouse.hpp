@@ -13,6 +13,9 @@ namespace Krys
   /// The `Mouse` class provides methods to query the state of mouse buttons and movement,
   /// including whether a button was pressed or released during the current frame. The mouse
   /// state is updated each frame by the `InputManager`, allowing for accurate per-frame input handling.
+  ///
+  /// Buttons are tracked as `MouseButton` bitmasks. Which buttons are down is double buffered, so the previous
+  /// frame can be compared against, and presses and releases are latched separately.
   class Mouse
   {
     friend class InputManager; // To allow the `InputManager` to directly update the state of the mouse.
@@ -40,19 +43,30 @@ namespace Krys
     /// @returns `true` if the button is in the state `MouseButtonState::Pressed`.
     NO_DISCARD bool IsButtonPressed(MouseButton button) const noexcept;
 
-    /// @brief Checks if a button is currently held down.
+    /// @brief Checks if a button is being held this frame, i.e. it was already down last frame and still is.
     /// @param button The button to check.
     /// @returns `true` if the button is in the state `MouseButtonState::Held`.
     NO_DISCARD bool IsButtonHeld(MouseButton button) const noexcept;
 
+    /// @brief Checks if a button is currently down, regardless of when it was pressed.
+    /// @param button The button to check.
+    NO_DISCARD bool IsButtonDown(MouseButton button) const noexcept;
+
     /// @brief Checks if a button was released this frame.
     /// @param button The button to check.
     /// @returns `true` if the button is in the state `MouseButtonState::Pressed`.
     NO_DISCARD bool WasButtonReleased(MouseButton button) const noexcept;
 
   private:
+    /// @brief Starts a new frame, making the current state the previous one.
+    void BeginFrame() noexcept;
+
+    /// @brief Applies a button event to the current frame.
+    void Update(MouseButton button, MouseButtonState state) noexcept;
+
     float _clientX {0}, _clientY {0};
     float _deltaX {0}, _deltaY {0};
-    MouseButton _pressed {MouseButton::None}, _released {MouseButton::None}, _held {MouseButton::None};
+    MouseButton _down {MouseButton::None}, _previous {MouseButton::None};
+    MouseButton _pressed {MouseButton::None}, _released {MouseButton::None};
   };
 }
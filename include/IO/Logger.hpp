@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <format>
 #include <fstream>
 #include <iostream>
@@ -9,100 +10,185 @@
 #include "Base/Attributes.hpp"
 #include "Base/Macros.hpp"
 #include "Base/Types.hpp"
+#include "IO/Logging/LogRecord.hpp"
 
-namespace Krys
-{
-  enum class LogLevel
-  {
-    Debug,
-    Info,
-    Error,
-    Warn,
-    Fatal
-  };
+// Messages below this level are compiled out entirely. Defaults to `LogLevel::Debug` (everything).
+#ifndef KRYS_LOG_MIN_LEVEL
+  #define KRYS_LOG_MIN_LEVEL 0
+#endif
 
-  NO_DISCARD constexpr inline string ToString(LogLevel level)
-  {
-    switch (level)
-    {
-      case LogLevel::Debug: return "[DEBUG]";
-      case LogLevel::Info:  return "[INFO ]";
-      case LogLevel::Warn:  return "[WARN ]";
-      case LogLevel::Error: return "[ERROR]";
-      case LogLevel::Fatal: return "[FATAL]";
-      default:              return "[UNDEF]";
-    }
-  }
+// Bitmask of `LogCategory` values (see `ToBit`) that are compiled out entirely.
+#ifndef KRYS_LOG_DISABLED_CATEGORIES
+  #define KRYS_LOG_DISABLED_CATEGORIES 0u
+#endif
+
+namespace Krys::Impl
+{
+  class LogBackend;
+}
 
+namespace Krys
+{
+  /// @brief Asynchronous logger.
+  /// @details Arguments are captured by value into a lock-free queue owned by the calling thread. Formatting
+  /// and I/O happen on a background writer thread, so logging costs the caller little more than a copy.
+  /// Messages from a single thread are always written in the order they were logged; messages from different
+  /// threads may interleave. `Fatal` messages block until everything logged before them has been written.
   class Logger
   {
+    friend class Impl::LogBackend;
+
   public:
     STATIC_CLASS(Logger)
 
-    template <typename... Args>
-    static void Info(const string &message, Args &&...args) noexcept
+    template <LogCategory Category = LogCategory::General, typename... Args>
+    static void Info(std::format_string<Args...> message, Args &&...args) noexcept
     {
-      Log<LogLevel::Info>(message, std::forward<Args>(args)...);
+      Log<LogLevel::Info, Category>(message, std::forward<Args>(args)...);
     }
 
-    template <typename... Args>
-    static void Debug(const string &message, Args &&...args) noexcept
+    template <LogCategory Category = LogCategory::General, typename... Args>
+    static void Debug(std::format_string<Args...> message, Args &&...args) noexcept
     {
-      Log<LogLevel::Debug>(message, std::forward<Args>(args)...);
+      Log<LogLevel::Debug, Category>(message, std::forward<Args>(args)...);
     }
 
-    template <typename... Args>
-    static void Warn(const string &message, Args &&...args) noexcept
+    template <LogCategory Category = LogCategory::General, typename... Args>
+    static void Warn(std::format_string<Args...> message, Args &&...args) noexcept
     {
-      Log<LogLevel::Warn>(message, std::forward<Args>(args)...);
+      Log<LogLevel::Warn, Category>(message, std::forward<Args>(args)...);
     }
 
-    template <typename... Args>
-    static void Error(const string &message, Args &&...args) noexcept
+    template <LogCategory Category = LogCategory::General, typename... Args>
+    static void Error(std::format_string<Args...> message, Args &&...args) noexcept
     {
-      Log<LogLevel::Error>(message, std::forward<Args>(args)...);
+      Log<LogLevel::Error, Category>(message, std::forward<Args>(args)...);
     }
 
-    template <typename... Args>
-    static void Fatal(const string &message, Args &&...args) noexcept
+    /// @brief Logs a fatal message and blocks until all pending messages have been written.
+    template <LogCategory Category = LogCategory::General, typename... Args>
+    static void Fatal(std::format_string<Args...> message, Args &&...args) noexcept
     {
-      Log<LogLevel::Fatal>(message, std::forward<Args>(args)...);
+      Log<LogLevel::Fatal, Category>(message, std::forward<Args>(args)...);
     }
 
+    /// @brief Writes a message as-is, without a level prefix or a trailing new line. Never filtered.
     template <typename... Args>
-    static void Write(const string &message, Args &&...args) noexcept
+    static void Write(std::format_string<Args...> message, Args &&...args) noexcept
     {
-      std::lock_guard<std::mutex> lock(_mu);
-      Output(std::vformat(message, std::make_format_args(args...)));
+      Submit(LogLevel::Info, LogCategory::General, Impl::LogRecordFlags::Raw, message,
+             std::forward<Args>(args)...);
     }
 
+    /// @brief Writes a message followed by a new line, without a level prefix. Never filtered.
     template <typename... Args>
-    static void WriteLine(const string &message, Args &&...args) noexcept
+    static void WriteLine(std::format_string<Args...> message, Args &&...args) noexcept
     {
-      std::lock_guard<std::mutex> lock(_mu);
-      Output(std::vformat(message, std::make_format_args(args...)) + '\n');
+      Submit(LogLevel::Info, LogCategory::General, Impl::LogRecordFlags::Raw | Impl::LogRecordFlags::NewLine,
+             message, std::forward<Args>(args)...);
     }
 
     static void NewLine() noexcept
     {
-      std::lock_guard<std::mutex> lock(_mu);
-      Output("\n");
+      Submit(LogLevel::Info, LogCategory::General, Impl::LogRecordFlags::Raw | Impl::LogRecordFlags::NewLine,
+             "");
     }
 
+    /// @brief Sets the minimum level that will be written. Lower levels are discarded on the calling thread.
+    static void SetLevel(LogLevel level) noexcept;
+
+    NO_DISCARD static LogLevel GetLevel() noexcept;
+
+    /// @brief Enables or disables a category at runtime.
+    static void SetCategoryEnabled(LogCategory category, bool enabled) noexcept;
+
+    /// @brief Checks whether a message with the given level and category would currently be written.
+    NO_DISCARD static bool IsEnabled(LogLevel level, LogCategory category) noexcept
+    {
+      return static_cast<uint8>(level) >= _level.load(std::memory_order_relaxed)
+             && (_categories.load(std::memory_order_relaxed) & ToBit(category)) != 0;
+    }
+
+    /// @brief Checks whether a message with the given level and category has been compiled in.
+    NO_DISCARD static constexpr bool IsCompiledIn(LogLevel level, LogCategory category) noexcept
+    {
+      return static_cast<int>(level) >= static_cast<int>(KRYS_LOG_MIN_LEVEL)
+             && (static_cast<uint32>(KRYS_LOG_DISABLED_CATEGORIES) & ToBit(category)) == 0;
+    }
+
+    /// @brief Blocks until every message submitted before this call has been written.
+    static void Flush() noexcept;
+
+    /// @brief Writes all pending messages and stops the writer thread. Messages logged afterwards are written
+    /// synchronously on the calling thread.
+    static void Shutdown() noexcept;
+
+    /// @brief Redirects all further messages to a binary log at `path`, replacing any binary log that is
+    /// already open. Format strings are written once and each message only stores a format id, a timestamp,
+    /// the thread and the raw argument bytes, which is much cheaper than formatting text. Use
+    /// `DecodeBinaryLog`, or the KrystalLogDecoder tool, to read the file back.
+    /// @returns False if the file couldn't be opened, in which case messages continue to be written as text.
+    static bool OpenBinaryLog(const stringview &path) noexcept;
+
+    /// @brief Closes the binary log, if one is open, and goes back to writing text.
+    static void CloseBinaryLog() noexcept;
+
   private:
-    template <LogLevel level, typename... Args>
-    static void Log(const string &fmt, Args &&...args) noexcept
+    template <LogLevel level, LogCategory category, typename... Args>
+    static void Log(std::format_string<Args...> fmt, Args &&...args) noexcept
     {
 #ifdef KRYS_ENABLE_LOGGING
-      string fullMessage = ToString(level) + ": " + std::vformat(fmt, std::make_format_args(args...)) + '\n';
-      std::lock_guard<std::mutex> lock(_mu);
-      Output(fullMessage);
+      if constexpr (IsCompiledIn(level, category))
+      {
+        if (!IsEnabled(level, category))
+          return;
+
+        Submit(level, category, Impl::LogRecordFlags::NewLine, fmt, std::forward<Args>(args)...);
+        if constexpr (level == LogLevel::Fatal)
+          Flush();
+      }
 #endif
     }
 
+    template <typename... Args>
+    static void Submit(LogLevel level, LogCategory category, Impl::LogRecordFlags flags,
+                       std::format_string<Args...> fmt, Args &&...args) noexcept
+    {
+      Impl::LogRecord *record = BeginRecord();
+      if (record == nullptr)
+      {
+        // The writer has shut down, fall back to writing on this thread.
+        string message = Prefix(level, flags);
+        std::format_to(std::back_inserter(message), fmt, std::forward<Args>(args)...);
+        if (!!(flags & Impl::LogRecordFlags::NewLine))
+          message += '\n';
+        Output(message);
+        return;
+      }
+
+      record->Level = level;
+      record->Category = category;
+      record->Flags = flags;
+      Impl::CaptureLogArgs(*record, fmt, std::forward<Args>(args)...);
+      EndRecord();
+    }
+
+    NO_DISCARD static string Prefix(LogLevel level, Impl::LogRecordFlags flags) noexcept
+    {
+      return !!(flags & Impl::LogRecordFlags::Raw) ? string {} : ToString(level) + ": ";
+    }
+
+    /// @brief Reserves a record in the calling thread's queue, waiting for space if it is full.
+    /// @returns The record to fill in, or `nullptr` if the writer has shut down.
+    NO_DISCARD static Impl::LogRecord *BeginRecord() noexcept;
+
+    /// @brief Publishes the record returned by `BeginRecord` to the writer thread.
+    static void EndRecord() noexcept;
+
+    /// @brief Writes a fully formatted message to the platform's log outputs.
     static void Output(const string &message) noexcept;
 
-    static std::mutex _mu;
-    static std::ofstream _logFile;
+    static std::atomic<uint8> _level;
+    static std::atomic<uint32> _categories;
   };
-}
\ No newline at end of file
+}
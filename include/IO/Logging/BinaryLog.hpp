@@ -0,0 +1,137 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Endian.hpp"
+#include "Base/Types.hpp"
+
+#include <bit>
+#include <type_traits>
+
+namespace Krys
+{
+  /// @brief Decodes a binary log written by `Logger::OpenBinaryLog` back into text.
+  /// @param path The path to the binary log.
+  /// @return The decoded log, one message per line, or an error describing why the file couldn't be decoded.
+  NO_DISCARD Expected<string> DecodeBinaryLog(const stringview &path) noexcept;
+}
+
+namespace Krys::Impl
+{
+#pragma region File Format
+
+  // A binary log is a header followed by a stream of entries. Every value is little endian.
+  //
+  // Header:  char[4] magic, uint16 version, int64 tick frequency.
+  // Format:  uint8 kind, uint32 id, uint32 length, char[length] format, uint8 count, LogArgType[count].
+  // Message: uint8 kind, uint32 id, int64 ticks, uint32 thread, uint8 level, uint8 category, uint8 flags,
+  //          then each argument encoded as described by the format entry with the same id.
+  //
+  // Formats are written once, the first time a message using them is written.
+
+  constexpr Array<char, 4> BinaryLogMagic = {'K', 'L', 'O', 'G'};
+  constexpr uint16 BinaryLogVersion = 1;
+
+  enum class BinaryLogEntry : uint8
+  {
+    Format,
+    Message
+  };
+
+  /// @brief How a single argument is encoded. Strings are a `uint32` length followed by the characters,
+  /// pointers are a `uint64`, everything else is written as-is.
+  enum class LogArgType : uint8
+  {
+    Bool,
+    Char,
+    Int8,
+    Int16,
+    Int32,
+    Int64,
+    UInt8,
+    UInt16,
+    UInt32,
+    UInt64,
+    Float32,
+    Float64,
+    String,
+    Pointer
+  };
+
+#pragma endregion File Format
+
+#pragma region Encoding
+
+  /// @brief Get the binary encoding of `T`, or nothing if `T` has to be formatted as text instead.
+  template <typename T>
+  NO_DISCARD constexpr Nullable<LogArgType> GetLogArgType() noexcept
+  {
+    if constexpr (std::is_same_v<T, bool>)
+      return LogArgType::Bool;
+    else if constexpr (std::is_same_v<T, char>)
+      return LogArgType::Char;
+    else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+    {
+      if constexpr (sizeof(T) == 1)
+        return LogArgType::Int8;
+      else if constexpr (sizeof(T) == 2)
+        return LogArgType::Int16;
+      else if constexpr (sizeof(T) == 4)
+        return LogArgType::Int32;
+      else
+        return LogArgType::Int64;
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T>)
+    {
+      if constexpr (sizeof(T) == 1)
+        return LogArgType::UInt8;
+      else if constexpr (sizeof(T) == 2)
+        return LogArgType::UInt16;
+      else if constexpr (sizeof(T) == 4)
+        return LogArgType::UInt32;
+      else
+        return LogArgType::UInt64;
+    }
+    else if constexpr (std::is_same_v<T, float32>)
+      return LogArgType::Float32;
+    else if constexpr (std::is_same_v<T, float64>)
+      return LogArgType::Float64;
+    else if constexpr (std::is_same_v<T, string>)
+      return LogArgType::String;
+    else if constexpr (std::is_pointer_v<T>)
+      return LogArgType::Pointer;
+    else
+      return std::nullopt;
+  }
+
+  template <IsArithmeticT T>
+  void AppendLogBytes(List<byte> &out, T value) noexcept
+  {
+    if constexpr (std::is_same_v<T, bool>)
+      out.push_back(static_cast<byte>(value));
+    else
+    {
+      const auto bytes = std::bit_cast<Array<byte, sizeof(T)>>(Endian::ToLittleEndian(value));
+      out.insert(out.end(), bytes.begin(), bytes.end());
+    }
+  }
+
+  inline void AppendLogBytes(List<byte> &out, stringview value) noexcept
+  {
+    AppendLogBytes(out, static_cast<uint32>(value.size()));
+    const auto *data = reinterpret_cast<const byte *>(value.data());
+    out.insert(out.end(), data, data + value.size());
+  }
+
+  template <typename T>
+  void EncodeLogArg(List<byte> &out, const T &value) noexcept
+  {
+    if constexpr (std::is_same_v<T, string>)
+      AppendLogBytes(out, stringview {value});
+    else if constexpr (std::is_pointer_v<T>)
+      AppendLogBytes(out, static_cast<uint64>(reinterpret_cast<uintptr_t>(value)));
+    else
+      AppendLogBytes(out, value);
+  }
+
+#pragma endregion Encoding
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Macros.hpp"
+#include "Base/Types.hpp"
+#include "IO/Logging/BinaryLog.hpp"
+#include "Utils/Concurrency/SPSCQueue.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <tuple>
+
+namespace Krys
+{
+  enum class LogLevel : uint8
+  {
+    Debug,
+    Info,
+    Warn,
+    Error,
+    Fatal
+  };
+
+  /// @brief Subsystem a message belongs to. Used for filtering, both at compile time and at runtime.
+  enum class LogCategory : uint8
+  {
+    General,
+    Core,
+    Events,
+    Graphics,
+    IO,
+    Input,
+    Platform,
+    Scripting,
+    Count
+  };
+
+  NO_DISCARD constexpr inline string ToString(LogLevel level)
+  {
+    switch (level)
+    {
+      case LogLevel::Debug: return "[DEBUG]";
+      case LogLevel::Info:  return "[INFO ]";
+      case LogLevel::Warn:  return "[WARN ]";
+      case LogLevel::Error: return "[ERROR]";
+      case LogLevel::Fatal: return "[FATAL]";
+      default:              return "[UNDEF]";
+    }
+  }
+
+  NO_DISCARD constexpr inline uint32 ToBit(LogCategory category) noexcept
+  {
+    return 1u << static_cast<uint32>(category);
+  }
+}
+
+namespace Krys::Impl
+{
+  enum class LogRecordFlags : uint8
+  {
+    None = 0,
+    /// @brief Don't prefix the message with the log level.
+    Raw = 1,
+    /// @brief Append a new line to the message.
+    NewLine = 2,
+  };
+
+  ENUM_CLASS_BITWISE_OPERATORS(LogRecordFlags, uint8)
+
+  /// @brief Type-erased operations on a set of captured arguments.
+  struct LogArgsInfo
+  {
+    /// @brief Formats the captured arguments into `out`.
+    using FormatFunc = void (*)(string &out, stringview format, const byte *storage) noexcept;
+
+    /// @brief Appends the binary encoding of the captured arguments to `out`.
+    using EncodeFunc = void (*)(List<byte> &out, const byte *storage) noexcept;
+
+    /// @brief Destroys the captured arguments.
+    using DestroyFunc = void (*)(byte *storage) noexcept;
+
+    FormatFunc Format {nullptr};
+
+    /// @brief `nullptr` if any of the arguments can't be encoded, in which case binary logs store the
+    /// formatted message instead.
+    EncodeFunc Encode {nullptr};
+
+    DestroyFunc Destroy {nullptr};
+
+    const LogArgType *Types {nullptr};
+    uint8 Count {0};
+  };
+
+  /// @brief A message that has been submitted but not yet formatted.
+  /// @details The arguments are captured by value into `Storage` on the calling thread. Formatting or encoding
+  /// happens later on the writer thread through `ArgsInfo`.
+  struct LogRecord
+  {
+    static constexpr size_t InlineStorageSize = 208;
+
+    int64 Timestamp {0};
+    stringview Format;
+    const LogArgsInfo *ArgsInfo {nullptr};
+    LogLevel Level {LogLevel::Info};
+    LogCategory Category {LogCategory::General};
+    LogRecordFlags Flags {LogRecordFlags::None};
+    alignas(std::max_align_t) byte Storage[InlineStorageSize];
+  };
+
+  /// @brief Per-thread queue of pending log records.
+  struct LogQueue
+  {
+    static constexpr size_t Capacity = 1'024;
+
+    Concurrency::SPSCQueue<LogRecord, Capacity> Records;
+
+    /// @brief Identifies the owning thread in binary logs. Assigned when the queue is registered.
+    uint32 ThreadId {0};
+
+    /// @brief Set when the owning thread exits, so the writer can drop the queue once it's drained.
+    std::atomic<bool> Retired {false};
+  };
+
+  /// @brief How an argument is stored until it's formatted. Anything that may point at memory owned by the
+  /// caller is copied into a `string`.
+  template <typename T>
+  struct LogArgCapture
+  {
+    using type = T;
+  };
+
+  template <>
+  struct LogArgCapture<const char *>
+  {
+    using type = string;
+  };
+
+  template <>
+  struct LogArgCapture<char *>
+  {
+    using type = string;
+  };
+
+  template <>
+  struct LogArgCapture<stringview>
+  {
+    using type = string;
+  };
+
+  template <typename... Args>
+  using LogArgs = std::tuple<typename LogArgCapture<std::decay_t<Args>>::type...>;
+
+  template <typename... Args>
+  constexpr bool FitsInLogRecord =
+    sizeof(LogArgs<Args...>) <= LogRecord::InlineStorageSize
+    && alignof(LogArgs<Args...>) <= alignof(std::max_align_t);
+
+  template <typename Tuple>
+  struct LogArgsTraits;
+
+  template <typename... Ts>
+  struct LogArgsTraits<std::tuple<Ts...>>
+  {
+    using Tuple = std::tuple<Ts...>;
+
+    static constexpr bool IsEncodable = (GetLogArgType<Ts>().has_value() && ...);
+    static constexpr Array<LogArgType, sizeof...(Ts)> Types {GetLogArgType<Ts>().value_or(LogArgType::String)...};
+
+    static void Format(string &out, stringview format, const byte *storage) noexcept
+    {
+      const auto *args = std::launder(reinterpret_cast<const Tuple *>(storage));
+      std::apply([&](const auto &...values)
+                 { std::vformat_to(std::back_inserter(out), format, std::make_format_args(values...)); },
+                 *args);
+    }
+
+    static void Encode(List<byte> &out, const byte *storage) noexcept
+    {
+      if constexpr (IsEncodable)
+      {
+        const auto *args = std::launder(reinterpret_cast<const Tuple *>(storage));
+        std::apply([&](const auto &...values) { (EncodeLogArg(out, values), ...); }, *args);
+      }
+    }
+
+    static void Destroy(byte *storage) noexcept
+    {
+      std::destroy_at(std::launder(reinterpret_cast<Tuple *>(storage)));
+    }
+
+    static constexpr LogArgsInfo Info {&Format, IsEncodable ? &Encode : nullptr, &Destroy, Types.data(),
+                                       static_cast<uint8>(sizeof...(Ts))};
+  };
+
+  /// @brief Captures `args` into `record`. Falls back to formatting on the calling thread when the arguments
+  /// don't fit in the record's inline storage.
+  template <typename... Args>
+  void CaptureLogArgs(LogRecord &record, std::format_string<Args...> format, Args &&...args) noexcept
+  {
+    if constexpr (FitsInLogRecord<Args...>)
+    {
+      std::construct_at(reinterpret_cast<LogArgs<Args...> *>(record.Storage), std::forward<Args>(args)...);
+      record.Format = format.get();
+      record.ArgsInfo = &LogArgsTraits<LogArgs<Args...>>::Info;
+    }
+    else
+    {
+      std::construct_at(reinterpret_cast<LogArgs<string> *>(record.Storage),
+                        std::format(format, std::forward<Args>(args)...));
+      record.Format = "{}";
+      record.ArgsInfo = &LogArgsTraits<LogArgs<string>>::Info;
+    }
+  }
+}
@@ -7,84 +7,190 @@
 #include "Debug/Macros.hpp"
 #include "Utils/Bytes.hpp"
 
-#include <bitset>
+#include <bit>
+#include <cstring>
+#include <span>
 
 namespace Krys::IO
 {
-  template <Endian::Type TSource, Endian::Type TDestination = Endian::Type::System>
-  class BitReader
+  /// @brief The order bits are packed into each byte.
+  enum class BitOrder
   {
-    static constexpr size_t BitsetSize = 8 * sizeof(byte);
+    /// @brief The first bit is the most significant bit of the byte, e.g. BMP, PNM and JPEG.
+    MSBFirst,
+
+    /// @brief The first bit is the least significant bit of the byte, e.g. DEFLATE.
+    LSBFirst
+  };
 
+  /// @brief Reads bits from a byte buffer, which must outlive the reader.
+  /// @details Bits are kept in a 64-bit buffer that is refilled 8 bytes at a time, so reading a field is a
+  /// shift and a mask rather than a loop over its bits. Refills only take the unaligned 8 byte load when at
+  /// least 8 bytes are left; the tail of the buffer is loaded byte by byte. Reading past the end returns zero
+  /// bits and sets `HasOverrun`.
+  template <BitOrder TOrder = BitOrder::MSBFirst>
+  class BitReader
+  {
   public:
-    BitReader(const List<byte> *buffer) noexcept
-        : _buffer(buffer), _bitIndex(0), _byteIndex(0), _currentByte(0)
+    /// @brief The most bits `PeekBits` can return at once.
+    static constexpr uint32 MaxPeekBits = 56;
+
+    BitReader() noexcept = default;
+
+    explicit BitReader(std::span<const byte> buffer) noexcept
     {
-      KRYS_ASSERT(buffer != nullptr, "Buffer cannot be null.");
+      SetBuffer(buffer);
     }
 
     ~BitReader() noexcept = default;
 
-    void SetBuffer(const List<byte> *buffer) noexcept
+    void SetBuffer(std::span<const byte> buffer) noexcept
     {
-      KRYS_ASSERT(buffer != nullptr, "Buffer cannot be null.");
-      _buffer = buffer;
-      _bitIndex = 0;
-      _byteIndex = 0;
-      _currentByte = 0;
+      _begin = _current = buffer.data();
+      _end = buffer.data() + buffer.size();
+      _bits = 0;
+      _count = 0;
+      _overrun = false;
     }
 
-    NO_DISCARD bool ReadBit() noexcept
+    /// @brief Get the next `count` bits without consuming them.
+    NO_DISCARD uint64 PeekBits(uint32 count) noexcept
     {
-      if (_bitIndex == 0)
-        _currentByte = static_cast<uint8>(_buffer->at(_byteIndex++));
+      KRYS_ASSERT(count <= MaxPeekBits, "Can't peek more than {0} bits at once", MaxPeekBits);
+      if (_count < count)
+        Refill(count);
 
-      // Extract the current bit (MSB first)
-      bool bit = (_currentByte >> (7 - _bitIndex)) & 1;
-      _bitIndex = (_bitIndex + 1) % 8;
+      if (count == 0)
+        return 0;
 
-      return bit;
+      if constexpr (TOrder == BitOrder::MSBFirst)
+        return _bits >> (64 - count);
+      else
+        return _bits & ((uint64 {1} << count) - 1);
     }
 
-    NO_DISCARD byte ReadBits(uint length) noexcept
+    /// @brief Move past `count` bits, which must have been peeked first.
+    void ConsumeBits(uint32 count) noexcept
     {
-      KRYS_ASSERT(length <= BitsetSize, "Length must be less than or equal to %zu.", BitsetSize);
-      KRYS_ASSERT(length > 0, "Length must be greater than 0.");
+      KRYS_ASSERT(count <= _count, "Bits must be peeked before they are consumed");
+      if constexpr (TOrder == BitOrder::MSBFirst)
+        _bits <<= count;
+      else
+        _bits >>= count;
+      _count -= count;
+    }
 
-      byte value {};
-      for (uint i = 0; i < length; i++)
+    /// @brief Read a field of up to 64 bits.
+    NO_DISCARD uint64 ReadBits(uint32 count) noexcept
+    {
+      KRYS_ASSERT(count <= 64, "Can't read more than 64 bits at once");
+      if (count > MaxPeekBits)
       {
-        bool bit = ReadBit();
-        value |= static_cast<byte>(bit) << (length - i - 1);
+        // Split so that each half fits in the bit buffer.
+        const uint64 first = ReadBits(32);
+        const uint64 second = ReadBits(count - 32);
+        if constexpr (TOrder == BitOrder::MSBFirst)
+          return (first << (count - 32)) | second;
+        else
+          return first | (second << 32);
       }
 
+      const uint64 value = PeekBits(count);
+      ConsumeBits(count);
       return value;
     }
 
-    NO_DISCARD List<byte> ReadBytes(size_t count) noexcept
+    NO_DISCARD bool ReadBit() noexcept
+    {
+      return ReadBits(1) != 0;
+    }
+
+    /// @brief Skip to the start of the next byte, unless already at one.
+    void AlignToByte() noexcept
     {
-      List<byte> bytes(count);
-      for (size_t i = 0; i < count; i++)
-        bytes[i] = ReadBits(8);
-      return bytes;
+      ConsumeBits(_count % 8);
     }
 
-    template <IsArithmeticT T>
+    /// @brief Copy `size` whole bytes into `data`.
+    void ReadBytes(byte *data, size_t size) noexcept
+    {
+      for (size_t i = 0; i < size; i++)
+        data[i] = static_cast<byte>(ReadBits(8));
+    }
+
+    /// @brief Read a value stored as `sizeof(T)` bytes with `TSource` endianness.
+    template <IsArithmeticT T, Endian::Type TSource = Endian::Type::Little>
     NO_DISCARD T Read() noexcept
     {
-      auto bytes = ReadBytes(sizeof(T));
-      return Bytes::AsNumeric<T, TSource, TDestination>(bytes);
+      Array<byte, sizeof(T)> bytes;
+      ReadBytes(bytes.data(), bytes.size());
+      return Bytes::AsNumeric<T, TSource, Endian::Type::System>(bytes.data());
     }
 
-    void NextByte() noexcept
+    /// @brief Get the number of bits read so far.
+    NO_DISCARD size_t GetBitPosition() const noexcept
     {
-      _bitIndex = 0; // will fetch the next byte on the next call to Read
+      return static_cast<size_t>(_current - _begin) * 8 - _count;
+    }
+
+    /// @brief Get the number of bits left to read.
+    NO_DISCARD size_t GetRemainingBits() const noexcept
+    {
+      return static_cast<size_t>(_end - _current) * 8 + _count;
+    }
+
+    /// @brief Check if more bits were read than the buffer has.
+    NO_DISCARD bool HasOverrun() const noexcept
+    {
+      return _overrun;
     }
 
   private:
-    const List<byte> *_buffer;
-    uint8 _currentByte;
-    size_t _bitIndex;
-    size_t _byteIndex;
+    /// @brief Top up the bit buffer so it holds at least `count` bits, padding with zeros at the end.
+    void Refill(uint32 count) noexcept
+    {
+      if (_end - _current >= 8)
+      {
+        // Branchless refill: load 8 bytes, but only credit the whole bytes that fit. The extra bits that
+        // land below the new count are the same stream bits the next refill will load again, so OR-ing them
+        // in twice is harmless.
+        uint64 next;
+        std::memcpy(&next, _current, sizeof(next));
+        if constexpr (TOrder == BitOrder::MSBFirst)
+          _bits |= Endian::Convert<uint64, Endian::Type::Big, Endian::Type::System>(next) >> _count;
+        else
+          _bits |= Endian::Convert<uint64, Endian::Type::Little, Endian::Type::System>(next) << _count;
+
+        _current += (63 - _count) >> 3;
+        _count |= 56;
+        return;
+      }
+
+      while (_count <= 56 && _current < _end)
+      {
+        const auto next = std::to_integer<uint64>(*_current++);
+        if constexpr (TOrder == BitOrder::MSBFirst)
+          _bits |= next << (56 - _count);
+        else
+          _bits |= next << _count;
+        _count += 8;
+      }
+
+      if (_count < count)
+      {
+        // Past the end: the buffer is already zero beyond `_count`, so just account for the padding.
+        _overrun = true;
+        _count = count;
+      }
+    }
+
+    const byte *_begin {nullptr};
+    const byte *_current {nullptr};
+    const byte *_end {nullptr};
+
+    /// @brief Buffered bits, starting from the top (MSB first) or the bottom (LSB first).
+    uint64 _bits {0};
+    uint32 _count {0};
+    bool _overrun {false};
   };
 }
@@ -0,0 +1,216 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Concepts.hpp"
+#include "Base/Endian.hpp"
+#include "Base/Macros.hpp"
+#include "Base/Pointers.hpp"
+#include "Base/Types.hpp"
+#include "IO/Readers/MappedFile.hpp"
+#include "Utils/Bytes.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <utility>
+
+namespace Krys::IO
+{
+  /// @brief Where a `BufferedReader` gets its data from.
+  class ReadSource
+  {
+  public:
+    virtual ~ReadSource() noexcept = default;
+
+    NO_DISCARD virtual bool IsOpen() const noexcept = 0;
+
+    NO_DISCARD virtual size_t GetSize() const noexcept = 0;
+
+    /// @brief Copy up to `size` bytes starting at `offset` into `data`.
+    /// @returns The number of bytes copied, which is less than `size` at the end of the source.
+    virtual size_t ReadAt(size_t offset, byte *data, size_t size) noexcept = 0;
+
+    /// @brief Get the whole source if it's already in memory, so it can be read without copying.
+    NO_DISCARD virtual std::span<const byte> GetContiguous() const noexcept
+    {
+      return {};
+    }
+  };
+
+  /// @brief Reads a file through an `std::ifstream`.
+  class StreamReadSource : public ReadSource
+  {
+  public:
+    explicit StreamReadSource(const stringview &path) noexcept;
+
+    NO_DISCARD bool IsOpen() const noexcept override;
+    NO_DISCARD size_t GetSize() const noexcept override;
+    size_t ReadAt(size_t offset, byte *data, size_t size) noexcept override;
+
+  private:
+    std::ifstream _stream;
+    size_t _size {0};
+    size_t _position {0};
+  };
+
+  /// @brief Reads a file through a `MappedFile`.
+  class MappedReadSource : public ReadSource
+  {
+  public:
+    explicit MappedReadSource(const stringview &path) noexcept;
+    explicit MappedReadSource(MappedFile &&file) noexcept;
+
+    NO_DISCARD bool IsOpen() const noexcept override;
+    NO_DISCARD size_t GetSize() const noexcept override;
+    size_t ReadAt(size_t offset, byte *data, size_t size) noexcept override;
+    NO_DISCARD std::span<const byte> GetContiguous() const noexcept override;
+
+  private:
+    MappedFile _file;
+  };
+
+  /// @brief Reads from memory owned by someone else, which must outlive the source.
+  class MemoryReadSource : public ReadSource
+  {
+  public:
+    explicit MemoryReadSource(std::span<const byte> data) noexcept;
+
+    NO_DISCARD bool IsOpen() const noexcept override;
+    NO_DISCARD size_t GetSize() const noexcept override;
+    size_t ReadAt(size_t offset, byte *data, size_t size) noexcept override;
+    NO_DISCARD std::span<const byte> GetContiguous() const noexcept override;
+
+  private:
+    std::span<const byte> _data;
+  };
+
+  /// @brief Sequential reader that pulls data from a `ReadSource` in large blocks.
+  /// @details Values are read out of the current block, so a numeric read is a bounds check and a `memcpy`
+  /// rather than a call into the source. Sources that are already in memory (mapped files, buffers) are read
+  /// in place without a block. Bulk reads larger than a block go straight from the source into the
+  /// destination. Reading past the end never fails hard; missing bytes read as zero and the position stops
+  /// at the end.
+  class BufferedReader
+  {
+  public:
+    NO_COPY(BufferedReader)
+
+    static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+    /// @brief Constructs a `BufferedReader` over a memory mapping of `path`. Check `IsOpen` for the result.
+    explicit BufferedReader(const stringview &path) noexcept;
+
+    /// @brief Constructs a `BufferedReader` over `source`.
+    /// @param blockSize How much to read from the source at a time. Unused if the source is in memory.
+    explicit BufferedReader(Unique<ReadSource> source, size_t blockSize = DefaultBlockSize) noexcept;
+
+    BufferedReader(BufferedReader &&other) noexcept;
+    BufferedReader &operator=(BufferedReader &&other) noexcept;
+
+    NO_DISCARD bool IsOpen() const noexcept;
+
+    NO_DISCARD bool IsEOS() const noexcept
+    {
+      return GetPosition() >= _size;
+    }
+
+    NO_DISCARD size_t GetSize() const noexcept
+    {
+      return _size;
+    }
+
+    NO_DISCARD size_t GetPosition() const noexcept
+    {
+      return _windowOffset + static_cast<size_t>(_current - _begin);
+    }
+
+    NO_DISCARD size_t GetRemaining() const noexcept
+    {
+      return _size - GetPosition();
+    }
+
+    /// @brief Get the whole source if it's already in memory, so it can be parsed in place. Empty otherwise.
+    NO_DISCARD std::span<const byte> GetContiguous() const noexcept
+    {
+      return _source ? _source->GetContiguous() : std::span<const byte> {};
+    }
+
+    void Seek(size_t position) noexcept;
+
+    void Skip(intmax_t offset) noexcept;
+
+    void Reset() noexcept
+    {
+      Seek(0);
+    }
+
+    NO_DISCARD uint8 PeekNextByte() noexcept
+    {
+      if (_current == _end && !Refill(1))
+        return 0;
+      return std::to_integer<uint8>(*_current);
+    }
+
+    uint8 NextByte() noexcept
+    {
+      if (_current == _end && !Refill(1))
+        return 0;
+      return std::to_integer<uint8>(*_current++);
+    }
+
+    /// @brief Read a value stored with `TSource` endianness, converting it to the system's.
+    template <IsArithmeticT T, Endian::Type TSource = Endian::Type::Little>
+    NO_DISCARD T Read() noexcept
+    {
+      if (static_cast<size_t>(_end - _current) < sizeof(T) && !Refill(sizeof(T)))
+      {
+        Seek(_size);
+        return T {};
+      }
+
+      const T value = Bytes::AsNumeric<T, TSource, Endian::Type::System>(_current);
+      _current += sizeof(T);
+      return value;
+    }
+
+    /// @brief Fill `values` with values stored with `TSource` endianness, converting them to the system's.
+    template <IsArithmeticT T, Endian::Type TSource = Endian::Type::Little>
+    void Read(std::span<T> values) noexcept
+    {
+      ReadBytes(reinterpret_cast<byte *>(values.data()), values.size_bytes());
+      Endian::ConvertArray<T, TSource, Endian::Type::System>(values);
+    }
+
+    /// @brief Read `count` values stored with `TSource` endianness, converting them to the system's.
+    template <IsArithmeticT T, Endian::Type TSource = Endian::Type::Little>
+    NO_DISCARD List<T> Read(size_t count) noexcept
+    {
+      List<T> values(count);
+      Read<T, TSource>(std::span<T>(values));
+      return values;
+    }
+
+    /// @brief Copy the next `size` bytes into `data`. Anything past the end of the source is zeroed.
+    void ReadBytes(byte *data, size_t size) noexcept;
+
+    /// @brief Read the text up to the next '\n', and move past it. The '\n' isn't included.
+    NO_DISCARD string ReadLine() noexcept;
+
+    void SkipLine() noexcept;
+
+  private:
+    /// @brief Make sure at least `size` bytes are available in the window, reading a new block if needed.
+    /// @returns False if the source doesn't have that many bytes left.
+    bool Refill(size_t size) noexcept;
+
+    Unique<ReadSource> _source;
+    List<byte> _block;
+    size_t _size {0};
+
+    /// @brief The bytes currently readable without going to the source, and their offset in it.
+    const byte *_begin {nullptr};
+    const byte *_current {nullptr};
+    const byte *_end {nullptr};
+    size_t _windowOffset {0};
+  };
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Detection.hpp"
+#include "Base/Macros.hpp"
+#include "Base/Types.hpp"
+
+#include <span>
+#include <utility>
+
+// The only backend is src/Platform/Win32/IO/MappedFile.cpp. Fail here rather than at link time.
+#if !defined(KRYS_PLATFORM_WINDOWS)
+  #error "IO::MappedFile has no implementation for this platform!"
+#endif
+
+namespace Krys::IO
+{
+  /// @brief Read-only view of a file's contents, mapped into the address space by the OS.
+  /// @details Pages are loaded on first access, so opening a file is cheap regardless of its size and the
+  /// contents are never copied into a user buffer. The mapping stays valid until the file is closed, so
+  /// spans returned by `GetSpan` must not outlive it.
+  class MappedFile
+  {
+  public:
+    NO_COPY(MappedFile)
+
+    MappedFile() noexcept = default;
+
+    /// @brief Constructs a `MappedFile` and opens `path`. Check `IsOpen` for the result.
+    explicit MappedFile(const stringview &path) noexcept
+    {
+      Open(path);
+    }
+
+    ~MappedFile() noexcept
+    {
+      Close();
+    }
+
+    MappedFile(MappedFile &&other) noexcept
+        : _data(std::exchange(other._data, nullptr)), _size(std::exchange(other._size, 0)),
+          _isOpen(std::exchange(other._isOpen, false))
+    {
+    }
+
+    MappedFile &operator=(MappedFile &&other) noexcept
+    {
+      if (this != &other)
+      {
+        Close();
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+        _isOpen = std::exchange(other._isOpen, false);
+      }
+      return *this;
+    }
+
+    /// @brief Map `path` into memory, closing any previously opened file.
+    /// @returns False if the file couldn't be opened or mapped. Empty files open successfully but have no
+    /// data.
+    bool Open(const stringview &path) noexcept;
+
+    /// @brief Unmap the file. Safe to call if nothing is open.
+    void Close() noexcept;
+
+    NO_DISCARD bool IsOpen() const noexcept
+    {
+      return _isOpen;
+    }
+
+    NO_DISCARD const byte *GetData() const noexcept
+    {
+      return _data;
+    }
+
+    NO_DISCARD size_t GetSize() const noexcept
+    {
+      return _size;
+    }
+
+    NO_DISCARD std::span<const byte> GetSpan() const noexcept
+    {
+      return {_data, _size};
+    }
+
+    /// @brief Get the contents as text. Line endings are left as they are in the file.
+    NO_DISCARD stringview GetText() const noexcept
+    {
+      return {reinterpret_cast<const char *>(_data), _size};
+    }
+
+  private:
+    const byte *_data {nullptr};
+    size_t _size {0};
+    bool _isOpen {false};
+  };
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Concepts.hpp"
+#include "Base/Endian.hpp"
+#include "Base/Macros.hpp"
+#include "Base/Types.hpp"
+#include "IO/Readers/MappedFile.hpp"
+#include "IO/Readers/MemoryReader.hpp"
+
+#include <span>
+#include <utility>
+
+namespace Krys::IO
+{
+  /// @brief Sequential reader over a `MappedFile` it owns.
+  /// @details Reading is done by a `MemoryReader` over the mapping, so this only ties its lifetime to the
+  /// file's. `ReadSpan`/`ReadLine` return views into the file, valid for as long as the reader is.
+  class MappedFileReader
+  {
+  public:
+    NO_COPY(MappedFileReader)
+
+    /// @brief Constructs a `MappedFileReader` and maps `path`. Check `IsOpen` for the result.
+    explicit MappedFileReader(const stringview &path) noexcept : _file(path), _reader(_file.GetSpan())
+    {
+    }
+
+    /// @brief Constructs a `MappedFileReader` over an already opened file.
+    explicit MappedFileReader(MappedFile &&file) noexcept
+        : _file(std::move(file)), _reader(_file.GetSpan())
+    {
+    }
+
+    // The mapping itself doesn't move, so the reader's view of it stays valid.
+    MappedFileReader(MappedFileReader &&other) noexcept
+        : _file(std::move(other._file)), _reader(std::exchange(other._reader, {}))
+    {
+    }
+
+    MappedFileReader &operator=(MappedFileReader &&other) noexcept
+    {
+      if (this != &other)
+      {
+        _file = std::move(other._file);
+        _reader = std::exchange(other._reader, {});
+      }
+      return *this;
+    }
+
+    NO_DISCARD bool IsOpen() const noexcept
+    {
+      return _file.IsOpen();
+    }
+
+    NO_DISCARD bool IsEOS() const noexcept
+    {
+      return _reader.IsEOS();
+    }
+
+    NO_DISCARD size_t GetSize() const noexcept
+    {
+      return _reader.GetSize();
+    }
+
+    NO_DISCARD size_t GetPosition() const noexcept
+    {
+      return _reader.GetPosition();
+    }
+
+    NO_DISCARD size_t GetRemaining() const noexcept
+    {
+      return _reader.GetRemaining();
+    }
+
+    /// @brief Get the whole file.
+    NO_DISCARD std::span<const byte> GetSpan() const noexcept
+    {
+      return _reader.GetSpan();
+    }
+
+    /// @brief Get the rest of the file from the current position.
+    NO_DISCARD std::span<const byte> GetRemainingSpan() const noexcept
+    {
+      return _reader.GetRemainingSpan();
+    }
+
+    void Seek(size_t position) noexcept
+    {
+      _reader.Seek(position);
+    }
+
+    void Skip(intmax_t offset) noexcept
+    {
+      _reader.Skip(offset);
+    }
+
+    void Reset() noexcept
+    {
+      _reader.Reset();
+    }
+
+    NO_DISCARD uint8 PeekNextByte() const noexcept
+    {
+      return _reader.PeekNextByte();
+    }
+
+    uint8 NextByte() noexcept
+    {
+      return _reader.NextByte();
+    }
+
+    /// @brief Read a value stored with `TSource` endianness, converting it to the system's.
+    template <IsArithmeticT T, Endian::Type TSource = Endian::Type::Little>
+    NO_DISCARD T Read() noexcept
+    {
+      return _reader.Read<T, TSource>();
+    }
+
+    /// @brief Fill `values` with values stored with `TSource` endianness, converting them to the system's.
+    template <IsArithmeticT T, Endian::Type TSource = Endian::Type::Little>
+    void Read(std::span<T> values) noexcept
+    {
+      _reader.Read<T, TSource>(values);
+    }
+
+    /// @brief Read `count` values stored with `TSource` endianness, converting them to the system's.
+    template <IsArithmeticT T, Endian::Type TSource = Endian::Type::Little>
+    NO_DISCARD List<T> Read(size_t count) noexcept
+    {
+      return _reader.Read<T, TSource>(count);
+    }
+
+    /// @brief Get a view of the next `count` bytes and move past them. The view is shorter than `count` if
+    /// the end of the file is reached first.
+    NO_DISCARD std::span<const byte> ReadSpan(size_t count) noexcept
+    {
+      return _reader.ReadSpan(count);
+    }
+
+    /// @brief Copy the next `size` bytes into `data`. Anything past the end of the file is zeroed.
+    void ReadBytes(byte *data, size_t size) noexcept
+    {
+      _reader.ReadBytes(data, size);
+    }
+
+    /// @brief Get a view of the text up to the next '\n', and move past it. The '\n' isn't included.
+    NO_DISCARD stringview ReadLine() noexcept
+    {
+      return _reader.ReadLine();
+    }
+
+    void SkipLine() noexcept
+    {
+      _reader.SkipLine();
+    }
+
+  private:
+    MappedFile _file;
+    MemoryReader _reader;
+  };
+}
@@ -4,117 +4,162 @@
 #include "Base/Concepts.hpp"
 #include "Base/Endian.hpp"
 #include "Base/Macros.hpp"
-#include "Base/Pointers.hpp"
 #include "Base/Types.hpp"
 #include "Utils/Bytes.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <span>
+
 namespace Krys::IO
 {
-  template <Endian::Type TSource, Endian::Type TDestination>
+  /// @brief Sequential reader over memory owned by someone else, which must outlive the reader.
+  /// @details Nothing is copied up front, so any buffer already in memory (a file mapping, an archive entry,
+  /// a downloaded blob) can be parsed in place. Numeric reads copy only the bytes of the value, and
+  /// `ReadSpan`/`ReadLine` return views without copying at all. Reading past the end never touches memory
+  /// outside the buffer; missing bytes read as zero and the position stops at the end.
   class MemoryReader
   {
   public:
-    explicit constexpr MemoryReader(const List<byte> &data) noexcept : _buffer(data), _readIndex(0)
+    constexpr MemoryReader() noexcept = default;
+
+    explicit constexpr MemoryReader(std::span<const byte> data) noexcept : _data(data)
     {
     }
 
-    explicit constexpr MemoryReader(const string &data) noexcept : _readIndex(0)
+    explicit MemoryReader(stringview text) noexcept : _data(std::as_bytes(std::span(text)))
     {
-      _buffer.reserve(data.size());
-      for (auto c : data)
-        _buffer.push_back(static_cast<byte>(c));
     }
 
-    template <typename T>
-    explicit constexpr MemoryReader(const List<T> &data) noexcept : _readIndex(0)
+    NO_DISCARD constexpr bool IsEOS() const noexcept
     {
-      _buffer.reserve(data.size() * sizeof(T));
-      for (auto &value : data)
-      {
-        auto bytes = Bytes::From<T, Endian::Type::System, Endian::Type::System>(value);
-        _buffer.insert(_buffer.end(), bytes.begin(), bytes.end());
-      }
+      return _position >= _data.size();
     }
 
-    ~MemoryReader() noexcept = default;
-    constexpr MemoryReader(const MemoryReader &) = delete;
-    constexpr MemoryReader &operator=(const MemoryReader &) = delete;
+    NO_DISCARD constexpr size_t GetSize() const noexcept
+    {
+      return _data.size();
+    }
 
-    constexpr MemoryReader(MemoryReader &&other) noexcept
-        : _buffer(std::move(other._buffer)), _readIndex(other._readIndex)
+    NO_DISCARD constexpr size_t GetPosition() const noexcept
     {
+      return _position;
     }
 
-    constexpr MemoryReader &operator=(MemoryReader &&other) noexcept
+    NO_DISCARD constexpr size_t GetRemaining() const noexcept
     {
-      if (this != &other)
-      {
-        _buffer = std::move(other._buffer);
-        _readIndex = other._readIndex;
-      }
-      return *this;
+      return _data.size() - _position;
     }
 
-    constexpr void Open() noexcept
+    /// @brief Get the whole buffer.
+    NO_DISCARD constexpr std::span<const byte> GetSpan() const noexcept
     {
+      return _data;
     }
 
-    constexpr void Close() noexcept
+    /// @brief Get the rest of the buffer from the current position.
+    NO_DISCARD constexpr std::span<const byte> GetRemainingSpan() const noexcept
     {
+      return _data.subspan(_position);
     }
 
-    NO_DISCARD constexpr bool IsEOS() const noexcept
+    constexpr void Seek(size_t position) noexcept
     {
-      return _readIndex >= _buffer.size();
+      _position = std::min(position, _data.size());
     }
 
-    NO_DISCARD constexpr uintmax_t GetSize() const noexcept
+    constexpr void Skip(intmax_t offset) noexcept
     {
-      return _buffer.size();
+      if (offset < 0)
+        _position -= std::min(_position, static_cast<size_t>(-offset));
+      else
+        _position += std::min(GetRemaining(), static_cast<size_t>(offset));
     }
 
-    template <IsArithmeticT T>
-    NO_DISCARD constexpr T Read() noexcept
+    constexpr void Reset() noexcept
     {
-      auto bytes = ReadBytes(sizeof(T));
-      return Bytes::AsNumeric<T, TSource, TDestination>(bytes);
+      _position = 0;
     }
 
-    template <IsArithmeticT T>
-    NO_DISCARD constexpr List<T> Read(size_t count) noexcept
+    NO_DISCARD constexpr uint8 PeekNextByte() const noexcept
     {
-      auto bytes = ReadBytes(sizeof(T) * count);
-      return Bytes::AsNumericArray<T, TSource, TDestination>(bytes);
+      return IsEOS() ? 0 : std::to_integer<uint8>(_data[_position]);
     }
 
-    NO_DISCARD constexpr List<byte> ReadBytes(size_t count) noexcept
+    constexpr uint8 NextByte() noexcept
     {
-      if (_readIndex + count > _buffer.size())
-        count = _buffer.size() - _readIndex;
+      return IsEOS() ? 0 : std::to_integer<uint8>(_data[_position++]);
+    }
 
-      if (count == 0)
-        return {};
+    /// @brief Read a value stored with `TSource` endianness, converting it to the system's.
+    template <IsArithmeticT T, Endian::Type TSource = Endian::Type::Little>
+    NO_DISCARD T Read() noexcept
+    {
+      if (GetRemaining() < sizeof(T))
+      {
+        _position = _data.size();
+        return T {};
+      }
 
-      List<byte> result(count);
-      std::copy(_buffer.data() + _readIndex, _buffer.data() + _readIndex + count, result.begin());
-      _readIndex += count;
+      const T value = Bytes::AsNumeric<T, TSource, Endian::Type::System>(_data.data() + _position);
+      _position += sizeof(T);
+      return value;
+    }
 
+    /// @brief Fill `values` with values stored with `TSource` endianness, converting them to the system's.
+    template <IsArithmeticT T, Endian::Type TSource = Endian::Type::Little>
+    void Read(std::span<T> values) noexcept
+    {
+      ReadBytes(reinterpret_cast<byte *>(values.data()), values.size_bytes());
+      Endian::ConvertArray<T, TSource, Endian::Type::System>(values);
+    }
+
+    /// @brief Read `count` values stored with `TSource` endianness, converting them to the system's.
+    template <IsArithmeticT T, Endian::Type TSource = Endian::Type::Little>
+    NO_DISCARD List<T> Read(size_t count) noexcept
+    {
+      List<T> values(count);
+      Read<T, TSource>(std::span<T>(values));
+      return values;
+    }
+
+    /// @brief Get a view of the next `count` bytes and move past them. The view is shorter than `count` if
+    /// the end of the buffer is reached first.
+    NO_DISCARD constexpr std::span<const byte> ReadSpan(size_t count) noexcept
+    {
+      count = std::min(count, GetRemaining());
+      const std::span<const byte> result = _data.subspan(_position, count);
+      _position += count;
       return result;
     }
 
-    template <IsArithmeticT T>
-    constexpr void Skip(size_t count) noexcept
+    /// @brief Copy the next `size` bytes into `data`. Anything past the end of the buffer is zeroed.
+    void ReadBytes(byte *data, size_t size) noexcept
     {
-      _readIndex += sizeof(T) * count;
+      const auto bytes = ReadSpan(size);
+      if (!bytes.empty())
+        std::memcpy(data, bytes.data(), bytes.size());
+      if (size > bytes.size())
+        std::memset(data + bytes.size(), 0, size - bytes.size());
     }
 
-    constexpr void Reset() noexcept
+    /// @brief Get a view of the text up to the next '\n', and move past it. The '\n' isn't included.
+    NO_DISCARD stringview ReadLine() noexcept
+    {
+      const auto rest = GetRemainingSpan();
+      const stringview text(reinterpret_cast<const char *>(rest.data()), rest.size());
+      const size_t end = std::min(text.find('\n'), text.size());
+      _position += std::min(end + 1, text.size());
+      return text.substr(0, end);
+    }
+
+    void SkipLine() noexcept
     {
-      _readIndex = 0;
+      (void)ReadLine();
     }
 
   private:
-    List<byte> _buffer;
-    size_t _readIndex;
+    std::span<const byte> _data;
+    size_t _position {0};
   };
-}
\ No newline at end of file
+}
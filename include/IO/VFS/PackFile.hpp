@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Macros.hpp"
+#include "Base/Pointers.hpp"
+#include "Base/Types.hpp"
+#include "IO/VFS/VirtualFile.hpp"
+
+#include <span>
+
+namespace Krys::IO
+{
+  enum class PackCompression : uint8
+  {
+    None = 0,
+    LZ4 = 1
+  };
+
+  struct PackEntry
+  {
+    /// @brief `HashBytes` of the entry's name.
+    uint64 Hash;
+
+    /// @brief Offset of the stored contents from the start of the pack.
+    uint64 Offset;
+
+    /// @brief Size of the stored contents, which is `OriginalSize` unless they're compressed.
+    uint64 Size;
+    uint64 OriginalSize;
+
+    /// @brief Location of the name in the pack's name table.
+    uint32 NameOffset;
+    uint16 NameLength;
+
+    PackCompression Compression;
+  };
+
+  /// @brief A file to add to a pack.
+  struct PackSource
+  {
+    /// @brief The name the file is found by, relative to where the pack is mounted and separated by '/'.
+    string Name;
+
+    /// @brief Where the file is read from when the pack is written.
+    string Path;
+
+    /// @brief Whether to try compressing the file. Files that are used in place, like cooked textures and
+    /// models, should be stored as they are.
+    bool Compress {true};
+  };
+
+  /// @brief A single file holding many others, so they can be opened without going to the file system.
+  /// @details A small header is followed by the entry table, sorted by the hash of each entry's name, then
+  /// the names and finally the contents. Finding an entry is a binary search over the table. The whole pack
+  /// is mapped when it's opened: entries stored as they are start on an `EntryAlignment` boundary and are
+  /// used straight from the mapping, while compressed entries are decompressed into memory when they're
+  /// read. Entries are only kept compressed when that makes them noticeably smaller.
+  class PackFile
+  {
+  public:
+    NO_COPY_MOVE(PackFile)
+
+    static constexpr stringview Extension = ".kpak";
+
+    /// @brief Alignment of entries that are stored as they are, which covers every cooked format.
+    static constexpr uint64 EntryAlignment = 64;
+
+    PackFile() noexcept = default;
+    ~PackFile() noexcept = default;
+
+    /// @brief Constructs a `PackFile` and opens `path`. Check `IsOpen` for the result.
+    explicit PackFile(const stringview &path) noexcept
+    {
+      Open(path);
+    }
+
+    /// @brief Map the pack at `path` and validate its entry table.
+    bool Open(const stringview &path) noexcept;
+
+    NO_DISCARD bool IsOpen() const noexcept
+    {
+      return _file != nullptr;
+    }
+
+    /// @brief Find an entry by name, e.g. "shaders/phong.vert".
+    /// @returns nullptr if there's no such entry.
+    NO_DISCARD const PackEntry *Find(stringview name) const noexcept;
+
+    /// @brief Read the contents of `entry`, which must be one of this pack's.
+    /// @returns A file that isn't open if a compressed entry turns out to be corrupt.
+    NO_DISCARD VirtualFile Read(const PackEntry &entry) const noexcept;
+
+    NO_DISCARD stringview GetName(const PackEntry &entry) const noexcept;
+
+    NO_DISCARD std::span<const PackEntry> GetEntries() const noexcept
+    {
+      return _entries;
+    }
+
+    /// @brief Write a pack holding `sources` to `path`.
+    /// @return True if the write was successful.
+    static bool Save(const string &path, const List<PackSource> &sources) noexcept;
+
+  private:
+    Ref<const MappedFile> _file;
+    List<PackEntry> _entries;
+    stringview _names;
+  };
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Macros.hpp"
+#include "Base/Types.hpp"
+#include "IO/VFS/VirtualFile.hpp"
+
+namespace Krys::IO
+{
+  /// @brief The files the engine loads its assets from, gathered from directories and packs.
+  /// @details Directories and packs are mounted at a point in the virtual tree, and paths are looked up in
+  /// the most recently mounted first. That way a directory mounted after a pack overrides what's in it,
+  /// e.g. to iterate on a shader without rebuilding the pack. Paths no mount has are opened from the working
+  /// directory as they are, so nothing needs mounting to work with loose files. Mounting and opening are
+  /// safe from any thread.
+  class VFS
+  {
+  public:
+    STATIC_CLASS(VFS)
+
+    /// @brief Mount the directory or pack at `path`, so its files are found under `mountPoint`.
+    /// @param mountPoint A directory in the virtual tree, e.g. "shaders", or empty for the root.
+    /// @returns False if `path` is neither a directory nor a valid pack.
+    static bool Mount(const stringview &path, const stringview &mountPoint = "") noexcept;
+
+    /// @brief Unmount everything mounted from `path`. Files already opened from it stay valid.
+    /// @returns False if nothing was mounted from `path`.
+    static bool Unmount(const stringview &path) noexcept;
+
+    static void UnmountAll() noexcept;
+
+    /// @brief Open the file at `path`.
+    /// @returns A file that isn't open if it can't be found.
+    NO_DISCARD static VirtualFile Open(const stringview &path) noexcept;
+
+    NO_DISCARD static bool Exists(const stringview &path) noexcept;
+
+    /// @brief Turn `path` into the form files are found by: separated by '/', without a leading "./" and
+    /// without repeated separators.
+    NO_DISCARD static string NormalisePath(const stringview &path) noexcept;
+  };
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Macros.hpp"
+#include "Base/Pointers.hpp"
+#include "Base/Types.hpp"
+#include "IO/Readers/MappedFile.hpp"
+
+#include <span>
+#include <utility>
+
+namespace Krys::IO
+{
+  /// @brief Read-only contents of a file opened through the `VFS`.
+  /// @details Depending on where the file was found, the contents are a mapping of a loose file, a range of
+  /// a mapped pack or an entry decompressed into memory. They stay valid as long as the `VirtualFile`,
+  /// even if what it came from is unmounted in the meantime.
+  class VirtualFile
+  {
+  public:
+    NO_COPY(VirtualFile)
+
+    VirtualFile() noexcept = default;
+    ~VirtualFile() noexcept = default;
+
+    /// @brief A loose file.
+    explicit VirtualFile(MappedFile &&file) noexcept
+        : _file(std::move(file)), _data(_file.GetSpan()), _isOpen(_file.IsOpen())
+    {
+    }
+
+    /// @brief A range of a mapped pack, which is kept open for as long as the range is used.
+    VirtualFile(Ref<const MappedFile> pack, std::span<const byte> data) noexcept
+        : _pack(std::move(pack)), _data(data), _isOpen(true)
+    {
+    }
+
+    /// @brief Contents that were decompressed into memory.
+    explicit VirtualFile(List<byte> &&buffer) noexcept
+        : _buffer(std::move(buffer)), _data(_buffer), _isOpen(true)
+    {
+    }
+
+    VirtualFile(VirtualFile &&other) noexcept
+        : _file(std::move(other._file)), _pack(std::move(other._pack)), _buffer(std::move(other._buffer)),
+          _data(std::exchange(other._data, {})), _isOpen(std::exchange(other._isOpen, false))
+    {
+    }
+
+    VirtualFile &operator=(VirtualFile &&other) noexcept
+    {
+      if (this != &other)
+      {
+        _file = std::move(other._file);
+        _pack = std::move(other._pack);
+        _buffer = std::move(other._buffer);
+        _data = std::exchange(other._data, {});
+        _isOpen = std::exchange(other._isOpen, false);
+      }
+      return *this;
+    }
+
+    NO_DISCARD bool IsOpen() const noexcept
+    {
+      return _isOpen;
+    }
+
+    NO_DISCARD const byte *GetData() const noexcept
+    {
+      return _data.data();
+    }
+
+    NO_DISCARD size_t GetSize() const noexcept
+    {
+      return _data.size();
+    }
+
+    NO_DISCARD std::span<const byte> GetSpan() const noexcept
+    {
+      return _data;
+    }
+
+    /// @brief Get the contents as text. Line endings are left as they are in the file.
+    NO_DISCARD stringview GetText() const noexcept
+    {
+      return {reinterpret_cast<const char *>(_data.data()), _data.size()};
+    }
+
+  private:
+    MappedFile _file;
+    Ref<const MappedFile> _pack;
+    List<byte> _buffer;
+
+    /// @brief Points into whichever of the above holds the contents. Moving them doesn't move the contents,
+    /// so this stays valid when the file is moved.
+    std::span<const byte> _data;
+    bool _isOpen {false};
+  };
+}
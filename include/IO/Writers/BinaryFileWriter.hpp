@@ -4,13 +4,11 @@
 #include "Base/Concepts.hpp"
 #include "Base/Endian.hpp"
 #include "Base/Macros.hpp"
+#include "Base/Pointers.hpp"
 #include "Base/Types.hpp"
 #include "Debug/Macros.hpp"
 #include "IO/IO.hpp"
-
-#include <bit>
-#include <fstream>
-#include <iostream>
+#include "IO/Writers/BufferedWriter.hpp"
 
 namespace Krys::IO
 {
@@ -31,37 +29,34 @@ namespace Krys::IO
     {
       KRYS_ASSERT(!_path.empty(), "No path has been provided.");
 
-      if (!_stream.is_open())
-        _stream.open(_path.c_str(), std::ios::out | std::ios::binary);
+      if (!_writer)
+        _writer = CreateUnique<BufferedWriter>(_path);
 
-      KRYS_ASSERT(_stream.is_open(), "Unable to open '{0}'.", _path);
+      KRYS_ASSERT(_writer->IsOpen(), "Unable to open '{0}'.", _path);
     }
 
     void Close() noexcept
     {
-      if (_stream.is_open())
-        _stream.close();
+      _writer.reset();
     }
 
     template <IsArithmeticT T>
     void Write(T value) noexcept
     {
-      KRYS_ASSERT(_stream.is_open(), "Stream was not opened before writing");
-      value = Endian::Convert<T, TSource, TDestination>(value);
-      auto bytes = std::bit_cast<Array<char, sizeof(T)>>(value);
-      _stream.write(bytes.data(), bytes.size());
+      KRYS_ASSERT(_writer, "Stream was not opened before writing");
+      _writer->Write<T, Endian::Type::System>(Endian::Convert<T, TSource, TDestination>(value));
     }
 
     void Write(const string &value) noexcept
     {
-      KRYS_ASSERT(_stream.is_open(), "Stream was not opened before writing");
-      _stream.write(value.c_str(), value.size());
+      KRYS_ASSERT(_writer, "Stream was not opened before writing");
+      _writer->WriteText(value);
     }
 
     template <typename T>
     void Write(const List<T> &values) noexcept
     {
-      KRYS_ASSERT(_stream.is_open(), "Stream was not opened before writing");
+      KRYS_ASSERT(_writer, "Stream was not opened before writing");
       if constexpr (std::is_same_v<T, byte>)
       {
         WriteBytes(values);
@@ -75,12 +70,12 @@ namespace Krys::IO
 
     void WriteBytes(const List<byte> &bytes) noexcept
     {
-      KRYS_ASSERT(_stream.is_open(), "Stream was not opened before writing");
-      _stream.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+      KRYS_ASSERT(_writer, "Stream was not opened before writing");
+      _writer->WriteBytes(bytes);
     }
 
   private:
     string _path;
-    std::ofstream _stream;
+    Unique<BufferedWriter> _writer;
   };
 }
\ No newline at end of file
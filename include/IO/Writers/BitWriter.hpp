@@ -5,18 +5,22 @@
 #include "Base/Endian.hpp"
 #include "Base/Types.hpp"
 #include "Debug/Macros.hpp"
+#include "IO/Readers/BitReader.hpp"
 
-#include <bitset>
+#include <cstring>
+#include <span>
 
 namespace Krys::IO
 {
+  /// @brief Appends bits to a byte buffer, which must outlive the writer.
+  /// @details Bits are collected in a 64-bit buffer and only written out, as whole bytes at once, when the
+  /// next field wouldn't fit. The last partial byte is padded with zeros by `Flush`, which is also called on
+  /// destruction.
+  template <BitOrder TOrder = BitOrder::MSBFirst>
   class BitWriter
   {
-    static constexpr size_t BitsetSize = 8 * sizeof(byte);
-
   public:
-    BitWriter(List<byte> *buffer) noexcept
-        : _bitset(0), _bitIndex(static_cast<int>(BitsetSize) - 1), _buffer(buffer)
+    explicit BitWriter(List<byte> *buffer) noexcept : _buffer(buffer)
     {
       KRYS_ASSERT(buffer != nullptr, "Buffer cannot be null.");
     }
@@ -26,53 +30,115 @@ namespace Krys::IO
       Flush();
     }
 
-    void Write(bool bit) noexcept
-    {
-      _bitset.set(_bitIndex, bit);
-      if (--_bitIndex < 0)
-        Flush();
-    }
-
-    void Write(IsIntegralT auto value, uint length) noexcept
+    /// @brief Write the low `count` bits of `value`, up to 64.
+    void WriteBits(uint64 value, uint32 count) noexcept
     {
-      KRYS_ASSERT(length <= BitsetSize, "Length must be less than or equal to {0}.", BitsetSize);
-      KRYS_ASSERT(length > 0, "Length must be greater than 0.");
-      KRYS_ASSERT(length <= sizeof(value) * 8, "Length must be less than or equal to {0}.",
-                  sizeof(value) * 8);
+      KRYS_ASSERT(count <= 64, "Can't write more than 64 bits at once");
+      if (count == 0)
+        return;
 
-      for (int i = length - 1; i >= 0; i--)
+      if (count > 56)
       {
-        bool bit = ((value >> i) & 1) != 0;
-        Write(bit);
+        // Split so that each half fits in the bit buffer alongside a partial byte.
+        if constexpr (TOrder == BitOrder::MSBFirst)
+        {
+          WriteBits(value >> 32, count - 32);
+          WriteBits(value, 32);
+        }
+        else
+        {
+          WriteBits(value, 32);
+          WriteBits(value >> 32, count - 32);
+        }
+        return;
       }
+
+      value &= (uint64 {1} << count) - 1;
+      if (_count + count > 64)
+        WriteWholeBytes();
+
+      if constexpr (TOrder == BitOrder::MSBFirst)
+        _bits |= value << (64 - _count - count);
+      else
+        _bits |= value << _count;
+      _count += count;
     }
 
-    void Write(byte value) noexcept
+    void WriteBit(bool bit) noexcept
     {
-      Write(static_cast<uint8>(value), 8);
+      WriteBits(bit ? 1 : 0, 1);
     }
 
-    void Flush() noexcept
+    void WriteBytes(std::span<const byte> bytes) noexcept
     {
-      if (_bitIndex == static_cast<int>(BitsetSize) - 1)
-        return;
+      for (auto value : bytes)
+        WriteBits(std::to_integer<uint64>(value), 8);
+    }
 
-      KRYS_ASSERT(_buffer != nullptr, "Buffer cannot be null.");
-      _buffer->push_back(static_cast<byte>(_bitset.to_ullong()));
+    /// @brief Write `value` as `sizeof(T)` bytes with `TDestination` endianness.
+    template <IsArithmeticT T, Endian::Type TDestination = Endian::Type::Little>
+    void Write(T value) noexcept
+    {
+      value = Endian::Convert<T, Endian::Type::System, TDestination>(value);
+      Array<byte, sizeof(T)> bytes;
+      std::memcpy(bytes.data(), &value, sizeof(T));
+      WriteBytes(bytes);
+    }
 
-      _bitset.reset();
-      _bitIndex = static_cast<int>(BitsetSize) - 1;
+    /// @brief Pad to the next byte with zeros, unless already at one.
+    void AlignToByte() noexcept
+    {
+      if (const uint32 padding = (8 - _count % 8) % 8; padding != 0)
+        WriteBits(0, padding);
     }
 
+    /// @brief Write everything to the buffer, padding the last partial byte with zeros.
+    void Flush() noexcept
+    {
+      AlignToByte();
+      WriteWholeBytes();
+    }
+
+    /// @brief Flush to the current buffer and start appending to `buffer`.
     void SetBuffer(List<byte> *buffer) noexcept
     {
       KRYS_ASSERT(buffer != nullptr, "Buffer cannot be null.");
+      Flush();
       _buffer = buffer;
     }
 
   private:
-    std::bitset<BitsetSize> _bitset;
-    int _bitIndex;
+    /// @brief Move all whole bytes in the bit buffer to the byte buffer.
+    void WriteWholeBytes() noexcept
+    {
+      const uint32 count = _count / 8;
+      if (count == 0)
+        return;
+
+      // The bytes to write are at the start of the bit buffer once it's in stream order.
+      uint64 bits;
+      if constexpr (TOrder == BitOrder::MSBFirst)
+        bits = Endian::Convert<uint64, Endian::Type::System, Endian::Type::Big>(_bits);
+      else
+        bits = Endian::Convert<uint64, Endian::Type::System, Endian::Type::Little>(_bits);
+
+      const size_t offset = _buffer->size();
+      _buffer->resize(offset + count);
+      std::memcpy(_buffer->data() + offset, &bits, count);
+
+      if (count == 8)
+        _bits = 0;
+      else if constexpr (TOrder == BitOrder::MSBFirst)
+        _bits <<= count * 8;
+      else
+        _bits >>= count * 8;
+      _count -= count * 8;
+    }
+
     List<byte> *_buffer;
+
+    /// @brief Pending bits, starting from the top (MSB first) or the bottom (LSB first).
+    uint64 _bits {0};
+    uint32 _count {0};
   };
-}
\ No newline at end of file
+}
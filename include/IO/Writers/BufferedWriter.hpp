@@ -0,0 +1,149 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Concepts.hpp"
+#include "Base/Endian.hpp"
+#include "Base/Macros.hpp"
+#include "Base/Pointers.hpp"
+#include "Base/Types.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <utility>
+
+namespace Krys::IO
+{
+  /// @brief Where a `BufferedWriter` sends its data.
+  class WriteTarget
+  {
+  public:
+    virtual ~WriteTarget() noexcept = default;
+
+    NO_DISCARD virtual bool IsOpen() const noexcept = 0;
+
+    /// @brief Append `size` bytes from `data`.
+    /// @returns False if the bytes couldn't be written.
+    virtual bool Write(const byte *data, size_t size) noexcept = 0;
+  };
+
+  /// @brief Writes to a file through an `std::ofstream`, replacing its contents.
+  class StreamWriteTarget : public WriteTarget
+  {
+  public:
+    explicit StreamWriteTarget(const stringview &path) noexcept;
+
+    NO_DISCARD bool IsOpen() const noexcept override;
+    bool Write(const byte *data, size_t size) noexcept override;
+
+  private:
+    std::ofstream _stream;
+  };
+
+  /// @brief Appends to a buffer owned by someone else, which must outlive the target.
+  class MemoryWriteTarget : public WriteTarget
+  {
+  public:
+    explicit MemoryWriteTarget(List<byte> &buffer) noexcept;
+
+    NO_DISCARD bool IsOpen() const noexcept override;
+    bool Write(const byte *data, size_t size) noexcept override;
+
+  private:
+    List<byte> &_buffer;
+  };
+
+  /// @brief Sequential writer that collects values into a large block and hands it to a `WriteTarget` when
+  /// full, instead of calling into the target per value.
+  /// @details Bulk writes are converted to the destination endianness inside the block, so they never need a
+  /// temporary buffer. Data is only guaranteed to reach the target after `Flush`, which is also called on
+  /// destruction.
+  class BufferedWriter
+  {
+  public:
+    NO_COPY(BufferedWriter)
+
+    static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+    /// @brief Constructs a `BufferedWriter` that replaces the contents of `path`. Check `IsOpen` for the
+    /// result.
+    explicit BufferedWriter(const stringview &path) noexcept;
+
+    /// @brief Constructs a `BufferedWriter` over `target`.
+    /// @param blockSize How much to collect before writing to the target.
+    explicit BufferedWriter(Unique<WriteTarget> target, size_t blockSize = DefaultBlockSize) noexcept;
+
+    BufferedWriter(BufferedWriter &&other) noexcept;
+    BufferedWriter &operator=(BufferedWriter &&other) noexcept;
+
+    ~BufferedWriter() noexcept;
+
+    NO_DISCARD bool IsOpen() const noexcept;
+
+    /// @brief Check if any write to the target has failed.
+    NO_DISCARD bool HasFailed() const noexcept
+    {
+      return _failed;
+    }
+
+    /// @brief Get the number of bytes written so far, including those not flushed yet.
+    NO_DISCARD size_t GetPosition() const noexcept
+    {
+      return _flushed + _used;
+    }
+
+    /// @brief Write `value` with `TDestination` endianness.
+    template <IsArithmeticT T, Endian::Type TDestination = Endian::Type::Little>
+    void Write(T value) noexcept
+    {
+      if (_block.size() - _used < sizeof(T))
+        Flush();
+
+      value = Endian::Convert<T, Endian::Type::System, TDestination>(value);
+      std::memcpy(_block.data() + _used, &value, sizeof(T));
+      _used += sizeof(T);
+    }
+
+    /// @brief Write `values` with `TDestination` endianness.
+    template <IsArithmeticT T, Endian::Type TDestination = Endian::Type::Little>
+    void Write(std::span<const T> values) noexcept
+    {
+      if constexpr (!Endian::NeedsSwap<T, Endian::Type::System, TDestination>())
+        WriteBytes(std::as_bytes(values));
+      else
+      {
+        // Convert straight into the block, a block's worth of values at a time.
+        while (!values.empty())
+        {
+          if (_block.size() - _used < sizeof(T))
+            Flush();
+
+          const size_t count = std::min(values.size(), (_block.size() - _used) / sizeof(T));
+          byte *destination = _block.data() + _used;
+          Endian::ConvertArray<T, Endian::Type::System, TDestination>(values.data(), destination, count);
+          _used += count * sizeof(T);
+          values = values.subspan(count);
+        }
+      }
+    }
+
+    void WriteBytes(std::span<const byte> bytes) noexcept;
+
+    void WriteText(stringview text) noexcept
+    {
+      WriteBytes(std::as_bytes(std::span(text)));
+    }
+
+    /// @brief Send everything written so far to the target.
+    /// @returns False if this or any earlier write to the target failed.
+    bool Flush() noexcept;
+
+  private:
+    Unique<WriteTarget> _target;
+    List<byte> _block;
+    size_t _used {0};
+    size_t _flushed {0};
+    bool _failed {false};
+  };
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Types.hpp"
+
+#include <bit>
+
+namespace Krys::MTL
+{
+  /// @brief Streaming histogram of unsigned integer samples with a bounded relative error, in the style of
+  /// HdrHistogram. Values below `2^SubBucketBits` are recorded exactly; larger values are grouped into
+  /// buckets no wider than `1 / 2^(SubBucketBits - 1)` of their value. Recording is O(1) and memory use is
+  /// fixed, so it can be fed every frame forever.
+  /// @tparam SubBucketBits Controls precision. The default gives percentiles within ~3% of the true value.
+  template <uint32 SubBucketBits = 6>
+  class Histogram
+  {
+    static_assert(SubBucketBits >= 2 && SubBucketBits < 32, "SubBucketBits must be in [2, 32).");
+
+    static constexpr uint64 SubBucketCount = 1ull << SubBucketBits;
+    static constexpr uint64 HalfSubBucketCount = SubBucketCount / 2;
+    static constexpr size_t BucketCount = (64 - SubBucketBits + 2) * HalfSubBucketCount;
+
+  public:
+    constexpr Histogram() noexcept = default;
+
+    constexpr void Add(uint64 value, uint64 count = 1) noexcept
+    {
+      if (count == 0)
+        return;
+
+      _counts[IndexOf(value)] += count;
+      if (_total == 0 || value < _min)
+        _min = value;
+      if (value > _max)
+        _max = value;
+      _total += count;
+      _sum += static_cast<float64>(value) * static_cast<float64>(count);
+    }
+
+    constexpr void Reset() noexcept
+    {
+      _counts = {};
+      _total = _min = _max = 0;
+      _sum = 0.0;
+    }
+
+    /// @brief Get the value at or below which `percentile` percent of the samples fall.
+    /// @param percentile In the range [0, 100].
+    NO_DISCARD constexpr uint64 GetPercentile(float64 percentile) const noexcept
+    {
+      if (_total == 0)
+        return 0;
+      if (percentile <= 0.0)
+        return _min;
+      if (percentile >= 100.0)
+        return _max;
+
+      // Rank of the sample we're looking for, rounded up so p50 of {1, 2} is 1.
+      const float64 exactRank = percentile / 100.0 * static_cast<float64>(_total);
+      uint64 rank = static_cast<uint64>(exactRank);
+      if (static_cast<float64>(rank) < exactRank)
+        rank++;
+      if (rank == 0)
+        rank = 1;
+
+      uint64 seen = 0;
+      for (size_t i = 0; i < BucketCount; i++)
+      {
+        seen += _counts[i];
+        if (seen >= rank)
+        {
+          const uint64 value = HighestEquivalentValue(i);
+          return value < _min ? _min : (value > _max ? _max : value);
+        }
+      }
+      return _max;
+    }
+
+    NO_DISCARD constexpr uint64 GetCount() const noexcept
+    {
+      return _total;
+    }
+
+    NO_DISCARD constexpr uint64 GetMin() const noexcept
+    {
+      return _min;
+    }
+
+    NO_DISCARD constexpr uint64 GetMax() const noexcept
+    {
+      return _max;
+    }
+
+    NO_DISCARD constexpr float64 GetMean() const noexcept
+    {
+      return _total == 0 ? 0.0 : _sum / static_cast<float64>(_total);
+    }
+
+  private:
+    NO_DISCARD static constexpr size_t IndexOf(uint64 value) noexcept
+    {
+      if (value < SubBucketCount)
+        return static_cast<size_t>(value);
+
+      // Shift the value down until it fits in the top half of a sub bucket range, then offset by the number
+      // of half-ranges that came before it.
+      const uint64 shift = static_cast<uint64>(std::bit_width(value)) - SubBucketBits;
+      return static_cast<size_t>(shift * HalfSubBucketCount + (value >> shift));
+    }
+
+    NO_DISCARD static constexpr uint64 HighestEquivalentValue(size_t index) noexcept
+    {
+      if (index < SubBucketCount)
+        return index;
+
+      const uint64 shift = index / HalfSubBucketCount - 1;
+      const uint64 subBucket = index - shift * HalfSubBucketCount;
+      return (subBucket << shift) + ((1ull << shift) - 1);
+    }
+
+    Array<uint64, BucketCount> _counts {};
+    uint64 _total {0};
+    uint64 _min {0};
+    uint64 _max {0};
+    float64 _sum {0.0};
+  };
+}
@@ -5,6 +5,7 @@
 #include "Base/Endian.hpp"
 #include "Base/Macros.hpp"
 #include "Base/Types.hpp"
+#include "Debug/Macros.hpp"
 
 namespace Krys::Bytes
 {
@@ -32,12 +33,9 @@ namespace Krys::Bytes
                 "Unable to convert all bytes to the specified type. Unexpected number of bytes. ");
     size_t elementCount = bytes.size() / sizeof(T);
 
-    List<T> elements;
-    elements.resize(elementCount);
-
-    for (size_t i = 0; i < elementCount; i++)
-      elements[i] = AsNumeric<T, TSource, TDestination>(&bytes[i * sizeof(T)]);
-
+    List<T> elements(elementCount);
+    Endian::ConvertArray<T, TSource, TDestination>(reinterpret_cast<const T *>(bytes.data()), elements.data(),
+                                                   elementCount);
     return elements;
   }
 
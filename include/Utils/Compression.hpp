@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Types.hpp"
+
+#include <span>
+
+namespace Krys
+{
+  /// @brief Upper bound of the size `CompressLZ4` can produce from `size` bytes.
+  NO_DISCARD constexpr size_t GetMaxCompressedSizeLZ4(size_t size) noexcept
+  {
+    return size + size / 255 + 16;
+  }
+
+  /// @brief Compresses `bytes` as a single LZ4 block.
+  /// @details LZ4 trades ratio for speed: decompression runs at several GB/s, so reading a compressed file
+  /// from disk is usually faster than reading it uncompressed. The output is a standard LZ4 block (without
+  /// the frame), so the original size has to be stored alongside it.
+  NO_DISCARD List<byte> CompressLZ4(std::span<const byte> bytes) noexcept;
+
+  /// @brief Decompresses an LZ4 block into `output`, which must be exactly the original size.
+  /// @returns False if the block is corrupt or doesn't decompress to the size of `output`.
+  NO_DISCARD bool DecompressLZ4(std::span<const byte> block, std::span<byte> output) noexcept;
+
+  /// @brief Decompresses a zlib stream (DEFLATE with a zlib header), as used by PNG, into `output`.
+  /// @details Huffman codes are decoded with a table lookup on bits read a word at a time, with a second
+  /// lookup only for the rare codes longer than the first table covers. Corrupt streams are rejected without
+  /// reading or writing outside of either span.
+  /// @returns The number of bytes written, or an error if the stream is corrupt or `output` is too small.
+  NO_DISCARD Expected<size_t> InflateZlib(std::span<const byte> stream, std::span<byte> output) noexcept;
+}
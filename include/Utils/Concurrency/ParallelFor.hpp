@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Base/Types.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace Krys::Concurrency
+{
+  /// @brief Split [0, count) into contiguous ranges and call `function(begin, end)` for each range, one
+  /// thread per range.
+  /// @details The range count is capped by `maxRanges`, the number of hardware threads and `count`. The
+  /// calling thread runs the first range, and everything has finished when this returns. Callers cap
+  /// `maxRanges` by the amount of work so small jobs stay on one thread.
+  template <typename TFunction>
+  void ParallelForRanges(uint32 count, size_t maxRanges, const TFunction &function) noexcept
+  {
+    const uint32 rangeCount = static_cast<uint32>(
+      std::min<size_t>({maxRanges, std::max(1u, std::thread::hardware_concurrency()), count}));
+
+    if (rangeCount <= 1)
+    {
+      function(0u, count);
+      return;
+    }
+
+    const uint32 rangeSize = (count + rangeCount - 1) / rangeCount;
+    List<std::thread> threads;
+    threads.reserve(rangeCount - 1);
+    for (uint32 begin = rangeSize; begin < count; begin += rangeSize)
+      threads.emplace_back(function, begin, std::min(count, begin + rangeSize));
+
+    function(0u, rangeSize);
+    for (auto &thread : threads)
+      thread.join();
+  }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Macros.hpp"
+#include "Base/Types.hpp"
+
+#include <atomic>
+#include <bit>
+#include <new>
+
+namespace Krys::Concurrency
+{
+  /// @brief Bounded, lock-free, single-producer/single-consumer ring buffer.
+  /// @details Slots are written and read in place to avoid copying large elements. The producer calls
+  /// `BeginWrite`/`EndWrite` and the consumer calls `BeginRead`/`EndRead`; no other synchronisation is
+  /// needed as long as each side is only ever used by one thread at a time.
+  /// @tparam T The slot type. Must be default constructible.
+  /// @tparam Capacity The number of slots. Must be a power of two.
+  template <typename T, size_t Capacity>
+  class SPSCQueue
+  {
+    static_assert(std::has_single_bit(Capacity), "Capacity must be a power of two.");
+    static constexpr size_t Mask = Capacity - 1;
+    static constexpr size_t CacheLineSize = 64;
+
+  public:
+    NO_COPY_MOVE(SPSCQueue)
+
+    SPSCQueue() noexcept = default;
+
+    /// @brief Get the next free slot, or `nullptr` if the queue is full. Producer only.
+    NO_DISCARD T *BeginWrite() noexcept
+    {
+      const size_t tail = _tail.load(std::memory_order_relaxed);
+      if (tail - _cachedHead == Capacity)
+      {
+        _cachedHead = _head.load(std::memory_order_acquire);
+        if (tail - _cachedHead == Capacity)
+          return nullptr;
+      }
+      return &_slots[tail & Mask];
+    }
+
+    /// @brief Publish the slot returned by the last call to `BeginWrite`. Producer only.
+    void EndWrite() noexcept
+    {
+      _tail.store(_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /// @brief Get the oldest published slot, or `nullptr` if the queue is empty. Consumer only.
+    NO_DISCARD T *BeginRead() noexcept
+    {
+      const size_t head = _head.load(std::memory_order_relaxed);
+      if (head == _cachedTail)
+      {
+        _cachedTail = _tail.load(std::memory_order_acquire);
+        if (head == _cachedTail)
+          return nullptr;
+      }
+      return &_slots[head & Mask];
+    }
+
+    /// @brief Release the slot returned by the last call to `BeginRead`. Consumer only.
+    void EndRead() noexcept
+    {
+      _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /// @brief Total number of slots ever published. Safe to call from any thread.
+    NO_DISCARD size_t GetWriteCount() const noexcept
+    {
+      return _tail.load(std::memory_order_acquire);
+    }
+
+    /// @brief Total number of slots ever released. Safe to call from any thread.
+    NO_DISCARD size_t GetReadCount() const noexcept
+    {
+      return _head.load(std::memory_order_acquire);
+    }
+
+    NO_DISCARD bool IsEmpty() const noexcept
+    {
+      return GetReadCount() == GetWriteCount();
+    }
+
+    NO_DISCARD static constexpr size_t GetCapacity() noexcept
+    {
+      return Capacity;
+    }
+
+  private:
+    // Producer and consumer indices live on separate cache lines so the two threads don't false-share.
+    alignas(CacheLineSize) std::atomic<size_t> _head {0};
+    size_t _cachedTail {0};
+    alignas(CacheLineSize) std::atomic<size_t> _tail {0};
+    size_t _cachedHead {0};
+    alignas(CacheLineSize) Array<T, Capacity> _slots {};
+  };
+}
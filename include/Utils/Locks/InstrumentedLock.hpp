@@ -0,0 +1,146 @@
+#pragma once
+
+#include "Base/Macros.hpp"
+#include "Base/Types.hpp"
+#include "Core/Platform.hpp"
+#include "Debug/LockProfiler.hpp"
+#include "Utils/Locks/ScopedLock.hpp"
+
+#include <atomic>
+#include <source_location>
+
+namespace Krys::Concurrency
+{
+  /// @brief Wraps a lock and records how long threads wait to acquire it, how long it's held, how often
+  /// acquiring it was contended and which call sites were involved. Stats are aggregated per name in
+  /// `Debug::LockProfiler`.
+  /// @details Measurement only happens when `KRYS_ENABLE_LOCK_PROFILING` is defined, otherwise this simply
+  /// forwards to the wrapped lock. Reader acquisitions of a `ReadersWriterLock` record wait time but not
+  /// hold time, since several readers can hold the lock at once.
+  /// @tparam TLock The lock to wrap, e.g. `SpinLock`, `ReentrantLock` or `ReadersWriterLock`.
+  template <Lockable TLock>
+  class InstrumentedLock
+  {
+  public:
+    NO_COPY_MOVE(InstrumentedLock)
+
+    explicit InstrumentedLock(const string &name) noexcept
+#ifdef KRYS_ENABLE_LOCK_PROFILING
+        : _stats(Debug::LockProfiler::Register(name))
+#endif
+    {
+      (void)name;
+    }
+
+    bool TryAcquire(std::source_location site = std::source_location::current()) noexcept
+    {
+      if (!_lock.TryAcquire())
+        return false;
+
+#ifdef KRYS_ENABLE_LOCK_PROFILING
+      _stats.RecordAcquire(0, false);
+      OnAcquired(site);
+#else
+      (void)site;
+#endif
+      return true;
+    }
+
+    void Acquire(std::source_location site = std::source_location::current()) noexcept
+    {
+#ifdef KRYS_ENABLE_LOCK_PROFILING
+      if (_lock.TryAcquire())
+        _stats.RecordAcquire(0, false);
+      else
+      {
+        const Debug::LockSite holder = GetOwner();
+        const int64 start = Platform::GetTicks();
+        _lock.Acquire();
+        const int64 waitTicks = Platform::GetTicks() - start;
+
+        _stats.RecordAcquire(waitTicks, true);
+        _stats.RecordContention(ToLockSite(site), holder, waitTicks);
+      }
+      OnAcquired(site);
+#else
+      (void)site;
+      _lock.Acquire();
+#endif
+    }
+
+    void AcquireRead(std::source_location site = std::source_location::current()) noexcept
+      REQUIRES(requires(TLock lock) { lock.AcquireRead(); })
+    {
+#ifdef KRYS_ENABLE_LOCK_PROFILING
+      if (_lock.TryAcquireRead())
+        _stats.RecordAcquire(0, false);
+      else
+      {
+        const Debug::LockSite holder = GetOwner();
+        const int64 start = Platform::GetTicks();
+        _lock.AcquireRead();
+        const int64 waitTicks = Platform::GetTicks() - start;
+
+        _stats.RecordAcquire(waitTicks, true);
+        _stats.RecordContention(ToLockSite(site), holder, waitTicks);
+      }
+#else
+      (void)site;
+      _lock.AcquireRead();
+#endif
+    }
+
+    void Release() noexcept
+    {
+#ifdef KRYS_ENABLE_LOCK_PROFILING
+      // Readers never increment the depth, and can't hold the lock at the same time as a writer.
+      if (_depth > 0 && --_depth == 0)
+      {
+        _stats.RecordRelease(Platform::GetTicks() - _acquiredAt);
+        _ownerLine.store(0, std::memory_order_relaxed);
+      }
+#endif
+      _lock.Release();
+    }
+
+  private:
+#ifdef KRYS_ENABLE_LOCK_PROFILING
+    NO_DISCARD static Debug::LockSite ToLockSite(const std::source_location &site) noexcept
+    {
+      return Debug::LockSite {site.file_name(), site.function_name(), site.line()};
+    }
+
+    /// @brief Only called by the thread that holds the lock, so `_depth` and `_acquiredAt` need no
+    /// synchronisation. The owner's call site is read by waiting threads, so it's kept in atomics.
+    void OnAcquired(const std::source_location &site) noexcept
+    {
+      if (_depth++ > 0)
+        return;
+
+      _acquiredAt = Platform::GetTicks();
+      _ownerFile.store(site.file_name(), std::memory_order_relaxed);
+      _ownerFunction.store(site.function_name(), std::memory_order_relaxed);
+      _ownerLine.store(site.line(), std::memory_order_relaxed);
+    }
+
+    /// @brief Best effort snapshot of the call site currently holding the lock, for reporting only.
+    NO_DISCARD Debug::LockSite GetOwner() const noexcept
+    {
+      const uint32 line = _ownerLine.load(std::memory_order_relaxed);
+      if (line == 0)
+        return {};
+      return Debug::LockSite {_ownerFile.load(std::memory_order_relaxed),
+                              _ownerFunction.load(std::memory_order_relaxed), line};
+    }
+
+    Debug::LockStats &_stats;
+    uint32 _depth {0};
+    int64 _acquiredAt {0};
+    std::atomic<const char *> _ownerFile {nullptr};
+    std::atomic<const char *> _ownerFunction {nullptr};
+    std::atomic<uint32> _ownerLine {0};
+#endif
+
+    TLock _lock;
+  };
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <concepts>
+#include <source_location>
 
 namespace Krys::Concurrency
 {
@@ -16,9 +17,14 @@ namespace Krys::Concurrency
     Lockable *_lock;
 
   public:
-    explicit ScopedLock(Lockable &lock) noexcept : _lock(lock)
+    explicit ScopedLock(Lockable &lock, std::source_location site = std::source_location::current()) noexcept
+        : _lock(&lock)
     {
-      _lock->Acquire();
+      // Instrumented locks want to know where they were acquired from.
+      if constexpr (requires { lock.Acquire(site); })
+        _lock->Acquire(site);
+      else
+        _lock->Acquire();
     }
 
     ~ScopedLock() noexcept
@@ -0,0 +1,56 @@
+#include "Base/CPU.hpp"
+
+#if defined(KRYS_COMPILER_VISUAL_STUDIO)
+  #include <immintrin.h>
+  #include <intrin.h>
+#endif
+
+namespace Krys::CPU
+{
+  struct Features
+  {
+    bool SSSE3 {false};
+    bool AVX2 {false};
+  };
+
+  static Features DetectFeatures() noexcept
+  {
+    Features features;
+#if defined(KRYS_COMPILER_VISUAL_STUDIO)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    features.SSSE3 = (info[2] & (1 << 9)) != 0;
+    const bool hasOSXSave = (info[2] & (1 << 27)) != 0;
+
+    if (maxLeaf >= 7 && hasOSXSave && (_xgetbv(0) & 0x6) == 0x6)
+    {
+      __cpuidex(info, 7, 0);
+      features.AVX2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    features.SSSE3 = __builtin_cpu_supports("ssse3");
+    features.AVX2 = __builtin_cpu_supports("avx2");
+#endif
+    return features;
+  }
+
+  static const Features &GetFeatures() noexcept
+  {
+    static const Features s_Features = DetectFeatures();
+    return s_Features;
+  }
+
+  bool HasSSSE3() noexcept
+  {
+    return GetFeatures().SSSE3;
+  }
+
+  bool HasAVX2() noexcept
+  {
+    return GetFeatures().AVX2;
+  }
+}
@@ -0,0 +1,130 @@
+#include "Base/Endian.hpp"
+#include "Base/CPU.hpp"
+#include "Base/Types.hpp"
+
+#include <cstring>
+
+#if defined(KRYS_COMPILER_VISUAL_STUDIO)
+  #include <immintrin.h>
+#else
+  #include <x86intrin.h>
+#endif
+
+namespace Krys::Endian::Impl
+{
+  enum class SwapPath
+  {
+    Scalar,
+    SSSE3,
+    AVX2
+  };
+
+  /// @brief Picks the widest byte shuffle this CPU supports.
+  static SwapPath DetectSwapPath() noexcept
+  {
+    if (CPU::HasAVX2())
+      return SwapPath::AVX2;
+    if (CPU::HasSSSE3())
+      return SwapPath::SSSE3;
+    return SwapPath::Scalar;
+  }
+
+  static const SwapPath s_SwapPath = DetectSwapPath();
+
+  /// @brief Shuffle control that reverses every `TSize` byte group in a 32 byte vector.
+  template <size_t TSize>
+  static constexpr Array<int8, 32> s_ReverseMask = []
+  {
+    Array<int8, 32> mask {};
+    for (size_t i = 0; i < mask.size(); i++)
+      mask[i] = static_cast<int8>((i / TSize) * TSize + (TSize - 1 - i % TSize));
+    return mask;
+  }();
+
+  template <typename T>
+  static void SwapScalar(const byte *source, byte *destination, size_t count) noexcept
+  {
+    for (size_t i = 0; i < count; i++)
+    {
+      T value;
+      std::memcpy(&value, source + i * sizeof(T), sizeof(T));
+      value = std::byteswap(value);
+      std::memcpy(destination + i * sizeof(T), &value, sizeof(T));
+    }
+  }
+
+  template <typename T>
+  KRYS_TARGET("ssse3")
+  static void SwapSSSE3(const byte *source, byte *destination, size_t count) noexcept
+  {
+    const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s_ReverseMask<sizeof(T)>.data()));
+    const size_t size = count * sizeof(T);
+
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+      const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), _mm_shuffle_epi8(value, mask));
+    }
+
+    SwapScalar<T>(source + i, destination + i, (size - i) / sizeof(T));
+  }
+
+  template <typename T>
+  KRYS_TARGET("avx2")
+  static void SwapAVX2(const byte *source, byte *destination, size_t count) noexcept
+  {
+    // The shuffle works within each 16 byte lane, which is fine since no element crosses a lane.
+    const auto *maskData = s_ReverseMask<sizeof(T)>.data();
+    const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(maskData));
+    const size_t size = count * sizeof(T);
+
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64)
+    {
+      const auto *from = reinterpret_cast<const __m256i *>(source + i);
+      auto *to = reinterpret_cast<__m256i *>(destination + i);
+      const __m256i first = _mm256_loadu_si256(from);
+      const __m256i second = _mm256_loadu_si256(from + 1);
+      _mm256_storeu_si256(to, _mm256_shuffle_epi8(first, mask));
+      _mm256_storeu_si256(to + 1, _mm256_shuffle_epi8(second, mask));
+    }
+
+    for (; i + 32 <= size; i += 32)
+    {
+      const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), _mm256_shuffle_epi8(value, mask));
+    }
+
+    SwapScalar<T>(source + i, destination + i, (size - i) / sizeof(T));
+  }
+
+  template <typename T>
+  static void Swap(const void *source, void *destination, size_t count) noexcept
+  {
+    const auto *from = static_cast<const byte *>(source);
+    auto *to = static_cast<byte *>(destination);
+
+    switch (s_SwapPath)
+    {
+      case SwapPath::AVX2:  SwapAVX2<T>(from, to, count); break;
+      case SwapPath::SSSE3: SwapSSSE3<T>(from, to, count); break;
+      default:              SwapScalar<T>(from, to, count); break;
+    }
+  }
+
+  void SwapBytes16(const void *source, void *destination, size_t count) noexcept
+  {
+    Swap<uint16>(source, destination, count);
+  }
+
+  void SwapBytes32(const void *source, void *destination, size_t count) noexcept
+  {
+    Swap<uint32>(source, destination, count);
+  }
+
+  void SwapBytes64(const void *source, void *destination, size_t count) noexcept
+  {
+    Swap<uint64>(source, destination, count);
+  }
+}
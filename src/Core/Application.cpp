@@ -3,8 +3,12 @@
 #include "Core/Platform.hpp"
 #include "Core/Window.hpp"
 #include "Core/WindowManager.hpp"
+#include "Debug/LockProfiler.hpp"
 #include "Debug/Macros.hpp"
 #include "Events/EventManager.hpp"
+#include "Events/EventRecorder.hpp"
+#include "IO/Logger.hpp"
+#include "IO/Input/EventReplayDevice.hpp"
 
 namespace Krys
 {
@@ -30,6 +34,26 @@ namespace Krys
 
   void Application::Run() noexcept
   {
+    const ApplicationSettings &settings = _context->GetSettings();
+    auto eventManager = _context->GetEventManager();
+
+    EventRecorder recorder;
+    if (!settings.EventRecordingPath.empty() && recorder.Start(settings.EventRecordingPath))
+      eventManager->SetRecorder(&recorder);
+    eventManager->SetFixedFrameTime(settings.FixedFrameTimeMs);
+
+    if (!settings.EventReplayPath.empty())
+    {
+      auto replay = CreateUnique<EventReplayDevice>();
+      if (replay->Load(settings.EventReplayPath))
+      {
+        // Live input would make the run differ from the recording, so the replay is the only input.
+        const DeviceId id = SID("event-replay");
+        _context->GetInputManager()->RegisterHID(id, std::move(replay));
+        _context->GetInputManager()->SetExclusiveDevice(id);
+      }
+    }
+
     OnInit();
     {
       _running = true;
@@ -41,14 +65,27 @@ namespace Krys
         // KRYS_SCOPED_PROFILER("Frame");
 
         const int64 startCounter = Platform::GetTicks();
+        int64 phaseStart = startCounter;
+        const auto EndPhase = [&](Debug::FramePhase phase)
+        {
+          const int64 now = Platform::GetTicks();
+          _frameStats.Record(phase, now - phaseStart);
+          phaseStart = now;
+        };
+
+        uint32 fixedSteps = 0;
         auto window = _context->GetWindowManager()->GetCurrentWindow();
         {
           // Poll window events and input devices.
+          eventManager->BeginInput();
           window->Poll();
           _context->GetInputManager()->PollDevices();
+          eventManager->EndInput();
+          EndPhase(Debug::FramePhase::Poll);
 
           // Process events, including those just generated by input devices.
           _context->GetEventManager()->ProcessEvents();
+          EndPhase(Debug::FramePhase::Events);
 
           // Fixed update loop.
           const auto physicsStepMs = 1'000.0f / _context->GetSettings().PhysicsFrameRate;
@@ -56,14 +93,23 @@ namespace Krys
           {
             OnFixedUpdate(physicsStepMs / 1'000.0f);
             accumulatedMs -= physicsStepMs;
+            fixedSteps++;
           }
+          EndPhase(Debug::FramePhase::FixedUpdate);
 
           // Per-frame update and render.
           OnUpdate(static_cast<float>(elapsedMs) / 1'000.0f);
+          EndPhase(Debug::FramePhase::Update);
           OnRender();
+          EndPhase(Debug::FramePhase::Render);
 
           // Swap buffers to display the rendered frame.
           window->SwapBuffers();
+          EndPhase(Debug::FramePhase::Swap);
+
+          // Input-to-present latency, measured from the oldest input handled this frame.
+          if (const auto inputTicks = _context->GetInputManager()->GetOldestInputTimestamp())
+            _frameStats.RecordInputLatency(phaseStart - *inputTicks);
         }
 
         // We'll only manually cap the frame rate if vsync is disabled.
@@ -86,11 +132,35 @@ namespace Krys
         }
 
         // Calculate the elapsed time since the last frame.
-        elapsedMs = Platform::TicksToMilliseconds(Platform::GetTicks() - startCounter);
+        const int64 frameTicks = Platform::GetTicks() - startCounter;
+        elapsedMs = settings.FixedFrameTimeMs > 0.0f ? settings.FixedFrameTimeMs
+                                                     : Platform::TicksToMilliseconds(frameTicks);
         accumulatedMs += elapsedMs;
+
+        _frameStats.EndFrame(frameTicks, fixedSteps);
+
+        KRYS_MEMORY_END_FRAME();
       }
     }
     OnShutdown();
+
+    eventManager->SetRecorder(nullptr);
+    recorder.Stop();
+
+#ifdef KRYS_ENABLE_PERFORMANCE_CHECKS
+    if (const auto &path = settings.FrameStatsPath; !path.empty())
+      _frameStats.WriteToFile(path);
+#endif
+
+#ifdef KRYS_ENABLE_LOCK_PROFILING
+    Debug::LockProfiler::LogReport();
+#endif
+
+    KRYS_MEMORY_REPORT_LEAKS();
+
+    // Nothing is logged from the loop after this, so write what's queued and stop the writer thread now
+    // rather than from a static destructor. Anything logged later, during teardown, is written directly.
+    Logger::Shutdown();
   }
 
 #pragma region Lifecycle Methods
@@ -1,4 +1,7 @@
 #include "Core/ApplicationContext.hpp"
+#include "IO/IO.hpp"
+#include "IO/Logger.hpp"
+#include "IO/VFS/VFS.hpp"
 
 namespace Krys
 {
@@ -6,6 +9,15 @@ namespace Krys
       : _settings(settings), _args(argc)
   {
     std::transform(argv, argv + argc, std::begin(_args), [](const char *arg) -> string { return arg; });
+
+    if (!settings.BinaryLogPath.empty() && !Logger::OpenBinaryLog(settings.BinaryLogPath))
+      Logger::Warn("ApplicationContext: Could not open binary log '{0}', logging as text.",
+                   settings.BinaryLogPath);
+
+    if (!settings.PackPath.empty() && IO::PathExists(settings.PackPath))
+      IO::VFS::Mount(settings.PackPath);
+    if (!settings.DataDirectory.empty())
+      IO::VFS::Mount(settings.DataDirectory);
   }
 
   Ptr<EventManager> ApplicationContext::GetEventManager() const noexcept
@@ -73,6 +85,11 @@ namespace Krys
     return _fontManager.get();
   }
 
+  Ptr<IO::AssetCache> ApplicationContext::GetAssetCache() const noexcept
+  {
+    return _assetCache.get();
+  }
+
   const ApplicationSettings &ApplicationContext::GetSettings() const noexcept
   {
     return _settings;
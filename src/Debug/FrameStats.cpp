@@ -0,0 +1,135 @@
+#include "Debug/FrameStats.hpp"
+#include "Core/Platform.hpp"
+#include "IO/IO.hpp"
+
+#include <format>
+#include <iterator>
+
+namespace Krys::Debug
+{
+  FrameStats::FrameStats() noexcept
+      : _ticksToMicroseconds(1'000'000.0 / static_cast<float64>(Platform::GetTickFrequency()))
+  {
+  }
+
+  void FrameStats::Record(FramePhase phase, int64 ticks) noexcept
+  {
+    _phases[static_cast<size_t>(phase)].Add(ToMicroseconds(ticks));
+  }
+
+  void FrameStats::RecordInputLatency(int64 ticks) noexcept
+  {
+    _inputLatency.Add(ToMicroseconds(ticks));
+  }
+
+  void FrameStats::EndFrame(int64 frameTicks, uint32 fixedSteps) noexcept
+  {
+    const uint64 frameUs = ToMicroseconds(frameTicks);
+    _phases[static_cast<size_t>(FramePhase::Frame)].Add(frameUs);
+
+    if (_hasLastFrame)
+      _jitter.Add(frameUs > _lastFrameUs ? frameUs - _lastFrameUs : _lastFrameUs - frameUs);
+    _lastFrameUs = frameUs;
+    _hasLastFrame = true;
+
+    _fixedSteps[fixedSteps < MaxTrackedFixedSteps ? fixedSteps : MaxTrackedFixedSteps]++;
+    if (fixedSteps > _maxFixedSteps)
+      _maxFixedSteps = fixedSteps;
+  }
+
+  void FrameStats::Reset() noexcept
+  {
+    for (auto &phase : _phases)
+      phase.Reset();
+    _jitter.Reset();
+    _inputLatency.Reset();
+    _fixedSteps = {};
+    _maxFixedSteps = 0;
+    _lastFrameUs = 0;
+    _hasLastFrame = false;
+  }
+
+  TimingSummary FrameStats::GetSummary(FramePhase phase) const noexcept
+  {
+    return Summarise(_phases[static_cast<size_t>(phase)]);
+  }
+
+  TimingSummary FrameStats::GetJitter() const noexcept
+  {
+    return Summarise(_jitter);
+  }
+
+  TimingSummary FrameStats::GetInputLatency() const noexcept
+  {
+    return Summarise(_inputLatency);
+  }
+
+  uint64 FrameStats::GetFramesWithFixedSteps(uint32 steps) const noexcept
+  {
+    return _fixedSteps[steps < MaxTrackedFixedSteps ? steps : MaxTrackedFixedSteps];
+  }
+
+  uint64 FrameStats::GetCatchUpFrames() const noexcept
+  {
+    uint64 frames = 0;
+    for (uint32 steps = 2; steps <= MaxTrackedFixedSteps; steps++)
+      frames += _fixedSteps[steps];
+    return frames;
+  }
+
+  uint32 FrameStats::GetMaxFixedSteps() const noexcept
+  {
+    return _maxFixedSteps;
+  }
+
+  string FrameStats::ToString() const noexcept
+  {
+    string out;
+    auto it = std::back_inserter(out);
+
+    std::format_to(it, "{:<12} {:>8} {:>9} {:>9} {:>9} {:>9} {:>9}\n", "Phase (ms)", "Count", "Mean", "P50",
+                   "P95", "P99", "Max");
+
+    const auto WriteRow = [&](stringview name, const TimingSummary &summary)
+    {
+      std::format_to(it, "{:<12} {:>8} {:>9.3f} {:>9.3f} {:>9.3f} {:>9.3f} {:>9.3f}\n", name, summary.Count,
+                     summary.Mean, summary.P50, summary.P95, summary.P99, summary.Max);
+    };
+
+    for (size_t i = 0; i < _phases.size(); i++)
+      WriteRow(Debug::ToString(static_cast<FramePhase>(i)), Summarise(_phases[i]));
+    WriteRow("Jitter", GetJitter());
+    WriteRow("InputLatency", GetInputLatency());
+
+    std::format_to(it, "\nFixed updates per frame (max {}, {} catch-up frames)\n", _maxFixedSteps,
+                   GetCatchUpFrames());
+    for (uint32 steps = 0; steps <= MaxTrackedFixedSteps; steps++)
+      std::format_to(it, "{:>3}{} {:>8}\n", steps, steps == MaxTrackedFixedSteps ? "+" : " ",
+                     _fixedSteps[steps]);
+
+    return out;
+  }
+
+  bool FrameStats::WriteToFile(const stringview &path) const noexcept
+  {
+    return IO::WriteFileText(path, ToString());
+  }
+
+  uint64 FrameStats::ToMicroseconds(int64 ticks) const noexcept
+  {
+    return ticks <= 0 ? 0 : static_cast<uint64>(static_cast<float64>(ticks) * _ticksToMicroseconds);
+  }
+
+  TimingSummary FrameStats::Summarise(const MTL::Histogram<> &histogram) noexcept
+  {
+    constexpr float64 MicrosecondsToMilliseconds = 1.0 / 1'000.0;
+    return TimingSummary {
+      .P50 = static_cast<float64>(histogram.GetPercentile(50.0)) * MicrosecondsToMilliseconds,
+      .P95 = static_cast<float64>(histogram.GetPercentile(95.0)) * MicrosecondsToMilliseconds,
+      .P99 = static_cast<float64>(histogram.GetPercentile(99.0)) * MicrosecondsToMilliseconds,
+      .Max = static_cast<float64>(histogram.GetMax()) * MicrosecondsToMilliseconds,
+      .Mean = histogram.GetMean() * MicrosecondsToMilliseconds,
+      .Count = histogram.GetCount(),
+    };
+  }
+}
@@ -0,0 +1,148 @@
+#include "Debug/LockProfiler.hpp"
+#include "Base/Pointers.hpp"
+#include "Core/Platform.hpp"
+#include "IO/Logger.hpp"
+
+#include <algorithm>
+#include <format>
+#include <iterator>
+
+namespace Krys::Debug
+{
+  namespace
+  {
+    void UpdateMax(std::atomic<int64> &max, int64 value) noexcept
+    {
+      int64 current = max.load(std::memory_order_relaxed);
+      while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        ;
+    }
+
+    struct LockRegistry
+    {
+      std::mutex Mutex;
+      List<Unique<LockStats>> Locks;
+    };
+
+    LockRegistry &GetRegistry() noexcept
+    {
+      static LockRegistry registry;
+      return registry;
+    }
+
+    string FormatSite(const LockSite &site) noexcept
+    {
+      if (site.File == nullptr)
+        return "<unknown>";
+      return std::format("{}:{} ({})", site.File, site.Line, site.Function);
+    }
+  }
+
+#pragma region LockStats
+
+  void LockStats::RecordAcquire(int64 waitTicks, bool contended) noexcept
+  {
+    _acquisitions.fetch_add(1, std::memory_order_relaxed);
+    if (!contended)
+      return;
+
+    _contentions.fetch_add(1, std::memory_order_relaxed);
+    _totalWaitTicks.fetch_add(waitTicks, std::memory_order_relaxed);
+    UpdateMax(_maxWaitTicks, waitTicks);
+  }
+
+  void LockStats::RecordRelease(int64 holdTicks) noexcept
+  {
+    _totalHoldTicks.fetch_add(holdTicks, std::memory_order_relaxed);
+    UpdateMax(_maxHoldTicks, holdTicks);
+  }
+
+  void LockStats::RecordContention(const LockSite &waiter, const LockSite &holder, int64 waitTicks) noexcept
+  {
+    std::lock_guard<std::mutex> lock(_sitesMutex);
+
+    auto it = std::find_if(_sites.begin(), _sites.end(), [&](const LockContentionSite &site)
+                           { return site.Waiter == waiter && site.Holder == holder; });
+    if (it == _sites.end())
+      it = _sites.insert(_sites.end(), LockContentionSite {.Waiter = waiter, .Holder = holder});
+
+    it->Count++;
+    it->WaitTicks += waitTicks;
+  }
+
+  List<LockContentionSite> LockStats::GetContentionSites() const noexcept
+  {
+    List<LockContentionSite> sites;
+    {
+      std::lock_guard<std::mutex> lock(_sitesMutex);
+      sites = _sites;
+    }
+
+    std::sort(sites.begin(), sites.end(),
+              [](const LockContentionSite &a, const LockContentionSite &b) { return a.WaitTicks > b.WaitTicks; });
+    return sites;
+  }
+
+#pragma endregion LockStats
+
+#pragma region LockProfiler
+
+  LockStats &LockProfiler::Register(const string &name) noexcept
+  {
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+
+    for (auto &stats : registry.Locks)
+      if (stats->GetName() == name)
+        return *stats;
+
+    return *registry.Locks.emplace_back(CreateUnique<LockStats>(name));
+  }
+
+  void LockProfiler::ForEach(const Func<void(const LockStats &)> &func) noexcept
+  {
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+
+    for (const auto &stats : registry.Locks)
+      func(*stats);
+  }
+
+  string LockProfiler::ToString() noexcept
+  {
+    const float64 ticksToMs = 1'000.0 / static_cast<float64>(Platform::GetTickFrequency());
+
+    List<const LockStats *> locks;
+    ForEach([&](const LockStats &stats) { locks.push_back(&stats); });
+    std::sort(locks.begin(), locks.end(), [](const LockStats *a, const LockStats *b)
+              { return a->GetTotalWaitTicks() > b->GetTotalWaitTicks(); });
+
+    string out;
+    auto it = std::back_inserter(out);
+    std::format_to(it, "{:<24} {:>10} {:>10} {:>12} {:>12} {:>12} {:>12}\n", "Lock", "Acquires", "Contended",
+                   "Wait (ms)", "Max wait", "Hold (ms)", "Max hold");
+
+    for (const auto *stats : locks)
+    {
+      std::format_to(it, "{:<24} {:>10} {:>10} {:>12.3f} {:>12.3f} {:>12.3f} {:>12.3f}\n", stats->GetName(),
+                     stats->GetAcquisitions(), stats->GetContentions(),
+                     static_cast<float64>(stats->GetTotalWaitTicks()) * ticksToMs,
+                     static_cast<float64>(stats->GetMaxWaitTicks()) * ticksToMs,
+                     static_cast<float64>(stats->GetTotalHoldTicks()) * ticksToMs,
+                     static_cast<float64>(stats->GetMaxHoldTicks()) * ticksToMs);
+
+      for (const auto &site : stats->GetContentionSites())
+        std::format_to(it, "  {} waits at {} for {}: {:.3f} ms\n", site.Count, FormatSite(site.Waiter),
+                       FormatSite(site.Holder), static_cast<float64>(site.WaitTicks) * ticksToMs);
+    }
+
+    return out;
+  }
+
+  void LockProfiler::LogReport() noexcept
+  {
+    Logger::Info("Lock contention:\n{}", ToString());
+  }
+
+#pragma endregion LockProfiler
+}
@@ -0,0 +1,298 @@
+#include "Debug/MemoryTracker.hpp"
+#include "IO/Logger.hpp"
+
+#include <atomic>
+#include <cstdlib>
+
+namespace Krys::Debug
+{
+  namespace
+  {
+    struct TagCounters
+    {
+      std::atomic<uint64> CurrentBytes {0};
+      std::atomic<uint64> PeakBytes {0};
+      std::atomic<uint64> LiveAllocations {0};
+      std::atomic<uint64> TotalAllocations {0};
+      std::atomic<uint64> FrameAllocations {0};
+      std::atomic<uint64> LastFrameAllocations {0};
+    };
+
+    /// @brief Stored immediately before every allocation made by `MemoryTracker::Allocate`.
+    struct alignas(16) AllocationHeader
+    {
+      uint64 Size;
+
+      /// @brief Distance from the start of the underlying block to the allocation.
+      uint32 Offset;
+
+      MemoryTag Tag;
+    };
+
+    static_assert(sizeof(AllocationHeader) == 16);
+
+    constexpr size_t TagCount = static_cast<size_t>(MemoryTag::Count);
+
+    // Zero-initialised before any dynamic initialisation, so it's safe to use from operator new.
+    Array<TagCounters, TagCount> s_Counters;
+
+    thread_local MemoryTag s_CurrentTag = MemoryTag::General;
+
+    TagCounters &GetCounters(MemoryTag tag) noexcept
+    {
+      return s_Counters[static_cast<size_t>(tag) < TagCount ? static_cast<size_t>(tag) : 0];
+    }
+  }
+
+  void *MemoryTracker::Allocate(size_t bytes, size_t alignment, MemoryTag tag) noexcept
+  {
+    if (alignment < alignof(AllocationHeader))
+      alignment = alignof(AllocationHeader);
+
+    // Over-allocate so the header fits directly before the allocation whatever the alignment.
+    const size_t padding = sizeof(AllocationHeader) + alignment - alignof(AllocationHeader);
+    auto *block = static_cast<byte *>(std::malloc(bytes + padding));
+    if (block == nullptr)
+      return nullptr;
+
+    const uintptr_t start = reinterpret_cast<uintptr_t>(block) + sizeof(AllocationHeader);
+    auto *memory = reinterpret_cast<byte *>((start + alignment - 1) & ~(alignment - 1));
+
+    auto *header = reinterpret_cast<AllocationHeader *>(memory) - 1;
+    header->Size = bytes;
+    header->Offset = static_cast<uint32>(memory - block);
+    header->Tag = tag;
+
+    RecordAllocation(tag, bytes);
+    return memory;
+  }
+
+  void MemoryTracker::Free(void *memory) noexcept
+  {
+    if (memory == nullptr)
+      return;
+
+    const auto *header = static_cast<const AllocationHeader *>(memory) - 1;
+    RecordFree(header->Tag, header->Size);
+    std::free(static_cast<byte *>(memory) - header->Offset);
+  }
+
+  void MemoryTracker::RecordAllocation(MemoryTag tag, size_t bytes) noexcept
+  {
+    auto &counters = GetCounters(tag);
+    const uint64 current = counters.CurrentBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    counters.LiveAllocations.fetch_add(1, std::memory_order_relaxed);
+    counters.TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+    counters.FrameAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    uint64 peak = counters.PeakBytes.load(std::memory_order_relaxed);
+    while (current > peak
+           && !counters.PeakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+      ;
+  }
+
+  void MemoryTracker::RecordFree(MemoryTag tag, size_t bytes) noexcept
+  {
+    auto &counters = GetCounters(tag);
+    counters.CurrentBytes.fetch_sub(bytes, std::memory_order_relaxed);
+    counters.LiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  MemoryStats MemoryTracker::GetStats(MemoryTag tag) noexcept
+  {
+    const auto &counters = GetCounters(tag);
+    return MemoryStats {
+      .CurrentBytes = counters.CurrentBytes.load(std::memory_order_relaxed),
+      .PeakBytes = counters.PeakBytes.load(std::memory_order_relaxed),
+      .LiveAllocations = counters.LiveAllocations.load(std::memory_order_relaxed),
+      .TotalAllocations = counters.TotalAllocations.load(std::memory_order_relaxed),
+      .FrameAllocations = counters.LastFrameAllocations.load(std::memory_order_relaxed),
+    };
+  }
+
+  MemoryStats MemoryTracker::GetTotalStats() noexcept
+  {
+    MemoryStats total {};
+    for (size_t i = 0; i < TagCount; i++)
+    {
+      const auto stats = GetStats(static_cast<MemoryTag>(i));
+      total.CurrentBytes += stats.CurrentBytes;
+      total.PeakBytes += stats.PeakBytes;
+      total.LiveAllocations += stats.LiveAllocations;
+      total.TotalAllocations += stats.TotalAllocations;
+      total.FrameAllocations += stats.FrameAllocations;
+    }
+    return total;
+  }
+
+  MemoryTag MemoryTracker::GetCurrentTag() noexcept
+  {
+    return s_CurrentTag;
+  }
+
+  void MemoryTracker::SetCurrentTag(MemoryTag tag) noexcept
+  {
+    s_CurrentTag = tag;
+  }
+
+  void MemoryTracker::EndFrame() noexcept
+  {
+    for (auto &counters : s_Counters)
+      counters.LastFrameAllocations.store(counters.FrameAllocations.exchange(0, std::memory_order_relaxed),
+                                          std::memory_order_relaxed);
+  }
+
+  void MemoryTracker::LogStats() noexcept
+  {
+    Logger::Info("Memory: {:<10} {:>12} {:>12} {:>10} {:>12} {:>8}", "Tag", "Current", "Peak", "Live", "Total",
+                 "Frame");
+    for (size_t i = 0; i < TagCount; i++)
+    {
+      const auto tag = static_cast<MemoryTag>(i);
+      const auto stats = GetStats(tag);
+      if (stats.TotalAllocations == 0)
+        continue;
+
+      Logger::Info("Memory: {:<10} {:>12} {:>12} {:>10} {:>12} {:>8}", ToString(tag), stats.CurrentBytes,
+                   stats.PeakBytes, stats.LiveAllocations, stats.TotalAllocations, stats.FrameAllocations);
+    }
+  }
+
+  bool MemoryTracker::ReportLeaks() noexcept
+  {
+    bool clean = true;
+    for (size_t i = 0; i < TagCount; i++)
+    {
+      const auto tag = static_cast<MemoryTag>(i);
+      const auto stats = GetStats(tag);
+      if (stats.LiveAllocations == 0)
+        continue;
+
+      clean = false;
+      Logger::Warn("Memory: {} has {} live allocations ({} bytes) at shutdown.", ToString(tag),
+                   stats.LiveAllocations, stats.CurrentBytes);
+    }
+    return clean;
+  }
+}
+
+#ifdef KRYS_ENABLE_MEMORY_TRACKING_NEW
+  #pragma region Global Operator New
+
+using Krys::Debug::MemoryTracker;
+
+static void *TrackedNew(size_t bytes, size_t alignment) noexcept
+{
+  return MemoryTracker::Allocate(bytes == 0 ? 1 : bytes, alignment, MemoryTracker::GetCurrentTag());
+}
+
+static void *TrackedNewOrThrow(size_t bytes, size_t alignment)
+{
+  void *memory = TrackedNew(bytes, alignment);
+  if (memory == nullptr)
+    throw std::bad_alloc();
+  return memory;
+}
+
+void *operator new(size_t bytes)
+{
+  return TrackedNewOrThrow(bytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new[](size_t bytes)
+{
+  return TrackedNewOrThrow(bytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new(size_t bytes, std::align_val_t alignment)
+{
+  return TrackedNewOrThrow(bytes, static_cast<size_t>(alignment));
+}
+
+void *operator new[](size_t bytes, std::align_val_t alignment)
+{
+  return TrackedNewOrThrow(bytes, static_cast<size_t>(alignment));
+}
+
+void *operator new(size_t bytes, const std::nothrow_t &) noexcept
+{
+  return TrackedNew(bytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new[](size_t bytes, const std::nothrow_t &) noexcept
+{
+  return TrackedNew(bytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new(size_t bytes, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+  return TrackedNew(bytes, static_cast<size_t>(alignment));
+}
+
+void *operator new[](size_t bytes, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+  return TrackedNew(bytes, static_cast<size_t>(alignment));
+}
+
+void operator delete(void *memory) noexcept
+{
+  MemoryTracker::Free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+  MemoryTracker::Free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+  MemoryTracker::Free(memory);
+}
+
+void operator delete[](void *memory, size_t) noexcept
+{
+  MemoryTracker::Free(memory);
+}
+
+void operator delete(void *memory, std::align_val_t) noexcept
+{
+  MemoryTracker::Free(memory);
+}
+
+void operator delete[](void *memory, std::align_val_t) noexcept
+{
+  MemoryTracker::Free(memory);
+}
+
+void operator delete(void *memory, size_t, std::align_val_t) noexcept
+{
+  MemoryTracker::Free(memory);
+}
+
+void operator delete[](void *memory, size_t, std::align_val_t) noexcept
+{
+  MemoryTracker::Free(memory);
+}
+
+void operator delete(void *memory, const std::nothrow_t &) noexcept
+{
+  MemoryTracker::Free(memory);
+}
+
+void operator delete[](void *memory, const std::nothrow_t &) noexcept
+{
+  MemoryTracker::Free(memory);
+}
+
+void operator delete(void *memory, std::align_val_t, const std::nothrow_t &) noexcept
+{
+  MemoryTracker::Free(memory);
+}
+
+void operator delete[](void *memory, std::align_val_t, const std::nothrow_t &) noexcept
+{
+  MemoryTracker::Free(memory);
+}
+
+  #pragma endregion Global Operator New
+#endif
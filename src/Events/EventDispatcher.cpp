@@ -2,17 +2,20 @@
 
 namespace Krys
 {
-  void EventDispatcher::Dispatch(const Event &event) const noexcept
+  bool EventDispatcher::Dispatch() noexcept
   {
-    auto it = _handlers.find(event.GetEventType());
-    if (it != _handlers.end())
+    bool dispatched = false;
+
+    // Handlers may register new event types, which can reallocate `_queues`, so don't hold iterators.
+    for (size_t i = 0; i < _queues.size(); i++)
     {
-      for (const auto &func : it->second)
-      {
-        const bool handled = func(event);
-        if (handled)
-          break;
-      }
+      if (!_queues[i] || _queues[i]->IsEmpty())
+        continue;
+
+      _queues[i]->Dispatch();
+      dispatched = true;
     }
+
+    return dispatched;
   }
 }
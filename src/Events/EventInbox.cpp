@@ -0,0 +1,115 @@
+#include "Events/EventInbox.hpp"
+#include "Debug/Macros.hpp"
+
+namespace Krys
+{
+  namespace Impl
+  {
+    byte *EventStagingArena::Allocate(size_t size) noexcept
+    {
+      KRYS_ASSERT(size <= BlockSize, "Allocation is larger than a block");
+
+      if (_blocks.empty())
+        _blocks.push_back(Block {std::make_unique<byte[]>(BlockSize), 0});
+
+      if (_blocks[_current].Used + size > BlockSize)
+      {
+        if (++_current == _blocks.size())
+          _blocks.push_back(Block {std::make_unique<byte[]>(BlockSize), 0});
+      }
+
+      auto &block = _blocks[_current];
+      byte *entry = block.Data.get() + block.Used;
+      block.Used += size;
+      return entry;
+    }
+
+    void EventStagingArena::Drain(EventDispatcher *dispatcher) noexcept
+    {
+      if (_blocks.empty())
+        return;
+
+      for (size_t i = 0; i <= _current; i++)
+      {
+        auto &block = _blocks[i];
+        for (size_t offset = 0; offset < block.Used;)
+        {
+          auto *entry = reinterpret_cast<StagedEvent *>(block.Data.get() + offset);
+          void *event = block.Data.get() + offset + EventOffset;
+
+          if (dispatcher)
+            entry->Deliver(*dispatcher, event);
+          else
+            entry->Destroy(event);
+
+          offset += EventOffset + entry->Size;
+        }
+        block.Used = 0;
+      }
+
+      _current = 0;
+    }
+  }
+
+  namespace
+  {
+    /// @brief The calling thread's producer for every inbox it has posted to. Usually just one.
+    struct ThreadEventProducers
+    {
+      List<std::pair<uint64, Ref<Impl::EventProducer>>> Producers;
+
+      ~ThreadEventProducers() noexcept
+      {
+        for (auto &[_, producer] : Producers)
+          producer->Retired.store(true, std::memory_order_release);
+      }
+    };
+
+    thread_local ThreadEventProducers s_ThreadProducers;
+    std::atomic<uint64> s_NextInboxId {0};
+  }
+
+  EventInbox::EventInbox() noexcept : _id(s_NextInboxId.fetch_add(1, std::memory_order_relaxed))
+  {
+  }
+
+  Impl::EventProducer &EventInbox::GetThreadProducer() noexcept
+  {
+    auto &producers = s_ThreadProducers.Producers;
+    for (auto &[id, producer] : producers)
+      if (id == _id)
+        return *producer;
+
+    auto producer = CreateRef<Impl::EventProducer>();
+    {
+      std::lock_guard<std::mutex> lock(_registryMutex);
+      _producers.push_back(producer);
+    }
+    return *producers.emplace_back(_id, std::move(producer)).second;
+  }
+
+  void EventInbox::Drain(EventDispatcher &dispatcher) noexcept
+  {
+    std::lock_guard<std::mutex> lock(_registryMutex);
+
+    for (auto it = _producers.begin(); it != _producers.end();)
+    {
+      auto &producer = **it;
+
+      uint8 drained;
+      {
+        Concurrency::ScopedLock<Concurrency::SpinLock> producerLock(producer.Lock);
+        drained = producer.Active;
+        producer.Active ^= 1;
+      }
+      producer.Arenas[drained].Drain(&dispatcher);
+
+      // A retired thread can't post again, so once the arena it was writing to is empty it can be dropped.
+      const bool retired = producer.Retired.load(std::memory_order_acquire);
+      if (retired && producer.Arenas[producer.Active].IsEmpty())
+        it = _producers.erase(it);
+      else
+        ++it;
+    }
+  }
+}
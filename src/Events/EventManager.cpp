@@ -1,19 +1,30 @@
 #include "Events/EventManager.hpp"
+#include "Core/Platform.hpp"
 
 namespace Krys
 {
-  void EventManager::Enqueue(Unique<Event> event) noexcept
+  bool EventManager::CancelTimer(TimerId id) noexcept
   {
-    _events.emplace(std::move(event));
+    return _timers.Cancel(id);
   }
 
   void EventManager::ProcessEvents() noexcept
   {
-    while (!_events.empty())
-    {
-      auto event = std::move(_events.front());
-      _events.pop();
-      _dispatcher.Dispatch(*event);
-    }
+    _inbox.Drain(_dispatcher);
+    _timers.Advance(GetTimeMs(), _dispatcher);
+    while (_dispatcher.Dispatch())
+      ;
+    _frame++;
+  }
+
+  uint64 EventManager::GetTimeMs() const noexcept
+  {
+    // Derived from the frame rather than accumulated, so it can't drift.
+    if (_fixedFrameTimeMs > 0.0f)
+      return static_cast<uint64>(static_cast<float64>(_frame) * _fixedFrameTimeMs);
+
+    const int64 ticks = Platform::GetTicks();
+    const int64 frequency = Platform::GetTickFrequency();
+    return static_cast<uint64>((ticks / frequency) * 1'000 + (ticks % frequency) * 1'000 / frequency);
   }
 }
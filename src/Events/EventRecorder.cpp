@@ -0,0 +1,72 @@
+#include "Events/EventRecorder.hpp"
+#include "Core/Platform.hpp"
+#include "IO/Logger.hpp"
+
+namespace Krys
+{
+  namespace
+  {
+    /// @brief Flush to disk once this much has been buffered, rather than on every event.
+    constexpr size_t FlushThreshold = 64 * 1'024;
+  }
+
+  bool EventRecorder::Start(const stringview &path) noexcept
+  {
+    Stop();
+
+    _file.open(string(path), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!_file.is_open())
+    {
+      Logger::Error("Unable to open event recording '{}'", path);
+      return false;
+    }
+
+    _buffer.clear();
+    EventRecordWriter writer(_buffer);
+    writer.WriteBytes(reinterpret_cast<const byte *>(EventRecordingMagic.data()), EventRecordingMagic.size());
+    writer.Write(EventRecordingVersion);
+
+    _lastFrame = 0;
+    _startTicks = Platform::GetTicks();
+    _lastMicroseconds = 0;
+    return true;
+  }
+
+  void EventRecorder::Stop() noexcept
+  {
+    if (!IsRecording())
+      return;
+
+    Flush();
+    _file.close();
+  }
+
+  void EventRecorder::WriteEntry(uint64 frame, EventType type) noexcept
+  {
+    // Timestamps are derived from the start of the recording rather than summed, so rounding doesn't drift.
+    const int64 elapsedTicks = Platform::GetTicks() - _startTicks;
+    const int64 frequency = Platform::GetTickFrequency();
+    const uint64 microseconds = static_cast<uint64>((elapsedTicks / frequency) * 1'000'000 +
+                                                    (elapsedTicks % frequency) * 1'000'000 / frequency);
+
+    EventRecordWriter writer(_buffer);
+    writer.WriteVarint(frame >= _lastFrame ? frame - _lastFrame : 0);
+    writer.WriteVarint(microseconds >= _lastMicroseconds ? microseconds - _lastMicroseconds : 0);
+    writer.Write(static_cast<uint32>(type));
+    writer.WriteVarint(_payload.size());
+    writer.WriteBytes(_payload.data(), _payload.size());
+
+    _lastFrame = frame;
+    _lastMicroseconds = microseconds;
+
+    if (_buffer.size() >= FlushThreshold)
+      Flush();
+  }
+
+  void EventRecorder::Flush() noexcept
+  {
+    _file.write(reinterpret_cast<const char *>(_buffer.data()), static_cast<std::streamsize>(_buffer.size()));
+    _file.flush();
+    _buffer.clear();
+  }
+}
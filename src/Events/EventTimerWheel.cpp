@@ -0,0 +1,83 @@
+#include "Events/EventTimerWheel.hpp"
+
+#include <algorithm>
+
+namespace Krys
+{
+  bool EventTimerWheel::Cancel(TimerId id) noexcept
+  {
+    for (auto &slot : _slots)
+    {
+      auto it = std::find_if(slot.begin(), slot.end(), [id](const Timer &timer) { return timer.Id == id; });
+      if (it == slot.end())
+        continue;
+
+      slot.erase(it);
+      _pendingCount--;
+      return true;
+    }
+
+    return false;
+  }
+
+  void EventTimerWheel::Advance(uint64 nowMs, EventDispatcher &dispatcher) noexcept
+  {
+    if (_started && nowMs <= _currentMs)
+      return;
+
+    // Before the first advance nothing has been visited, so every slot needs checking.
+    const uint64 ticks = _started ? nowMs - _currentMs : SlotCount;
+    const uint64 visits = ticks < SlotCount ? ticks : SlotCount;
+
+    for (uint64 i = 1; i <= visits; i++)
+    {
+      auto &slot = _slots[(_currentMs + i) % SlotCount];
+
+      // Compact the slot in place, so timers that aren't due keep the order they were scheduled in.
+      size_t kept = 0;
+      for (size_t j = 0; j < slot.size(); j++)
+      {
+        auto &timer = slot[j];
+        if (timer.DueMs > nowMs)
+        {
+          if (kept != j)
+            slot[kept] = std::move(timer);
+          kept++;
+          continue;
+        }
+
+        _pendingCount--;
+        if (timer.IntervalMs == 0)
+        {
+          timer.Fire(dispatcher, true);
+          continue;
+        }
+
+        timer.Fire(dispatcher, false);
+        const uint64 intervals = (nowMs - timer.DueMs) / timer.IntervalMs + 1;
+        timer.DueMs += intervals * timer.IntervalMs;
+        _periodic.push_back(std::move(timer));
+      }
+      slot.erase(slot.begin() + static_cast<ptrdiff_t>(kept), slot.end());
+    }
+
+    _currentMs = nowMs;
+    _started = true;
+
+    // Rescheduled after every slot has been visited, so a timer can't fire twice in one advance.
+    for (auto &timer : _periodic)
+      Insert(std::move(timer));
+    _periodic.clear();
+  }
+
+  TimerId EventTimerWheel::Insert(Timer &&timer) noexcept
+  {
+    if (_started && timer.DueMs <= _currentMs)
+      timer.DueMs = _currentMs + 1;
+
+    const TimerId id = timer.Id;
+    _slots[timer.DueMs % SlotCount].push_back(std::move(timer));
+    _pendingCount++;
+    return id;
+  }
+}
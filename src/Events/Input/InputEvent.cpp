@@ -0,0 +1,14 @@
+#include "Events/Input/InputEvent.hpp"
+#include "Core/Platform.hpp"
+
+namespace Krys
+{
+  InputEvent::InputEvent() noexcept : Event(), _timestamp(Platform::GetTicks())
+  {
+  }
+
+  NO_DISCARD int64 InputEvent::GetTimestamp() const noexcept
+  {
+    return _timestamp;
+  }
+}
@@ -3,7 +3,7 @@
 namespace Krys
 {
   KeyboardEvent::KeyboardEvent(const Key key, const KeyState state) noexcept
-      : Event(), _key(key), _state(state)
+      : InputEvent(), _key(key), _state(state)
   {
   }
 
@@ -16,4 +16,17 @@ namespace Krys
   {
     return _state;
   }
-}
+
+  void KeyboardEvent::Serialize(EventRecordWriter &writer) const noexcept
+  {
+    writer.Write(_key);
+    writer.Write(_state);
+  }
+
+  KeyboardEvent KeyboardEvent::Deserialize(EventRecordReader &reader) noexcept
+  {
+    const Key key = reader.Read<Key>();
+    const KeyState state = reader.Read<KeyState>();
+    return KeyboardEvent(key, state);
+  }
+}
\ No newline at end of file
@@ -3,7 +3,7 @@
 namespace Krys
 {
   MouseButtonEvent::MouseButtonEvent(const MouseButton button, const MouseButtonState state) noexcept
-      : Event(), _button(button), _state(state)
+      : InputEvent(), _button(button), _state(state)
   {
   }
 
@@ -26,4 +26,17 @@ namespace Krys
   {
     return _state == MouseButtonState::Released;
   }
-}
+
+  void MouseButtonEvent::Serialize(EventRecordWriter &writer) const noexcept
+  {
+    writer.Write(_button);
+    writer.Write(_state);
+  }
+
+  MouseButtonEvent MouseButtonEvent::Deserialize(EventRecordReader &reader) noexcept
+  {
+    const MouseButton button = reader.Read<MouseButton>();
+    const MouseButtonState state = reader.Read<MouseButtonState>();
+    return MouseButtonEvent(button, state);
+  }
+}
\ No newline at end of file
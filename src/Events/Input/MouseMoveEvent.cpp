@@ -4,7 +4,7 @@ namespace Krys
 {
   MouseMoveEvent::MouseMoveEvent(const float deltaX, const float deltaY, const float clientX,
                                  const float clientY) noexcept
-      : Event(), _deltaX(deltaX), _deltaY(deltaY), _clientX(clientX), _clientY(clientY)
+      : InputEvent(), _deltaX(deltaX), _deltaY(deltaY), _clientX(clientX), _clientY(clientY)
   {
   }
 
@@ -27,4 +27,29 @@ namespace Krys
   {
     return _clientY;
   }
-}
+
+  void MouseMoveEvent::Accumulate(const MouseMoveEvent &next) noexcept
+  {
+    _deltaX += next._deltaX;
+    _deltaY += next._deltaY;
+    _clientX = next._clientX;
+    _clientY = next._clientY;
+  }
+
+  void MouseMoveEvent::Serialize(EventRecordWriter &writer) const noexcept
+  {
+    writer.Write(_deltaX);
+    writer.Write(_deltaY);
+    writer.Write(_clientX);
+    writer.Write(_clientY);
+  }
+
+  MouseMoveEvent MouseMoveEvent::Deserialize(EventRecordReader &reader) noexcept
+  {
+    const float deltaX = reader.Read<float>();
+    const float deltaY = reader.Read<float>();
+    const float clientX = reader.Read<float>();
+    const float clientY = reader.Read<float>();
+    return MouseMoveEvent(deltaX, deltaY, clientX, clientY);
+  }
+}
\ No newline at end of file
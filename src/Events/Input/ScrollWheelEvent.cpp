@@ -2,7 +2,7 @@
 
 namespace Krys
 {
-  ScrollWheelEvent::ScrollWheelEvent(const float delta) noexcept : Event(), _delta(delta)
+  ScrollWheelEvent::ScrollWheelEvent(const float delta) noexcept : InputEvent(), _delta(delta)
   {
   }
 
@@ -10,4 +10,19 @@ namespace Krys
   {
     return _delta;
   }
-}
+
+  void ScrollWheelEvent::Accumulate(const ScrollWheelEvent &next) noexcept
+  {
+    _delta += next._delta;
+  }
+
+  void ScrollWheelEvent::Serialize(EventRecordWriter &writer) const noexcept
+  {
+    writer.Write(_delta);
+  }
+
+  ScrollWheelEvent ScrollWheelEvent::Deserialize(EventRecordReader &reader) noexcept
+  {
+    return ScrollWheelEvent(reader.Read<float>());
+  }
+}
\ No newline at end of file
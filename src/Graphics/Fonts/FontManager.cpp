@@ -1,16 +1,51 @@
 #include "Graphics/Fonts/FontManager.hpp"
 #include "Graphics/Fonts/Font.hpp"
 #include "Graphics/Textures/TextureManager.hpp"
+#include "Debug/Macros.hpp"
 #include <ft2build.h>
 #include FT_FREETYPE_H
+#include FT_MODULE_H
+
+#include <cstring>
 
 namespace Krys::Gfx
 {
   static FT_Library library;
 
+#ifdef KRYS_ENABLE_MEMORY_TRACKING
+  // Route FreeType's allocations (faces, glyph bitmaps etc.) through the memory tracker.
+  static FT_MemoryRec_ s_FreeTypeMemory {
+    .user = nullptr,
+    .alloc = [](FT_Memory, long size) -> void *
+    { return Debug::MemoryTracker::Allocate(static_cast<size_t>(size), alignof(std::max_align_t),
+                                            Debug::MemoryTag::Fonts); },
+    .free = [](FT_Memory, void *block) { Debug::MemoryTracker::Free(block); },
+    .realloc = [](FT_Memory, long currentSize, long newSize, void *block) -> void *
+    {
+      void *resized = Debug::MemoryTracker::Allocate(static_cast<size_t>(newSize), alignof(std::max_align_t),
+                                                     Debug::MemoryTag::Fonts);
+      if (resized != nullptr && block != nullptr)
+      {
+        std::memcpy(resized, block, static_cast<size_t>(currentSize < newSize ? currentSize : newSize));
+        Debug::MemoryTracker::Free(block);
+      }
+      return resized;
+    },
+  };
+#endif
+
   FontManager::FontManager(Ptr<TextureManager> textureManager) noexcept : _textureManager(textureManager)
   {
+#ifdef KRYS_ENABLE_MEMORY_TRACKING
+    auto error = FT_New_Library(&s_FreeTypeMemory, &library);
+    if (error == 0)
+    {
+      FT_Add_Default_Modules(library);
+      FT_Set_Default_Properties(library);
+    }
+#else
     auto error = FT_Init_FreeType(&library);
+#endif
     (void)error;
     KRYS_ASSERT(error == 0, "Failed to initialize FreeType library");
     Logger::Info("FreeType library initialized successfully");
@@ -18,12 +53,17 @@ namespace Krys::Gfx
 
   FontManager::~FontManager() noexcept
   {
+#ifdef KRYS_ENABLE_MEMORY_TRACKING
+    FT_Done_Library(library);
+#else
     FT_Done_FreeType(library);
+#endif
   }
 
   FontHandle FontManager::LoadFont(const string &path, FontSettings settings) noexcept
   {
     KRYS_SCOPED_PROFILER(std::format("FontManager::LoadFont {0}", path));
+    KRYS_MEMORY_SCOPE(Fonts);
     KRYS_ASSERT(!path.empty(), "Font path cannot be empty");
 
     SamplerDescriptor samplerDescriptor;
@@ -71,13 +111,10 @@ namespace Krys::Gfx
         .OffsetY = static_cast<float>(face->glyph->bitmap_top) / settings.Size,
       };
 
+      // The bitmap is uploaded straight from FreeType's memory, which is already tracked as `Fonts`.
       if (size > 0)
-      {
-        List<byte> data(size);
-        memcpy(data.data(), reinterpret_cast<byte *>(face->glyph->bitmap.buffer), size);
-
-        glyph.Texture = _textureManager->CreateTexture(textureDescriptor, data);
-      }
+        glyph.Texture = _textureManager->CreateTexture(
+          textureDescriptor, std::span(reinterpret_cast<const byte *>(face->glyph->bitmap.buffer), size));
 
       font->_glyphs[std::string(1, c)] = glyph;
     }
@@ -2,9 +2,10 @@
 
 namespace Krys::Gfx
 {
-  Mesh::Mesh(MeshHandle handle, const List<vertex_t> &vertices, const List<index_t> &indices,
+  Mesh::Mesh(MeshHandle handle, std::span<const vertex_t> vertices, std::span<const index_t> indices,
              const VertexLayout &layout) noexcept
-      : _handle(handle), _vertices(vertices), _indices(indices), _layout(layout),
+      : _handle(handle), _vertices(vertices.begin(), vertices.end()),
+        _indices(indices.begin(), indices.end()), _layout(layout),
         _count(indices.empty() ? vertices.size() : indices.size())
   {
   }
@@ -14,12 +15,12 @@ namespace Krys::Gfx
     return _handle;
   }
 
-  const List<Mesh::vertex_t> &Mesh::GetVertices() const noexcept
+  const Mesh::vertex_list_t &Mesh::GetVertices() const noexcept
   {
     return _vertices;
   }
 
-  const List<Mesh::index_t> &Mesh::GetIndices() const noexcept
+  const Mesh::index_list_t &Mesh::GetIndices() const noexcept
   {
     return _indices;
   }
@@ -79,6 +79,7 @@ namespace Krys::Gfx
         return it->second;
     }
 
+    KRYS_MEMORY_SCOPE(Meshes);
     auto handle = _meshHandles.Next();
     auto [vertices, indices] = Impl::GetCubeData(colour);
 
@@ -88,9 +89,10 @@ namespace Krys::Gfx
     return handle;
   }
 
-  MeshHandle MeshManager::CreateMesh(const string &name, const List<VertexData> &vertices,
-                                     const List<uint32> &indices, const VertexLayout &layout) noexcept
+  MeshHandle MeshManager::CreateMesh(const string &name, std::span<const VertexData> vertices,
+                                     std::span<const uint32> indices, const VertexLayout &layout) noexcept
   {
+    KRYS_MEMORY_SCOPE(Meshes);
     auto handle = _meshHandles.Next();
     _meshes[handle] = {.Mesh = CreateMeshImpl(handle, vertices, indices, layout), .Id = name};
     return handle;
@@ -0,0 +1,303 @@
+#include "Graphics/Models/KMDL.hpp"
+#include "Debug/Macros.hpp"
+#include "IO/Logger.hpp"
+#include "IO/Readers/MemoryReader.hpp"
+#include "IO/VFS/VFS.hpp"
+#include "IO/Writers/BufferedWriter.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace
+{
+  using namespace Krys;
+  using namespace Krys::Gfx;
+  using namespace Krys::IO;
+
+  constexpr std::array Magic {byte {'K'}, byte {'M'}, byte {'D'}, byte {'L'}};
+  constexpr uint16 Version = 1;
+
+  /// @brief Offset every array is aligned to, relative to the start of the file.
+  constexpr uint64 DataAlignment = 64;
+  static_assert(DataAlignment % alignof(VertexData) == 0);
+
+  /// @brief Smallest possible size of a material and a renderable in the tables, used to reject counts
+  /// that can't fit in the file before allocating for them.
+  constexpr size_t MinMaterialSize = 17 * sizeof(float) + 4 * sizeof(uint32);
+  constexpr size_t MinRenderableSize = sizeof(uint32) + sizeof(int32) + 4 * sizeof(uint64);
+
+  NO_DISCARD static uint64 AlignOffset(uint64 offset) noexcept
+  {
+    return (offset + DataAlignment - 1) / DataAlignment * DataAlignment;
+  }
+
+  NO_DISCARD static Expected<string> ReadString(MemoryReader &reader) noexcept
+  {
+    const uint32 length = reader.Read<uint32>();
+    if (length > reader.GetRemaining())
+      return Unexpected("String is cropped");
+
+    const auto text = reader.ReadSpan(length);
+    return string(reinterpret_cast<const char *>(text.data()), text.size());
+  }
+
+  NO_DISCARD static Colour ReadColour(MemoryReader &reader) noexcept
+  {
+    Colour colour;
+    colour.r = reader.Read<float>();
+    colour.g = reader.Read<float>();
+    colour.b = reader.Read<float>();
+    colour.a = reader.Read<float>();
+    return colour;
+  }
+
+  NO_DISCARD static Expected<void> ReadMaterial(MemoryReader &reader, KMDLMaterial &material) noexcept
+  {
+    material.Ambient = ReadColour(reader);
+    material.Diffuse = ReadColour(reader);
+    material.Specular = ReadColour(reader);
+    material.Emissive = ReadColour(reader);
+    material.Shininess = reader.Read<float>();
+
+    for (string *map :
+         {&material.AmbientMap, &material.DiffuseMap, &material.SpecularMap, &material.EmissiveMap})
+    {
+      auto path = ReadString(reader);
+      if (!path)
+        return Unexpected(path.error());
+      *map = std::move(*path);
+    }
+
+    return {};
+  }
+
+  /// @brief The location of one array relative to the start of the data, as stored in the file.
+  struct ArrayRange
+  {
+    uint64 Offset;
+    uint64 Count;
+  };
+
+  template <typename T>
+  NO_DISCARD static Expected<std::span<const T>> GetArray(std::span<const byte> data,
+                                                          ArrayRange range) noexcept
+  {
+    if (range.Offset % DataAlignment != 0 || range.Offset > data.size()
+        || range.Count > (data.size() - range.Offset) / sizeof(T))
+      return Unexpected("Mesh data is cropped");
+
+    return std::span<const T>(reinterpret_cast<const T *>(data.data() + range.Offset),
+                              static_cast<size_t>(range.Count));
+  }
+
+  NO_DISCARD static Expected<Unique<KMDLModel>> Decode(std::span<const byte> file) noexcept
+  {
+    if (reinterpret_cast<uintptr_t>(file.data()) % alignof(VertexData) != 0)
+      return Unexpected("Data is misaligned");
+
+    MemoryReader reader(file);
+    const auto magic = reader.ReadSpan(Magic.size());
+    if (!std::equal(magic.begin(), magic.end(), Magic.begin(), Magic.end()))
+      return Unexpected("Invalid KMDL header");
+
+    if (reader.Read<uint16>() != Version)
+      return Unexpected("Unsupported KMDL version");
+
+    auto model = CreateUnique<KMDLModel>();
+    model->Flags = static_cast<ModelLoaderFlags>(reader.Read<uint8>());
+    reader.Skip(sizeof(uint8));
+
+    // The vertices are stored as they are in memory, so a change to their layout makes the file unusable.
+    if (reader.Read<uint32>() != sizeof(VertexData))
+      return Unexpected("Vertex layout has changed");
+
+    model->SourceHash = reader.Read<uint64>();
+    const uint32 materialCount = reader.Read<uint32>();
+    const uint32 renderableCount = reader.Read<uint32>();
+    if (materialCount > reader.GetRemaining() / MinMaterialSize
+        || renderableCount > reader.GetRemaining() / MinRenderableSize)
+      return Unexpected("Tables are cropped");
+
+    model->Materials.resize(materialCount);
+    for (auto &material : model->Materials)
+    {
+      if (auto result = ReadMaterial(reader, material); !result)
+        return Unexpected(result.error());
+    }
+
+    List<std::pair<ArrayRange, ArrayRange>> ranges(renderableCount);
+    model->Renderables.resize(renderableCount);
+    for (uint32 i = 0; i < renderableCount; i++)
+    {
+      auto &renderable = model->Renderables[i];
+      auto name = ReadString(reader);
+      if (!name)
+        return Unexpected(name.error());
+
+      renderable.Name = std::move(*name);
+      renderable.Material = reader.Read<int32>();
+      if (renderable.Material < -1 || renderable.Material >= static_cast<int32>(materialCount))
+        return Unexpected("Invalid material index");
+
+      ranges[i].first = {reader.Read<uint64>(), reader.Read<uint64>()};
+      ranges[i].second = {reader.Read<uint64>(), reader.Read<uint64>()};
+    }
+
+    const uint64 dataOffset = AlignOffset(reader.GetPosition());
+    if (dataOffset > file.size())
+      return Unexpected("Tables are cropped");
+
+    const auto data = file.subspan(static_cast<size_t>(dataOffset));
+    for (uint32 i = 0; i < renderableCount; i++)
+    {
+      auto &renderable = model->Renderables[i];
+      const auto vertices = GetArray<VertexData>(data, ranges[i].first);
+      const auto indices = GetArray<uint32>(data, ranges[i].second);
+      if (!vertices)
+        return Unexpected(vertices.error());
+      if (!indices)
+        return Unexpected(indices.error());
+
+      // An index past the end of the vertices would have the GPU read outside the buffer.
+      const size_t vertexCount = vertices->size();
+      if (std::any_of(indices->begin(), indices->end(), [=](uint32 index) { return index >= vertexCount; }))
+        return Unexpected("Index out of range");
+
+      renderable.Vertices = *vertices;
+      renderable.Indices = *indices;
+    }
+
+    return model;
+  }
+
+  static void WriteString(BufferedWriter &writer, stringview text) noexcept
+  {
+    writer.Write(static_cast<uint32>(text.size()));
+    writer.WriteText(text);
+  }
+
+  static void WriteColour(BufferedWriter &writer, const Colour &colour) noexcept
+  {
+    writer.Write(colour.r);
+    writer.Write(colour.g);
+    writer.Write(colour.b);
+    writer.Write(colour.a);
+  }
+
+  static void WritePadding(BufferedWriter &writer, uint64 offset) noexcept
+  {
+    static constexpr std::array<byte, DataAlignment> Zeros {};
+    writer.WriteBytes(std::span(Zeros).first(static_cast<size_t>(AlignOffset(offset) - offset)));
+  }
+
+  static void Encode(BufferedWriter &writer, const KMDLModel &model) noexcept
+  {
+    writer.WriteBytes(Magic);
+    writer.Write(Version);
+    writer.Write(static_cast<uint8>(model.Flags));
+    writer.Write(uint8 {0});
+    writer.Write(static_cast<uint32>(sizeof(VertexData)));
+    writer.Write(model.SourceHash);
+    writer.Write(static_cast<uint32>(model.Materials.size()));
+    writer.Write(static_cast<uint32>(model.Renderables.size()));
+
+    for (const auto &material : model.Materials)
+    {
+      WriteColour(writer, material.Ambient);
+      WriteColour(writer, material.Diffuse);
+      WriteColour(writer, material.Specular);
+      WriteColour(writer, material.Emissive);
+      writer.Write(material.Shininess);
+      WriteString(writer, material.AmbientMap);
+      WriteString(writer, material.DiffuseMap);
+      WriteString(writer, material.SpecularMap);
+      WriteString(writer, material.EmissiveMap);
+    }
+
+    // Array offsets are relative to the start of the data, which follows the tables.
+    uint64 offset = 0;
+    for (const auto &renderable : model.Renderables)
+    {
+      WriteString(writer, renderable.Name);
+      writer.Write(renderable.Material);
+
+      writer.Write(offset);
+      writer.Write(static_cast<uint64>(renderable.Vertices.size()));
+      offset = AlignOffset(offset + renderable.Vertices.size_bytes());
+
+      writer.Write(offset);
+      writer.Write(static_cast<uint64>(renderable.Indices.size()));
+      offset = AlignOffset(offset + renderable.Indices.size_bytes());
+    }
+
+    WritePadding(writer, writer.GetPosition());
+    for (const auto &renderable : model.Renderables)
+    {
+      writer.WriteBytes(std::as_bytes(renderable.Vertices));
+      WritePadding(writer, renderable.Vertices.size_bytes());
+      writer.WriteBytes(std::as_bytes(renderable.Indices));
+      WritePadding(writer, renderable.Indices.size_bytes());
+    }
+  }
+}
+
+namespace Krys::Gfx
+{
+  Unique<KMDLModel> KMDL::Load(const string &path) noexcept
+  {
+    auto file = IO::VFS::Open(path);
+    if (!file.IsOpen())
+    {
+      return nullptr;
+    }
+
+    auto model = Load(file.GetSpan());
+    if (model)
+      model->File = std::move(file);
+
+    return model;
+  }
+
+  Unique<KMDLModel> KMDL::Load(std::span<const byte> data) noexcept
+  {
+    auto model = Decode(data);
+    if (!model)
+    {
+      Logger::Error("KMDL: {0}", model.error());
+      return nullptr;
+    }
+
+    return std::move(*model);
+  }
+
+  bool KMDL::Save(const string &path, const KMDLModel &model) noexcept
+  {
+    KRYS_SCOPED_PROFILER("KMDL::Save");
+
+    IO::BufferedWriter writer(path);
+    if (!writer.IsOpen())
+    {
+      Logger::Error("KMDL: Unable to open '{0}' for writing", path);
+      return false;
+    }
+
+    Encode(writer, model);
+    if (!writer.Flush() || writer.HasFailed())
+    {
+      Logger::Error("KMDL: Failed to write '{0}'", path);
+      return false;
+    }
+
+    return true;
+  }
+
+  bool KMDL::Save(List<byte> &buffer, const KMDLModel &model) noexcept
+  {
+    KRYS_SCOPED_PROFILER("KMDL::Save");
+
+    buffer.clear();
+    IO::BufferedWriter writer(CreateUnique<IO::MemoryWriteTarget>(buffer));
+    Encode(writer, model);
+    return writer.Flush() && !writer.HasFailed();
+  }
+}
@@ -3,11 +3,15 @@
 #include "Graphics/Colours.hpp"
 #include "IO/IO.hpp"
 #include "IO/Logger.hpp"
+#include "IO/Readers/MemoryReader.hpp"
+#include "IO/VFS/VFS.hpp"
 #include "MTL/Vectors/Ext/Geometric.hpp"
 #include "Utils/Hash.hpp"
 
 #include "rapidobj.hpp"
 
+#include <filesystem>
+
 namespace Krys::Gfx
 {
   struct SizeTUint32Hash
@@ -18,9 +22,50 @@ namespace Krys::Gfx
     }
   };
 
+  /// @brief Hash the OBJ file at `path` and the material libraries it uses, which between them decide
+  /// everything a cooked model holds. Textures aren't included, as they're only referenced by path.
+  NO_DISCARD static uint64 HashSource(const stringview &path) noexcept
+  {
+    KRYS_SCOPED_PROFILER("ModelManager::HashSource");
+
+    auto file = IO::VFS::Open(path);
+    if (!file.IsOpen())
+      return 0;
+
+    uint64 hash = HashBytes(file.GetSpan());
+
+    // Libraries are looked up next to the OBJ file, as rapidobj does.
+    const auto directory = std::filesystem::path(path).parent_path();
+    IO::MemoryReader reader(file.GetText());
+    while (!reader.IsEOS())
+    {
+      auto line = reader.ReadLine();
+      if (!line.starts_with("mtllib"))
+        continue;
+
+      line.remove_prefix(std::min(line.find_first_not_of(" \t", 6), line.size()));
+      line.remove_suffix(line.size() - std::min(line.find_last_not_of(" \t\r") + 1, line.size()));
+
+      const auto libraryPath = (directory / line).string();
+      if (line.empty() || !IO::VFS::Exists(libraryPath))
+        continue;
+
+      auto library = IO::VFS::Open(libraryPath);
+      hash = HashBytes(library.GetSpan(), hash);
+    }
+
+    return hash;
+  }
+
+  /// @brief Names the cooked models in the `IO::AssetCache`. Bump the version whenever parsing or the KMDL
+  /// layout changes what a cooked model holds.
+  constexpr stringview CookedModelImporter = "ModelManager";
+  constexpr uint32 CookedModelVersion = 1;
+
   ModelManager::ModelManager(Ptr<MaterialManager> materialManager, Ptr<MeshManager> meshManager,
-                             Ptr<TextureManager> textureManager) noexcept
-      : _materialManager(materialManager), _meshManager(meshManager), _textureManager(textureManager)
+                             Ptr<TextureManager> textureManager, Ptr<IO::AssetCache> assetCache) noexcept
+      : _materialManager(materialManager), _meshManager(meshManager), _textureManager(textureManager),
+        _assetCache(assetCache)
   {
   }
 
@@ -28,61 +73,157 @@ namespace Krys::Gfx
   {
     KRYS_SCOPED_PROFILER(std::format("ModelManager::LoadModel ({0})", path));
 
-    auto result = rapidobj::ParseFile(path);
+    const string cookedPath = string(path) + string(KMDL::Extension);
+    const uint64 hash = HashSource(path);
 
-    if (result.error)
+    // Prefer the cooked model next to the source, or in a mounted pack, whose meshes are uploaded straight
+    // from the mapped file. A cooked model from different source contents or flags is stale. The source is
+    // allowed to be missing, so a build can ship only the cooked models.
+    if (IO::VFS::Exists(cookedPath))
     {
-      return Unexpected<string>(std::format("Failed to parse OBJ file: code: {0}, line: {1}, line_num {2}",
-                                            result.error.code.message(), result.error.line,
-                                            result.error.line_num));
+      auto cooked = KMDL().Load(cookedPath);
+      if (cooked && (hash == 0 || cooked->SourceHash == hash) && cooked->Flags == flags)
+      {
+        Logger::Info("ModelManager: Using cooked model '{0}'.", cookedPath);
+        return CreateModel(path, *cooked);
+      }
     }
 
-    if (!!(flags & ModelLoaderFlags::Triangulate))
+    // Then the one in the asset cache. The OBJ file and its material libraries are keyed by their combined
+    // hash, as that's what the cooked model depends on.
+    Nullable<IO::AssetKey> key;
+    if (_assetCache && hash != 0)
     {
-      rapidobj::Triangulate(result);
-      if (result.error)
+      const auto source = std::as_bytes(std::span(&hash, 1));
+      const auto settings = static_cast<uint8>(flags);
+      key = IO::AssetCache::MakeKey(CookedModelImporter, CookedModelVersion, source,
+                                    std::as_bytes(std::span(&settings, 1)));
+
+      auto file = _assetCache->Load(*key);
+      if (file.IsOpen())
       {
-        return Unexpected<string>(
-          std::format("Failed to triangulate OBJ file: code: {0}, line: {1}, line_num {2}",
-                      result.error.code.message(), result.error.line, result.error.line_num));
+        auto cooked = KMDL().Load(file.GetSpan());
+        if (cooked)
+        {
+          cooked->File = IO::VirtualFile(std::move(file));
+          Logger::Info("ModelManager: Using cooked model for '{0}'.", path);
+          return CreateModel(path, *cooked);
+        }
       }
     }
 
+    auto parsed = ParseModel(path, flags);
+    if (!parsed)
+      return Unexpected(parsed.error());
+
+    auto &model = *parsed.value();
+    model.SourceHash = hash;
+
+    // Kept in the asset cache when there is one, which leaves the source directory alone. Without one it's
+    // written next to the source, which is also how the cooked models a pack ships with are made.
+    if (key)
+    {
+      List<byte> cooked;
+      if (KMDL().Save(cooked, model) && _assetCache->Store(*key, cooked))
+        Logger::Info("ModelManager: Cooked '{0}' to {1:016x}.", path, key->Hash);
+    }
+    else if (!_assetCache && KMDL().Save(cookedPath, model))
+      Logger::Info("ModelManager: Cooked '{0}' to '{1}'.", path, cookedPath);
+
+    return CreateModel(path, model);
+  }
+
+  Model ModelManager::CreateModel(const stringview &path, const KMDLModel &cooked) noexcept
+  {
     Model model;
     model.Name = path;
 
     List<MaterialHandle> materials;
-    for (const auto &mat : result.materials)
+    for (const auto &mat : cooked.Materials)
     {
       PhongMaterialDescriptor descriptor;
-      descriptor.Ambient = Colour {mat.ambient[0], mat.ambient[1], mat.ambient[2]};
-      descriptor.Diffuse = Colour {mat.diffuse[0], mat.diffuse[1], mat.diffuse[2]};
-      descriptor.Specular = Colour {mat.specular[0], mat.specular[1], mat.specular[2]};
-      descriptor.Emissive = Colour {mat.emission[0], mat.emission[1], mat.emission[2]};
+      descriptor.Ambient = mat.Ambient;
+      descriptor.Diffuse = mat.Diffuse;
+      descriptor.Specular = mat.Specular;
+      descriptor.Emissive = mat.Emissive;
 
       // TODO: texture parameters
-      if (!mat.ambient_texname.empty())
-        descriptor.AmbientMap = _textureManager->LoadTexture(mat.ambient_texname);
+      if (!mat.AmbientMap.empty())
+        descriptor.AmbientMap = _textureManager->LoadTexture(mat.AmbientMap);
 
-      if (!mat.diffuse_texname.empty())
-        descriptor.DiffuseMap = _textureManager->LoadTexture(mat.diffuse_texname);
+      if (!mat.DiffuseMap.empty())
+        descriptor.DiffuseMap = _textureManager->LoadTexture(mat.DiffuseMap);
 
-      if (!mat.specular_texname.empty())
-        descriptor.SpecularMap = _textureManager->LoadTexture(mat.specular_texname);
+      if (!mat.SpecularMap.empty())
+        descriptor.SpecularMap = _textureManager->LoadTexture(mat.SpecularMap);
 
-      if (!mat.emissive_texname.empty())
-        descriptor.EmissiveMap = _textureManager->LoadTexture(mat.emissive_texname);
-      descriptor.Shininess = mat.shininess;
+      if (!mat.EmissiveMap.empty())
+        descriptor.EmissiveMap = _textureManager->LoadTexture(mat.EmissiveMap);
+      descriptor.Shininess = mat.Shininess;
 
       auto handle = _materialManager->CreatePhongMaterial(descriptor);
       materials.push_back(handle);
     }
 
+    for (const auto &renderable : cooked.Renderables)
+    {
+      auto material = renderable.Material != -1 ? materials[renderable.Material]
+                                                : _materialManager->GetDefaultPhongMaterial();
+      auto mesh = _meshManager->CreateMesh(renderable.Name, renderable.Vertices, renderable.Indices);
+      model.Renderables.push_back(Renderable {renderable.Name, mesh, material});
+    }
+
+    return model;
+  }
+
+  Expected<Unique<KMDLModel>> ModelManager::ParseModel(const stringview &path,
+                                                       ModelLoaderFlags flags) const noexcept
+  {
+    KRYS_SCOPED_PROFILER(std::format("ModelManager::ParseModel ({0})", path));
+
+    auto result = rapidobj::ParseFile(path);
+
+    if (result.error)
+    {
+      return Unexpected<string>(std::format("Failed to parse OBJ file: code: {0}, line: {1}, line_num {2}",
+                                            result.error.code.message(), result.error.line,
+                                            result.error.line_num));
+    }
+
+    if (!!(flags & ModelLoaderFlags::Triangulate))
+    {
+      rapidobj::Triangulate(result);
+      if (result.error)
+      {
+        return Unexpected<string>(
+          std::format("Failed to triangulate OBJ file: code: {0}, line: {1}, line_num {2}",
+                      result.error.code.message(), result.error.line, result.error.line_num));
+      }
+    }
+
+    auto model = CreateUnique<KMDLModel>();
+    model->Flags = flags;
+
+    for (const auto &mat : result.materials)
+    {
+      KMDLMaterial material;
+      material.Ambient = Colour {mat.ambient[0], mat.ambient[1], mat.ambient[2]};
+      material.Diffuse = Colour {mat.diffuse[0], mat.diffuse[1], mat.diffuse[2]};
+      material.Specular = Colour {mat.specular[0], mat.specular[1], mat.specular[2]};
+      material.Emissive = Colour {mat.emission[0], mat.emission[1], mat.emission[2]};
+      material.Shininess = mat.shininess;
+      material.AmbientMap = mat.ambient_texname;
+      material.DiffuseMap = mat.diffuse_texname;
+      material.SpecularMap = mat.specular_texname;
+      material.EmissiveMap = mat.emissive_texname;
+      model->Materials.push_back(std::move(material));
+    }
+
     const auto &data = result.attributes;
     for (const auto &shape : result.shapes)
     {
       Map<int, List<rapidobj::Index>> indicesByMaterial;
-      indicesByMaterial.reserve(materials.size());
+      indicesByMaterial.reserve(model->Materials.size());
 
       for (size_t i = 0; i < shape.mesh.indices.size(); i++)
       {
@@ -92,9 +233,6 @@ namespace Krys::Gfx
 
       for (const auto &[materialId, modelIndices] : indicesByMaterial)
       {
-        auto material =
-          materialId != -1 ? materials[materialId] : _materialManager->GetDefaultPhongMaterial();
-
         struct VertexRawInfo
         {
           rapidobj::Index index;
@@ -282,12 +420,19 @@ namespace Krys::Gfx
           }
         }
 
-        auto mesh = _meshManager->CreateMesh(shape.name, vertices, indices);
-        model.Renderables.push_back(Renderable {shape.name, mesh, material});
+        model->Renderables.push_back(KMDLRenderable {shape.name, materialId});
+        model->VertexStorage.push_back(std::move(vertices));
+        model->IndexStorage.push_back(std::move(indices));
       }
     }
 
-    return Expected<Model>(model);
+    for (size_t i = 0; i < model->Renderables.size(); i++)
+    {
+      model->Renderables[i].Vertices = model->VertexStorage[i];
+      model->Renderables[i].Indices = model->IndexStorage[i];
+    }
+
+    return model;
   }
 
   Vec3 ModelManager::GenerateNormal(const Vec3 &v0, const Vec3 &v1, const Vec3 &v2) const noexcept
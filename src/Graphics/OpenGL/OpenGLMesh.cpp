@@ -5,8 +5,9 @@
 
 namespace Krys::Gfx::OpenGL
 {
-  OpenGLMesh::OpenGLMesh(MeshHandle handle, const List<vertex_t> &vertices, const List<index_t> &indices,
-                         const VertexLayout &layout, Ptr<OpenGLGraphicsContext> ctx) noexcept
+  OpenGLMesh::OpenGLMesh(MeshHandle handle, std::span<const vertex_t> vertices,
+                         std::span<const index_t> indices, const VertexLayout &layout,
+                         Ptr<OpenGLGraphicsContext> ctx) noexcept
       : Mesh(handle, vertices, indices, layout), _ctx(ctx)
   {
     ::glCreateVertexArrays(1, &_vao);
@@ -15,14 +16,14 @@ namespace Krys::Gfx::OpenGL
     {
       _vbo = _ctx->CreateVertexBuffer(static_cast<uint32>(vertices.size() * sizeof(vertex_t)));
       BufferWriter<VertexBuffer> writer(*_ctx->GetVertexBuffer(_vbo));
-      writer.Write(_vertices);
+      writer.Write(vertices);
     }
 
     if (!indices.empty())
     {
       _ebo = _ctx->CreateIndexBuffer(static_cast<uint32>(indices.size() * sizeof(index_t)));
       BufferWriter<IndexBuffer> writer(*_ctx->GetIndexBuffer(_ebo));
-      writer.Write(_indices);
+      writer.Write(indices);
     }
 
     _ctx->SetupVertexArray(_vbo, _ebo, _layout);
@@ -48,14 +49,14 @@ namespace Krys::Gfx::OpenGL
 
   void OpenGLMesh::SetVertices(const List<vertex_t> &vertices) noexcept
   {
-    _vertices = vertices;
+    _vertices.assign(vertices.begin(), vertices.end());
     BufferWriter<VertexBuffer> writer(*_ctx->GetVertexBuffer(_vbo));
     writer.Write(_vertices);
   }
 
   void OpenGLMesh::SetIndices(const List<index_t> &indices) noexcept
   {
-    _indices = indices;
+    _indices.assign(indices.begin(), indices.end());
     BufferWriter<IndexBuffer> writer(*_ctx->GetIndexBuffer(_ebo));
     writer.Write(_indices);
   }
@@ -9,8 +9,8 @@ namespace Krys::Gfx::OpenGL
   {
   }
 
-  Unique<Mesh> OpenGLMeshManager::CreateMeshImpl(MeshHandle handle, const List<VertexData> &vertices,
-                                                 const List<uint32> &indices,
+  Unique<Mesh> OpenGLMeshManager::CreateMeshImpl(MeshHandle handle, std::span<const VertexData> vertices,
+                                                 std::span<const uint32> indices,
                                                  const VertexLayout &layout) noexcept
   {
     return CreateUnique<OpenGLMesh>(handle, vertices, indices, layout,
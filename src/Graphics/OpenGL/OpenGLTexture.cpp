@@ -1,12 +1,87 @@
 #include "Graphics/OpenGL/OpenGLTexture.hpp"
 #include "Graphics/OpenGL/OpenGLSampler.hpp"
+#include "Graphics/Textures/BlockCompression.hpp"
 
 namespace Krys::Gfx::OpenGL
 {
+  /// @brief Creates a texture from block compressed data, which includes every mip level, largest first.
+  static void CreateCompressedTexture(GLuint texture, const TextureDescriptor &desc,
+                                      const SamplerDescriptor &sampler, std::span<const byte> data) noexcept
+  {
+    int levels = !sampler.UseMipmaps ? 1 : static_cast<int>(std::log2(std::max(desc.Width, desc.Height))) + 1;
+    GLenum internalFormat = 0;
+    switch (desc.Compression)
+    {
+      case TextureCompression::BC1: internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT; break;
+      case TextureCompression::BC3: internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
+      case TextureCompression::BC4: internalFormat = GL_COMPRESSED_RED_RGTC1; break;
+      case TextureCompression::BC5: internalFormat = GL_COMPRESSED_RG_RGTC2; break;
+      case TextureCompression::BC7: internalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM; break;
+      default:                      KRYS_ASSERT(false, "Unknown enum value: TextureCompression"); break;
+    }
+
+    ::glTextureStorage2D(texture, levels, internalFormat, desc.Width, desc.Height);
+    if (data.empty())
+      return;
+
+    size_t offset = 0;
+    uint32 width = desc.Width, height = desc.Height;
+    for (int level = 0; level < levels; level++)
+    {
+      const size_t size = BlockCompression::GetCompressedSize(desc.Compression, width, height);
+      KRYS_ASSERT(offset + size <= data.size(), "Compressed texture data is missing mip level {0}", level);
+
+      ::glCompressedTextureSubImage2D(texture, level, 0, 0, width, height, internalFormat,
+                                      static_cast<GLsizei>(size), data.data() + offset);
+      offset += size;
+      width = std::max(1u, width / 2);
+      height = std::max(1u, height / 2);
+    }
+  }
+
+  /// @brief Uploads the full size image from `data`, followed by the rest of the mip chain if `data` holds
+  /// it. Otherwise the chain is generated on the GPU.
+  static void UploadPixels(GLuint texture, const TextureDescriptor &desc, int levels, GLenum format,
+                           std::span<const byte> data) noexcept
+  {
+    ::glTextureSubImage2D(texture, 0, 0, 0, desc.Width, desc.Height, format, GL_UNSIGNED_BYTE, data.data());
+    if (levels == 1)
+      return;
+
+    size_t offset = static_cast<size_t>(desc.Width) * desc.Height * desc.Channels;
+    if (data.size() <= offset)
+    {
+      ::glGenerateTextureMipmap(texture);
+      return;
+    }
+
+    // Smaller levels are tightly packed, so their rows aren't necessarily 4 byte aligned.
+    ::glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    uint32 width = desc.Width, height = desc.Height;
+    for (int level = 1; level < levels; level++)
+    {
+      width = std::max(1u, width / 2);
+      height = std::max(1u, height / 2);
+      const size_t size = static_cast<size_t>(width) * height * desc.Channels;
+      KRYS_ASSERT(offset + size <= data.size(), "Texture data is missing mip level {0}", level);
+
+      ::glTextureSubImage2D(texture, level, 0, 0, width, height, format, GL_UNSIGNED_BYTE,
+                            data.data() + offset);
+      offset += size;
+    }
+    ::glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  }
+
   /// @brief Creates an image texture using SRGB color space.
   static void CreateImageTexture(GLuint texture, const TextureDescriptor &desc,
-                                 const SamplerDescriptor &sampler, const List<byte> &data) noexcept
+                                 const SamplerDescriptor &sampler, std::span<const byte> data) noexcept
   {
+    if (desc.Compression != TextureCompression::None)
+    {
+      CreateCompressedTexture(texture, desc, sampler, data);
+      return;
+    }
+
     int levels = !sampler.UseMipmaps ? 1 : static_cast<int>(std::log2(std::max(desc.Width, desc.Height))) + 1;
     // TODO: this should be srgb instead.
     GLenum format = 0;
@@ -35,16 +110,19 @@ namespace Krys::Gfx::OpenGL
       KRYS_ASSERT(false, "Invalid number of channels: {}", desc.Channels);
 
     ::glTextureStorage2D(texture, levels, internalFormat, desc.Width, desc.Height);
-    ::glTextureSubImage2D(texture, 0, 0, 0, desc.Width, desc.Height, format, GL_UNSIGNED_BYTE, data.data());
-
-    if (sampler.UseMipmaps)
-      ::glGenerateTextureMipmap(texture);
+    UploadPixels(texture, desc, levels, format, data);
   }
 
   /// @brief Creates a data texture using RGB color space.
   static void CreateDataTexture(GLuint texture, const TextureDescriptor &desc,
-                                const SamplerDescriptor &sampler, const List<byte> &data) noexcept
+                                const SamplerDescriptor &sampler, std::span<const byte> data) noexcept
   {
+    if (desc.Compression != TextureCompression::None)
+    {
+      CreateCompressedTexture(texture, desc, sampler, data);
+      return;
+    }
+
     int levels = !sampler.UseMipmaps ? 1 : static_cast<int>(std::log2(std::max(desc.Width, desc.Height))) + 1;
     GLenum format = 0;
     GLenum internalFormat = 0;
@@ -72,10 +150,7 @@ namespace Krys::Gfx::OpenGL
       KRYS_ASSERT(false, "Invalid number of channels: {}", desc.Channels);
 
     ::glTextureStorage2D(texture, levels, internalFormat, desc.Width, desc.Height);
-    ::glTextureSubImage2D(texture, 0, 0, 0, desc.Width, desc.Height, format, GL_UNSIGNED_BYTE, data.data());
-
-    if (sampler.UseMipmaps)
-      ::glGenerateTextureMipmap(texture);
+    UploadPixels(texture, desc, levels, format, data);
   }
 
   /// @brief Creates a depth texture.
@@ -103,7 +178,7 @@ namespace Krys::Gfx::OpenGL
   }
 
   static GLint CreateTexture(const TextureDescriptor &descriptor, const SamplerDescriptor &sampler,
-                             const List<byte> &data) noexcept
+                             std::span<const byte> data) noexcept
   {
     GLuint texture;
     ::glCreateTextures(GL_TEXTURE_2D, 1, &texture);
@@ -138,7 +213,7 @@ namespace Krys::Gfx::OpenGL
   }
 
   OpenGLTexture::OpenGLTexture(TextureHandle handle, const TextureDescriptor &descriptor,
-                               OpenGLSampler &sampler, const List<byte> &data) noexcept
+                               OpenGLSampler &sampler, std::span<const byte> data) noexcept
       : Texture(handle, descriptor), _id(CreateTexture(descriptor, sampler.GetDescriptor(), data))
   {
     if (descriptor.IsBindless)
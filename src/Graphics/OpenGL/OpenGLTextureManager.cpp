@@ -13,7 +13,7 @@ namespace Krys::Gfx::OpenGL
 
   Unique<Texture> OpenGLTextureManager::CreateTextureImpl(TextureHandle handle,
                                                           const TextureDescriptor &descriptor,
-                                                          const List<byte> &data) noexcept
+                                                          std::span<const byte> data) noexcept
   {
     KRYS_ASSERT(handle.IsValid(), "Texture handle is not valid");
     KRYS_ASSERT(descriptor.Sampler.IsValid(), "Sampler handle is not valid");
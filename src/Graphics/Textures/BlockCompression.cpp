@@ -0,0 +1,1183 @@
+#include "Graphics/Textures/BlockCompression.hpp"
+#include "Debug/Macros.hpp"
+#include "MTL/SIMD.hpp"
+#include "Utils/Concurrency/ParallelFor.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+namespace
+{
+  using namespace Krys;
+  using namespace Krys::Gfx;
+
+  /// @brief Images are only split across threads when each band has at least this many blocks.
+  constexpr size_t MinBandBlocks = 256;
+
+  /// @brief Which pixels of a block a fit covers, one bit per pixel in row order.
+  constexpr uint32 AllPixels = 0xFFFF;
+
+  /// @brief BC7 mode 1 candidates fitted in full, picked by `EstimatePartitionErrors`. Past 16 the gains
+  /// are a few hundredths of a dB for several times the encoding time.
+  constexpr uint32 BalancedPartitions = 4;
+  constexpr uint32 BestPartitions = 16;
+
+  /// @brief Balanced only tries BC7 mode 1 when mode 6 leaves more squared error than this, an average of
+  /// 1 per pixel. Below it, partitioning rarely helps enough to pay for the search.
+  constexpr float BalancedPartitionThreshold = 16.0f;
+
+  /// @brief A 4x4 block with one row of 16 floats per channel (RGBA), so four pixels fill a register.
+  struct Block
+  {
+    alignas(16) float Channels[4][16];
+  };
+
+  using Vector = Array<float, 4>;
+  using Texel = Array<uint8, 4>;
+  using BlockIndices = Array<uint8, 16>;
+
+  /// @brief The colours a block's indices select from. Only the channels being fitted are filled in.
+  struct Palette
+  {
+    Array<Vector, 16> Colours {};
+    uint32 Size {0};
+  };
+
+  /// @brief Endpoints of the line a block (or subset) is fitted to, before quantisation.
+  struct Line
+  {
+    Vector Start {};
+    Vector End {};
+  };
+
+  struct Statistics
+  {
+    Vector Minimum {}, Maximum {}, Mean {};
+
+    /// @brief Sums of products of the deviations from the mean (i.e. unnormalised covariance).
+    Array<Vector, 4> Scatter {};
+  };
+
+#pragma region SIMD
+
+  NO_DISCARD static simd_float Select(simd_float mask, simd_float a, simd_float b) noexcept
+  {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+  }
+
+  /// @brief A lane mask with lane `i` set if bit `i` of `lanes` is.
+  NO_DISCARD static simd_float GetLaneMask(uint32 lanes) noexcept
+  {
+    return _mm_castsi128_ps(_mm_set_epi32(lanes & 8 ? -1 : 0, lanes & 4 ? -1 : 0, lanes & 2 ? -1 : 0,
+                                          lanes & 1 ? -1 : 0));
+  }
+
+  NO_DISCARD static float HorizontalSum(simd_float v) noexcept
+  {
+    v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    return _mm_cvtss_f32(_mm_add_ss(v, _mm_shuffle_ps(v, v, 1)));
+  }
+
+  NO_DISCARD static float HorizontalMin(simd_float v) noexcept
+  {
+    v = _mm_min_ps(v, _mm_movehl_ps(v, v));
+    return _mm_cvtss_f32(_mm_min_ss(v, _mm_shuffle_ps(v, v, 1)));
+  }
+
+  NO_DISCARD static float HorizontalMax(simd_float v) noexcept
+  {
+    v = _mm_max_ps(v, _mm_movehl_ps(v, v));
+    return _mm_cvtss_f32(_mm_max_ss(v, _mm_shuffle_ps(v, v, 1)));
+  }
+
+#pragma endregion SIMD
+
+#pragma region Fitting
+
+  static void LoadBlock(const byte *pixels, uint32 width, uint32 height, uint32 channels, uint32 blockX,
+                        uint32 blockY, Block &block) noexcept
+  {
+    for (uint32 y = 0; y < 4; y++)
+    {
+      // Blocks hanging off the edge of the image repeat its last row/column.
+      const uint32 row = std::min(blockY * 4 + y, height - 1);
+      for (uint32 x = 0; x < 4; x++)
+      {
+        const uint32 column = std::min(blockX * 4 + x, width - 1);
+        const byte *pixel = pixels + (static_cast<size_t>(row) * width + column) * channels;
+
+        Vector rgba {0.0f, 0.0f, 0.0f, 255.0f};
+        for (uint32 c = 0; c < channels; c++)
+          rgba[c] = static_cast<float>(static_cast<uint8>(pixel[c]));
+        if (channels == 1)
+          rgba[1] = rgba[2] = rgba[0];
+
+        for (uint32 c = 0; c < 4; c++)
+          block.Channels[c][y * 4 + x] = rgba[c];
+      }
+    }
+  }
+
+  /// @brief Bounds, mean and scatter of channels [first, first + count) over the pixels in `mask`.
+  NO_DISCARD static Statistics GetStatistics(const Block &block, uint32 first, uint32 count,
+                                             uint32 mask) noexcept
+  {
+    Statistics statistics;
+    const float pixels = static_cast<float>(std::popcount(mask));
+    const simd_float highest = _mm_set1_ps(std::numeric_limits<float>::max());
+    const simd_float lowest = _mm_set1_ps(std::numeric_limits<float>::lowest());
+
+    for (uint32 c = first; c < first + count; c++)
+    {
+      simd_float sum = _mm_setzero_ps(), minimum = highest, maximum = lowest;
+      for (uint32 group = 0; group < 16; group += 4)
+      {
+        if (const uint32 lanes = (mask >> group) & 0xF; lanes != 0)
+        {
+          const simd_float laneMask = GetLaneMask(lanes);
+          const simd_float values = _mm_load_ps(&block.Channels[c][group]);
+          sum = _mm_add_ps(sum, _mm_and_ps(laneMask, values));
+          minimum = _mm_min_ps(minimum, Select(laneMask, values, highest));
+          maximum = _mm_max_ps(maximum, Select(laneMask, values, lowest));
+        }
+      }
+
+      statistics.Mean[c] = HorizontalSum(sum) / pixels;
+      statistics.Minimum[c] = HorizontalMin(minimum);
+      statistics.Maximum[c] = HorizontalMax(maximum);
+    }
+
+    simd_float products[4][4] {};
+    for (uint32 group = 0; group < 16; group += 4)
+    {
+      const uint32 lanes = (mask >> group) & 0xF;
+      if (lanes == 0)
+        continue;
+
+      const simd_float laneMask = GetLaneMask(lanes);
+      simd_float deviations[4] {};
+      for (uint32 c = first; c < first + count; c++)
+        deviations[c] = _mm_and_ps(
+          laneMask, _mm_sub_ps(_mm_load_ps(&block.Channels[c][group]), _mm_set1_ps(statistics.Mean[c])));
+
+      for (uint32 c = first; c < first + count; c++)
+        for (uint32 d = c; d < first + count; d++)
+          products[c][d] = _mm_add_ps(products[c][d], _mm_mul_ps(deviations[c], deviations[d]));
+    }
+
+    for (uint32 c = first; c < first + count; c++)
+      for (uint32 d = c; d < first + count; d++)
+        statistics.Scatter[c][d] = statistics.Scatter[d][c] = HorizontalSum(products[c][d]);
+
+    return statistics;
+  }
+
+  /// @brief Find the direction the pixels vary along most by power iteration.
+  /// @param variance Receives the scatter along the axis.
+  /// @returns The unit axis, or zero if the pixels are all the same.
+  NO_DISCARD static Vector GetPrincipalAxis(const Statistics &statistics, uint32 first, uint32 count,
+                                            float &variance) noexcept
+  {
+    // Start from the row of the channel that varies most, which is never orthogonal to the answer.
+    uint32 widest = first;
+    for (uint32 c = first; c < first + count; c++)
+      if (statistics.Scatter[c][c] > statistics.Scatter[widest][widest])
+        widest = c;
+
+    Vector axis = statistics.Scatter[widest];
+    variance = 0.0f;
+    for (uint32 iteration = 0; iteration < 8; iteration++)
+    {
+      Vector next {};
+      float largest = 0.0f;
+      for (uint32 c = first; c < first + count; c++)
+      {
+        for (uint32 d = first; d < first + count; d++)
+          next[c] += statistics.Scatter[c][d] * axis[d];
+        largest = std::max(largest, std::abs(next[c]));
+      }
+
+      if (largest <= 0.0f)
+        return {};
+
+      for (uint32 c = first; c < first + count; c++)
+        axis[c] = next[c] / largest;
+    }
+
+    float length = 0.0f;
+    for (uint32 c = first; c < first + count; c++)
+      length += axis[c] * axis[c];
+    length = std::sqrt(length);
+
+    for (uint32 c = first; c < first + count; c++)
+    {
+      axis[c] /= length;
+      for (uint32 d = first; d < first + count; d++)
+        variance += axis[c] * statistics.Scatter[c][d] * axis[d];
+    }
+
+    return axis;
+  }
+
+  /// @brief Endpoints at the corners of the pixels' bounding box, inset slightly, picking the diagonal that
+  /// follows how the channels vary together.
+  NO_DISCARD static Line FitBoundingBox(const Statistics &statistics, uint32 first, uint32 count) noexcept
+  {
+    uint32 widest = first;
+    for (uint32 c = first; c < first + count; c++)
+      if (statistics.Maximum[c] - statistics.Minimum[c] >
+          statistics.Maximum[widest] - statistics.Minimum[widest])
+        widest = c;
+
+    Line line;
+    for (uint32 c = first; c < first + count; c++)
+    {
+      const float inset = (statistics.Maximum[c] - statistics.Minimum[c]) / 16.0f;
+      const float high = statistics.Maximum[c] - inset, low = statistics.Minimum[c] + inset;
+      const bool flip = statistics.Scatter[widest][c] < 0.0f;
+      line.Start[c] = flip ? low : high;
+      line.End[c] = flip ? high : low;
+    }
+
+    return line;
+  }
+
+  /// @brief Endpoints at the extremes of the pixels projected onto their principal axis.
+  NO_DISCARD static Line FitPrincipalAxis(const Block &block, const Statistics &statistics, uint32 first,
+                                          uint32 count, uint32 mask) noexcept
+  {
+    float variance = 0.0f;
+    const Vector axis = GetPrincipalAxis(statistics, first, count, variance);
+    if (variance <= 0.0f)
+      return {statistics.Mean, statistics.Mean};
+
+    const simd_float highest = _mm_set1_ps(std::numeric_limits<float>::max());
+    const simd_float lowest = _mm_set1_ps(std::numeric_limits<float>::lowest());
+    simd_float minimum = highest, maximum = lowest;
+    for (uint32 group = 0; group < 16; group += 4)
+    {
+      const uint32 lanes = (mask >> group) & 0xF;
+      if (lanes == 0)
+        continue;
+
+      simd_float projection = _mm_setzero_ps();
+      for (uint32 c = first; c < first + count; c++)
+      {
+        const simd_float deviation =
+          _mm_sub_ps(_mm_load_ps(&block.Channels[c][group]), _mm_set1_ps(statistics.Mean[c]));
+        projection = _mm_add_ps(projection, _mm_mul_ps(deviation, _mm_set1_ps(axis[c])));
+      }
+
+      const simd_float laneMask = GetLaneMask(lanes);
+      minimum = _mm_min_ps(minimum, Select(laneMask, projection, highest));
+      maximum = _mm_max_ps(maximum, Select(laneMask, projection, lowest));
+    }
+
+    const float low = HorizontalMin(minimum), high = HorizontalMax(maximum);
+    Line line;
+    for (uint32 c = first; c < first + count; c++)
+    {
+      line.Start[c] = std::clamp(statistics.Mean[c] + axis[c] * high, 0.0f, 255.0f);
+      line.End[c] = std::clamp(statistics.Mean[c] + axis[c] * low, 0.0f, 255.0f);
+    }
+
+    return line;
+  }
+
+  /// @brief Endpoints minimising the squared error of the pixels in `mask` for their current indices, where
+  /// index `i` blends `weights[i]` of the end endpoint with the rest of the start.
+  /// @returns False if the indices don't pin down a line, e.g. when they're all the same.
+  NO_DISCARD static bool FitLeastSquares(const Block &block, uint32 first, uint32 count, uint32 mask,
+                                         const BlockIndices &indices, std::span<const float> weights,
+                                         Line &line) noexcept
+  {
+    float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    Vector ax {}, bx {};
+    for (uint32 i = 0; i < 16; i++)
+    {
+      if (!(mask & (1u << i)))
+        continue;
+
+      const float b = weights[indices[i]], a = 1.0f - b;
+      aa += a * a;
+      ab += a * b;
+      bb += b * b;
+      for (uint32 c = first; c < first + count; c++)
+      {
+        ax[c] += a * block.Channels[c][i];
+        bx[c] += b * block.Channels[c][i];
+      }
+    }
+
+    const float determinant = aa * bb - ab * ab;
+    if (determinant <= 1e-3f)
+      return false;
+
+    for (uint32 c = first; c < first + count; c++)
+    {
+      line.Start[c] = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+      line.End[c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+    }
+
+    return true;
+  }
+
+  /// @brief Pick the nearest palette colour for each pixel in `mask`, over channels [first, first + count).
+  /// @returns The summed squared error of those pixels.
+  static float FitIndices(const Block &block, uint32 first, uint32 count, const Palette &palette,
+                          uint32 mask, BlockIndices &indices) noexcept
+  {
+    simd_float total = _mm_setzero_ps();
+    for (uint32 group = 0; group < 16; group += 4)
+    {
+      const uint32 lanes = (mask >> group) & 0xF;
+      if (lanes == 0)
+        continue;
+
+      simd_float best = _mm_set1_ps(std::numeric_limits<float>::max());
+      simd_float bestIndex = _mm_setzero_ps();
+      for (uint32 entry = 0; entry < palette.Size; entry++)
+      {
+        simd_float distance = _mm_setzero_ps();
+        for (uint32 c = first; c < first + count; c++)
+        {
+          const simd_float difference =
+            _mm_sub_ps(_mm_load_ps(&block.Channels[c][group]), _mm_set1_ps(palette.Colours[entry][c]));
+          distance = _mm_add_ps(distance, _mm_mul_ps(difference, difference));
+        }
+
+        const simd_float closer = _mm_cmplt_ps(distance, best);
+        best = _mm_min_ps(distance, best);
+        bestIndex = Select(closer, _mm_set1_ps(static_cast<float>(entry)), bestIndex);
+      }
+
+      total = _mm_add_ps(total, _mm_and_ps(GetLaneMask(lanes), best));
+
+      alignas(16) int32 found[4];
+      _mm_store_si128(reinterpret_cast<simd_int *>(found), _mm_cvttps_epi32(bestIndex));
+      for (uint32 lane = 0; lane < 4; lane++)
+        if (lanes & (1u << lane))
+          indices[group + lane] = static_cast<uint8>(found[lane]);
+    }
+
+    return HorizontalSum(total);
+  }
+
+  /// @brief How many times to refit the endpoints to the indices they produced.
+  NO_DISCARD static uint32 GetRefinements(CompressionQuality quality) noexcept
+  {
+    switch (quality)
+    {
+      case CompressionQuality::Fast:     return 0;
+      case CompressionQuality::Balanced: return 1;
+      case CompressionQuality::Best:     return 3;
+      default:                           KRYS_ASSERT(false, "Unknown enum value: CompressionQuality"); break;
+    }
+
+    return 0;
+  }
+
+  NO_DISCARD static Line FitLine(const Block &block, uint32 first, uint32 count, uint32 mask,
+                                 CompressionQuality quality) noexcept
+  {
+    const auto statistics = GetStatistics(block, first, count, mask);
+    return quality == CompressionQuality::Fast ? FitBoundingBox(statistics, first, count)
+                                               : FitPrincipalAxis(block, statistics, first, count, mask);
+  }
+
+#pragma endregion Fitting
+
+#pragma region BC1
+
+  constexpr Array<float, 4> BC1Weights {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+
+  NO_DISCARD static uint16 To565(const Vector &colour) noexcept
+  {
+    const auto quantise = [](float value, uint32 maximum)
+    { return static_cast<uint32>(std::lround(std::clamp(value, 0.0f, 255.0f) * maximum / 255.0f)); };
+
+    return static_cast<uint16>(quantise(colour[0], 31) << 11 | quantise(colour[1], 63) << 5 |
+                               quantise(colour[2], 31));
+  }
+
+  NO_DISCARD static Texel From565(uint16 colour) noexcept
+  {
+    const uint32 r = colour >> 11, g = (colour >> 5) & 63, b = colour & 31;
+    return {static_cast<uint8>(r << 3 | r >> 2), static_cast<uint8>(g << 2 | g >> 4),
+            static_cast<uint8>(b << 3 | b >> 2), 255};
+  }
+
+  /// @brief The colours of a BC1 block. BC3 colour blocks always use the 4 colour mode.
+  NO_DISCARD static Array<Texel, 4> GetBC1Colours(uint16 colour0, uint16 colour1,
+                                                  bool alwaysFourColours) noexcept
+  {
+    Array<Texel, 4> colours {From565(colour0), From565(colour1), Texel {0, 0, 0, 255}, Texel {0, 0, 0, 255}};
+    for (uint32 c = 0; c < 3; c++)
+    {
+      const uint32 a = colours[0][c], b = colours[1][c];
+      if (colour0 > colour1 || alwaysFourColours)
+      {
+        colours[2][c] = static_cast<uint8>((2 * a + b) / 3);
+        colours[3][c] = static_cast<uint8>((a + 2 * b) / 3);
+      }
+      else
+        colours[2][c] = static_cast<uint8>((a + b) / 2);
+    }
+
+    return colours;
+  }
+
+  struct BC1Block
+  {
+    uint16 Colour0 {0}, Colour1 {0};
+    BlockIndices Indices {};
+    float Error {0.0f};
+  };
+
+  NO_DISCARD static BC1Block QuantiseBC1(const Block &block, const Line &line) noexcept
+  {
+    BC1Block result {To565(line.Start), To565(line.End)};
+
+    // Equal endpoints would switch the block to 3 colour mode, so move one a step away.
+    if (result.Colour0 == result.Colour1)
+    {
+      if (result.Colour1 > 0)
+        result.Colour1--;
+      else
+        result.Colour0++;
+    }
+    if (result.Colour0 < result.Colour1)
+      std::swap(result.Colour0, result.Colour1);
+
+    Palette palette {.Size = 4};
+    const auto colours = GetBC1Colours(result.Colour0, result.Colour1, false);
+    for (uint32 i = 0; i < 4; i++)
+      for (uint32 c = 0; c < 3; c++)
+        palette.Colours[i][c] = colours[i][c];
+
+    result.Error = FitIndices(block, 0, 3, palette, AllPixels, result.Indices);
+    return result;
+  }
+
+  static void EncodeBC1(const Block &block, CompressionQuality quality, byte *output) noexcept
+  {
+    Line line = FitLine(block, 0, 3, AllPixels, quality);
+    BC1Block best = QuantiseBC1(block, line);
+    for (uint32 i = 0; i < GetRefinements(quality) && best.Error > 0.0f; i++)
+    {
+      if (!FitLeastSquares(block, 0, 3, AllPixels, best.Indices, BC1Weights, line))
+        break;
+
+      const auto candidate = QuantiseBC1(block, line);
+      if (candidate.Error >= best.Error)
+        break;
+
+      best = candidate;
+    }
+
+    uint32 indices = 0;
+    for (uint32 i = 0; i < 16; i++)
+      indices |= static_cast<uint32>(best.Indices[i]) << (i * 2);
+
+    std::memcpy(output, &best.Colour0, 2);
+    std::memcpy(output + 2, &best.Colour1, 2);
+    std::memcpy(output + 4, &indices, 4);
+  }
+
+  static void DecodeBC1(const byte *input, bool alwaysFourColours, Array<Texel, 16> &texels) noexcept
+  {
+    uint16 colour0, colour1;
+    uint32 indices;
+    std::memcpy(&colour0, input, 2);
+    std::memcpy(&colour1, input + 2, 2);
+    std::memcpy(&indices, input + 4, 4);
+
+    const auto colours = GetBC1Colours(colour0, colour1, alwaysFourColours);
+    for (uint32 i = 0; i < 16; i++)
+    {
+      const auto &colour = colours[(indices >> (i * 2)) & 3];
+      std::copy_n(colour.begin(), 3, texels[i].begin());
+    }
+  }
+
+#pragma endregion BC1
+
+#pragma region BC4
+
+  constexpr Array<float, 8> BC4Weights {0.0f,        1.0f,        1.0f / 7.0f, 2.0f / 7.0f,
+                                        3.0f / 7.0f, 4.0f / 7.0f, 5.0f / 7.0f, 6.0f / 7.0f};
+
+  /// @brief The values of a BC4 block. Only the 8 value mode (`endpoint0 > endpoint1`) is written.
+  NO_DISCARD static Array<uint8, 8> GetBC4Values(uint32 endpoint0, uint32 endpoint1) noexcept
+  {
+    Array<uint8, 8> values {static_cast<uint8>(endpoint0), static_cast<uint8>(endpoint1)};
+    if (endpoint0 > endpoint1)
+    {
+      for (uint32 i = 2; i < 8; i++)
+        values[i] = static_cast<uint8>(((8 - i) * endpoint0 + (i - 1) * endpoint1 + 3) / 7);
+    }
+    else
+    {
+      for (uint32 i = 2; i < 6; i++)
+        values[i] = static_cast<uint8>(((6 - i) * endpoint0 + (i - 1) * endpoint1 + 2) / 5);
+      values[6] = 0;
+      values[7] = 255;
+    }
+
+    return values;
+  }
+
+  struct BC4Block
+  {
+    uint8 Endpoint0 {0}, Endpoint1 {0};
+    BlockIndices Indices {};
+    float Error {0.0f};
+  };
+
+  NO_DISCARD static BC4Block QuantiseBC4(const Block &block, uint32 channel, int32 endpoint0,
+                                         int32 endpoint1) noexcept
+  {
+    endpoint0 = std::clamp(endpoint0, 0, 255);
+    endpoint1 = std::clamp(endpoint1, 0, 255);
+    if (endpoint0 == endpoint1)
+    {
+      if (endpoint1 > 0)
+        endpoint1--;
+      else
+        endpoint0++;
+    }
+    if (endpoint0 < endpoint1)
+      std::swap(endpoint0, endpoint1);
+
+    BC4Block result {static_cast<uint8>(endpoint0), static_cast<uint8>(endpoint1)};
+
+    Palette palette {.Size = 8};
+    const auto values = GetBC4Values(result.Endpoint0, result.Endpoint1);
+    for (uint32 i = 0; i < 8; i++)
+      palette.Colours[i][channel] = values[i];
+
+    result.Error = FitIndices(block, channel, 1, palette, AllPixels, result.Indices);
+    return result;
+  }
+
+  static void EncodeBC4(const Block &block, uint32 channel, CompressionQuality quality, byte *output) noexcept
+  {
+    const auto statistics = GetStatistics(block, channel, 1, AllPixels);
+    BC4Block best = QuantiseBC4(block, channel, static_cast<int32>(statistics.Maximum[channel]),
+                                static_cast<int32>(statistics.Minimum[channel]));
+
+    Line line;
+    for (uint32 i = 0; i < GetRefinements(quality) && best.Error > 0.0f; i++)
+    {
+      if (!FitLeastSquares(block, channel, 1, AllPixels, best.Indices, BC4Weights, line))
+        break;
+
+      const auto candidate = QuantiseBC4(block, channel, static_cast<int32>(std::lround(line.Start[channel])),
+                                         static_cast<int32>(std::lround(line.End[channel])));
+      if (candidate.Error >= best.Error)
+        break;
+
+      best = candidate;
+    }
+
+    // Rounding the endpoints independently isn't always best, so try their neighbours too.
+    if (quality == CompressionQuality::Best && best.Error > 0.0f)
+    {
+      const BC4Block centre = best;
+      for (int32 d0 = -1; d0 <= 1; d0++)
+      {
+        for (int32 d1 = -1; d1 <= 1; d1++)
+        {
+          const auto candidate = QuantiseBC4(block, channel, centre.Endpoint0 + d0, centre.Endpoint1 + d1);
+          if (candidate.Error < best.Error)
+            best = candidate;
+        }
+      }
+    }
+
+    uint64 indices = 0;
+    for (uint32 i = 0; i < 16; i++)
+      indices |= static_cast<uint64>(best.Indices[i]) << (i * 3);
+
+    output[0] = static_cast<byte>(best.Endpoint0);
+    output[1] = static_cast<byte>(best.Endpoint1);
+    std::memcpy(output + 2, &indices, 6);
+  }
+
+  static void DecodeBC4(const byte *input, uint32 channel, Array<Texel, 16> &texels) noexcept
+  {
+    uint64 indices = 0;
+    std::memcpy(&indices, input + 2, 6);
+
+    const auto values = GetBC4Values(static_cast<uint8>(input[0]), static_cast<uint8>(input[1]));
+    for (uint32 i = 0; i < 16; i++)
+      texels[i][channel] = values[(indices >> (i * 3)) & 7];
+  }
+
+#pragma endregion BC4
+
+#pragma region BC7
+
+  /// @brief The parts of a BC7 mode's layout the encoder needs. Only modes 1 and 6 are written: mode 6
+  /// covers everything with a single RGBA line, and mode 1 splits opaque blocks into two RGB lines.
+  struct BC7Mode
+  {
+    uint32 Channels;
+    /// @brief Bits per endpoint channel, including the p-bit.
+    uint32 EndpointBits;
+    /// @brief Whether both endpoints of a subset share a p-bit, rather than having one each.
+    bool SharedPBit;
+    uint32 IndexBits;
+  };
+
+  constexpr BC7Mode Mode1 {3, 7, true, 3};
+  constexpr BC7Mode Mode6 {4, 8, false, 4};
+
+  constexpr Array<uint32, 8> BC7Weights3 {0, 9, 18, 27, 37, 46, 55, 64};
+  constexpr Array<uint32, 16> BC7Weights4 {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+  template <size_t N>
+  NO_DISCARD constexpr Array<float, N> ToFractions(const Array<uint32, N> &weights) noexcept
+  {
+    Array<float, N> fractions {};
+    for (size_t i = 0; i < N; i++)
+      fractions[i] = static_cast<float>(weights[i]) / 64.0f;
+    return fractions;
+  }
+
+  constexpr Array<float, 8> BC7Fractions3 = ToFractions(BC7Weights3);
+  constexpr Array<float, 16> BC7Fractions4 = ToFractions(BC7Weights4);
+
+  /// @brief Pixels in subset 1 of each two subset partition, one bit per pixel in row order.
+  constexpr Array<uint16, 64> BC7Partitions {
+    0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80, 0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8,
+    0xFF00, 0xFFF0, 0xF000, 0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE, 0x088C, 0x3110,
+    0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C, 0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696,
+    0xA55A, 0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660, 0x0272, 0x04E4, 0x4E40, 0x2720,
+    0xC936, 0x936C, 0x39C6, 0x639C, 0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22};
+
+  /// @brief The pixel of subset 1 whose index is stored with one bit fewer. Subset 0's is always pixel 0.
+  constexpr Array<uint8, 64> BC7Anchors {15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+                                         15, 2,  8,  2,  2,  8,  8,  15, 2,  8,  2,  2,  8,  8,  2,  2,
+                                         15, 15, 6,  8,  2,  8,  15, 15, 2,  8,  2,  2,  2,  15, 15, 6,
+                                         6,  2,  6,  8,  15, 15, 2,  2,  15, 15, 15, 15, 15, 2,  2,  15};
+
+  /// @brief Packs fields into a 128 bit block, least significant bit first.
+  struct BitWriter
+  {
+    Array<uint64, 2> Words {};
+    uint32 Position {0};
+
+    void Write(uint32 value, uint32 bits) noexcept
+    {
+      const uint64 field = value & ((1ull << bits) - 1);
+      const uint32 word = Position / 64, shift = Position % 64;
+      Words[word] |= field << shift;
+      if (shift + bits > 64)
+        Words[word + 1] |= field >> (64 - shift);
+      Position += bits;
+    }
+  };
+
+  struct BitReader
+  {
+    Array<uint64, 2> Words {};
+    uint32 Position {0};
+
+    NO_DISCARD uint32 Read(uint32 bits) noexcept
+    {
+      const uint32 word = Position / 64, shift = Position % 64;
+      uint64 field = Words[word] >> shift;
+      if (shift + bits > 64)
+        field |= Words[word + 1] << (64 - shift);
+      Position += bits;
+      return static_cast<uint32>(field & ((1ull << bits) - 1));
+    }
+  };
+
+  struct BC7Subset
+  {
+    /// @brief Quantised endpoint channels, without their p-bits.
+    Array<Array<uint8, 4>, 2> Codes {};
+    Array<uint8, 2> PBits {};
+  };
+
+  /// @brief Expand an endpoint channel (code and p-bit) of `bits` bits to 8, replicating the top bits.
+  NO_DISCARD static uint32 Unquantise(uint32 code, uint32 pbit, uint32 bits) noexcept
+  {
+    const uint32 value = code << 1 | pbit;
+    return bits == 8 ? value : (value << (8 - bits)) | (value >> (2 * bits - 8));
+  }
+
+  /// @brief The code whose expansion with `pbit` is nearest `target`.
+  NO_DISCARD static uint32 Quantise(float target, uint32 pbit, uint32 bits, float &error) noexcept
+  {
+    const int32 maximum = (1 << (bits - 1)) - 1;
+    const int32 guess = static_cast<int32>(
+      std::lround((target * static_cast<float>((1 << bits) - 1) / 255.0f - static_cast<float>(pbit)) / 2.0f));
+
+    uint32 best = 0;
+    error = std::numeric_limits<float>::max();
+    for (int32 code = std::max(guess - 1, 0); code <= std::min(guess + 1, maximum); code++)
+    {
+      const float difference = static_cast<float>(Unquantise(code, pbit, bits)) - target;
+      if (difference * difference < error)
+      {
+        error = difference * difference;
+        best = static_cast<uint32>(code);
+      }
+    }
+
+    return best;
+  }
+
+  /// @brief Quantise `line` with the p-bits in `pbits` (bit `i` for endpoint `i`).
+  /// @returns The squared error of the quantised endpoints.
+  static float QuantiseBC7(const BC7Mode &mode, const Line &line, uint32 pbits, BC7Subset &subset) noexcept
+  {
+    float total = 0.0f;
+    for (uint32 endpoint = 0; endpoint < 2; endpoint++)
+    {
+      const uint32 pbit = (pbits >> endpoint) & 1;
+      const auto &target = endpoint == 0 ? line.Start : line.End;
+      for (uint32 c = 0; c < mode.Channels; c++)
+      {
+        float error;
+        subset.Codes[endpoint][c] = static_cast<uint8>(Quantise(target[c], pbit, mode.EndpointBits, error));
+        total += error;
+      }
+      subset.PBits[endpoint] = static_cast<uint8>(pbit);
+    }
+
+    return total;
+  }
+
+  NO_DISCARD static Palette GetBC7Palette(const BC7Mode &mode, const BC7Subset &subset) noexcept
+  {
+    const std::span<const uint32> weights =
+      mode.IndexBits == 3 ? std::span<const uint32>(BC7Weights3) : std::span<const uint32>(BC7Weights4);
+
+    Palette palette {.Size = static_cast<uint32>(weights.size())};
+    for (uint32 c = 0; c < 4; c++)
+    {
+      if (c >= mode.Channels)
+      {
+        for (uint32 i = 0; i < palette.Size; i++)
+          palette.Colours[i][c] = 255.0f;
+        continue;
+      }
+
+      const uint32 a = Unquantise(subset.Codes[0][c], subset.PBits[0], mode.EndpointBits);
+      const uint32 b = Unquantise(subset.Codes[1][c], subset.PBits[1], mode.EndpointBits);
+      for (uint32 i = 0; i < palette.Size; i++)
+        palette.Colours[i][c] = static_cast<float>(((64 - weights[i]) * a + weights[i] * b + 32) >> 6);
+    }
+
+    return palette;
+  }
+
+  /// @brief Fit one subset of a BC7 block, filling in the indices of the pixels in `mask`.
+  /// @returns The squared error of those pixels.
+  static float FitBC7Subset(const Block &block, const BC7Mode &mode, uint32 mask, CompressionQuality quality,
+                            BC7Subset &subset, BlockIndices &indices) noexcept
+  {
+    const std::span<const float> fractions =
+      mode.IndexBits == 3 ? std::span<const float>(BC7Fractions3) : std::span<const float>(BC7Fractions4);
+    const Array<uint32, 4> allPBits {0b00, 0b11, 0b01, 0b10};
+    const uint32 pbitCount = mode.SharedPBit ? 2 : 4;
+
+    Line line = FitLine(block, 0, mode.Channels, mask, quality);
+    float bestError = std::numeric_limits<float>::max();
+    for (uint32 refinement = 0;; refinement++)
+    {
+      // Best tries every p-bit combination; otherwise take whichever quantises the endpoints closest.
+      BC7Subset candidate;
+      BlockIndices candidateIndices = indices;
+      float error = std::numeric_limits<float>::max();
+      float closest = std::numeric_limits<float>::max();
+      for (uint32 i = 0; i < pbitCount; i++)
+      {
+        BC7Subset quantised;
+        const float quantisationError = QuantiseBC7(mode, line, allPBits[i], quantised);
+        if (quality != CompressionQuality::Best)
+        {
+          if (quantisationError < closest)
+          {
+            closest = quantisationError;
+            candidate = quantised;
+          }
+          continue;
+        }
+
+        BlockIndices fitted = indices;
+        const float fittedError =
+          FitIndices(block, 0, mode.Channels, GetBC7Palette(mode, quantised), mask, fitted);
+        if (fittedError < error)
+        {
+          error = fittedError;
+          candidate = quantised;
+          candidateIndices = fitted;
+        }
+      }
+
+      if (quality != CompressionQuality::Best)
+        error = FitIndices(block, 0, mode.Channels, GetBC7Palette(mode, candidate), mask, candidateIndices);
+
+      if (error >= bestError)
+        break;
+
+      bestError = error;
+      subset = candidate;
+      indices = candidateIndices;
+
+      if (refinement == GetRefinements(quality) || bestError <= 0.0f ||
+          !FitLeastSquares(block, 0, mode.Channels, mask, indices, fractions, line))
+        break;
+    }
+
+    return bestError;
+  }
+
+  /// @brief Swap a subset's endpoints if needed so its anchor's index has a clear top bit, which the format
+  /// relies on to save a bit.
+  static void FixAnchor(const BC7Mode &mode, uint32 mask, uint32 anchor, BC7Subset &subset,
+                        BlockIndices &indices) noexcept
+  {
+    const uint32 highest = (1u << mode.IndexBits) - 1;
+    if (indices[anchor] <= highest / 2)
+      return;
+
+    std::swap(subset.Codes[0], subset.Codes[1]);
+    std::swap(subset.PBits[0], subset.PBits[1]);
+    for (uint32 i = 0; i < 16; i++)
+      if (mask & (1u << i))
+        indices[i] = static_cast<uint8>(highest - indices[i]);
+  }
+
+  NO_DISCARD static BitWriter PackMode6(BC7Subset subset, BlockIndices indices) noexcept
+  {
+    FixAnchor(Mode6, AllPixels, 0, subset, indices);
+
+    BitWriter writer;
+    writer.Write(1u << 6, 7);
+    for (uint32 c = 0; c < 4; c++)
+      for (uint32 endpoint = 0; endpoint < 2; endpoint++)
+        writer.Write(subset.Codes[endpoint][c], 7);
+
+    writer.Write(subset.PBits[0], 1);
+    writer.Write(subset.PBits[1], 1);
+    for (uint32 i = 0; i < 16; i++)
+      writer.Write(indices[i], i == 0 ? 3 : 4);
+
+    return writer;
+  }
+
+  NO_DISCARD static BitWriter PackMode1(uint32 partition, Array<BC7Subset, 2> subsets,
+                                        BlockIndices indices) noexcept
+  {
+    const uint32 anchor = BC7Anchors[partition];
+    FixAnchor(Mode1, ~BC7Partitions[partition] & AllPixels, 0, subsets[0], indices);
+    FixAnchor(Mode1, BC7Partitions[partition], anchor, subsets[1], indices);
+
+    BitWriter writer;
+    writer.Write(1u << 1, 2);
+    writer.Write(partition, 6);
+    for (uint32 c = 0; c < 3; c++)
+      for (const auto &subset : subsets)
+        for (uint32 endpoint = 0; endpoint < 2; endpoint++)
+          writer.Write(subset.Codes[endpoint][c], 6);
+
+    writer.Write(subsets[0].PBits[0], 1);
+    writer.Write(subsets[1].PBits[0], 1);
+    for (uint32 i = 0; i < 16; i++)
+      writer.Write(indices[i], i == 0 || i == anchor ? 2 : 3);
+
+    return writer;
+  }
+
+  /// @brief Cheap estimate of how well each partition splits the (opaque) block: the scatter each subset has
+  /// left once its principal axis is taken out. Partitions are estimated four at a time, one per lane.
+  static void EstimatePartitionErrors(const Block &block, Array<float, 64> &estimates) noexcept
+  {
+    // Pixel count, RGB sums and RGB products (rr, gg, bb, rg, rb, gb) of every combination of pixels in each
+    // row, so a subset's are four lookups away.
+    constexpr uint32 MomentCount = 10;
+    float rows[4][16][MomentCount];
+    Array<float, MomentCount> total {};
+    for (uint32 y = 0; y < 4; y++)
+    {
+      std::fill_n(rows[y][0], MomentCount, 0.0f);
+      for (uint32 lanes = 1; lanes < 16; lanes++)
+      {
+        const uint32 pixel = y * 4 + static_cast<uint32>(std::countr_zero(lanes));
+        const float r = block.Channels[0][pixel], g = block.Channels[1][pixel], b = block.Channels[2][pixel];
+        const float moments[MomentCount] {1.0f, r, g, b, r * r, g * g, b * b, r * g, r * b, g * b};
+        for (uint32 k = 0; k < MomentCount; k++)
+          rows[y][lanes][k] = rows[y][lanes & (lanes - 1)][k] + moments[k];
+      }
+
+      for (uint32 k = 0; k < MomentCount; k++)
+        total[k] += rows[y][15][k];
+    }
+
+    const auto getResidual = [](const simd_float (&moments)[MomentCount])
+    {
+      const simd_float inverseCount = _mm_div_ps(_mm_set1_ps(1.0f), moments[0]);
+      const auto getScatter = [&](uint32 product, uint32 a, uint32 b)
+      { return _mm_sub_ps(moments[product], _mm_mul_ps(_mm_mul_ps(moments[a], moments[b]), inverseCount)); };
+
+      const simd_float xx = getScatter(4, 1, 1), yy = getScatter(5, 2, 2), zz = getScatter(6, 3, 3);
+      const simd_float xy = getScatter(7, 1, 2), xz = getScatter(8, 1, 3), yz = getScatter(9, 2, 3);
+      const auto multiply = [&](const simd_float (&v)[3], simd_float (&result)[3])
+      {
+        result[0] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xx, v[0]), _mm_mul_ps(xy, v[1])), _mm_mul_ps(xz, v[2]));
+        result[1] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xy, v[0]), _mm_mul_ps(yy, v[1])), _mm_mul_ps(yz, v[2]));
+        result[2] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xz, v[0]), _mm_mul_ps(yz, v[1])), _mm_mul_ps(zz, v[2]));
+      };
+
+      // One step of power iteration from the widest channel's row, then the Rayleigh quotient, is plenty
+      // for ranking partitions.
+      const simd_float xWidest = _mm_and_ps(_mm_cmpge_ps(xx, yy), _mm_cmpge_ps(xx, zz));
+      const simd_float yWidest = _mm_cmpge_ps(yy, zz);
+      const simd_float row[3] {Select(xWidest, xx, Select(yWidest, xy, xz)),
+                               Select(xWidest, xy, Select(yWidest, yy, yz)),
+                               Select(xWidest, xz, Select(yWidest, yz, zz))};
+      simd_float axis[3], image[3];
+      multiply(row, axis);
+      multiply(axis, image);
+
+      const auto dot = [](const simd_float (&a)[3], const simd_float (&b)[3])
+      {
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])),
+                          _mm_mul_ps(a[2], b[2]));
+      };
+
+      const simd_float length = _mm_max_ps(dot(axis, axis), _mm_set1_ps(1e-12f));
+      const simd_float variance = _mm_div_ps(dot(axis, image), length);
+      return _mm_max_ps(_mm_setzero_ps(), _mm_sub_ps(_mm_add_ps(_mm_add_ps(xx, yy), zz), variance));
+    };
+
+    for (uint32 first = 0; first < 64; first += 4)
+    {
+      simd_float subset0[MomentCount], subset1[MomentCount];
+      for (uint32 k = 0; k < MomentCount; k++)
+      {
+        subset1[k] = _mm_setzero_ps();
+        for (uint32 y = 0; y < 4; y++)
+        {
+          const auto lookup = [&](uint32 partition)
+          { return rows[y][(BC7Partitions[partition] >> (y * 4)) & 0xF][k]; };
+
+          subset1[k] = _mm_add_ps(
+            subset1[k], _mm_setr_ps(lookup(first), lookup(first + 1), lookup(first + 2), lookup(first + 3)));
+        }
+        subset0[k] = _mm_sub_ps(_mm_set1_ps(total[k]), subset1[k]);
+      }
+
+      _mm_storeu_ps(estimates.data() + first, _mm_add_ps(getResidual(subset0), getResidual(subset1)));
+    }
+  }
+
+  static void EncodeBC7(const Block &block, CompressionQuality quality, byte *output) noexcept
+  {
+    BlockIndices indices {};
+    BC7Subset subset;
+    const float error = FitBC7Subset(block, Mode6, AllPixels, quality, subset, indices);
+    BitWriter writer = PackMode6(subset, indices);
+
+    const auto alpha = GetStatistics(block, 3, 1, AllPixels);
+    const float threshold = quality == CompressionQuality::Balanced ? BalancedPartitionThreshold : 0.0f;
+    if (quality != CompressionQuality::Fast && error > threshold && alpha.Minimum[3] >= 255.0f)
+    {
+      Array<float, 64> estimates;
+      EstimatePartitionErrors(block, estimates);
+
+      Array<uint8, 64> order;
+      std::iota(order.begin(), order.end(), uint8 {0});
+      const uint32 candidates = quality == CompressionQuality::Best ? BestPartitions : BalancedPartitions;
+      std::partial_sort(order.begin(), order.begin() + candidates, order.end(),
+                        [&](uint8 a, uint8 b) { return estimates[a] < estimates[b]; });
+
+      float bestError = error;
+      for (uint32 i = 0; i < candidates; i++)
+      {
+        const uint32 partition = order[i];
+        BlockIndices partitionIndices {};
+        Array<BC7Subset, 2> subsets;
+        const uint32 subset1 = BC7Partitions[partition];
+        float partitionError =
+          FitBC7Subset(block, Mode1, ~subset1 & AllPixels, quality, subsets[0], partitionIndices);
+        if (partitionError >= bestError)
+          continue;
+
+        partitionError += FitBC7Subset(block, Mode1, subset1, quality, subsets[1], partitionIndices);
+        if (partitionError < bestError)
+        {
+          bestError = partitionError;
+          writer = PackMode1(partition, subsets, partitionIndices);
+        }
+      }
+    }
+
+    std::memcpy(output, writer.Words.data(), 16);
+  }
+
+  /// @brief Decode a BC7 block. Only the modes `EncodeBC7` writes are understood; anything else decodes to
+  /// transparent black, as invalid blocks do on the GPU.
+  static void DecodeBC7(const byte *input, Array<Texel, 16> &texels) noexcept
+  {
+    BitReader reader;
+    std::memcpy(reader.Words.data(), input, 16);
+
+    const uint32 mode = std::countr_zero(static_cast<uint32>(static_cast<uint8>(input[0])));
+    if (mode != 1 && mode != 6)
+    {
+      texels.fill({0, 0, 0, 0});
+      return;
+    }
+
+    (void)reader.Read(mode + 1);
+    const BC7Mode &layout = mode == 1 ? Mode1 : Mode6;
+    const uint32 partition = mode == 1 ? reader.Read(6) : 0;
+    const uint32 subsetMask = mode == 1 ? BC7Partitions[partition] : 0;
+    const uint32 subsetCount = mode == 1 ? 2 : 1;
+
+    Array<BC7Subset, 2> subsets;
+    for (uint32 c = 0; c < layout.Channels; c++)
+      for (uint32 s = 0; s < subsetCount; s++)
+        for (uint32 endpoint = 0; endpoint < 2; endpoint++)
+          subsets[s].Codes[endpoint][c] = static_cast<uint8>(reader.Read(layout.EndpointBits - 1));
+
+    for (uint32 s = 0; s < subsetCount; s++)
+    {
+      subsets[s].PBits[0] = static_cast<uint8>(reader.Read(1));
+      subsets[s].PBits[1] = layout.SharedPBit ? subsets[s].PBits[0] : static_cast<uint8>(reader.Read(1));
+    }
+
+    const Array<Palette, 2> palettes {GetBC7Palette(layout, subsets[0]), GetBC7Palette(layout, subsets[1])};
+    const uint32 anchor = mode == 1 ? BC7Anchors[partition] : 0;
+    for (uint32 i = 0; i < 16; i++)
+    {
+      const uint32 index = reader.Read(i == 0 || i == anchor ? layout.IndexBits - 1 : layout.IndexBits);
+      const auto &colour = palettes[(subsetMask >> i) & 1].Colours[index];
+      for (uint32 c = 0; c < 4; c++)
+        texels[i][c] = static_cast<uint8>(colour[c]);
+    }
+  }
+
+#pragma endregion BC7
+
+  static void EncodeBlock(const Block &block, TextureCompression format, CompressionQuality quality,
+                          byte *output) noexcept
+  {
+    switch (format)
+    {
+      case TextureCompression::BC1: EncodeBC1(block, quality, output); break;
+      case TextureCompression::BC3:
+        EncodeBC4(block, 3, quality, output);
+        EncodeBC1(block, quality, output + 8);
+        break;
+      case TextureCompression::BC4: EncodeBC4(block, 0, quality, output); break;
+      case TextureCompression::BC5:
+        EncodeBC4(block, 0, quality, output);
+        EncodeBC4(block, 1, quality, output + 8);
+        break;
+      case TextureCompression::BC7: EncodeBC7(block, quality, output); break;
+      default:                      KRYS_ASSERT(false, "Unknown enum value: TextureCompression"); break;
+    }
+  }
+
+  static void DecodeBlock(const byte *input, TextureCompression format, Array<Texel, 16> &texels) noexcept
+  {
+    switch (format)
+    {
+      case TextureCompression::BC1: DecodeBC1(input, false, texels); break;
+      case TextureCompression::BC3:
+        DecodeBC4(input, 3, texels);
+        DecodeBC1(input + 8, true, texels);
+        break;
+      case TextureCompression::BC4: DecodeBC4(input, 0, texels); break;
+      case TextureCompression::BC5:
+        DecodeBC4(input, 0, texels);
+        DecodeBC4(input + 8, 1, texels);
+        break;
+      case TextureCompression::BC7: DecodeBC7(input, texels); break;
+      default:                      KRYS_ASSERT(false, "Unknown enum value: TextureCompression"); break;
+    }
+  }
+}
+
+namespace Krys::Gfx::BlockCompression
+{
+  List<byte> Compress(std::span<const byte> pixels, uint32 width, uint32 height, uint32 channels,
+                      TextureCompression format, CompressionQuality quality) noexcept
+  {
+    KRYS_SCOPED_PROFILER("BlockCompression::Compress");
+    if (format == TextureCompression::None || width == 0 || height == 0)
+      return {};
+
+    KRYS_ASSERT(channels >= 1 && channels <= 4, "Invalid number of channels: {0}", channels);
+    KRYS_ASSERT(pixels.size() >= static_cast<size_t>(width) * height * channels,
+                "Compress: pixel data is smaller than the image.");
+
+    const uint32 blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    const uint32 blockSize = GetBlockSize(format);
+    List<byte> output(GetCompressedSize(format, width, height));
+
+    const auto encodeRows = [&](uint32 begin, uint32 end)
+    {
+      Block block;
+      for (uint32 y = begin; y < end; y++)
+      {
+        byte *destination = output.data() + static_cast<size_t>(y) * blocksX * blockSize;
+        for (uint32 x = 0; x < blocksX; x++, destination += blockSize)
+        {
+          LoadBlock(pixels.data(), width, height, channels, x, y, block);
+          EncodeBlock(block, format, quality, destination);
+        }
+      }
+    };
+
+    const size_t maxBands = std::max<size_t>(1, static_cast<size_t>(blocksX) * blocksY / MinBandBlocks);
+    Concurrency::ParallelForRanges(blocksY, maxBands, encodeRows);
+
+    return output;
+  }
+
+  List<byte> Decompress(std::span<const byte> blocks, uint32 width, uint32 height,
+                        TextureCompression format) noexcept
+  {
+    if (format == TextureCompression::None || width == 0 || height == 0)
+      return {};
+
+    KRYS_ASSERT(blocks.size() >= GetCompressedSize(format, width, height),
+                "Decompress: block data is smaller than the image.");
+
+    const uint32 blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    const uint32 blockSize = GetBlockSize(format);
+    List<byte> output(static_cast<size_t>(width) * height * 4);
+
+    Array<Texel, 16> texels;
+    for (uint32 y = 0; y < blocksY; y++)
+    {
+      for (uint32 x = 0; x < blocksX; x++)
+      {
+        texels.fill({0, 0, 0, 255});
+        DecodeBlock(blocks.data() + (static_cast<size_t>(y) * blocksX + x) * blockSize, format, texels);
+
+        for (uint32 row = 0; row < 4 && y * 4 + row < height; row++)
+        {
+          const uint32 columns = std::min(4u, width - x * 4);
+          byte *destination = output.data() + ((static_cast<size_t>(y) * 4 + row) * width + x * 4) * 4;
+          std::memcpy(destination, &texels[row * 4], columns * 4);
+        }
+      }
+    }
+
+    return output;
+  }
+}
@@ -1,11 +1,205 @@
 #include "Graphics/Textures/TextureManager.hpp"
 #include "Graphics/Colours.hpp"
+#include "Graphics/Textures/BlockCompression.hpp"
+#include "IO/IO.hpp"
+#include "IO/Image/KTEX.hpp"
 #include "IO/Logger.hpp"
+#include "IO/VFS/VFS.hpp"
+#include "Utils/Hash.hpp"
 
+#include <bit>
 #include <sstream>
 
 namespace Krys::Gfx
 {
+  /// @brief Number of levels in a full mip chain for `descriptor`, as the texture will be created with.
+  NO_DISCARD static size_t GetLevelCount(const TextureDescriptor &descriptor) noexcept
+  {
+    return static_cast<size_t>(std::bit_width(std::max(descriptor.Width, descriptor.Height)));
+  }
+
+  /// @brief Size in bytes of one `width` by `height` level of a texture described by `descriptor`.
+  NO_DISCARD static size_t GetLevelSize(const TextureDescriptor &descriptor, uint32 width,
+                                        uint32 height) noexcept
+  {
+    if (descriptor.Compression != TextureCompression::None)
+      return BlockCompression::GetCompressedSize(descriptor.Compression, width, height);
+    return static_cast<size_t>(width) * height * descriptor.Channels;
+  }
+
+  /// @brief Prepare `image` for uploading as `descriptor` asks: block compressed if requested, followed by
+  /// each of its mip levels if `useMipmaps`. The image's pixels may be moved out.
+  NO_DISCARD static IO::ImageData CookImage(IO::Image &image, const TextureDescriptor &descriptor,
+                                             bool useMipmaps) noexcept
+  {
+    KRYS_SCOPED_PROFILER("TextureManager::CookImage");
+    const bool compress = descriptor.Compression != TextureCompression::None;
+
+    // Compressed textures can't have their mips generated by the GPU, and for the others the cooked file
+    // saves generating them again at load time. Image textures hold sRGB colour, which has to be filtered in
+    // linear space or the smaller levels come out too dark; data textures are filtered as they are.
+    IO::MipChain chain;
+    if (useMipmaps)
+      chain = IO::GenerateMipmaps(
+        image, {.Filter = IO::MipFilter::Kaiser, .SRGB = descriptor.Type == TextureType::Image});
+
+    IO::ImageData data;
+    if (!compress)
+    {
+      data = std::move(image.Data);
+      data.reserve(data.size() + chain.Data.size());
+    }
+    else
+    {
+      const auto blocks = BlockCompression::Compress(image.Data, image.Width, image.Height, image.Channels,
+                                                     descriptor.Compression, descriptor.Quality);
+      data.assign(blocks.begin(), blocks.end());
+    }
+
+    for (size_t i = 0; i < chain.Levels.size(); i++)
+    {
+      const auto &level = chain.Levels[i];
+      if (!compress)
+      {
+        const auto pixels = chain.GetLevel(i);
+        data.insert(data.end(), pixels.begin(), pixels.end());
+        continue;
+      }
+
+      const auto blocks =
+        BlockCompression::Compress(chain.GetLevel(i), level.Width, level.Height, chain.Channels,
+                                   descriptor.Compression, descriptor.Quality);
+      data.insert(data.end(), blocks.begin(), blocks.end());
+    }
+
+    return data;
+  }
+
+  /// @brief Names the cooked textures in the `IO::AssetCache`. Bump the version whenever `CookImage` or
+  /// the KTEX layout changes what a cooked texture holds.
+  constexpr stringview CookedTextureImporter = "TextureManager";
+  constexpr uint32 CookedTextureVersion = 2;
+
+  /// @brief Key of the texture cooked from the source hashing to `sourceHash` as `descriptor` asks.
+  NO_DISCARD static IO::AssetKey GetCookedTextureKey(uint64 sourceHash, const TextureDescriptor &descriptor,
+                                                     bool useMipmaps) noexcept
+  {
+    const bool compress = descriptor.Compression != TextureCompression::None;
+    const Array<uint8, 4> settings {static_cast<uint8>(descriptor.Compression),
+                                    static_cast<uint8>(compress ? descriptor.Quality : CompressionQuality {}),
+                                    static_cast<uint8>(useMipmaps),
+                                    static_cast<uint8>(descriptor.Type == TextureType::Image)};
+    const auto source = std::as_bytes(std::span(&sourceHash, 1));
+    return IO::AssetCache::MakeKey(CookedTextureImporter, CookedTextureVersion, source,
+                                   std::as_bytes(std::span(settings)));
+  }
+
+  /// @brief Whether `cooked` (called `name` in messages) was cooked from the source hashing to `sourceHash`,
+  /// and has what `descriptor` asks for. A `sourceHash` of 0 means the source is missing, in which case any
+  /// cooked texture is taken, so a build can ship only the cooked textures.
+  NO_DISCARD static bool IsUsable(const IO::KTEXImage &cooked, const stringview &name, uint64 sourceHash,
+                                  const TextureDescriptor &descriptor, bool useMipmaps) noexcept
+  {
+    if (sourceHash != 0 && cooked.SourceHash != sourceHash)
+      return false;
+
+    // A texture compressed at a higher quality than asked for is still good to use.
+    if (cooked.Format != static_cast<uint8>(descriptor.Compression)
+        || (descriptor.Compression != TextureCompression::None
+            && cooked.Quality < static_cast<uint8>(descriptor.Quality)))
+      return false;
+
+    auto desc = descriptor;
+    desc.Width = cooked.Width;
+    desc.Height = cooked.Height;
+    desc.Channels = cooked.Channels;
+    if (useMipmaps && cooked.Levels.size() != GetLevelCount(desc))
+      return false;
+
+    for (const auto &level : cooked.Levels)
+    {
+      if (level.Size != GetLevelSize(desc, level.Width, level.Height))
+      {
+        Logger::Warn("TextureManager: Ignoring '{0}', its levels are the wrong size.", name);
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /// @brief Map the cooked texture at `cookedPath`, which may be in a mounted pack, if it's usable.
+  NO_DISCARD static Unique<IO::KTEXImage> LoadCookedTexture(const string &cookedPath, uint64 sourceHash,
+                                                            const TextureDescriptor &descriptor,
+                                                            bool useMipmaps) noexcept
+  {
+    KRYS_SCOPED_PROFILER("TextureManager::LoadCookedTexture");
+    if (!IO::VFS::Exists(cookedPath))
+      return nullptr;
+
+    auto cooked = IO::KTEX().Load(cookedPath);
+    if (!cooked || !IsUsable(*cooked, cookedPath, sourceHash, descriptor, useMipmaps))
+      return nullptr;
+
+    return cooked;
+  }
+
+  /// @brief Map the cooked texture stored under `key`, if it's usable.
+  NO_DISCARD static Unique<IO::KTEXImage> LoadCookedTexture(IO::AssetCache &cache, IO::AssetKey key,
+                                                            uint64 sourceHash,
+                                                            const TextureDescriptor &descriptor,
+                                                            bool useMipmaps) noexcept
+  {
+    KRYS_SCOPED_PROFILER("TextureManager::LoadCookedTexture");
+    auto file = cache.Load(key);
+    if (!file.IsOpen())
+      return nullptr;
+
+    auto cooked = IO::KTEX().Load(file.GetSpan());
+    if (!cooked || !IsUsable(*cooked, std::format("{0:016x}", key.Hash), sourceHash, descriptor, useMipmaps))
+      return nullptr;
+
+    cooked->File = IO::VirtualFile(std::move(file));
+    return cooked;
+  }
+
+  /// @brief Keep `data`, cooked from `path` as `descriptor` describes, for the next load: in the asset cache
+  /// under `key` if there is one, otherwise at `cookedPath` next to the source.
+  static void SaveCookedTexture(const string &path, const string &cookedPath, Ptr<IO::AssetCache> cache,
+                                IO::AssetKey key, uint64 sourceHash, const TextureDescriptor &descriptor,
+                                std::span<const byte> data) noexcept
+  {
+    IO::KTEXImage cooked;
+    cooked.Width = descriptor.Width;
+    cooked.Height = descriptor.Height;
+    cooked.Channels = static_cast<uint8>(descriptor.Channels);
+    cooked.Format = static_cast<uint8>(descriptor.Compression);
+    cooked.Quality = static_cast<uint8>(descriptor.Quality);
+    cooked.SourceHash = sourceHash;
+    cooked.Data = data;
+
+    size_t size = 0;
+    uint32 width = descriptor.Width, height = descriptor.Height;
+    while (size < data.size())
+    {
+      cooked.Levels.push_back({width, height, 0, GetLevelSize(descriptor, width, height)});
+      size += cooked.Levels.back().Size;
+      width = std::max(1u, width / 2);
+      height = std::max(1u, height / 2);
+    }
+
+    if (!cache)
+    {
+      if (IO::KTEX().Save(cookedPath, cooked))
+        Logger::Info("TextureManager: Cooked '{0}' to '{1}'.", path, cookedPath);
+      return;
+    }
+
+    List<byte> file;
+    if (IO::KTEX().Save(file, cooked) && cache->Store(key, file))
+      Logger::Info("TextureManager: Cooked '{0}' to {1:016x}.", path, key.Hash);
+  }
+
 #pragma region Samplers
 
   SamplerHandle TextureManager::DefaultTextureSampler() noexcept
@@ -78,8 +272,9 @@ namespace Krys::Gfx
 #pragma endregion Samplers
 
   TextureHandle TextureManager::CreateTexture(const TextureDescriptor &descriptor,
-                                              const List<byte> &data) noexcept
+                                              std::span<const byte> data) noexcept
   {
+    KRYS_MEMORY_SCOPE(Textures);
     auto desc = descriptor; // Copy to modify
     if (desc.Name.empty())
     {
@@ -118,6 +313,7 @@ namespace Krys::Gfx
 
   TextureHandle TextureManager::LoadTexture(const string &path, const TextureDescriptor &descriptor) noexcept
   {
+    KRYS_MEMORY_SCOPE(Textures);
     auto desc = descriptor; // Copy to modify
     KRYS_ASSERT(desc.Type == TextureType::Image || desc.Type == TextureType::Data,
                 "TextureManager: Can only load image or data textures from file.");
@@ -131,23 +327,58 @@ namespace Krys::Gfx
       return loaded.Resource->GetHandle();
     }
 
-    auto loadedImage = IO::LoadImage(path);
-    // TODO: handle this more gracefully
-    KRYS_ASSERT(loadedImage.has_value(), "TextureManager: Failed to load '{0}': {1}", path,
-                loadedImage.error());
-    auto &image = loadedImage.value();
-    desc.Width = image.Width;
-    desc.Height = image.Height;
-    desc.Channels = image.Channels;
-
-    auto handle = _textureHandles.Next();
     if (desc.Name.empty())
       desc.Name = path;
 
     if (!desc.Sampler.IsValid())
       desc.Sampler = DefaultTextureSampler();
 
-    auto texture = CreateTextureImpl(handle, desc, image.Data);
+    const bool useMipmaps = GetSampler(desc.Sampler)->GetDescriptor().UseMipmaps;
+
+    // Prefer the cooked texture next to the source, or in a mounted pack, then the one in the asset cache.
+    // Either is uploaded straight from the mapped file. Otherwise the source is decoded and cooked, and the
+    // result kept so the next load can skip all of that.
+    const string cookedPath = path + string(IO::KTEX::Extension);
+    const auto source = IO::VFS::Open(path);
+    const uint64 sourceHash = source.IsOpen() ? HashBytes(source.GetSpan()) : 0;
+    const auto key = GetCookedTextureKey(sourceHash, desc, useMipmaps);
+
+    auto cooked = LoadCookedTexture(cookedPath, sourceHash, desc, useMipmaps);
+    if (!cooked && _assetCache && source.IsOpen())
+      cooked = LoadCookedTexture(*_assetCache, key, sourceHash, desc, useMipmaps);
+
+    IO::ImageData data;
+    std::span<const byte> levels;
+    if (cooked)
+    {
+      desc.Width = cooked->Width;
+      desc.Height = cooked->Height;
+      desc.Channels = cooked->Channels;
+      levels = cooked->Data;
+      Logger::Info("TextureManager: Using cooked texture for '{0}'.", path);
+    }
+    else
+    {
+      auto loadedImage = IO::LoadImage(source, path);
+      // TODO: handle this more gracefully
+      KRYS_ASSERT(loadedImage.has_value(), "TextureManager: Failed to load '{0}': {1}", path,
+                  loadedImage.error());
+      auto &image = loadedImage.value();
+      desc.Width = image.Width;
+      desc.Height = image.Height;
+      desc.Channels = image.Channels;
+
+      const size_t size = image.Data.size();
+      data = CookImage(image, desc, useMipmaps);
+      if (desc.Compression != TextureCompression::None)
+        Logger::Info("TextureManager: Compressed '{0}' from {1} to {2} bytes.", path, size, data.size());
+
+      SaveCookedTexture(path, cookedPath, _assetCache, key, sourceHash, desc, data);
+      levels = data;
+    }
+
+    auto handle = _textureHandles.Next();
+    auto texture = CreateTextureImpl(handle, desc, levels);
 
     _loadedTextures[path] = {1u, std::move(texture)};
     _textures[handle] = _loadedTextures[path].Resource.get();
@@ -215,6 +446,6 @@ namespace Krys::Gfx
                                             .Channels = 4,
                                             .Sampler = DefaultTextureSampler(),
                                             .IsBindless = true},
-                         {Colour::AsBytes(colour)});
+                         Colour::AsBytes(colour));
   }
 }
\ No newline at end of file
@@ -0,0 +1,373 @@
+#include "IO/AssetCache.hpp"
+#include "Debug/Macros.hpp"
+#include "IO/IO.hpp"
+#include "IO/Logger.hpp"
+#include "IO/Readers/MemoryReader.hpp"
+#include "IO/Writers/BufferedWriter.hpp"
+#include "Utils/Concurrency/ParallelFor.hpp"
+#include "Utils/Hash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <filesystem>
+#include <format>
+#include <random>
+
+namespace
+{
+  using namespace Krys;
+  using namespace Krys::IO;
+  namespace fs = std::filesystem;
+
+  constexpr std::array Magic {byte {'K'}, byte {'A'}, byte {'C'}, byte {'I'}};
+  constexpr uint16 Version = 1;
+
+  constexpr stringview IndexName = "index.kaci";
+  constexpr stringview ArtifactExtension = ".bin";
+
+  /// @brief Hash, size and last use.
+  constexpr size_t IndexEntrySize = 3 * sizeof(uint64);
+
+  /// @brief Warming reads one byte per page, which is enough to have the OS read in the whole page.
+  constexpr size_t PageSize = 4096;
+
+  /// @brief Artifacts each warming thread is given at least, so a short list isn't spread over threads.
+  constexpr size_t MinArtifactsPerThread = 4;
+
+  /// @brief Parse an artifact's key from its file name, which is the hash in hex.
+  NO_DISCARD static bool ParseArtifactName(const fs::path &path, uint64 &hash) noexcept
+  {
+    if (path.extension() != ArtifactExtension)
+      return false;
+
+    const string stem = path.stem().string();
+    const auto result = std::from_chars(stem.data(), stem.data() + stem.size(), hash, 16);
+    return stem.size() == 16 && result.ec == std::errc {} && result.ptr == stem.data() + stem.size();
+  }
+
+  /// @brief Write `path` by way of a temporary file, so nothing ever sees it half written.
+  template <typename TFunction>
+  NO_DISCARD static bool WriteAtomically(const string &path, const string &tempPath,
+                                         const TFunction &write) noexcept
+  {
+    bool written;
+    {
+      BufferedWriter writer(tempPath);
+      if (!writer.IsOpen())
+        return false;
+
+      write(writer);
+      written = writer.Flush() && !writer.HasFailed();
+    }
+
+    // Only removed once the writer is closed; Windows won't delete a file that's still open.
+    std::error_code error;
+    if (!written)
+    {
+      fs::remove(tempPath, error);
+      return false;
+    }
+
+    fs::rename(tempPath, path, error);
+    if (!error)
+      return true;
+
+    fs::remove(tempPath, error);
+
+    // The file can't be replaced while something has it mapped. Artifacts never change, so for those the
+    // one already there is as good as ours.
+    return PathExists(path);
+  }
+}
+
+namespace Krys::IO
+{
+  AssetCache::AssetCache(const stringview &directory, uint64 maxSize) noexcept
+      : _directory(directory), _maxSize(maxSize), _instance(std::random_device {}())
+  {
+    std::error_code error;
+    fs::create_directories(_directory, error);
+    if (error)
+    {
+      Logger::Error("AssetCache: Unable to create '{0}': {1}", _directory, error.message());
+      return;
+    }
+
+    LoadIndex();
+
+    std::lock_guard lock(_mutex);
+    Evict({});
+  }
+
+  AssetCache::~AssetCache() noexcept
+  {
+    SaveIndex();
+  }
+
+  AssetKey AssetCache::MakeKey(stringview importer, uint32 version, std::span<const byte> source,
+                               std::span<const byte> settings) noexcept
+  {
+    uint64 seed = HashBytes(std::as_bytes(std::span(importer)));
+    seed = HashBytes(std::as_bytes(std::span(&version, 1)), seed);
+    seed = HashBytes(settings, seed);
+    return AssetKey {HashBytes(source, seed)};
+  }
+
+  MappedFile AssetCache::Load(AssetKey key) noexcept
+  {
+    const string path = GetPath(key);
+    {
+      std::lock_guard lock(_mutex);
+      auto it = _entries.find(key.Hash);
+      if (it != _entries.end())
+      {
+        it->second.LastUse = ++_clock;
+      }
+      else if (PathExists(path))
+      {
+        // Stored by another process since the index was loaded.
+        const uint64 size = static_cast<uint64>(GetFileSize(path));
+        _entries[key.Hash] = Entry {size, ++_clock};
+        _size += size;
+      }
+      else
+      {
+        _misses++;
+        return {};
+      }
+    }
+
+    // It can still be evicted by another cache on the same directory between the check and the mapping.
+    MappedFile file;
+    if (!PathExists(path) || !file.Open(path))
+    {
+      _misses++;
+      return {};
+    }
+
+    _hits++;
+    return file;
+  }
+
+  bool AssetCache::Contains(AssetKey key) const noexcept
+  {
+    {
+      std::lock_guard lock(_mutex);
+      if (_entries.contains(key.Hash))
+        return true;
+    }
+
+    return PathExists(GetPath(key));
+  }
+
+  bool AssetCache::Store(AssetKey key, std::span<const byte> data) noexcept
+  {
+    KRYS_SCOPED_PROFILER("AssetCache::Store");
+
+    const string path = GetPath(key);
+    const string tempPath = std::format("{0}.{1:x}.{2}.tmp", path, _instance, _tempCount++);
+    if (!WriteAtomically(path, tempPath, [&](BufferedWriter &writer) { writer.WriteBytes(data); }))
+    {
+      Logger::Error("AssetCache: Failed to write '{0}'", path);
+      return false;
+    }
+
+    _stores++;
+
+    std::lock_guard lock(_mutex);
+    auto [it, inserted] = _entries.try_emplace(key.Hash, Entry {0, 0});
+    _size = _size - it->second.Size + data.size();
+    it->second = Entry {data.size(), ++_clock};
+
+    Evict(key);
+    return true;
+  }
+
+  std::future<size_t> AssetCache::Warm(List<AssetKey> keys) noexcept
+  {
+    return std::async(
+      std::launch::async,
+      [this, keys = std::move(keys)]() -> size_t
+      {
+        KRYS_SCOPED_PROFILER("AssetCache::Warm");
+
+        std::atomic<size_t> warmed {0};
+        const uint32 count = static_cast<uint32>(keys.size());
+        Concurrency::ParallelForRanges(
+          count, std::max<size_t>(1, keys.size() / MinArtifactsPerThread),
+          [&](uint32 begin, uint32 end)
+          {
+            for (uint32 i = begin; i < end; i++)
+            {
+              if (!Contains(keys[i]))
+                continue;
+
+              MappedFile file;
+              if (!file.Open(GetPath(keys[i])))
+                continue;
+
+              // Reading through a volatile pointer keeps the reads from being optimised away.
+              const volatile byte *data = file.GetData();
+              byte sum {0};
+              for (size_t offset = 0; offset < file.GetSize(); offset += PageSize)
+                sum ^= data[offset];
+              (void)sum;
+
+              {
+                std::lock_guard lock(_mutex);
+                if (auto it = _entries.find(keys[i].Hash); it != _entries.end())
+                  it->second.LastUse = ++_clock;
+              }
+
+              warmed++;
+              _prefetched++;
+            }
+          });
+
+        return warmed.load();
+      });
+  }
+
+  bool AssetCache::SaveIndex() noexcept
+  {
+    if (!PathExists(_directory))
+      return false;
+
+    List<std::pair<uint64, Entry>> entries;
+    uint64 clock;
+    {
+      std::lock_guard lock(_mutex);
+      entries.assign(_entries.begin(), _entries.end());
+      clock = _clock;
+    }
+
+    const string path = std::format("{0}/{1}", _directory, IndexName);
+    const string tempPath = std::format("{0}.{1:x}.{2}.tmp", path, _instance, _tempCount++);
+    const auto WriteIndex = [&](BufferedWriter &writer)
+    {
+      writer.WriteBytes(Magic);
+      writer.Write(Version);
+      writer.Write(clock);
+      writer.Write(static_cast<uint32>(entries.size()));
+      for (const auto &[hash, entry] : entries)
+      {
+        writer.Write(hash);
+        writer.Write(entry.Size);
+        writer.Write(entry.LastUse);
+      }
+    };
+
+    const bool written = WriteAtomically(path, tempPath, WriteIndex);
+    if (!written)
+      Logger::Error("AssetCache: Failed to write '{0}'", path);
+
+    return written;
+  }
+
+  AssetCacheStats AssetCache::GetStats() const noexcept
+  {
+    AssetCacheStats stats;
+    stats.Hits = _hits.load();
+    stats.Misses = _misses.load();
+    stats.Stores = _stores.load();
+    stats.Evictions = _evictions.load();
+    stats.Prefetched = _prefetched.load();
+
+    std::lock_guard lock(_mutex);
+    stats.Size = _size;
+    stats.Entries = _entries.size();
+    return stats;
+  }
+
+  const string &AssetCache::GetDirectory() const noexcept
+  {
+    return _directory;
+  }
+
+  string AssetCache::GetPath(AssetKey key) const noexcept
+  {
+    return std::format("{0}/{1:016x}{2}", _directory, key.Hash, ArtifactExtension);
+  }
+
+  void AssetCache::LoadIndex() noexcept
+  {
+    KRYS_SCOPED_PROFILER("AssetCache::LoadIndex");
+
+    // Last uses from the index. Anything it doesn't know about counts as the least recently used.
+    Map<uint64, uint64> lastUses;
+    const string indexPath = std::format("{0}/{1}", _directory, IndexName);
+    if (PathExists(indexPath))
+    {
+      MappedFile file(indexPath);
+      MemoryReader reader(file.GetSpan());
+      const auto magic = reader.ReadSpan(Magic.size());
+      if (std::equal(magic.begin(), magic.end(), Magic.begin(), Magic.end())
+          && reader.Read<uint16>() == Version)
+      {
+        _clock = reader.Read<uint64>();
+        const uint32 count = reader.Read<uint32>();
+        if (count <= reader.GetRemaining() / IndexEntrySize)
+        {
+          lastUses.reserve(count);
+          for (uint32 i = 0; i < count; i++)
+          {
+            const uint64 hash = reader.Read<uint64>();
+            reader.Skip(sizeof(uint64));
+            lastUses[hash] = reader.Read<uint64>();
+          }
+        }
+      }
+      else
+        Logger::Warn("AssetCache: Ignoring invalid index '{0}'", indexPath);
+    }
+
+    // The directory is what's actually cached, the index only adds the order to evict in.
+    std::lock_guard lock(_mutex);
+    std::error_code error;
+    for (const auto &item : fs::directory_iterator(_directory, error))
+    {
+      uint64 hash;
+      if (!item.is_regular_file(error) || !ParseArtifactName(item.path(), hash))
+        continue;
+
+      const uint64 size = item.file_size(error);
+      if (error)
+        continue;
+
+      const auto it = lastUses.find(hash);
+      _entries[hash] = Entry {size, it == lastUses.end() ? 0 : it->second};
+      _size += size;
+    }
+  }
+
+  void AssetCache::Evict(AssetKey keep) noexcept
+  {
+    if (_size <= _maxSize)
+      return;
+
+    List<std::pair<uint64, uint64>> order;
+    order.reserve(_entries.size());
+    for (const auto &[hash, entry] : _entries)
+      order.emplace_back(entry.LastUse, hash);
+    std::sort(order.begin(), order.end());
+
+    for (const auto &[lastUse, hash] : order)
+    {
+      if (_size <= _maxSize)
+        break;
+      if (hash == keep.Hash)
+        continue;
+
+      // An artifact that's mapped can't be deleted on Windows; it stays until a later eviction.
+      std::error_code error;
+      fs::remove(GetPath(AssetKey {hash}), error);
+      if (error)
+        continue;
+
+      _size -= _entries[hash].Size;
+      _entries.erase(hash);
+      _evictions++;
+    }
+  }
+}
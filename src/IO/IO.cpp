@@ -1,12 +1,12 @@
 #include "IO/IO.hpp"
 #include "Debug/Macros.hpp"
 #include "IO/Logger.hpp"
+#include "IO/VFS/VFS.hpp"
 
 #include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <ranges>
-#include <sstream>
 
 namespace Krys::IO
 {
@@ -40,7 +40,6 @@ namespace Krys::IO
       {
         string name {entry.path().stem().string()};
         entries.push_back({name, extension, path});
-        Logger::Info("Name: {0}, Extension: {1}, Path: {2}", name, extension, path);
       }
     };
 
@@ -98,21 +97,18 @@ namespace Krys::IO
 
   NO_DISCARD string ReadFileText(const stringview &path) noexcept
   {
-    KRYS_ASSERT(PathExists(path), "IO: File '{0}' does not exist", path);
+    KRYS_ASSERT(VFS::Exists(path), "IO: File '{0}' does not exist", path);
     KRYS_SCOPED_PROFILER("ReadFileText");
 
-    std::ifstream fileStream(path.data());
-    if (!fileStream.is_open())
+    // Loose files are mapped, so either way the contents are copied once, straight into the result.
+    auto file = VFS::Open(path);
+    if (!file.IsOpen())
     {
       Logger::Info("Unable to open {0}. Are you in the right directory?", path);
       return "";
     }
 
-    std::stringstream buffer;
-    buffer << fileStream.rdbuf();
-    fileStream.close();
-
-    return buffer.str();
+    return string(file.GetText());
   }
 
   bool WriteFileText(const stringview &path, const stringview &content) noexcept
@@ -135,4 +131,11 @@ namespace Krys::IO
   {
     return fs::file_size(path);
   }
+
+  NO_DISCARD int64 GetLastWriteTime(const stringview &path) noexcept
+  {
+    std::error_code error;
+    const auto time = fs::last_write_time(path, error);
+    return error ? 0 : static_cast<int64>(time.time_since_epoch().count());
+  }
 }
\ No newline at end of file
@@ -0,0 +1,750 @@
+#include "IO/Image/BMP.hpp"
+#include "Base/CPU.hpp"
+#include "IO/Logger.hpp"
+#include "IO/Readers/MemoryReader.hpp"
+#include "IO/VFS/VFS.hpp"
+#include "Utils/Concurrency/ParallelFor.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+#if defined(KRYS_COMPILER_VISUAL_STUDIO)
+  #include <immintrin.h>
+#else
+  #include <x86intrin.h>
+#endif
+
+namespace
+{
+  using namespace Krys;
+  using namespace Krys::IO;
+
+  enum class CompressionType : uint32
+  {
+    RGB = 0,
+    RLE8 = 1,
+    RLE4 = 2,
+    Bitfields = 3,
+    AlphaBitfields = 6
+  };
+
+  constexpr size_t FileHeaderSize = 14;
+
+  /// @brief Images with more pixels than this are rejected rather than risk a huge allocation.
+  constexpr uint64 MaxPixels = uint64 {1} << 28;
+
+  /// @brief Images are only split across threads when each band has at least this many output bytes.
+  constexpr size_t MinBandSize = 1024 * 1024;
+
+  struct Header
+  {
+    uint32 Offset;
+    uint32 Size;
+    uint32 Width;
+    uint32 Height;
+    bool TopDown;
+    uint16 BitsPerPixel;
+    CompressionType Compression;
+    uint32 ColorsUsed;
+
+    /// @brief Red, green, blue and alpha masks.
+    Array<uint32, 4> Masks {};
+
+    /// @brief Where the colour table starts, and how big each entry is.
+    size_t PaletteOffset;
+    uint32 PaletteEntrySize;
+
+    /// @brief Set for 32-bit images without masks, whose alpha byte is often left as zero.
+    bool ImplicitAlpha {false};
+  };
+
+  /// @brief How to turn one bitfield of a pixel into an 8-bit channel.
+  struct Channel
+  {
+    uint32 Mask {0};
+
+    /// @brief Shift that brings the top (up to) 8 bits of the field down to bit 0.
+    uint32 Shift {0};
+
+    /// @brief Widens a field of fewer than 8 bits by repeating its bits, i.e. `(value * Multiplier) >>
+    /// PostShift`.
+    uint32 Multiplier {0};
+    uint32 PostShift {0};
+  };
+
+  /// @brief Everything a row decoder needs, built once per image.
+  struct Format
+  {
+    uint32 Width;
+    uint8 Channels;
+
+    /// @brief Palette entries as RGBA bytes in memory order. Indices past the palette read as black.
+    Array<uint32, 256> Palette {};
+
+    Array<Channel, 4> Fields {};
+  };
+
+  using DecodeRowFunction = void (*)(const byte *source, byte *destination, const Format &format) noexcept;
+
+  NO_DISCARD static uint32 PackRGBA(uint8 red, uint8 green, uint8 blue, uint8 alpha) noexcept
+  {
+    const Array<uint8, 4> bytes {red, green, blue, alpha};
+    return std::bit_cast<uint32>(bytes);
+  }
+
+  NO_DISCARD static bool IsRLE(CompressionType compression) noexcept
+  {
+    return compression == CompressionType::RLE4 || compression == CompressionType::RLE8;
+  }
+
+  NO_DISCARD static bool HasBitfields(CompressionType compression) noexcept
+  {
+    return compression == CompressionType::Bitfields || compression == CompressionType::AlphaBitfields;
+  }
+
+#pragma region Header
+
+  static Expected<Header> ReadHeader(MemoryReader &reader) noexcept
+  {
+    if (reader.GetSize() < FileHeaderSize + 4)
+      return Unexpected("File is too small to be a BMP");
+
+    if (reader.NextByte() != 'B' || reader.NextByte() != 'M')
+      return Unexpected("Invalid BMP magic number");
+
+    Header header;
+    reader.Skip(8); // File size and reserved fields, which writers often get wrong.
+    header.Offset = reader.Read<uint32>();
+    header.Size = reader.Read<uint32>();
+
+    switch (header.Size)
+    {
+      case 12:
+      case 40:
+      case 52:
+      case 56:
+      case 64:
+      case 108:
+      case 124: break;
+      default:  return Unexpected("Unsupported BMP header size");
+    }
+
+    if (reader.GetRemaining() < header.Size - 4)
+      return Unexpected("BMP header is cropped");
+
+    int32 height;
+    if (header.Size == 12)
+    {
+      // BITMAPCOREHEADER: 16-bit dimensions, no compression and 3 byte palette entries.
+      header.Width = reader.Read<uint16>();
+      height = reader.Read<uint16>();
+      reader.Skip(2); // Planes
+      header.BitsPerPixel = reader.Read<uint16>();
+      header.Compression = CompressionType::RGB;
+      header.ColorsUsed = 0;
+      header.PaletteEntrySize = 3;
+    }
+    else
+    {
+      const int32 width = reader.Read<int32>();
+      height = reader.Read<int32>();
+      if (width <= 0)
+        return Unexpected("BMP width must be positive");
+
+      header.Width = static_cast<uint32>(width);
+      reader.Skip(2); // Planes
+      header.BitsPerPixel = reader.Read<uint16>();
+      header.Compression = static_cast<CompressionType>(reader.Read<uint32>());
+      reader.Skip(12); // Image size and resolution
+      header.ColorsUsed = reader.Read<uint32>();
+      reader.Skip(4); // Important colours
+      header.PaletteEntrySize = 4;
+
+      // OS/2 headers reuse compression values 3 and 4 for Huffman and RLE24, neither of which is supported.
+      if (header.Size == 64 && header.Compression != CompressionType::RGB && !IsRLE(header.Compression))
+        return Unexpected("Unsupported OS/2 BMP compression");
+    }
+
+    if (height == 0 || height == std::numeric_limits<int32>::min())
+      return Unexpected("Invalid BMP height");
+
+    header.TopDown = height < 0;
+    header.Height = static_cast<uint32>(header.TopDown ? -height : height);
+
+    const bool hasBitfields = HasBitfields(header.Compression);
+    if (header.Size >= 52 && header.Size != 64)
+    {
+      // V2 and later headers carry the masks themselves.
+      const uint32 maskCount = header.Size >= 56 ? 4 : 3;
+      reader.Seek(FileHeaderSize + 40);
+      for (uint32 i = 0; i < maskCount; i++)
+        header.Masks[i] = reader.Read<uint32>();
+    }
+
+    header.PaletteOffset = FileHeaderSize + header.Size;
+    if (header.Size == 40 && hasBitfields)
+    {
+      // BITMAPINFOHEADER puts the masks straight after the header.
+      const uint32 maskCount = header.Compression == CompressionType::AlphaBitfields ? 4 : 3;
+      if (reader.GetSize() < header.PaletteOffset + maskCount * 4)
+        return Unexpected("BMP colour masks are missing");
+
+      reader.Seek(header.PaletteOffset);
+      for (uint32 i = 0; i < maskCount; i++)
+        header.Masks[i] = reader.Read<uint32>();
+      header.PaletteOffset += maskCount * 4;
+    }
+
+    if (!hasBitfields)
+    {
+      // Without BI_BITFIELDS any masks in the header are ignored in favour of the defaults.
+      if (header.BitsPerPixel == 16)
+        header.Masks = {31u << 10, 31u << 5, 31u, 0};
+      else if (header.BitsPerPixel == 32)
+      {
+        header.Masks = {0xffu << 16, 0xffu << 8, 0xffu, 0xffu << 24};
+        header.ImplicitAlpha = true;
+      }
+      else
+        header.Masks = {};
+    }
+
+    return header;
+  }
+
+  static Expected<void> Validate(const Header &header, size_t fileSize) noexcept
+  {
+    if (static_cast<uint64>(header.Width) * header.Height > MaxPixels)
+      return Unexpected("BMP is too large");
+
+    switch (header.BitsPerPixel)
+    {
+      case 1:
+      case 2:
+      case 4:
+      case 8:
+      case 16:
+      case 24:
+      case 32: break;
+      default: return Unexpected("Unsupported BMP bit depth");
+    }
+
+    switch (header.Compression)
+    {
+      case CompressionType::RGB: break;
+      case CompressionType::RLE8:
+        if (header.BitsPerPixel != 8)
+          return Unexpected("RLE8 requires 8 bits per pixel");
+        break;
+      case CompressionType::RLE4:
+        if (header.BitsPerPixel != 4)
+          return Unexpected("RLE4 requires 4 bits per pixel");
+        break;
+      case CompressionType::Bitfields:
+      case CompressionType::AlphaBitfields:
+        if (header.BitsPerPixel != 16 && header.BitsPerPixel != 32)
+          return Unexpected("BI_BITFIELDS requires 16 or 32 bits per pixel");
+        break;
+      default: return Unexpected("Unsupported BMP compression");
+    }
+
+    if (header.TopDown && IsRLE(header.Compression))
+      return Unexpected("Compressed BMPs can't be top-down");
+
+    if (header.BitsPerPixel == 16 || header.BitsPerPixel == 32)
+    {
+      // Colour masks must be non-empty, contiguous and not overlap.
+      uint32 seen = 0;
+      for (uint32 i = 0; i < 4; i++)
+      {
+        const uint32 mask = header.Masks[i];
+        if (mask == 0)
+        {
+          if (i < 3)
+            return Unexpected("BMP colour mask is empty");
+          continue;
+        }
+
+        if ((mask & seen) != 0 || !std::has_single_bit((mask >> std::countr_zero(mask)) + 1ull))
+          return Unexpected("Invalid BMP colour mask");
+        seen |= mask;
+      }
+
+      if (header.BitsPerPixel == 16 && (seen >> 16) != 0)
+        return Unexpected("BMP colour mask is wider than a pixel");
+    }
+
+    if (header.Offset < header.PaletteOffset || header.Offset > fileSize)
+      return Unexpected("Invalid BMP pixel data offset");
+
+    return {};
+  }
+
+  static Expected<void> ReadPalette(MemoryReader &reader, const Header &header, BMPImage &image,
+                                    Format &format) noexcept
+  {
+    const uint32 maxEntries = 1u << header.BitsPerPixel;
+    const uint32 entries = header.ColorsUsed == 0 ? maxEntries : header.ColorsUsed;
+    if (entries > maxEntries)
+      return Unexpected("BMP palette is too large");
+
+    if (header.PaletteOffset + static_cast<size_t>(entries) * header.PaletteEntrySize > header.Offset)
+      return Unexpected("BMP palette overlaps the pixel data");
+
+    reader.Seek(header.PaletteOffset);
+    image.Palette.resize(entries);
+    for (uint32 i = 0; i < entries; i++)
+    {
+      auto &entry = image.Palette[i];
+      entry.Blue = reader.NextByte();
+      entry.Green = reader.NextByte();
+      entry.Red = reader.NextByte();
+      entry.Alpha = header.PaletteEntrySize == 4 ? reader.NextByte() : 0xFF;
+      format.Palette[i] = PackRGBA(entry.Red, entry.Green, entry.Blue, 0xFF);
+    }
+
+    // Out of range indices read as black rather than past the palette.
+    for (uint32 i = entries; i < format.Palette.size(); i++)
+      format.Palette[i] = PackRGBA(0, 0, 0, 0xFF);
+
+    return {};
+  }
+
+  static void BuildChannels(const Header &header, Format &format) noexcept
+  {
+    // Multipliers that repeat an n-bit value to fill 8 bits, e.g. 5 bits abcde -> abcdeabc.
+    static constexpr Array<uint32, 9> s_Multipliers {0, 0xff, 0x55, 0x49, 0x11, 0x21, 0x41, 0x81, 0x01};
+    static constexpr Array<uint32, 9> s_PostShifts {0, 0, 0, 1, 0, 2, 4, 6, 0};
+
+    for (uint32 i = 0; i < 4; i++)
+    {
+      const uint32 mask = header.Masks[i];
+      if (mask == 0)
+        continue;
+
+      const uint32 bits = static_cast<uint32>(std::popcount(mask));
+      const uint32 kept = std::min(bits, 8u);
+      auto &field = format.Fields[i];
+      field.Mask = mask;
+      field.Shift = static_cast<uint32>(std::countr_zero(mask)) + bits - kept;
+      field.Multiplier = s_Multipliers[kept];
+      field.PostShift = s_PostShifts[kept];
+    }
+  }
+
+#pragma endregion Header
+
+#pragma region Rows
+
+  NO_DISCARD static uint8 ExtractField(uint32 pixel, const Channel &field) noexcept
+  {
+    if (field.Mask == 0)
+      return 0xFF;
+    return static_cast<uint8>((((pixel & field.Mask) >> field.Shift) * field.Multiplier) >> field.PostShift);
+  }
+
+  template <uint32 TBits>
+  static void DecodeIndexedRow(const byte *source, byte *destination, const Format &format) noexcept
+  {
+    constexpr uint32 PixelsPerByte = 8 / TBits;
+    constexpr uint32 IndexMask = (1u << TBits) - 1;
+
+    const auto IndexAt = [&](uint32 x)
+    {
+      const uint32 value = std::to_integer<uint32>(source[x / PixelsPerByte]);
+      return (value >> (8 - TBits - (x % PixelsPerByte) * TBits)) & IndexMask;
+    };
+
+    // Palette images are always RGB; each 4 byte store is overwritten by the next pixel.
+    const uint32 last = format.Width - 1;
+    for (uint32 x = 0; x < last; x++)
+      std::memcpy(destination + x * 3, &format.Palette[IndexAt(x)], 4);
+    std::memcpy(destination + last * 3, &format.Palette[IndexAt(last)], 3);
+  }
+
+  static void DecodeBGRRowScalar(const byte *source, byte *destination, uint32 count) noexcept
+  {
+    for (uint32 x = 0; x < count; x++)
+    {
+      destination[x * 3 + 0] = source[x * 3 + 2];
+      destination[x * 3 + 1] = source[x * 3 + 1];
+      destination[x * 3 + 2] = source[x * 3 + 0];
+    }
+  }
+
+  static void DecodeBGRRow(const byte *source, byte *destination, const Format &format) noexcept
+  {
+    DecodeBGRRowScalar(source, destination, format.Width);
+  }
+
+  KRYS_TARGET("ssse3")
+  static void DecodeBGRRowSSSE3(const byte *source, byte *destination, const Format &format) noexcept
+  {
+    // Reverse five 3 byte pixels per 16 byte load; the 16th byte is rewritten by the next store.
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+    const size_t size = static_cast<size_t>(format.Width) * 3;
+
+    size_t i = 0;
+    for (; i + 16 <= size; i += 15)
+    {
+      const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), _mm_shuffle_epi8(pixels, shuffle));
+    }
+
+    DecodeBGRRowScalar(source + i, destination + i, static_cast<uint32>((size - i) / 3));
+  }
+
+  /// @brief Fallback for 32-bit pixels in the default BGRA layout.
+  static void DecodeBGRARowScalar(const byte *source, byte *destination, uint32 count,
+                                  uint8 channels) noexcept
+  {
+    for (uint32 x = 0; x < count; x++)
+    {
+      destination[x * channels + 0] = source[x * 4 + 2];
+      destination[x * channels + 1] = source[x * 4 + 1];
+      destination[x * channels + 2] = source[x * 4 + 0];
+      if (channels == 4)
+        destination[x * 4 + 3] = source[x * 4 + 3];
+    }
+  }
+
+  static void DecodeBGRARow(const byte *source, byte *destination, const Format &format) noexcept
+  {
+    DecodeBGRARowScalar(source, destination, format.Width, format.Channels);
+  }
+
+  KRYS_TARGET("ssse3")
+  static void DecodeBGRARowSSSE3(const byte *source, byte *destination, const Format &format) noexcept
+  {
+    uint32 x = 0;
+    if (format.Channels == 4)
+    {
+      const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+      for (; x + 4 <= format.Width; x += 4)
+      {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + x * 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + x * 4), _mm_shuffle_epi8(pixels, shuffle));
+      }
+    }
+    else
+    {
+      // Drop the unused byte: 4 pixels become 12 bytes, and the last 4 are rewritten by the next store.
+      const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+      for (; x + 6 <= format.Width; x += 4)
+      {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + x * 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + x * 3), _mm_shuffle_epi8(pixels, shuffle));
+      }
+    }
+
+    DecodeBGRARowScalar(source + x * 4, destination + x * format.Channels, format.Width - x, format.Channels);
+  }
+
+  /// @brief Any other 16/32-bit layout, four pixels at a time with SSE2.
+  template <uint32 TBytes>
+  static void DecodeBitfieldRow(const byte *source, byte *destination, const Format &format) noexcept
+  {
+    Array<uint32, 4> pixels;
+    uint32 x = 0;
+    for (; x + 4 <= format.Width; x += 4)
+    {
+      __m128i values;
+      if constexpr (TBytes == 2)
+        values = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(source + x * 2)),
+                                    _mm_setzero_si128());
+      else
+        values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + x * 4));
+
+      __m128i rgba = _mm_setzero_si128();
+      for (uint32 i = 0; i < 4; i++)
+      {
+        const auto &field = format.Fields[i];
+        __m128i channel;
+        if (field.Mask == 0)
+          channel = _mm_set1_epi32(0xFF);
+        else
+        {
+          channel = _mm_and_si128(values, _mm_set1_epi32(static_cast<int32>(field.Mask)));
+          channel = _mm_srl_epi32(channel, _mm_cvtsi32_si128(static_cast<int32>(field.Shift)));
+
+          // Channels are at most 8 bits here, so a 16-bit multiply can't overflow.
+          channel = _mm_mullo_epi16(channel, _mm_set1_epi32(static_cast<int32>(field.Multiplier)));
+          channel = _mm_srl_epi32(channel, _mm_cvtsi32_si128(static_cast<int32>(field.PostShift)));
+        }
+
+        rgba = _mm_or_si128(rgba, _mm_sll_epi32(channel, _mm_cvtsi32_si128(static_cast<int32>(i * 8))));
+      }
+
+      if (format.Channels == 4)
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + x * 4), rgba);
+      else
+      {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pixels.data()), rgba);
+        for (uint32 i = 0; i < 4; i++)
+          std::memcpy(destination + (x + i) * 3, &pixels[i], 3);
+      }
+    }
+
+    for (; x < format.Width; x++)
+    {
+      uint32 pixel = 0;
+      std::memcpy(&pixel, source + x * TBytes, TBytes);
+      const uint32 rgba =
+        PackRGBA(ExtractField(pixel, format.Fields[0]), ExtractField(pixel, format.Fields[1]),
+                 ExtractField(pixel, format.Fields[2]), ExtractField(pixel, format.Fields[3]));
+      std::memcpy(destination + x * format.Channels, &rgba, format.Channels);
+    }
+  }
+
+  NO_DISCARD static DecodeRowFunction SelectRowDecoder(const Header &header) noexcept
+  {
+    const bool ssse3 = CPU::HasSSSE3();
+    switch (header.BitsPerPixel)
+    {
+      case 1:  return DecodeIndexedRow<1>;
+      case 2:  return DecodeIndexedRow<2>;
+      case 4:  return DecodeIndexedRow<4>;
+      case 8:  return DecodeIndexedRow<8>;
+      case 16: return DecodeBitfieldRow<2>;
+      case 24: return ssse3 ? DecodeBGRRowSSSE3 : DecodeBGRRow;
+      default: break;
+    }
+
+    const auto &masks = header.Masks;
+    const bool isBGRA = masks[0] == 0xffu << 16 && masks[1] == 0xffu << 8 && masks[2] == 0xffu
+                        && (masks[3] == 0 || masks[3] == 0xffu << 24);
+    if (isBGRA)
+      return ssse3 ? DecodeBGRARowSSSE3 : DecodeBGRARow;
+    return DecodeBitfieldRow<4>;
+  }
+
+  /// @brief Run `decodeRows(begin, end)` over all rows, split into bands across threads if the image is
+  /// large enough for that to pay off.
+  template <typename TFunction>
+  static void ForEachRowBand(uint32 height, size_t rowSize, const TFunction &decodeRows) noexcept
+  {
+    Concurrency::ParallelForRanges(height, std::max<size_t>(1, (rowSize * height) / MinBandSize), decodeRows);
+  }
+
+#pragma endregion Rows
+
+#pragma region RLE
+
+  /// @brief Expand RLE4/RLE8 data into one palette index per pixel, in file row order. Pixels skipped by
+  /// deltas or early line ends stay at index 0; anything outside the image is dropped.
+  static Expected<void> DecodeRLE(std::span<const byte> data, const Header &header,
+                                  List<uint8> &indices) noexcept
+  {
+    const bool isRLE4 = header.Compression == CompressionType::RLE4;
+    const uint32 width = header.Width;
+    const uint32 height = header.Height;
+
+    size_t i = 0;
+    uint32 x = 0;
+    uint32 y = 0;
+
+    const auto At = [&](size_t offset) { return std::to_integer<uint8>(data[offset]); };
+    const auto Put = [&](uint8 index)
+    {
+      if (x < width && y < height)
+        indices[static_cast<size_t>(y) * width + x] = index;
+      x++;
+    };
+
+    while (i + 2 <= data.size())
+    {
+      const uint8 count = At(i);
+      const uint8 value = At(i + 1);
+      i += 2;
+
+      if (count > 0)
+      {
+        if (!isRLE4)
+        {
+          if (y < height && x < width)
+          {
+            uint8 *row = indices.data() + static_cast<size_t>(y) * width;
+            std::memset(row + x, value, std::min<uint32>(count, width - x));
+          }
+          x += count;
+        }
+        else
+          for (uint32 k = 0; k < count; k++)
+            Put(static_cast<uint8>((k & 1) ? (value & 0x0F) : (value >> 4)));
+        continue;
+      }
+
+      switch (value)
+      {
+        case 0: // End of line
+          x = 0;
+          y++;
+          break;
+        case 1: // End of bitmap
+          return {};
+        case 2: // Delta
+          if (i + 2 > data.size())
+            return Unexpected("BMP RLE delta is cropped");
+          x += At(i);
+          y += At(i + 1);
+          i += 2;
+          break;
+        default:
+        {
+          // Absolute run of `value` pixels, padded to a 16-bit boundary.
+          const size_t size = isRLE4 ? (value + 1u) / 2 : value;
+          if (i + size > data.size())
+            return Unexpected("BMP RLE absolute run is cropped");
+
+          for (uint32 k = 0; k < value; k++)
+          {
+            const uint8 packed = At(i + (isRLE4 ? k / 2 : k));
+            Put(isRLE4 ? static_cast<uint8>((k & 1) ? (packed & 0x0F) : (packed >> 4)) : packed);
+          }
+          i += (size + 1) & ~size_t {1};
+          break;
+        }
+      }
+    }
+
+    // Some writers leave out the end of bitmap marker, which is fine as long as every row was written.
+    if (y < height)
+      return Unexpected("BMP RLE data is cropped");
+    return {};
+  }
+
+#pragma endregion RLE
+
+  static Expected<Unique<BMPImage>> Decode(std::span<const byte> file, bool flipVertically) noexcept
+  {
+    MemoryReader reader(file);
+    auto header = ReadHeader(reader);
+    if (!header)
+      return Unexpected(header.error());
+
+    if (auto valid = Validate(*header, file.size()); !valid)
+      return Unexpected(valid.error());
+
+    auto image = CreateUnique<BMPImage>();
+    image->Width = header->Width;
+    image->Height = header->Height;
+    image->Channels = header->Masks[3] != 0 ? 4 : 3;
+
+    Format format;
+    format.Width = header->Width;
+    format.Channels = image->Channels;
+    if (header->BitsPerPixel <= 8)
+    {
+      if (auto palette = ReadPalette(reader, *header, *image, format); !palette)
+        return Unexpected(palette.error());
+    }
+    else
+      BuildChannels(*header, format);
+
+    const size_t width = header->Width;
+    const size_t height = header->Height;
+    const size_t outputRowSize = width * image->Channels;
+    image->Data.resize(outputRowSize * height);
+
+    // Rows are stored bottom-up unless the height was negative.
+    const bool sameOrder = header->TopDown != flipVertically;
+    const auto DestinationRow = [&](size_t row)
+    { return image->Data.data() + (sameOrder ? row : height - 1 - row) * outputRowSize; };
+
+    const auto pixels = file.subspan(header->Offset);
+    if (IsRLE(header->Compression))
+    {
+      List<uint8> indices(width * height, 0);
+      if (auto decoded = DecodeRLE(pixels, *header, indices); !decoded)
+        return Unexpected(decoded.error());
+
+      const auto indexedRows = std::as_bytes(std::span(indices));
+      ForEachRowBand(header->Height, outputRowSize,
+                     [&](uint32 begin, uint32 end)
+                     {
+                       for (size_t row = begin; row < end; row++)
+                         DecodeIndexedRow<8>(indexedRows.data() + row * width, DestinationRow(row), format);
+                     });
+      return image;
+    }
+
+    // Rows are padded to 4 bytes, except that the last row's padding is often left out.
+    const size_t stride = ((width * header->BitsPerPixel + 31) / 32) * 4;
+    const size_t lastRowSize = (width * header->BitsPerPixel + 7) / 8;
+    if (pixels.size() < stride * (height - 1) + lastRowSize)
+      return Unexpected("BMP pixel data is cropped");
+
+    const auto DecodeRow = SelectRowDecoder(*header);
+    ForEachRowBand(header->Height, outputRowSize,
+                   [&](uint32 begin, uint32 end)
+                   {
+                     for (size_t row = begin; row < end; row++)
+                       DecodeRow(pixels.data() + row * stride, DestinationRow(row), format);
+                   });
+
+    if (header->ImplicitAlpha)
+    {
+      // 32-bit images without masks usually leave the spare byte as zero rather than meaning transparent.
+      auto &data = image->Data;
+      bool anyAlpha = false;
+      for (size_t i = 3; i < data.size() && !anyAlpha; i += 4)
+        anyAlpha = data[i] != byte {0};
+
+      if (!anyAlpha)
+        for (size_t i = 3; i < data.size(); i += 4)
+          data[i] = byte {0xFF};
+    }
+
+    return image;
+  }
+}
+
+namespace Krys::IO
+{
+  bool BMP::IsBMP(BufferedReader &reader) noexcept
+  {
+    const size_t position = reader.GetPosition();
+    const bool isBMP = reader.NextByte() == 'B' && reader.NextByte() == 'M';
+    reader.Seek(position);
+    return isBMP;
+  }
+
+  Unique<BMPImage> BMP::Load(const string &path, bool flipVertically) noexcept
+  {
+    const auto file = VFS::Open(path);
+    if (!file.IsOpen())
+    {
+      return nullptr;
+    }
+
+    // Over memory the reader hands back the whole file, so it's decoded in place.
+    BufferedReader reader(CreateUnique<MemoryReadSource>(file.GetSpan()));
+    return Load(reader, flipVertically);
+  }
+
+  Unique<BMPImage> BMP::Load(BufferedReader &reader, bool flipVertically) noexcept
+  {
+    // Offsets in the file are absolute, so decode from the whole source. In-memory sources are decoded in
+    // place; anything else is read into memory once.
+    auto file = reader.GetContiguous();
+    List<byte> copy;
+    if (file.empty())
+    {
+      copy.resize(reader.GetSize());
+      reader.Seek(0);
+      reader.ReadBytes(copy.data(), copy.size());
+      file = copy;
+    }
+
+    auto image = Decode(file, flipVertically);
+    if (!image)
+    {
+      Logger::Error("BMP: {0}", image.error());
+      return nullptr;
+    }
+
+    return std::move(*image);
+  }
+}
@@ -0,0 +1,216 @@
+#include "IO/Image/KTEX.hpp"
+#include "Debug/Macros.hpp"
+#include "IO/Logger.hpp"
+#include "IO/Readers/MemoryReader.hpp"
+#include "IO/VFS/VFS.hpp"
+#include "IO/Writers/BufferedWriter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <format>
+#include <random>
+
+namespace
+{
+  using namespace Krys;
+  using namespace Krys::IO;
+
+  constexpr std::array Magic {byte {'K'}, byte {'T'}, byte {'E'}, byte {'X'}};
+  constexpr uint16 Version = 2;
+
+  /// @brief Magic, version, channels, format, quality, level count, reserved, width, height and source hash.
+  constexpr size_t HeaderSize = 28;
+  constexpr size_t LevelSize = 24;
+
+  /// @brief Enough levels for a 2^31 pixel wide image, anything more is corrupt.
+  constexpr uint8 MaxLevels = 32;
+
+  NO_DISCARD static uint64 GetDataOffset(size_t levelCount) noexcept
+  {
+    const uint64 tableEnd = HeaderSize + LevelSize * levelCount;
+    return (tableEnd + KTEX::DataAlignment - 1) / KTEX::DataAlignment * KTEX::DataAlignment;
+  }
+
+  NO_DISCARD static Expected<Unique<KTEXImage>> Decode(std::span<const byte> file) noexcept
+  {
+    if (file.size() < HeaderSize)
+      return Unexpected("File is too small");
+
+    MemoryReader reader(file);
+    const auto magic = reader.ReadSpan(Magic.size());
+    if (!std::equal(magic.begin(), magic.end(), Magic.begin()))
+      return Unexpected("Invalid KTEX header");
+
+    if (reader.Read<uint16>() != Version)
+      return Unexpected("Unsupported KTEX version");
+
+    auto image = CreateUnique<KTEXImage>();
+    image->Channels = reader.Read<uint8>();
+    image->Format = reader.Read<uint8>();
+    image->Quality = reader.Read<uint8>();
+    const uint8 levelCount = reader.Read<uint8>();
+    reader.Skip(sizeof(uint16));
+    image->Width = reader.Read<uint32>();
+    image->Height = reader.Read<uint32>();
+    image->SourceHash = reader.Read<uint64>();
+
+    if (image->Width == 0 || image->Height == 0)
+      return Unexpected("Invalid KTEX dimensions");
+    if (image->Channels == 0 || image->Channels > 4)
+      return Unexpected("Invalid KTEX channel count");
+    if (levelCount == 0 || levelCount > MaxLevels)
+      return Unexpected("Invalid KTEX level count");
+    if (reader.GetRemaining() < LevelSize * levelCount)
+      return Unexpected("Level table is cropped");
+
+    // The levels must follow each other without gaps, so they can be handed over as one block.
+    uint64 offset = GetDataOffset(levelCount);
+    image->Levels.reserve(levelCount);
+    for (uint8 i = 0; i < levelCount; i++)
+    {
+      auto &level = image->Levels.emplace_back();
+      level.Width = reader.Read<uint32>();
+      level.Height = reader.Read<uint32>();
+      level.Offset = reader.Read<uint64>();
+      level.Size = reader.Read<uint64>();
+
+      if (level.Width != std::max(image->Width >> i, 1u) || level.Height != std::max(image->Height >> i, 1u))
+        return Unexpected("Invalid KTEX level dimensions");
+      if (level.Offset != offset || offset > file.size() || level.Size > file.size() - offset)
+        return Unexpected("Level data is cropped");
+
+      offset += level.Size;
+    }
+
+    const uint64 dataOffset = image->Levels.front().Offset;
+    image->Data = file.subspan(static_cast<size_t>(dataOffset), static_cast<size_t>(offset - dataOffset));
+    return image;
+  }
+
+  /// @brief Check `image` is what `KTEX::Save` can write, logging why if it isn't.
+  NO_DISCARD static bool CanSave(stringview name, const KTEXImage &image) noexcept
+  {
+    uint64 total = 0;
+    for (const auto &level : image.Levels)
+      total += level.Size;
+
+    if (image.Levels.empty() || image.Levels.size() > MaxLevels || total != image.Data.size())
+    {
+      Logger::Error("KTEX: Levels don't match the data for '{0}'", name);
+      return false;
+    }
+
+    return true;
+  }
+
+  static void Encode(BufferedWriter &writer, const KTEXImage &image) noexcept
+  {
+    writer.WriteBytes(Magic);
+    writer.Write(Version);
+    writer.Write(image.Channels);
+    writer.Write(image.Format);
+    writer.Write(image.Quality);
+    writer.Write(static_cast<uint8>(image.Levels.size()));
+    writer.Write(uint16 {0});
+    writer.Write(image.Width);
+    writer.Write(image.Height);
+    writer.Write(image.SourceHash);
+
+    const uint64 dataOffset = GetDataOffset(image.Levels.size());
+    uint64 offset = dataOffset;
+    for (size_t i = 0; i < image.Levels.size(); i++)
+    {
+      writer.Write(std::max(image.Width >> i, 1u));
+      writer.Write(std::max(image.Height >> i, 1u));
+      writer.Write(offset);
+      writer.Write(image.Levels[i].Size);
+      offset += image.Levels[i].Size;
+    }
+
+    const List<byte> padding(static_cast<size_t>(dataOffset - writer.GetPosition()));
+    writer.WriteBytes(padding);
+    writer.WriteBytes(image.Data);
+  }
+}
+
+namespace Krys::IO
+{
+  Unique<KTEXImage> KTEX::Load(const string &path) noexcept
+  {
+    auto file = VFS::Open(path);
+    if (!file.IsOpen())
+    {
+      return nullptr;
+    }
+
+    auto image = Load(file.GetSpan());
+    if (image)
+      image->File = std::move(file);
+
+    return image;
+  }
+
+  Unique<KTEXImage> KTEX::Load(std::span<const byte> data) noexcept
+  {
+    auto image = Decode(data);
+    if (!image)
+    {
+      Logger::Error("KTEX: {0}", image.error());
+      return nullptr;
+    }
+
+    return std::move(*image);
+  }
+
+  bool KTEX::Save(const string &path, const KTEXImage &image) noexcept
+  {
+    KRYS_SCOPED_PROFILER("KTEX::Save");
+
+    if (!CanSave(path, image))
+      return false;
+
+    // Written to a temporary file and renamed into place, so a crash or a full disk never leaves a partial
+    // texture where the loader will find it.
+    namespace fs = std::filesystem;
+    const string tempPath = std::format("{0}.{1:x}.tmp", path, std::random_device {}());
+    bool written;
+    {
+      BufferedWriter writer(tempPath);
+      if (!writer.IsOpen())
+      {
+        Logger::Error("KTEX: Unable to open '{0}' for writing", tempPath);
+        return false;
+      }
+
+      Encode(writer, image);
+      written = writer.Flush() && !writer.HasFailed();
+    }
+
+    // The rename fails on Windows while the old file is mapped, in which case it's kept.
+    std::error_code error;
+    if (written)
+      fs::rename(tempPath, path, error);
+
+    if (!written || error)
+    {
+      Logger::Error("KTEX: Failed to write '{0}'", path);
+      fs::remove(tempPath, error);
+      return false;
+    }
+
+    return true;
+  }
+
+  bool KTEX::Save(List<byte> &buffer, const KTEXImage &image) noexcept
+  {
+    KRYS_SCOPED_PROFILER("KTEX::Save");
+    if (!CanSave("buffer", image))
+      return false;
+
+    buffer.clear();
+    BufferedWriter writer(CreateUnique<MemoryWriteTarget>(buffer));
+    Encode(writer, image);
+    return writer.Flush() && !writer.HasFailed();
+  }
+}
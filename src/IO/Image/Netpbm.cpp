@@ -0,0 +1,225 @@
+#include "IO/Image/Netpbm.hpp"
+#include "Base/Endian.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+#if defined(KRYS_COMPILER_VISUAL_STUDIO)
+  #include <immintrin.h>
+#else
+  #include <x86intrin.h>
+#endif
+
+namespace
+{
+  using namespace Krys;
+
+  NO_DISCARD static bool IsWhitespace(char c) noexcept
+  {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+  }
+
+  NO_DISCARD static const char *SkipWhitespace(const char *cursor, const char *end) noexcept
+  {
+    while (cursor != end)
+    {
+      if (IsWhitespace(*cursor))
+        cursor++;
+      else if (*cursor == '#')
+        while (cursor != end && *cursor != '\n')
+          cursor++;
+      else
+        break;
+    }
+
+    return cursor;
+  }
+
+  /// @brief Scale `value` from [0, maxValue] to [0, 255] or [0, 65535], depending on the sample size.
+  NO_DISCARD static uint32 Scale(uint32 value, uint32 maxValue, uint32 outputMax) noexcept
+  {
+    value = std::min(value, maxValue);
+    return (value * outputMax + maxValue / 2) / maxValue;
+  }
+
+  static void StoreSample(byte *samples, size_t index, uint32 value, uint16 maxValue) noexcept
+  {
+    if (maxValue > 255)
+    {
+      const auto sample = static_cast<uint16>(Scale(value, maxValue, 65535));
+      std::memcpy(samples + index * 2, &sample, sizeof(sample));
+    }
+    else
+      samples[index] = static_cast<byte>(Scale(value, maxValue, 255));
+  }
+
+  /// @brief Write the 8 pixels of `bits` as 0 (bit set) or 255 (bit clear).
+  static void UnpackByte(uint8 bits, byte *destination, uint32 count) noexcept
+  {
+    for (uint32 i = 0; i < count; i++)
+      destination[i] = (bits & (0x80 >> i)) ? byte {0} : byte {255};
+  }
+
+  static void UnpackRow(const byte *source, byte *destination, uint32 width) noexcept
+  {
+    // Each pair of source bytes is spread across the 16 lanes, 8 copies each, and tested against the bit
+    // for its lane.
+    const __m128i bits = _mm_setr_epi8(-128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1);
+    const __m128i ones = _mm_set1_epi8(-1);
+
+    uint32 x = 0;
+    for (; x + 16 <= width; x += 16, source += 2)
+    {
+      const int pair = std::to_integer<int>(source[0]) | (std::to_integer<int>(source[1]) << 8);
+      __m128i value = _mm_cvtsi32_si128(pair);
+      value = _mm_unpacklo_epi8(value, value);
+      value = _mm_unpacklo_epi16(value, value);
+      value = _mm_unpacklo_epi32(value, value);
+
+      const __m128i set = _mm_cmpeq_epi8(_mm_and_si128(value, bits), bits);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + x), _mm_xor_si128(set, ones));
+    }
+
+    for (; x < width; x += 8, source++)
+      UnpackByte(std::to_integer<uint8>(*source), destination + x, std::min(width - x, 8u));
+  }
+}
+
+namespace Krys::IO::Netpbm
+{
+  std::span<const byte> GetInput(BufferedReader &reader, List<byte> &storage) noexcept
+  {
+    const auto contiguous = reader.GetContiguous();
+    if (!contiguous.empty())
+      return contiguous.subspan(std::min(reader.GetPosition(), contiguous.size()));
+
+    storage.resize(reader.GetRemaining());
+    reader.ReadBytes(storage.data(), storage.size());
+    return storage;
+  }
+
+  void SkipWhitespace(MemoryReader &reader) noexcept
+  {
+    const auto text = reader.GetRemainingSpan();
+    const auto *begin = reinterpret_cast<const char *>(text.data());
+    reader.Skip(::SkipWhitespace(begin, begin + text.size()) - begin);
+  }
+
+  Expected<uint32> ReadNumber(MemoryReader &reader) noexcept
+  {
+    SkipWhitespace(reader);
+
+    const auto text = reader.GetRemainingSpan();
+    const auto *begin = reinterpret_cast<const char *>(text.data());
+    uint32 value = 0;
+    const auto [end, error] = std::from_chars(begin, begin + text.size(), value);
+    if (error != std::errc {})
+      return Unexpected("Expected a number");
+
+    reader.Skip(end - begin);
+    return value;
+  }
+
+  Expected<void> ReadASCIISamples(MemoryReader &reader, uint16 maxValue, std::span<byte> samples) noexcept
+  {
+    const size_t count = samples.size() / GetSampleSize(maxValue);
+
+    // Every sample but the last needs at least a digit and a separator.
+    if (count > (reader.GetRemaining() + 1) / 2)
+      return Unexpected("Pixel data is cropped");
+
+    const auto text = reader.GetRemainingSpan();
+    const auto *begin = reinterpret_cast<const char *>(text.data());
+    const auto *end = begin + text.size();
+    const auto *cursor = begin;
+
+    for (size_t i = 0; i < count; i++)
+    {
+      cursor = ::SkipWhitespace(cursor, end);
+
+      uint32 value = 0;
+      const auto [next, error] = std::from_chars(cursor, end, value);
+      if (error != std::errc {})
+        return Unexpected("Pixel data is cropped or malformed");
+      if (value > maxValue)
+        return Unexpected("Sample is larger than the maximum value");
+
+      StoreSample(samples.data(), i, value, maxValue);
+      cursor = next;
+    }
+
+    reader.Skip(cursor - begin);
+    return {};
+  }
+
+  Expected<void> ReadBinarySamples(MemoryReader &reader, uint16 maxValue, std::span<byte> samples) noexcept
+  {
+    if (reader.GetRemaining() < samples.size())
+      return Unexpected("Pixel data is cropped");
+
+    const auto data = reader.ReadSpan(samples.size());
+    if (maxValue == 255)
+      std::memcpy(samples.data(), data.data(), data.size());
+    else if (maxValue == 65535)
+      Endian::ConvertArray<uint16, Endian::Type::Big, Endian::Type::System>(
+        reinterpret_cast<const uint16 *>(data.data()), samples.data(), data.size() / 2);
+    else if (maxValue > 255)
+    {
+      for (size_t i = 0; i < data.size() / 2; i++)
+      {
+        const uint32 high = std::to_integer<uint32>(data[i * 2]);
+        const uint32 low = std::to_integer<uint32>(data[i * 2 + 1]);
+        StoreSample(samples.data(), i, (high << 8) | low, maxValue);
+      }
+    }
+    else
+    {
+      Array<byte, 256> table;
+      for (uint32 value = 0; value < table.size(); value++)
+        table[value] = static_cast<byte>(Scale(value, maxValue, 255));
+
+      for (size_t i = 0; i < data.size(); i++)
+        samples[i] = table[std::to_integer<uint8>(data[i])];
+    }
+
+    return {};
+  }
+
+  Expected<void> ReadASCIIBits(MemoryReader &reader, std::span<byte> pixels) noexcept
+  {
+    if (pixels.size() > reader.GetRemaining())
+      return Unexpected("Pixel data is cropped");
+
+    const auto text = reader.GetRemainingSpan();
+    const auto *begin = reinterpret_cast<const char *>(text.data());
+    const auto *end = begin + text.size();
+    const auto *cursor = begin;
+
+    for (auto &pixel : pixels)
+    {
+      cursor = ::SkipWhitespace(cursor, end);
+      if (cursor == end || (*cursor != '0' && *cursor != '1'))
+        return Unexpected("Pixel data is cropped or malformed");
+
+      pixel = *cursor++ == '1' ? byte {0} : byte {255};
+    }
+
+    reader.Skip(cursor - begin);
+    return {};
+  }
+
+  Expected<void> ReadBinaryBits(MemoryReader &reader, uint32 width, uint32 height,
+                                std::span<byte> pixels) noexcept
+  {
+    const size_t rowSize = (static_cast<size_t>(width) + 7) / 8;
+    if (reader.GetRemaining() < rowSize * height)
+      return Unexpected("Pixel data is cropped");
+
+    const auto data = reader.ReadSpan(rowSize * height);
+    for (uint32 y = 0; y < height; y++)
+      UnpackRow(data.data() + y * rowSize, pixels.data() + static_cast<size_t>(y) * width, width);
+
+    return {};
+  }
+}
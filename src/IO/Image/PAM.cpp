@@ -0,0 +1,199 @@
+#include "IO/Image/PAM.hpp"
+#include "IO/Image/Netpbm.hpp"
+#include "IO/Logger.hpp"
+#include "IO/Readers/MemoryReader.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <format>
+#include <limits>
+
+namespace
+{
+  using namespace Krys;
+  using namespace Krys::IO;
+
+  struct TupleType
+  {
+    stringview Name;
+    PAMType Type;
+    uint8 Channels;
+  };
+
+  constexpr Array<TupleType, 6> TupleTypes {{
+    {"BLACKANDWHITE", PAMType::BlackAndWhite, 1},
+    {"BLACKANDWHITE_ALPHA", PAMType::BlackAndWhiteAlpha, 2},
+    {"GRAYSCALE", PAMType::Grayscale, 1},
+    {"GRAYSCALE_ALPHA", PAMType::GrayscaleAlpha, 2},
+    {"RGB", PAMType::RGB, 3},
+    {"RGB_ALPHA", PAMType::RGBAlpha, 4},
+  }};
+
+  struct Header
+  {
+    uint32 Width {0};
+    uint32 Height {0};
+    uint32 Depth {0};
+    uint32 MaxValue {0};
+    const TupleType *Type {nullptr};
+  };
+
+  NO_DISCARD static stringview Trim(stringview text) noexcept
+  {
+    constexpr stringview whitespace = " \t\r\v\f";
+    const size_t start = text.find_first_not_of(whitespace);
+    if (start == stringview::npos)
+      return {};
+
+    return text.substr(start, text.find_last_not_of(whitespace) - start + 1);
+  }
+
+  NO_DISCARD static bool EqualsIgnoreCase(stringview a, stringview b) noexcept
+  {
+    return std::ranges::equal(a, b, [](uchar x, uchar y) { return std::toupper(x) == std::toupper(y); });
+  }
+
+  NO_DISCARD static Expected<uint32> ParseNumber(stringview keyword, stringview value) noexcept
+  {
+    uint32 number = 0;
+    const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+    if (error != std::errc {} || end != value.data() + value.size())
+      return Unexpected(std::format("Invalid PAM {0}: '{1}'", keyword, value));
+
+    return number;
+  }
+
+  NO_DISCARD static Expected<Header> ReadHeader(MemoryReader &reader) noexcept
+  {
+    if (Trim(reader.ReadLine()) != "P7")
+      return Unexpected("Invalid PAM header");
+
+    Header header;
+    while (!reader.IsEOS())
+    {
+      const auto line = Trim(reader.ReadLine());
+      if (line.empty() || line.starts_with('#'))
+        continue;
+
+      if (line == "ENDHDR")
+        return header;
+
+      const size_t split = std::min(line.find_first_of(" \t"), line.size());
+      const auto keyword = line.substr(0, split);
+      const auto value = Trim(line.substr(split));
+
+      uint32 *field = keyword == "WIDTH"  ? &header.Width
+                    : keyword == "HEIGHT" ? &header.Height
+                    : keyword == "DEPTH"  ? &header.Depth
+                    : keyword == "MAXVAL" ? &header.MaxValue
+                                          : nullptr;
+      if (field)
+      {
+        const auto number = ParseNumber(keyword, value);
+        if (!number)
+          return Unexpected(number.error());
+
+        *field = *number;
+      }
+      else if (keyword == "TUPLETYPE")
+      {
+        const auto type = std::ranges::find_if(TupleTypes, [&](const TupleType &tupleType)
+                                               { return EqualsIgnoreCase(tupleType.Name, value); });
+        if (type == TupleTypes.end())
+          return Unexpected(std::format("Unsupported PAM type: {0}", value));
+
+        header.Type = &*type;
+      }
+    }
+
+    return Unexpected("PAM header is missing ENDHDR");
+  }
+
+  NO_DISCARD static Expected<void> Validate(Header &header) noexcept
+  {
+    if (header.Width == 0 || header.Height == 0 || header.Depth == 0)
+      return Unexpected(std::format("Invalid PAM image dimensions: {0}x{1}x{2}", header.Width, header.Height,
+                                    header.Depth));
+
+    if (header.MaxValue == 0 || header.MaxValue > std::numeric_limits<uint16>::max())
+      return Unexpected(std::format("Invalid PAM image max value: {0}", header.MaxValue));
+
+    // The tuple type is optional, in which case the common types are inferred from the depth.
+    if (!header.Type)
+    {
+      constexpr Array<size_t, 4> byDepth {2, 3, 4, 5};
+      if (header.Depth > byDepth.size())
+        return Unexpected(std::format("Unsupported PAM depth: {0}", header.Depth));
+
+      header.Type = &TupleTypes[byDepth[header.Depth - 1]];
+    }
+
+    if (header.Depth != header.Type->Channels)
+      return Unexpected(std::format("PAM depth {0} doesn't match {1}", header.Depth, header.Type->Name));
+
+    return {};
+  }
+
+  NO_DISCARD static Expected<Unique<PAMImage>> Decode(MemoryReader &reader) noexcept
+  {
+    auto header = ReadHeader(reader);
+    if (!header)
+      return Unexpected(header.error());
+
+    if (auto valid = Validate(*header); !valid)
+      return Unexpected(valid.error());
+
+    auto image = CreateUnique<PAMImage>();
+    image->Width = header->Width;
+    image->Height = header->Height;
+    image->Channels = header->Type->Channels;
+    image->MaxValue = static_cast<uint16>(header->MaxValue);
+    image->BitsPerChannel = static_cast<uint8>(Netpbm::GetSampleSize(image->MaxValue) * 8);
+    image->Type = header->Type->Type;
+
+    // Check the raster fits in what's left of the file before allocating for it.
+    const uint64 pixels = uint64 {image->Width} * image->Height;
+    const uint64 size = pixels * image->Channels * Netpbm::GetSampleSize(image->MaxValue);
+    if (pixels > reader.GetRemaining() || size > reader.GetRemaining())
+      return Unexpected("Pixel data is cropped");
+
+    image->Data.resize(static_cast<size_t>(size));
+    if (auto samples = Netpbm::ReadBinarySamples(reader, image->MaxValue, image->Data); !samples)
+      return Unexpected(samples.error());
+
+    return image;
+  }
+}
+
+namespace Krys::IO
+{
+  Unique<PAMImage> PAM::Load(const string &path) noexcept
+  {
+    BufferedReader reader(path);
+    if (!reader.IsOpen())
+    {
+      return nullptr;
+    }
+
+    return Load(reader);
+  }
+
+  Unique<PAMImage> PAM::Load(BufferedReader &reader) noexcept
+  {
+    const size_t start = reader.GetPosition();
+    List<byte> storage;
+    MemoryReader input(Netpbm::GetInput(reader, storage));
+
+    auto image = Decode(input);
+    reader.Seek(start + input.GetPosition());
+
+    if (!image)
+    {
+      Logger::Error("PAM: {0}", image.error());
+      return nullptr;
+    }
+
+    return std::move(*image);
+  }
+}
@@ -0,0 +1,686 @@
+#include "IO/Image/PNG.hpp"
+#include "Base/CPU.hpp"
+#include "Base/Endian.hpp"
+#include "Debug/Macros.hpp"
+#include "IO/Logger.hpp"
+#include "IO/VFS/VFS.hpp"
+#include "Utils/Bytes.hpp"
+#include "Utils/Compression.hpp"
+#include "Utils/Concurrency/ParallelFor.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#if defined(KRYS_COMPILER_VISUAL_STUDIO)
+  #include <immintrin.h>
+#else
+  #include <x86intrin.h>
+#endif
+
+namespace
+{
+  using namespace Krys;
+  using namespace Krys::IO;
+
+  constexpr std::array Signature {byte {137}, byte {'P'}, byte {'N'}, byte {'G'},
+                                  byte {13},  byte {10},  byte {26},  byte {10}};
+
+  /// @brief Length, type and CRC.
+  constexpr size_t ChunkOverhead = 12;
+
+  constexpr uint32 MaxDimension = 1u << 24;
+
+  /// @brief Images with more pixels than this are rejected rather than risk a huge allocation.
+  constexpr uint64 MaxPixels = uint64 {1} << 28;
+
+  enum class ColourType : uint8
+  {
+    Grey = 0,
+    RGB = 2,
+    Palette = 3,
+    GreyAlpha = 4,
+    RGBA = 6
+  };
+
+  enum class Filter : uint8
+  {
+    None = 0,
+    Sub = 1,
+    Up = 2,
+    Average = 3,
+    Paeth = 4
+  };
+
+  struct Header
+  {
+    uint32 Width;
+    uint32 Height;
+    uint8 BitDepth;
+    ColourType Colour;
+    bool Interlaced;
+
+    /// @brief Samples per pixel as stored, e.g. 1 for palette indices.
+    uint8 Samples;
+
+    /// @brief Bytes per pixel (at least 1), which is how far back filters look for the pixel to the left.
+    uint32 FilterStride;
+
+    /// @brief Channels of the decoded image.
+    uint8 Channels;
+
+    /// @brief RGBA entries, opaque black where the palette (or its transparency) is shorter than 256.
+    std::array<uint8, 256 * 4> Palette;
+    uint32 PaletteSize {0};
+
+    /// @brief Whether there's a `tRNS` chunk.
+    bool HasTransparency {false};
+
+    /// @brief The transparent colour of grey and RGB images, in samples of `BitDepth` bits.
+    std::array<uint16, 3> TransparentColour {};
+  };
+
+  /// @brief Where an Adam7 pass starts, and how far apart its pixels are.
+  struct Pass
+  {
+    uint32 X;
+    uint32 Y;
+    uint32 XStep;
+    uint32 YStep;
+  };
+
+  constexpr std::array<Pass, 7> Adam7 {
+    {{0, 0, 8, 8}, {4, 0, 8, 8}, {0, 4, 4, 8}, {2, 0, 4, 4}, {0, 2, 2, 4}, {1, 0, 2, 2}, {0, 1, 1, 2}}};
+
+  NO_DISCARD static uint32 ReadBigEndian32(const byte *data) noexcept
+  {
+    return Bytes::AsNumeric<uint32, Endian::Type::Big, Endian::Type::System>(data);
+  }
+
+  NO_DISCARD static uint16 ReadBigEndian16(const byte *data) noexcept
+  {
+    return Bytes::AsNumeric<uint16, Endian::Type::Big, Endian::Type::System>(data);
+  }
+
+  /// @brief Size of a row of `width` pixels as stored, without the filter byte.
+  NO_DISCARD static uint64 GetRowSize(const Header &header, uint32 width) noexcept
+  {
+    return (uint64 {width} * header.Samples * header.BitDepth + 7) / 8;
+  }
+
+  NO_DISCARD static bool IsValidBitDepth(ColourType colour, uint8 depth) noexcept
+  {
+    switch (colour)
+    {
+      case ColourType::Grey: return depth == 1 || depth == 2 || depth == 4 || depth == 8 || depth == 16;
+      case ColourType::Palette: return depth == 1 || depth == 2 || depth == 4 || depth == 8;
+      case ColourType::RGB:
+      case ColourType::GreyAlpha:
+      case ColourType::RGBA: return depth == 8 || depth == 16;
+      default: return false;
+    }
+  }
+
+  NO_DISCARD static Expected<void> ReadHeader(std::span<const byte> chunk, Header &header) noexcept
+  {
+    if (chunk.size() != 13)
+      return Unexpected("Invalid IHDR size");
+
+    header.Width = ReadBigEndian32(chunk.data());
+    header.Height = ReadBigEndian32(chunk.data() + 4);
+    header.BitDepth = static_cast<uint8>(chunk[8]);
+    header.Colour = static_cast<ColourType>(chunk[9]);
+    header.Interlaced = chunk[12] == byte {1};
+
+    if (header.Width == 0 || header.Height == 0)
+      return Unexpected("Image is empty");
+    if (header.Width > MaxDimension || header.Height > MaxDimension
+        || uint64 {header.Width} * header.Height > MaxPixels)
+      return Unexpected("Image is too large");
+    if (!IsValidBitDepth(header.Colour, header.BitDepth))
+      return Unexpected("Unsupported colour type or bit depth");
+    if (chunk[10] != byte {0} || chunk[11] != byte {0} || chunk[12] > byte {1})
+      return Unexpected("Unsupported compression, filter or interlace method");
+
+    switch (header.Colour)
+    {
+      case ColourType::Grey:
+      case ColourType::Palette: header.Samples = 1; break;
+      case ColourType::GreyAlpha: header.Samples = 2; break;
+      case ColourType::RGB: header.Samples = 3; break;
+      case ColourType::RGBA: header.Samples = 4; break;
+    }
+
+    header.FilterStride = std::max(1u, uint32 {header.Samples} * header.BitDepth / 8);
+    header.Channels = header.Colour == ColourType::Palette ? 3 : header.Samples;
+
+    for (uint32 i = 0; i < 256; i++)
+    {
+      header.Palette[i * 4 + 0] = header.Palette[i * 4 + 1] = header.Palette[i * 4 + 2] = 0;
+      header.Palette[i * 4 + 3] = 255;
+    }
+
+    return {};
+  }
+
+  NO_DISCARD static Expected<void> ReadTransparency(std::span<const byte> chunk, Header &header) noexcept
+  {
+    switch (header.Colour)
+    {
+      case ColourType::Palette:
+        if (header.PaletteSize == 0 || chunk.size() > header.PaletteSize)
+          return Unexpected("Invalid palette transparency");
+        for (size_t i = 0; i < chunk.size(); i++)
+          header.Palette[i * 4 + 3] = static_cast<uint8>(chunk[i]);
+        break;
+      case ColourType::Grey:
+        if (chunk.size() != 2)
+          return Unexpected("Invalid grey transparency");
+        header.TransparentColour[0] = ReadBigEndian16(chunk.data());
+        break;
+      case ColourType::RGB:
+        if (chunk.size() != 6)
+          return Unexpected("Invalid RGB transparency");
+        for (size_t i = 0; i < 3; i++)
+          header.TransparentColour[i] = ReadBigEndian16(chunk.data() + i * 2);
+        break;
+      default: return Unexpected("Transparency chunk in an image with alpha");
+    }
+
+    header.HasTransparency = true;
+    header.Channels++;
+    return {};
+  }
+
+  /// @brief Read the chunks the image needs, up to `IEND`.
+  /// @param data Receives the contents of each `IDAT` chunk, which together are one zlib stream.
+  NO_DISCARD static Expected<void> ReadChunks(std::span<const byte> file, Header &header,
+                                              List<std::span<const byte>> &data) noexcept
+  {
+    if (!PNG::IsPNG(file))
+      return Unexpected("Invalid PNG signature");
+
+    bool hasHeader = false;
+    size_t position = Signature.size();
+    while (true)
+    {
+      if (file.size() - position < ChunkOverhead)
+        return Unexpected("File is cropped");
+
+      const uint32 length = ReadBigEndian32(file.data() + position);
+      const auto type = stringview(reinterpret_cast<const char *>(file.data()) + position + 4, 4);
+      if (length > file.size() - position - ChunkOverhead)
+        return Unexpected("Chunk is cropped");
+
+      const auto chunk = file.subspan(position + 8, length);
+      position += ChunkOverhead + length;
+
+      if (!hasHeader && type != "IHDR")
+        return Unexpected("IHDR is not the first chunk");
+
+      if (type == "IHDR")
+      {
+        if (hasHeader)
+          return Unexpected("More than one IHDR");
+        if (auto result = ReadHeader(chunk, header); !result)
+          return result;
+        hasHeader = true;
+      }
+      else if (type == "PLTE")
+      {
+        // Other colour types can suggest a palette for displays that need one, which isn't needed here.
+        if (header.Colour != ColourType::Palette)
+          continue;
+        if (!data.empty() || header.PaletteSize != 0)
+          return Unexpected("Unexpected PLTE");
+        if (chunk.size() % 3 != 0 || chunk.size() / 3 > (1u << header.BitDepth) || chunk.empty())
+          return Unexpected("Invalid palette size");
+
+        header.PaletteSize = static_cast<uint32>(chunk.size() / 3);
+        for (uint32 i = 0; i < header.PaletteSize; i++)
+          for (uint32 c = 0; c < 3; c++)
+            header.Palette[i * 4 + c] = static_cast<uint8>(chunk[i * 3 + c]);
+      }
+      else if (type == "tRNS")
+      {
+        if (!data.empty() || header.HasTransparency)
+          return Unexpected("Unexpected tRNS");
+        if (auto result = ReadTransparency(chunk, header); !result)
+          return result;
+      }
+      else if (type == "IDAT")
+      {
+        if (length > 0)
+          data.push_back(chunk);
+      }
+      else if (type == "IEND")
+        break;
+      else if ((type[0] & 0x20) == 0)
+        return Unexpected("Unknown critical chunk");
+    }
+
+    if (header.Colour == ColourType::Palette && header.PaletteSize == 0)
+      return Unexpected("Missing palette");
+    if (data.empty())
+      return Unexpected("Missing image data");
+
+    return {};
+  }
+
+  NO_DISCARD static uint8 PaethPredictor(uint8 a, uint8 b, uint8 c) noexcept
+  {
+    const int32 p = int32 {a} + b - c;
+    const int32 pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc)
+      return a;
+    return pb <= pc ? b : c;
+  }
+
+  static void UnfilterRowScalar(Filter filter, const uint8 *in, const uint8 *prior, uint8 *out, size_t size,
+                                uint32 stride) noexcept
+  {
+    const size_t first = std::min<size_t>(stride, size);
+    switch (filter)
+    {
+      case Filter::None: std::memcpy(out, in, size); break;
+      case Filter::Sub:
+        std::memcpy(out, in, first);
+        for (size_t i = first; i < size; i++)
+          out[i] = static_cast<uint8>(in[i] + out[i - stride]);
+        break;
+      case Filter::Up:
+        for (size_t i = 0; i < size; i++)
+          out[i] = static_cast<uint8>(in[i] + prior[i]);
+        break;
+      case Filter::Average:
+        for (size_t i = 0; i < first; i++)
+          out[i] = static_cast<uint8>(in[i] + (prior[i] >> 1));
+        for (size_t i = first; i < size; i++)
+          out[i] = static_cast<uint8>(in[i] + ((out[i - stride] + prior[i]) >> 1));
+        break;
+      case Filter::Paeth:
+        for (size_t i = 0; i < first; i++)
+          out[i] = static_cast<uint8>(in[i] + prior[i]);
+        for (size_t i = first; i < size; i++)
+          out[i] = static_cast<uint8>(in[i] + PaethPredictor(out[i - stride], prior[i], prior[i - stride]));
+        break;
+    }
+  }
+
+  // Sub, Average and Paeth depend on the pixel to the left, so the SIMD versions work a pixel at a time,
+  // doing all of a pixel's channels at once. That covers RGB and RGBA, which is what almost every image is.
+
+  // 3 byte pixels are assembled in a register rather than with a 3 byte `memcpy`, which compilers turn into
+  // partial stores to the stack followed by a wider load that can't be forwarded from them.
+
+  template <uint32 TStride>
+  NO_DISCARD static __m128i LoadPixel(const uint8 *data) noexcept
+  {
+    uint32 value;
+    if constexpr (TStride == 4)
+      std::memcpy(&value, data, sizeof(value));
+    else
+      value = uint32 {data[0]} | (uint32 {data[1]} << 8) | (uint32 {data[2]} << 16);
+    return _mm_cvtsi32_si128(static_cast<int>(value));
+  }
+
+  template <uint32 TStride>
+  static void StorePixel(uint8 *data, __m128i pixel) noexcept
+  {
+    const auto value = static_cast<uint32>(_mm_cvtsi128_si32(pixel));
+    if constexpr (TStride == 4)
+      std::memcpy(data, &value, sizeof(value));
+    else
+    {
+      data[0] = static_cast<uint8>(value);
+      data[1] = static_cast<uint8>(value >> 8);
+      data[2] = static_cast<uint8>(value >> 16);
+    }
+  }
+
+  template <uint32 TStride>
+  static void UnfilterSubSSE2(const uint8 *in, uint8 *out, size_t size) noexcept
+  {
+    __m128i left = _mm_setzero_si128();
+    for (size_t i = 0; i < size; i += TStride)
+    {
+      left = _mm_add_epi8(left, LoadPixel<TStride>(in + i));
+      StorePixel<TStride>(out + i, left);
+    }
+  }
+
+  template <uint32 TStride>
+  static void UnfilterAverageSSE2(const uint8 *in, const uint8 *prior, uint8 *out, size_t size) noexcept
+  {
+    // `_mm_avg_epu8` rounds up, so subtract the carry it added when the sum was odd.
+    const __m128i one = _mm_set1_epi8(1);
+    __m128i left = _mm_setzero_si128();
+    for (size_t i = 0; i < size; i += TStride)
+    {
+      const __m128i up = LoadPixel<TStride>(prior + i);
+      const __m128i average =
+        _mm_sub_epi8(_mm_avg_epu8(left, up), _mm_and_si128(_mm_xor_si128(left, up), one));
+      left = _mm_add_epi8(LoadPixel<TStride>(in + i), average);
+      StorePixel<TStride>(out + i, left);
+    }
+  }
+
+  NO_DISCARD static __m128i Abs16(__m128i value) noexcept
+  {
+    return _mm_max_epi16(value, _mm_sub_epi16(_mm_setzero_si128(), value));
+  }
+
+  NO_DISCARD static __m128i Select(__m128i mask, __m128i a, __m128i b) noexcept
+  {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+  }
+
+  template <uint32 TStride>
+  static void UnfilterPaethSSE2(const uint8 *in, const uint8 *prior, uint8 *out, size_t size) noexcept
+  {
+    // Works in 16 bits, where the predictor's differences fit. With p = a + b - c, the distances to a, b
+    // and c are |b - c|, |a - c| and |a + b - 2c|.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i low = _mm_set1_epi16(0xFF);
+    __m128i a = zero, c = zero;
+    for (size_t i = 0; i < size; i += TStride)
+    {
+      const __m128i b = _mm_unpacklo_epi8(LoadPixel<TStride>(prior + i), zero);
+      const __m128i bc = _mm_sub_epi16(b, c);
+      const __m128i ac = _mm_sub_epi16(a, c);
+      const __m128i pa = Abs16(bc);
+      const __m128i pb = Abs16(ac);
+      const __m128i pc = Abs16(_mm_add_epi16(bc, ac));
+
+      // Ties go to a, then b.
+      const __m128i smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+      const __m128i predictor = Select(_mm_cmpeq_epi16(smallest, pa), a,
+                                       Select(_mm_cmpeq_epi16(smallest, pb), b, c));
+
+      const __m128i x = _mm_unpacklo_epi8(LoadPixel<TStride>(in + i), zero);
+      a = _mm_and_si128(_mm_add_epi16(x, predictor), low);
+      StorePixel<TStride>(out + i, _mm_packus_epi16(a, a));
+      c = b;
+    }
+  }
+
+  /// @brief Up has no dependency along the row, so it's done 16 bytes at a time.
+  static void UnfilterUpSSE2(const uint8 *in, const uint8 *prior, uint8 *out, size_t size) noexcept
+  {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+      const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+      const __m128i up = _mm_loadu_si128(reinterpret_cast<const __m128i *>(prior + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_add_epi8(x, up));
+    }
+
+    UnfilterRowScalar(Filter::Up, in + i, prior + i, out + i, size - i, 1);
+  }
+
+  KRYS_TARGET("avx2")
+  static void UnfilterUpAVX2(const uint8 *in, const uint8 *prior, uint8 *out, size_t size) noexcept
+  {
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+      const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+      const __m256i up = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(prior + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_add_epi8(x, up));
+    }
+
+    UnfilterUpSSE2(in + i, prior + i, out + i, size - i);
+  }
+
+  template <uint32 TStride>
+  static void UnfilterPixelsSSE2(Filter filter, const uint8 *in, const uint8 *prior, uint8 *out,
+                                 size_t size) noexcept
+  {
+    switch (filter)
+    {
+      case Filter::Sub: UnfilterSubSSE2<TStride>(in, out, size); break;
+      case Filter::Average: UnfilterAverageSSE2<TStride>(in, prior, out, size); break;
+      case Filter::Paeth: UnfilterPaethSSE2<TStride>(in, prior, out, size); break;
+      default: break;
+    }
+  }
+
+  /// @brief Undo `filter` on a row of `size` bytes, given the previous row after it was unfiltered (zeros
+  /// for the first row).
+  static void UnfilterRow(Filter filter, const byte *in, const byte *prior, byte *out, size_t size,
+                          uint32 stride, bool avx2) noexcept
+  {
+    const auto *source = reinterpret_cast<const uint8 *>(in);
+    const auto *above = reinterpret_cast<const uint8 *>(prior);
+    auto *destination = reinterpret_cast<uint8 *>(out);
+
+    if (filter == Filter::None)
+      std::memcpy(destination, source, size);
+    else if (filter == Filter::Up)
+    {
+      if (avx2)
+        UnfilterUpAVX2(source, above, destination, size);
+      else
+        UnfilterUpSSE2(source, above, destination, size);
+    }
+    else if (stride == 3)
+      UnfilterPixelsSSE2<3>(filter, source, above, destination, size);
+    else if (stride == 4)
+      UnfilterPixelsSSE2<4>(filter, source, above, destination, size);
+    else
+      UnfilterRowScalar(filter, source, above, destination, size, stride);
+  }
+
+  /// @brief Get sample `index` of a row of samples with fewer than 8 bits.
+  NO_DISCARD static uint32 GetPackedSample(const byte *row, size_t index, uint32 depth) noexcept
+  {
+    const size_t bit = index * depth;
+    const uint32 shift = 8 - depth - static_cast<uint32>(bit & 7);
+    return (static_cast<uint32>(row[bit >> 3]) >> shift) & ((1u << depth) - 1);
+  }
+
+  /// @brief Convert an unfiltered row of `width` pixels to the image's 8-bit channels.
+  static void ExpandRow(const Header &header, const byte *row, byte *out, uint32 width) noexcept
+  {
+    const uint8 channels = header.Channels;
+    if (header.Colour == ColourType::Palette)
+    {
+      for (uint32 x = 0; x < width; x++)
+      {
+        const uint32 index = header.BitDepth == 8 ? static_cast<uint32>(row[x])
+                                                   : GetPackedSample(row, x, header.BitDepth);
+        std::memcpy(out + size_t {x} * channels, header.Palette.data() + index * 4, channels);
+      }
+      return;
+    }
+
+    if (header.BitDepth == 8 && !header.HasTransparency)
+    {
+      std::memcpy(out, row, size_t {width} * channels);
+      return;
+    }
+
+    // Samples with fewer than 8 bits are scaled so that their maximum becomes 255.
+    const uint32 scale = header.BitDepth < 8 ? 255 / ((1u << header.BitDepth) - 1) : 1;
+    for (uint32 x = 0; x < width; x++)
+    {
+      byte *pixel = out + size_t {x} * channels;
+      bool transparent = header.HasTransparency;
+      for (uint32 s = 0; s < header.Samples; s++)
+      {
+        const size_t index = size_t {x} * header.Samples + s;
+        uint32 sample;
+        if (header.BitDepth == 16)
+          sample = ReadBigEndian16(row + index * 2);
+        else if (header.BitDepth == 8)
+          sample = static_cast<uint32>(row[index]);
+        else
+          sample = GetPackedSample(row, index, header.BitDepth);
+
+        transparent = transparent && sample == header.TransparentColour[s];
+        pixel[s] = static_cast<byte>(header.BitDepth == 16 ? sample >> 8 : sample * scale);
+      }
+
+      if (header.HasTransparency)
+        pixel[header.Samples] = transparent ? byte {0} : byte {255};
+    }
+  }
+
+  NO_DISCARD static Expected<Unique<PNGImage>> Decode(std::span<const byte> file,
+                                                      bool flipVertically) noexcept
+  {
+    Header header;
+    List<std::span<const byte>> chunks;
+    if (auto result = ReadChunks(file, header, chunks); !result)
+      return Unexpected(result.error());
+
+    // The stream is usually split across several chunks, which only need joining if there's more than one.
+    List<byte> joined;
+    std::span<const byte> stream = chunks.front();
+    if (chunks.size() > 1)
+    {
+      for (const auto &chunk : chunks)
+        joined.insert(joined.end(), chunk.begin(), chunk.end());
+      stream = joined;
+    }
+
+    // Every row is stored with a filter byte in front of it; interlaced images are a sequence of smaller
+    // images, one per pass, that skip passes with no pixels.
+    uint64 rawSize = 0;
+    if (!header.Interlaced)
+      rawSize = (GetRowSize(header, header.Width) + 1) * header.Height;
+    else
+      for (const auto &pass : Adam7)
+      {
+        const uint32 width = (header.Width - pass.X + pass.XStep - 1) / pass.XStep;
+        const uint32 height = (header.Height - pass.Y + pass.YStep - 1) / pass.YStep;
+        if (header.Width > pass.X && header.Height > pass.Y)
+          rawSize += (GetRowSize(header, width) + 1) * height;
+      }
+
+    List<byte> raw(static_cast<size_t>(rawSize));
+    const auto inflated = InflateZlib(stream, raw);
+    if (!inflated)
+      return Unexpected(inflated.error());
+    if (*inflated != raw.size())
+      return Unexpected("Image data is cropped");
+
+    auto image = CreateUnique<PNGImage>();
+    image->Width = header.Width;
+    image->Height = header.Height;
+    image->Channels = header.Channels;
+    image->Data.resize(size_t {header.Width} * header.Height * header.Channels);
+
+    const size_t outRowSize = size_t {header.Width} * header.Channels;
+    const auto getOutRow = [&](uint32 y)
+    { return image->Data.data() + (flipVertically ? header.Height - 1 - y : y) * outRowSize; };
+
+    // 8-bit images without a palette or transparency are already in the image's format, so rows are
+    // unfiltered into the image itself, and the row above is read back from there.
+    const bool direct =
+      header.BitDepth == 8 && header.Colour != ColourType::Palette && !header.HasTransparency;
+    const bool avx2 = CPU::HasAVX2();
+    const auto maxRowSize = static_cast<size_t>(GetRowSize(header, header.Width));
+    List<byte> zeros(maxRowSize), rows(maxRowSize * 2), pixels(outRowSize);
+
+    const byte *in = raw.data();
+    if (!header.Interlaced)
+    {
+      const byte *prior = zeros.data();
+      for (uint32 y = 0; y < header.Height; y++)
+      {
+        if (*in > byte {4})
+          return Unexpected("Invalid filter type");
+
+        const auto filter = static_cast<Filter>(*in);
+        byte *out = direct ? getOutRow(y) : rows.data() + (y & 1) * maxRowSize;
+        UnfilterRow(filter, in + 1, prior, out, maxRowSize, header.FilterStride, avx2);
+        if (!direct)
+          ExpandRow(header, out, getOutRow(y), header.Width);
+
+        prior = out;
+        in += maxRowSize + 1;
+      }
+    }
+    else
+      for (const auto &pass : Adam7)
+      {
+        if (header.Width <= pass.X || header.Height <= pass.Y)
+          continue;
+
+        const uint32 width = (header.Width - pass.X + pass.XStep - 1) / pass.XStep;
+        const uint32 height = (header.Height - pass.Y + pass.YStep - 1) / pass.YStep;
+        const auto rowSize = static_cast<size_t>(GetRowSize(header, width));
+
+        const byte *prior = zeros.data();
+        for (uint32 y = 0; y < height; y++)
+        {
+          if (*in > byte {4})
+            return Unexpected("Invalid filter type");
+
+          const auto filter = static_cast<Filter>(*in);
+          byte *row = rows.data() + (y & 1) * maxRowSize;
+          UnfilterRow(filter, in + 1, prior, row, rowSize, header.FilterStride, avx2);
+          ExpandRow(header, row, pixels.data(), width);
+
+          byte *out = getOutRow(pass.Y + y * pass.YStep);
+          for (uint32 x = 0; x < width; x++)
+            std::memcpy(out + size_t {pass.X + x * pass.XStep} * header.Channels,
+                        pixels.data() + size_t {x} * header.Channels, header.Channels);
+
+          prior = row;
+          in += rowSize + 1;
+        }
+      }
+
+    return image;
+  }
+}
+
+namespace Krys::IO
+{
+  bool PNG::IsPNG(std::span<const byte> data) noexcept
+  {
+    return data.size() >= Signature.size() && std::equal(Signature.begin(), Signature.end(), data.begin());
+  }
+
+  Unique<PNGImage> PNG::Load(const string &path, bool flipVertically) noexcept
+  {
+    const auto file = VFS::Open(path);
+    if (!file.IsOpen())
+    {
+      return nullptr;
+    }
+
+    return Load(file.GetSpan(), flipVertically);
+  }
+
+  Unique<PNGImage> PNG::Load(std::span<const byte> data, bool flipVertically) noexcept
+  {
+    KRYS_SCOPED_PROFILER("PNG::Load");
+
+    auto image = Decode(data, flipVertically);
+    if (!image)
+    {
+      Logger::Error("PNG: {0}", image.error());
+      return nullptr;
+    }
+
+    return std::move(*image);
+  }
+
+  List<Unique<PNGImage>> PNG::LoadMany(std::span<const string> paths, bool flipVertically) noexcept
+  {
+    KRYS_SCOPED_PROFILER("PNG::LoadMany");
+
+    List<Unique<PNGImage>> images(paths.size());
+    Concurrency::ParallelForRanges(static_cast<uint32>(paths.size()), paths.size(),
+                                   [&](uint32 begin, uint32 end)
+                                   {
+                                     PNG png;
+                                     for (uint32 i = begin; i < end; i++)
+                                       images[i] = png.Load(paths[i], flipVertically);
+                                   });
+    return images;
+  }
+}
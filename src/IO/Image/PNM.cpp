@@ -0,0 +1,148 @@
+#include "IO/Image/PNM.hpp"
+#include "IO/Image/Netpbm.hpp"
+#include "IO/Logger.hpp"
+#include "IO/Readers/MemoryReader.hpp"
+
+#include <limits>
+
+namespace
+{
+  using namespace Krys;
+  using namespace Krys::IO;
+
+  NO_DISCARD static Expected<PNMType> ReadMagicNumber(MemoryReader &reader) noexcept
+  {
+    if (reader.NextByte() != 'P')
+      return Unexpected("Invalid PNM header");
+
+    switch (reader.NextByte())
+    {
+      case '1': return PNMType::PBMA;
+      case '2': return PNMType::PGMA;
+      case '3': return PNMType::PPMA;
+      case '4': return PNMType::PBMB;
+      case '5': return PNMType::PGMB;
+      case '6': return PNMType::PPMB;
+      default:  return Unexpected("Invalid PNM header");
+    }
+  }
+
+  NO_DISCARD static bool IsBitmap(PNMType type) noexcept
+  {
+    return type == PNMType::PBMA || type == PNMType::PBMB;
+  }
+
+  NO_DISCARD static bool IsBinary(PNMType type) noexcept
+  {
+    return type == PNMType::PBMB || type == PNMType::PGMB || type == PNMType::PPMB;
+  }
+
+  NO_DISCARD static Expected<void> ReadHeader(MemoryReader &reader, PNMImage &image) noexcept
+  {
+    const auto width = Netpbm::ReadNumber(reader);
+    const auto height = Netpbm::ReadNumber(reader);
+    if (!width || !height || *width == 0 || *height == 0)
+      return Unexpected("Invalid PNM dimensions");
+
+    image.Width = *width;
+    image.Height = *height;
+
+    if (!IsBitmap(image.Type))
+    {
+      const auto maxValue = Netpbm::ReadNumber(reader);
+      if (!maxValue || *maxValue == 0 || *maxValue > std::numeric_limits<uint16>::max())
+        return Unexpected("Invalid PNM max value");
+
+      image.MaxValue = static_cast<uint16>(*maxValue);
+      image.BitsPerChannel = static_cast<uint8>(Netpbm::GetSampleSize(image.MaxValue) * 8);
+    }
+
+    // Binary rasters start after exactly one whitespace character, since skipping more would eat pixels.
+    // Files written on Windows often end the header with "\r\n", which is treated as one character.
+    if (IsBinary(image.Type))
+    {
+      const char separator = static_cast<char>(reader.NextByte());
+      if (separator != ' ' && separator != '\t' && separator != '\n' && separator != '\r')
+        return Unexpected("Invalid PNM header");
+      if (separator == '\r' && reader.PeekNextByte() == '\n')
+        reader.Skip(1);
+    }
+
+    return {};
+  }
+
+  NO_DISCARD static Expected<Unique<PNMImage>> Decode(MemoryReader &reader) noexcept
+  {
+    auto image = CreateUnique<PNMImage>();
+
+    const auto type = ReadMagicNumber(reader);
+    if (!type)
+      return Unexpected(type.error());
+
+    image->Type = *type;
+    image->Channels = (*type == PNMType::PPMA || *type == PNMType::PPMB) ? 3 : 1;
+
+    if (auto header = ReadHeader(reader, *image); !header)
+      return Unexpected(header.error());
+
+    // Reject anything that can't fit in what's left of the file before allocating for it. Every pixel takes
+    // at least one byte, except binary bitmaps which take at least one bit.
+    const uint64 pixels = uint64 {image->Width} * image->Height;
+    const uint64 sampleSize = Netpbm::GetSampleSize(image->MaxValue);
+    const uint64 required = *type == PNMType::PBMB ? (uint64 {image->Width} + 7) / 8 * image->Height
+                          : IsBinary(*type)         ? pixels * image->Channels * sampleSize
+                                                    : pixels * image->Channels;
+    if (pixels > uint64 {reader.GetRemaining()} * 8 || required > reader.GetRemaining())
+      return Unexpected("Pixel data is cropped");
+
+    image->Data.resize(static_cast<size_t>(pixels * image->Channels * sampleSize));
+
+    const std::span<byte> data = image->Data;
+    Expected<void> result;
+    switch (*type)
+    {
+      case PNMType::PBMA: result = Netpbm::ReadASCIIBits(reader, data); break;
+      case PNMType::PBMB: result = Netpbm::ReadBinaryBits(reader, image->Width, image->Height, data); break;
+      case PNMType::PGMA:
+      case PNMType::PPMA: result = Netpbm::ReadASCIISamples(reader, image->MaxValue, data); break;
+      default:            result = Netpbm::ReadBinarySamples(reader, image->MaxValue, data); break;
+    }
+
+    if (!result)
+      return Unexpected(result.error());
+
+    return image;
+  }
+}
+
+namespace Krys::IO
+{
+  Unique<PNMImage> PNM::Load(const string &path) noexcept
+  {
+    BufferedReader reader(path);
+    if (!reader.IsOpen())
+    {
+      return nullptr;
+    }
+
+    return Load(reader);
+  }
+
+  Unique<PNMImage> PNM::Load(BufferedReader &reader) noexcept
+  {
+    const size_t start = reader.GetPosition();
+    List<byte> storage;
+    MemoryReader input(Netpbm::GetInput(reader, storage));
+
+    auto image = Decode(input);
+    reader.Seek(start + input.GetPosition());
+
+    if (!image)
+    {
+      Logger::Error("PNM: {0}", image.error());
+      return nullptr;
+    }
+
+    return std::move(*image);
+  }
+}
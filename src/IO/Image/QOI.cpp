@@ -0,0 +1,480 @@
+#include "IO/Image/QOI.hpp"
+#include "Base/Endian.hpp"
+#include "Debug/Macros.hpp"
+#include "IO/Logger.hpp"
+#include "IO/VFS/VFS.hpp"
+#include "IO/Writers/BufferedWriter.hpp"
+#include "Utils/Bytes.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+  using namespace Krys;
+  using namespace Krys::IO;
+
+  constexpr std::array Magic {byte {'q'}, byte {'o'}, byte {'i'}, byte {'f'}};
+  constexpr std::array EndMarker {byte {0}, byte {0}, byte {0}, byte {0},
+                                  byte {0}, byte {0}, byte {0}, byte {1}};
+
+  constexpr uint8 OpIndex = 0x00;
+  constexpr uint8 OpDiff = 0x40;
+  constexpr uint8 OpLuma = 0x80;
+  constexpr uint8 OpRun = 0xC0;
+  constexpr uint8 OpRGB = 0xFE;
+  constexpr uint8 OpRGBA = 0xFF;
+  constexpr uint8 OpMask = 0xC0;
+
+  /// @brief Longest run a single op holds. 63 and 64 would collide with `OpRGB` and `OpRGBA`.
+  constexpr uint32 MaxRun = 62;
+
+  /// @brief Images with more pixels than this are rejected rather than risk a huge allocation.
+  constexpr uint64 MaxPixels = uint64 {1} << 28;
+
+  /// @brief Roughly how many bytes of pixels `QOI::Save` encodes before writing them out.
+  constexpr size_t SavePieceSize = 256 * 1024;
+
+  /// @brief Where both the encoder and decoder start.
+  constexpr uint32 OpaqueBlack = 0xFF00'0000u;
+
+  NO_DISCARD static uint32 Hash(uint32 pixel) noexcept
+  {
+    const uint32 r = pixel & 0xFF, g = (pixel >> 8) & 0xFF, b = (pixel >> 16) & 0xFF, a = pixel >> 24;
+    return (r * 3 + g * 5 + b * 7 + a * 11) % 64;
+  }
+
+  NO_DISCARD static uint32 PackPixel(uint32 r, uint32 g, uint32 b, uint32 a) noexcept
+  {
+    return (r & 0xFF) | ((g & 0xFF) << 8) | ((b & 0xFF) << 16) | ((a & 0xFF) << 24);
+  }
+
+  template <uint8 TChannels>
+  NO_DISCARD static uint32 LoadPixel(const byte *data) noexcept
+  {
+    const uint32 alpha = TChannels == 4 ? static_cast<uint32>(data[3]) : 255;
+    return PackPixel(static_cast<uint32>(data[0]), static_cast<uint32>(data[1]), static_cast<uint32>(data[2]),
+                     alpha);
+  }
+
+  template <uint8 TChannels>
+  static void StorePixel(byte *data, uint32 pixel) noexcept
+  {
+    data[0] = static_cast<byte>(pixel);
+    data[1] = static_cast<byte>(pixel >> 8);
+    data[2] = static_cast<byte>(pixel >> 16);
+    if constexpr (TChannels == 4)
+      data[3] = static_cast<byte>(pixel >> 24);
+  }
+
+  /// @brief The difference between one channel of two pixels, wrapped to [-128, 127].
+  NO_DISCARD static int32 GetDifference(uint32 pixel, uint32 previous, uint32 shift) noexcept
+  {
+    return static_cast<int8>(static_cast<uint8>((pixel >> shift) - (previous >> shift)));
+  }
+
+  static void WriteBigEndian32(byte *data, uint32 value) noexcept
+  {
+    const auto bytes = Endian::Convert<uint32, Endian::Type::System, Endian::Type::Big>(value);
+    std::memcpy(data, &bytes, sizeof(bytes));
+  }
+
+  NO_DISCARD static Expected<void> Validate(const QOIHeader &header, std::span<const byte> pixels) noexcept
+  {
+    if (header.Channels != 3 && header.Channels != 4)
+      return Unexpected("Only RGB and RGBA images can be encoded");
+    if (header.Width == 0 || header.Height == 0)
+      return Unexpected("Image is empty");
+    if (pixels.size() != size_t {header.Width} * header.Height * header.Channels)
+      return Unexpected("Pixels don't match the header");
+
+    return {};
+  }
+
+  /// @brief Call `function` with each row of `pixels`, in the order they are stored in the file.
+  template <typename TFunction>
+  static void ForEachRow(const QOIHeader &header, std::span<const byte> pixels, bool flipVertically,
+                         const TFunction &function) noexcept
+  {
+    const size_t rowSize = size_t {header.Width} * header.Channels;
+    for (uint32 y = 0; y < header.Height; y++)
+    {
+      const uint32 row = flipVertically ? header.Height - 1 - y : y;
+      function(pixels.subspan(row * rowSize, rowSize));
+    }
+  }
+}
+
+namespace Krys::IO
+{
+  Expected<QOIHeader> QOIDecoder::Begin(std::span<const byte> data) noexcept
+  {
+    _data = {};
+    _remaining = 0;
+
+    if (data.size() < QOI::HeaderSize + EndMarker.size())
+      return Unexpected("File is too small");
+    if (!QOI::IsQOI(data))
+      return Unexpected("Invalid QOI header");
+
+    QOIHeader header;
+    header.Width = Bytes::AsNumeric<uint32, Endian::Type::Big, Endian::Type::System>(data.data() + 4);
+    header.Height = Bytes::AsNumeric<uint32, Endian::Type::Big, Endian::Type::System>(data.data() + 8);
+    header.Channels = static_cast<uint8>(data[12]);
+    header.ColourSpace = static_cast<QOIColourSpace>(data[13]);
+
+    if (header.Width == 0 || header.Height == 0)
+      return Unexpected("Image is empty");
+    if (uint64 {header.Width} * header.Height > MaxPixels)
+      return Unexpected("Image is too large");
+    if (header.Channels != 3 && header.Channels != 4)
+      return Unexpected("Invalid channel count");
+    if (header.ColourSpace != QOIColourSpace::SRGB && header.ColourSpace != QOIColourSpace::Linear)
+      return Unexpected("Invalid colour space");
+
+    _data = data;
+    _position = QOI::HeaderSize;
+    _remaining = uint64 {header.Width} * header.Height;
+    _pixel = OpaqueBlack;
+    _run = 0;
+    _index.fill(0);
+    return header;
+  }
+
+  Expected<void> QOIDecoder::Decode(std::span<byte> pixels, uint8 channels) noexcept
+  {
+    KRYS_ASSERT(channels == 3 || channels == 4, "QOIDecoder: Can only decode to 3 or 4 channels");
+
+    const size_t count = pixels.size() / channels;
+    if (count > _remaining)
+      return Unexpected("Not enough pixels left");
+
+    auto result =
+      channels == 4 ? DecodePixels<4>(pixels.data(), count) : DecodePixels<3>(pixels.data(), count);
+    _remaining = result ? _remaining - count : 0;
+    return result;
+  }
+
+  template <uint8 TChannels>
+  Expected<void> QOIDecoder::DecodePixels(byte *pixels, size_t count) noexcept
+  {
+    // Ops are at most 5 bytes and valid data always ends with the 8 byte end marker, so an op that starts
+    // before the marker can be read without checking each byte of it.
+    const byte *data = _data.data();
+    const size_t end = _data.size() - EndMarker.size();
+
+    size_t position = _position;
+    uint32 pixel = _pixel;
+    uint32 run = _run;
+    for (size_t i = 0; i < count; i++, pixels += TChannels)
+    {
+      if (run > 0)
+      {
+        run--;
+        StorePixel<TChannels>(pixels, pixel);
+        continue;
+      }
+
+      if (position >= end)
+        return Unexpected("Image data is cropped");
+
+      const auto op = static_cast<uint8>(data[position++]);
+      if (op == OpRGB)
+      {
+        pixel = PackPixel(static_cast<uint32>(data[position]), static_cast<uint32>(data[position + 1]),
+                          static_cast<uint32>(data[position + 2]), pixel >> 24);
+        position += 3;
+      }
+      else if (op == OpRGBA)
+      {
+        pixel = LoadPixel<4>(data + position);
+        position += 4;
+      }
+      else
+      {
+        const uint32 r = pixel & 0xFF, g = (pixel >> 8) & 0xFF, b = (pixel >> 16) & 0xFF, a = pixel >> 24;
+        switch (op & OpMask)
+        {
+          case OpIndex: pixel = _index[op]; break;
+          case OpDiff:
+            pixel = PackPixel(r + ((op >> 4) & 3) - 2, g + ((op >> 2) & 3) - 2, b + (op & 3) - 2, a);
+            break;
+          case OpLuma:
+          {
+            const auto second = static_cast<uint32>(data[position++]);
+            const uint32 green = (op & 0x3F) - 32;
+            pixel = PackPixel(r + green - 8 + (second >> 4), g + green, b + green - 8 + (second & 0xF), a);
+            break;
+          }
+          default:
+            // This pixel is the first of the run.
+            run = op & 0x3F;
+            break;
+        }
+      }
+
+      _index[Hash(pixel)] = pixel;
+      StorePixel<TChannels>(pixels, pixel);
+    }
+
+    _position = position;
+    _pixel = pixel;
+    _run = run;
+    return {};
+  }
+
+  size_t QOIEncoder::Begin(const QOIHeader &header, std::span<byte> output) noexcept
+  {
+    KRYS_ASSERT(output.size() >= QOI::HeaderSize, "QOIEncoder: Not enough room for the header");
+    KRYS_ASSERT(header.Channels == 3 || header.Channels == 4, "QOIEncoder: Can only encode 3 or 4 channels");
+
+    std::copy(Magic.begin(), Magic.end(), output.begin());
+    WriteBigEndian32(output.data() + 4, header.Width);
+    WriteBigEndian32(output.data() + 8, header.Height);
+    output[12] = static_cast<byte>(header.Channels);
+    output[13] = static_cast<byte>(header.ColourSpace);
+
+    _channels = header.Channels;
+    _pixel = OpaqueBlack;
+    _run = 0;
+    _index.fill(0);
+    return QOI::HeaderSize;
+  }
+
+  size_t QOIEncoder::Encode(std::span<const byte> pixels, std::span<byte> output) noexcept
+  {
+    const size_t count = pixels.size() / _channels;
+    KRYS_ASSERT(output.size() >= GetMaxEncodedSize(count, _channels), "QOIEncoder: Output is too small");
+
+    return _channels == 4 ? EncodePixels<4>(pixels.data(), count, output.data())
+                          : EncodePixels<3>(pixels.data(), count, output.data());
+  }
+
+  template <uint8 TChannels>
+  size_t QOIEncoder::EncodePixels(const byte *pixels, size_t count, byte *output) noexcept
+  {
+    byte *out = output;
+    uint32 previous = _pixel;
+    uint32 run = _run;
+    for (size_t i = 0; i < count; i++, pixels += TChannels)
+    {
+      const uint32 pixel = LoadPixel<TChannels>(pixels);
+      if (pixel == previous)
+      {
+        if (++run == MaxRun)
+        {
+          *out++ = static_cast<byte>(OpRun | (run - 1));
+          run = 0;
+        }
+        continue;
+      }
+
+      if (run > 0)
+      {
+        *out++ = static_cast<byte>(OpRun | (run - 1));
+        run = 0;
+      }
+
+      const uint32 hash = Hash(pixel);
+      if (_index[hash] == pixel)
+        *out++ = static_cast<byte>(OpIndex | hash);
+      else if ((pixel >> 24) != (previous >> 24))
+      {
+        _index[hash] = pixel;
+        *out++ = static_cast<byte>(OpRGBA);
+        StorePixel<4>(out, pixel);
+        out += 4;
+      }
+      else
+      {
+        _index[hash] = pixel;
+        const int32 red = GetDifference(pixel, previous, 0);
+        const int32 green = GetDifference(pixel, previous, 8);
+        const int32 blue = GetDifference(pixel, previous, 16);
+        const int32 redGreen = red - green, blueGreen = blue - green;
+
+        if (red >= -2 && red <= 1 && green >= -2 && green <= 1 && blue >= -2 && blue <= 1)
+          *out++ = static_cast<byte>(OpDiff | ((red + 2) << 4) | ((green + 2) << 2) | (blue + 2));
+        else if (green >= -32 && green <= 31 && redGreen >= -8 && redGreen <= 7 && blueGreen >= -8
+                 && blueGreen <= 7)
+        {
+          *out++ = static_cast<byte>(OpLuma | (green + 32));
+          *out++ = static_cast<byte>(((redGreen + 8) << 4) | (blueGreen + 8));
+        }
+        else
+        {
+          *out++ = static_cast<byte>(OpRGB);
+          StorePixel<3>(out, pixel);
+          out += 3;
+        }
+      }
+
+      previous = pixel;
+    }
+
+    _pixel = previous;
+    _run = run;
+    return static_cast<size_t>(out - output);
+  }
+
+  size_t QOIEncoder::End(std::span<byte> output) noexcept
+  {
+    KRYS_ASSERT(output.size() >= QOI::EndSize, "QOIEncoder: Not enough room for the end of the image");
+
+    size_t size = 0;
+    if (_run > 0)
+    {
+      output[size++] = static_cast<byte>(OpRun | (_run - 1));
+      _run = 0;
+    }
+
+    std::copy(EndMarker.begin(), EndMarker.end(), output.begin() + static_cast<ptrdiff_t>(size));
+    return size + EndMarker.size();
+  }
+
+  bool QOI::IsQOI(std::span<const byte> data) noexcept
+  {
+    return data.size() >= Magic.size() && std::equal(Magic.begin(), Magic.end(), data.begin());
+  }
+
+  Unique<QOIImage> QOI::Load(const string &path, bool flipVertically, uint8 channels) noexcept
+  {
+    const auto file = VFS::Open(path);
+    if (!file.IsOpen())
+    {
+      return nullptr;
+    }
+
+    return Load(file.GetSpan(), flipVertically, channels);
+  }
+
+  Unique<QOIImage> QOI::Load(std::span<const byte> data, bool flipVertically, uint8 channels) noexcept
+  {
+    KRYS_SCOPED_PROFILER("QOI::Load");
+
+    QOIDecoder decoder;
+    const auto header = decoder.Begin(data);
+    if (!header)
+    {
+      Logger::Error("QOI: {0}", header.error());
+      return nullptr;
+    }
+
+    if (channels == 0)
+      channels = header->Channels;
+    if (channels != 3 && channels != 4)
+    {
+      Logger::Error("QOI: Can only be decoded to 3 or 4 channels, not {0}", channels);
+      return nullptr;
+    }
+
+    auto image = CreateUnique<QOIImage>();
+    image->Width = header->Width;
+    image->Height = header->Height;
+    image->Channels = channels;
+    image->ColourSpace = header->ColourSpace;
+    image->Data.resize(size_t {header->Width} * header->Height * channels);
+
+    // Rows come out of the decoder top first, so flipping is just decoding each into its place.
+    Expected<void> result;
+    if (!flipVertically)
+      result = decoder.Decode(image->Data, channels);
+    else
+    {
+      const size_t rowSize = size_t {header->Width} * channels;
+      for (uint32 y = header->Height; y-- > 0 && result;)
+        result = decoder.Decode(std::span(image->Data).subspan(y * rowSize, rowSize), channels);
+    }
+
+    if (!result)
+    {
+      Logger::Error("QOI: {0}", result.error());
+      return nullptr;
+    }
+
+    return image;
+  }
+
+  List<byte> QOI::Encode(const QOIHeader &header, std::span<const byte> pixels, bool flipVertically) noexcept
+  {
+    KRYS_SCOPED_PROFILER("QOI::Encode");
+
+    if (auto result = Validate(header, pixels); !result)
+    {
+      Logger::Error("QOI: {0}", result.error());
+      return {};
+    }
+
+    const size_t count = size_t {header.Width} * header.Height;
+    List<byte> output(HeaderSize + QOIEncoder::GetMaxEncodedSize(count, header.Channels) + EndSize);
+    const std::span<byte> buffer(output);
+
+    QOIEncoder encoder;
+    size_t size = encoder.Begin(header, buffer);
+    if (!flipVertically)
+      size += encoder.Encode(pixels, buffer.subspan(size));
+    else
+      ForEachRow(header, pixels, true,
+                 [&](std::span<const byte> row) { size += encoder.Encode(row, buffer.subspan(size)); });
+    size += encoder.End(buffer.subspan(size));
+
+    output.resize(size);
+    return output;
+  }
+
+  bool QOI::Save(const string &path, const QOIHeader &header, std::span<const byte> pixels,
+                 bool flipVertically) noexcept
+  {
+    KRYS_SCOPED_PROFILER("QOI::Save");
+
+    if (auto result = Validate(header, pixels); !result)
+    {
+      Logger::Error("QOI: {0} for '{1}'", result.error(), path);
+      return false;
+    }
+
+    BufferedWriter writer(path);
+    if (!writer.IsOpen())
+    {
+      Logger::Error("QOI: Unable to open '{0}' for writing", path);
+      return false;
+    }
+
+    // Rows are encoded into a buffer of a fixed size, which is written out whenever the next row might not
+    // fit, so only a small part of the image is ever held encoded.
+    const size_t rowLimit = QOIEncoder::GetMaxEncodedSize(header.Width, header.Channels);
+    List<byte> buffer(std::max(rowLimit, SavePieceSize) + HeaderSize + EndSize);
+    size_t size = 0;
+
+    QOIEncoder encoder;
+    size += encoder.Begin(header, buffer);
+    ForEachRow(header, pixels, flipVertically,
+               [&](std::span<const byte> row)
+               {
+                 if (buffer.size() - size < rowLimit)
+                 {
+                   writer.WriteBytes(std::span(buffer).first(size));
+                   size = 0;
+                 }
+
+                 size += encoder.Encode(row, std::span(buffer).subspan(size));
+               });
+
+    if (buffer.size() - size < EndSize)
+    {
+      writer.WriteBytes(std::span(buffer).first(size));
+      size = 0;
+    }
+
+    size += encoder.End(std::span(buffer).subspan(size));
+    writer.WriteBytes(std::span(buffer).first(size));
+
+    if (!writer.Flush() || writer.HasFailed())
+    {
+      Logger::Error("QOI: Failed to write '{0}'", path);
+      return false;
+    }
+
+    return true;
+  }
+}
@@ -1,46 +1,403 @@
 #include "IO/Images.hpp"
-#include "MTL/Common/Rounding.hpp"
+#include "Debug/Macros.hpp"
+#include "MTL/Common/Constants.hpp"
+#include "MTL/SIMD.hpp"
+#include "Utils/Concurrency/ParallelFor.hpp"
 
-namespace Krys::IO
+#include <cmath>
+#include <format>
+
+namespace
 {
-  // TODO: revisit this, it's not the best way to generate mipmaps.
-  List<MipLevelData> GenerateMipmaps(const Image &image) noexcept
+  using namespace Krys;
+  using namespace Krys::IO;
+
+  /// @brief Levels are only split across threads when each band has at least this many output bytes.
+  constexpr size_t MinBandSize = 256 * 1024;
+
+  /// @brief Support of the windowed sinc filters, in output pixels either side of the centre.
+  constexpr float SincRadius = 3.0f;
+
+  /// @brief Shape of the Kaiser window. Higher is smoother with less ringing.
+  constexpr float KaiserAlpha = 4.0f;
+
+  /// @brief Weights for resampling one axis, `Taps` contiguous source pixels per output pixel.
+  struct FilterWeights
+  {
+    List<uint32> First;
+    List<float> Weights;
+    uint32 Taps {0};
+  };
+
+#pragma region Filters
+
+  NO_DISCARD static float Sinc(float x) noexcept
+  {
+    if (std::abs(x) < 1e-6f)
+      return 1.0f;
+
+    x *= MTL::Pi<float>();
+    return std::sin(x) / x;
+  }
+
+  /// @brief Zeroth order modified Bessel function of the first kind, used by the Kaiser window.
+  NO_DISCARD static float BesselI0(float x) noexcept
+  {
+    float sum = 1.0f, term = 1.0f;
+    for (int k = 1; k < 32 && term > sum * 1e-8f; k++)
+    {
+      const float factor = x / (2.0f * static_cast<float>(k));
+      term *= factor * factor;
+      sum += term;
+    }
+    return sum;
+  }
+
+  NO_DISCARD static float Kaiser(float x) noexcept
+  {
+    if (std::abs(x) >= SincRadius)
+      return 0.0f;
+
+    const float t = x / SincRadius;
+    return Sinc(x) * BesselI0(KaiserAlpha * std::sqrt(1.0f - t * t)) / BesselI0(KaiserAlpha);
+  }
+
+  NO_DISCARD static float Lanczos(float x) noexcept
+  {
+    return std::abs(x) < SincRadius ? Sinc(x) * Sinc(x / SincRadius) : 0.0f;
+  }
+
+  /// @brief Build the weights for shrinking `sourceSize` pixels to `size`. Pixels past either edge are
+  /// clamped to the edge.
+  NO_DISCARD static FilterWeights BuildWeights(uint32 sourceSize, uint32 size, MipFilter filter) noexcept
+  {
+    const double scale = static_cast<double>(sourceSize) / size;
+    const double support = filter == MipFilter::Box ? scale / 2 : SincRadius * scale;
+
+    // Gather the weights per output pixel, keyed by clamped source index, then lay them out with a fixed
+    // number of taps so the kernels don't need to look up each pixel's count.
+    List<List<float>> windows(size);
+    List<int64> starts(size);
+    size_t taps = 1;
+    for (uint32 i = 0; i < size; i++)
+    {
+      const double centre = (i + 0.5) * scale;
+      const auto low = static_cast<int64>(std::floor(centre - support));
+      const auto high = static_cast<int64>(std::ceil(centre + support));
+      const int64 first = std::clamp<int64>(low, 0, sourceSize - 1);
+      const int64 last = std::clamp<int64>(high - 1, 0, sourceSize - 1);
+
+      auto &window = windows[i];
+      window.assign(static_cast<size_t>(last - first + 1), 0.0f);
+      double total = 0.0;
+      for (int64 j = low; j < high; j++)
+      {
+        const auto position = static_cast<double>(j);
+        double weight;
+        if (filter == MipFilter::Box)
+        {
+          const double overlapEnd = std::min(position + 1, centre + support);
+          weight = std::max(0.0, overlapEnd - std::max(position, centre - support));
+        }
+        else
+        {
+          const auto x = static_cast<float>((position + 0.5 - centre) / scale);
+          weight = filter == MipFilter::Kaiser ? Kaiser(x) : Lanczos(x);
+        }
+
+        window[static_cast<size_t>(std::clamp<int64>(j, first, last) - first)] += static_cast<float>(weight);
+        total += weight;
+      }
+
+      if (total != 0.0)
+        for (auto &weight : window)
+          weight = static_cast<float>(weight / total);
+
+      starts[i] = first;
+      taps = std::max(taps, window.size());
+    }
+
+    FilterWeights result;
+    result.Taps = static_cast<uint32>(std::min<size_t>(taps, sourceSize));
+    result.First.resize(size);
+    result.Weights.assign(static_cast<size_t>(size) * result.Taps, 0.0f);
+    for (uint32 i = 0; i < size; i++)
+    {
+      // Shift windows near the far edge back so every tap stays inside the source.
+      const auto first = static_cast<uint32>(std::min<int64>(starts[i], sourceSize - result.Taps));
+      const auto offset = static_cast<size_t>(starts[i] - first);
+      result.First[i] = first;
+      std::copy(windows[i].begin(), windows[i].end(), result.Weights.begin() + i * result.Taps + offset);
+    }
+
+    return result;
+  }
+
+#pragma endregion Filters
+
+#pragma region Colour
+
+  /// @brief Decoding table from sRGB bytes to linear floats.
+  NO_DISCARD static const Array<float, 256> &GetSRGBToLinear() noexcept
   {
-    List<MipLevelData> levels;
-    levels.push_back({image.Data, image.Width, image.Height});
+    static const auto table = []
+    {
+      Array<float, 256> result;
+      for (size_t i = 0; i < result.size(); i++)
+      {
+        const double value = static_cast<double>(i) / 255.0;
+        const double linear = value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+        result[i] = static_cast<float>(linear);
+      }
+      return result;
+    }();
+    return table;
+  }
+
+  NO_DISCARD static const Array<float, 256> &GetUnormToFloat() noexcept
+  {
+    static const auto table = []
+    {
+      Array<float, 256> result;
+      for (size_t i = 0; i < result.size(); i++)
+        result[i] = static_cast<float>(static_cast<double>(i) / 255.0);
+      return result;
+    }();
+    return table;
+  }
 
-    auto scale = 2u;
+  /// @brief Encoding table from linear values, quantised to 16 bits, to sRGB bytes. 16 bits keeps the
+  /// darkest sRGB steps apart.
+  NO_DISCARD static const List<uint8> &GetLinearToSRGB() noexcept
+  {
+    static const auto table = []
+    {
+      List<uint8> result(65536);
+      for (size_t i = 0; i < result.size(); i++)
+      {
+        const double value = static_cast<double>(i) / 65535.0;
+        const double encoded =
+          value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+        result[i] = static_cast<uint8>(std::lround(std::clamp(encoded, 0.0, 1.0) * 255.0));
+      }
+      return result;
+    }();
+    return table;
+  }
+
+  /// @brief How each channel of an image is converted to and from the floats that get filtered.
+  struct ChannelCoding
+  {
+    uint32 Channels;
+    Array<const float *, 4> Decode;
+    Array<bool, 4> SRGB;
+  };
 
-    uint32 width = image.Width / scale;
-    uint32 height = image.Height / scale;
-    while (width > 0 && height > 0)
+  NO_DISCARD static ChannelCoding GetChannelCoding(uint8 channels, bool srgb) noexcept
+  {
+    ChannelCoding coding {.Channels = channels, .Decode = {}, .SRGB = {}};
+    const bool hasAlpha = channels == 2 || channels == 4;
+    for (uint32 c = 0; c < channels; c++)
     {
-      const auto stride = image.Channels;
-      const auto scaleX = static_cast<float>(levels.back().Width) / static_cast<float>(width);
-      const auto scaleY = static_cast<float>(levels.back().Height) / static_cast<float>(height);
+      coding.SRGB[c] = srgb && !(hasAlpha && c == channels - 1u);
+      coding.Decode[c] = coding.SRGB[c] ? GetSRGBToLinear().data() : GetUnormToFloat().data();
+    }
+    return coding;
+  }
+
+  static void DecodeRow(const byte *source, float *destination, uint32 width,
+                        const ChannelCoding &coding) noexcept
+  {
+    for (uint32 x = 0; x < width; x++)
+      for (uint32 c = 0; c < coding.Channels; c++)
+      {
+        const size_t i = static_cast<size_t>(x) * coding.Channels + c;
+        destination[i] = coding.Decode[c][std::to_integer<uint8>(source[i])];
+      }
+  }
 
-      ImageData data(width * height * stride);
-      const auto *src = levels.back().Data.data();
-      auto *dst = data.data();
+  static void EncodeRow(const float *source, byte *destination, uint32 width,
+                        const ChannelCoding &coding) noexcept
+  {
+    const auto &toSRGB = GetLinearToSRGB();
+    for (uint32 x = 0; x < width; x++)
+      for (uint32 c = 0; c < coding.Channels; c++)
+      {
+        const size_t i = static_cast<size_t>(x) * coding.Channels + c;
+        const float value = std::clamp(source[i], 0.0f, 1.0f);
+        const uint8 encoded = coding.SRGB[c] ? toSRGB[static_cast<size_t>(value * 65535.0f + 0.5f)]
+                                             : static_cast<uint8>(value * 255.0f + 0.5f);
+        destination[i] = static_cast<byte>(encoded);
+      }
+  }
 
-      // simple downsize algorithm by skipping pixels, will produce aliasing
-      for (auto y = 0u; y < height; ++y)
+#pragma endregion Colour
+
+#pragma region Kernels
+
+  /// @brief Shrink one decoded row horizontally.
+  static void FilterRow(const float *source, float *destination, uint32 width, uint32 channels,
+                        const FilterWeights &weights) noexcept
+  {
+    const uint32 taps = weights.Taps;
+    if (channels == 4)
+    {
+      // One pixel per vector.
+      for (uint32 x = 0; x < width; x++)
       {
-        const auto yNearest = static_cast<int>(MTL::Floor(y * scaleY));
+        const float *pixels = source + static_cast<size_t>(weights.First[x]) * 4;
+        const float *w = weights.Weights.data() + static_cast<size_t>(x) * taps;
+        simd_float sum = _mm_setzero_ps();
+        for (uint32 k = 0; k < taps; k++)
+          sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(w[k]), _mm_loadu_ps(pixels + k * 4)));
+        _mm_storeu_ps(destination + static_cast<size_t>(x) * 4, sum);
+      }
+      return;
+    }
+
+    for (uint32 x = 0; x < width; x++)
+    {
+      const float *pixels = source + static_cast<size_t>(weights.First[x]) * channels;
+      const float *w = weights.Weights.data() + static_cast<size_t>(x) * taps;
+      for (uint32 c = 0; c < channels; c++)
+      {
+        float sum = 0.0f;
+        for (uint32 k = 0; k < taps; k++)
+          sum += w[k] * pixels[k * channels + c];
+        destination[static_cast<size_t>(x) * channels + c] = sum;
+      }
+    }
+  }
+
+  /// @brief Blend `rows` together with `weights`, four samples at a time.
+  static void FilterColumns(const float *const *rows, const float *weights, uint32 taps, float *destination,
+                            size_t count) noexcept
+  {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+      simd_float sum = _mm_setzero_ps();
+      for (uint32 k = 0; k < taps; k++)
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(rows[k] + i)));
+      _mm_storeu_ps(destination + i, sum);
+    }
+
+    for (; i < count; i++)
+    {
+      float sum = 0.0f;
+      for (uint32 k = 0; k < taps; k++)
+        sum += weights[k] * rows[k][i];
+      destination[i] = sum;
+    }
+  }
+
+#pragma endregion Kernels
+
+  /// @brief Shrink `source` into `destination`, in bands of output rows.
+  static void ResampleLevel(const byte *source, uint32 sourceWidth, uint32 sourceHeight, byte *destination,
+                            uint32 width, uint32 height, const ChannelCoding &coding,
+                            MipFilter filter) noexcept
+  {
+    const FilterWeights horizontal = BuildWeights(sourceWidth, width, filter);
+    const FilterWeights vertical = BuildWeights(sourceHeight, height, filter);
+    const size_t sourceRowSize = static_cast<size_t>(sourceWidth) * coding.Channels;
+    const size_t rowSize = static_cast<size_t>(width) * coding.Channels;
 
-        for (auto x = 0u; x < width; ++x)
+    // Each band filters source rows horizontally as its output rows come to need them, keeping only the last
+    // `vertical.Taps` in a ring, then blends them vertically. Windows only move forward, so a row is never
+    // needed again once the window has passed it. Neighbouring bands share a few source rows at their edges,
+    // which are filtered by both.
+    const auto filterBand = [&](uint32 begin, uint32 end)
+    {
+      const uint32 ringSize = vertical.Taps;
+      List<float> decoded(sourceRowSize);
+      List<float> ring(ringSize * rowSize);
+      const auto ringRow = [&](uint32 y) { return ring.data() + (y % ringSize) * rowSize; };
+
+      List<const float *> taps(vertical.Taps);
+      List<float> blended(rowSize);
+      uint32 nextRow = vertical.First[begin];
+      for (uint32 y = begin; y < end; y++)
+      {
+        const uint32 first = vertical.First[y];
+        for (nextRow = std::max(nextRow, first); nextRow < first + vertical.Taps; nextRow++)
         {
-          const auto xNearest = static_cast<int>(MTL::Floor(x * scaleX));
-          std::memcpy(dst, src + ((yNearest * levels.back().Width) + xNearest) * stride, stride);
-          dst += stride;
+          DecodeRow(source + nextRow * sourceRowSize, decoded.data(), sourceWidth, coding);
+          FilterRow(decoded.data(), ringRow(nextRow), width, coding.Channels, horizontal);
         }
+
+        for (uint32 k = 0; k < vertical.Taps; k++)
+          taps[k] = ringRow(first + k);
+
+        FilterColumns(taps.data(), vertical.Weights.data() + static_cast<size_t>(y) * vertical.Taps,
+                      vertical.Taps, blended.data(), rowSize);
+        EncodeRow(blended.data(), destination + y * rowSize, width, coding);
       }
+    };
+
+    const size_t maxBands = std::max<size_t>(1, rowSize * height / MinBandSize);
+    Concurrency::ParallelForRanges(height, maxBands, filterBand);
+  }
+}
+
+namespace Krys::IO
+{
+  MipChain GenerateMipmaps(const Image &image, const MipmapSettings &settings) noexcept
+  {
+    KRYS_SCOPED_PROFILER("IO::GenerateMipmaps");
+    KRYS_MEMORY_SCOPE(Images);
 
-      levels.push_back({.Data = std::move(data), .Width = width, .Height = height});
+    MipChain chain;
+    chain.Channels = image.Channels;
+    if (image.Width == 0 || image.Height == 0 || image.Channels == 0 || image.Channels > 4)
+      return chain;
 
-      width /= scale;
-      height /= scale;
+    size_t size = 0;
+    for (uint32 width = image.Width, height = image.Height; width > 1 || height > 1;)
+    {
+      width = std::max(1u, width / 2);
+      height = std::max(1u, height / 2);
+      const size_t levelSize = static_cast<size_t>(width) * height * image.Channels;
+      chain.Levels.push_back({.Width = width, .Height = height, .Offset = size, .Size = levelSize});
+      size += levelSize;
     }
-    return levels;
+
+    chain.Data.resize(size);
+    const auto coding = GetChannelCoding(image.Channels, settings.SRGB);
+
+    const byte *source = image.Data.data();
+    uint32 sourceWidth = image.Width, sourceHeight = image.Height;
+    for (const auto &level : chain.Levels)
+    {
+      byte *destination = chain.Data.data() + level.Offset;
+      ResampleLevel(source, sourceWidth, sourceHeight, destination, level.Width, level.Height, coding,
+                    settings.Filter);
+
+      source = destination;
+      sourceWidth = level.Width;
+      sourceHeight = level.Height;
+    }
+
+    return chain;
+  }
+
+  Expected<void> SaveImage(const string &path, const Image &image, bool flipVertically) noexcept
+  {
+    KRYS_SCOPED_PROFILER("IO::SaveImage");
+
+    const string extension = GetExtension(path);
+    if (extension == QOI::Extension)
+    {
+      if (image.Channels != 3 && image.Channels != 4)
+        return Unexpected<string>("QOI images must have 3 or 4 channels");
+
+      QOI qoi;
+      if (!qoi.Save(path, {image.Width, image.Height, image.Channels}, image.Data, flipVertically))
+        return Unexpected<string>("Failed to save QOI image");
+
+      return {};
+    }
+
+    return Unexpected<string>(std::format("Can't save images as '{0}'", extension));
   }
-}
\ No newline at end of file
+}
@@ -0,0 +1,101 @@
+#include "IO/Input/EventReplayDevice.hpp"
+#include "Events/EventRecorder.hpp"
+#include "Events/Input/KeyboardEvent.hpp"
+#include "Events/Input/MouseButtonEvent.hpp"
+#include "Events/Input/MouseMoveEvent.hpp"
+#include "Events/Input/ScrollWheelEvent.hpp"
+#include "Events/QuitEvent.hpp"
+#include "IO/Logger.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace Krys
+{
+  EventReplayDevice::EventReplayDevice() noexcept
+  {
+    RegisterEvent<KeyboardEvent>();
+    RegisterEvent<MouseButtonEvent>();
+    RegisterEvent<MouseMoveEvent>();
+    RegisterEvent<ScrollWheelEvent>();
+    RegisterEvent<QuitEvent>();
+  }
+
+  bool EventReplayDevice::Load(const stringview &path) noexcept
+  {
+    _data.clear();
+    _offset = 0;
+    _nextFrame = 0;
+
+    std::ifstream file(string(path), std::ios::in | std::ios::binary);
+    if (!file.is_open())
+    {
+      Logger::Error("Unable to open event recording '{}'", path);
+      return false;
+    }
+
+    List<char> contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    constexpr size_t HeaderSize = EventRecordingMagic.size() + sizeof(EventRecordingVersion);
+    if (contents.size() < HeaderSize
+        || std::memcmp(contents.data(), EventRecordingMagic.data(), EventRecordingMagic.size()) != 0)
+    {
+      Logger::Error("'{}' is not an event recording", path);
+      return false;
+    }
+
+    EventRecordReader header(reinterpret_cast<const byte *>(contents.data()) + EventRecordingMagic.size(),
+                             sizeof(EventRecordingVersion));
+    if (const uint16 version = header.Read<uint16>(); version != EventRecordingVersion)
+    {
+      Logger::Error("Unsupported event recording version {} in '{}'", version, path);
+      return false;
+    }
+
+    _data.resize(contents.size() - HeaderSize);
+    std::memcpy(_data.data(), contents.data() + HeaderSize, _data.size());
+    ReadNextFrame();
+    return true;
+  }
+
+  void EventReplayDevice::PollDevice(Ptr<EventManager> eventManager) noexcept
+  {
+    const uint64 frame = eventManager->GetFrame();
+    while (!IsFinished() && _nextFrame <= frame)
+    {
+      EventRecordReader entry(_data.data() + _offset, _data.size() - _offset);
+      (void)entry.ReadVarint(); // Frame delta, already applied by `ReadNextFrame`.
+      (void)entry.ReadVarint(); // Microseconds since the previous entry, only needed for analysis.
+      const EventType type(entry.Read<uint32>());
+      const size_t size = static_cast<size_t>(entry.ReadVarint());
+
+      if (entry.HasFailed() || size > entry.GetRemaining())
+      {
+        Logger::Error("Event recording is truncated, stopping replay");
+        _offset = _data.size();
+        return;
+      }
+
+      if (auto it = _decoders.find(type); it != _decoders.end())
+      {
+        EventRecordReader payload(entry.GetCurrent(), size);
+        it->second(*eventManager, payload);
+      }
+      else
+        Logger::Warn("Skipping unregistered event type {} in event recording", static_cast<uint32>(type));
+
+      _offset = static_cast<size_t>(entry.GetCurrent() - _data.data()) + size;
+      ReadNextFrame();
+    }
+  }
+
+  void EventReplayDevice::ReadNextFrame() noexcept
+  {
+    if (IsFinished())
+      return;
+
+    EventRecordReader entry(_data.data() + _offset, _data.size() - _offset);
+    _nextFrame += entry.ReadVarint();
+  }
+}
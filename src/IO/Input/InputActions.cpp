@@ -0,0 +1,155 @@
+#include "IO/Input/InputActions.hpp"
+#include "Debug/Macros.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace Krys
+{
+  InputActionMap::InputActionMap(const Keyboard &keyboard, const Mouse &mouse) noexcept
+      : _keyboard(keyboard), _mouse(mouse)
+  {
+  }
+
+  InputAction InputActionMap::AddAction(ActionId id) noexcept
+  {
+    if (auto existing = FindAction(id))
+      return *existing;
+
+    KRYS_ASSERT(_actions.size() < MaxActions, "Too many input actions, the limit is {}", MaxActions);
+    _actions.push_back(id);
+    return static_cast<InputAction>(_actions.size() - 1);
+  }
+
+  Nullable<InputAction> InputActionMap::FindAction(ActionId id) const noexcept
+  {
+    auto it = std::find(_actions.begin(), _actions.end(), id);
+    if (it == _actions.end())
+      return std::nullopt;
+    return static_cast<InputAction>(it - _actions.begin());
+  }
+
+  void InputActionMap::Bind(InputAction action, Key key) noexcept
+  {
+    KRYS_ASSERT(action < _actions.size(), "Unknown input action");
+    _keyActions[static_cast<size_t>(key)] |= 1ull << action;
+    Resync();
+  }
+
+  void InputActionMap::Bind(InputAction action, MouseButton button) noexcept
+  {
+    KRYS_ASSERT(action < _actions.size(), "Unknown input action");
+    _buttonActions[GetButtonIndex(button)] |= 1ull << action;
+    Resync();
+  }
+
+  void InputActionMap::ClearBindings(InputAction action) noexcept
+  {
+    const uint64 mask = ~(1ull << action);
+    for (auto &actions : _keyActions)
+      actions &= mask;
+    for (auto &actions : _buttonActions)
+      actions &= mask;
+    Resync();
+  }
+
+  bool InputActionMap::IsActionPressed(InputAction action) const noexcept
+  {
+    return (_pressed >> action) & 1;
+  }
+
+  bool InputActionMap::IsActionHeld(InputAction action) const noexcept
+  {
+    return ((_down & _previous) >> action) & 1;
+  }
+
+  bool InputActionMap::WasActionReleased(InputAction action) const noexcept
+  {
+    return (_released >> action) & 1;
+  }
+
+  bool InputActionMap::IsActionDown(InputAction action) const noexcept
+  {
+    return (_down >> action) & 1;
+  }
+
+  void InputActionMap::BeginFrame() noexcept
+  {
+    _previous = _down;
+    _pressed = 0;
+    _released = 0;
+  }
+
+  void InputActionMap::OnKey(Key key, bool down) noexcept
+  {
+    const uint64 actions = _keyActions[static_cast<size_t>(key)];
+    if (down)
+      Press(actions);
+    else
+      Release(actions);
+  }
+
+  void InputActionMap::OnButton(MouseButton button, bool down) noexcept
+  {
+    const uint64 actions = _buttonActions[GetButtonIndex(button)];
+    if (down)
+      Press(actions);
+    else
+      Release(actions);
+  }
+
+  void InputActionMap::Press(uint64 actions) noexcept
+  {
+    for (; actions != 0; actions &= actions - 1)
+    {
+      const auto action = std::countr_zero(actions);
+      if (_downCount[action]++ > 0)
+        continue;
+
+      _down |= 1ull << action;
+      _pressed |= 1ull << action;
+    }
+  }
+
+  void InputActionMap::Release(uint64 actions) noexcept
+  {
+    for (; actions != 0; actions &= actions - 1)
+    {
+      const auto action = std::countr_zero(actions);
+      if (_downCount[action] == 0 || --_downCount[action] > 0)
+        continue;
+
+      _down &= ~(1ull << action);
+      _released |= 1ull << action;
+    }
+  }
+
+  void InputActionMap::Resync() noexcept
+  {
+    _downCount = {};
+
+    const KeyBits &keys = _keyboard.GetDownKeys();
+    for (uint32 key = 0; key < KeyCount; key++)
+      if (keys.test(key))
+        for (uint64 actions = _keyActions[key]; actions != 0; actions &= actions - 1)
+          _downCount[std::countr_zero(actions)]++;
+
+    for (uint32 button = 0; button < MouseButtonCount; button++)
+      if (_mouse.IsButtonDown(static_cast<MouseButton>(1 << button)))
+        for (uint64 actions = _buttonActions[button]; actions != 0; actions &= actions - 1)
+          _downCount[std::countr_zero(actions)]++;
+
+    // Only the current state changes, so rebinding doesn't look like a press or release.
+    _down = 0;
+    for (uint32 action = 0; action < MaxActions; action++)
+      if (_downCount[action] > 0)
+        _down |= 1ull << action;
+  }
+
+  uint32 InputActionMap::GetButtonIndex(MouseButton button) noexcept
+  {
+    const auto bits = static_cast<uint16>(button);
+    KRYS_ASSERT(std::has_single_bit(bits), "Exactly one mouse button must be given");
+    return static_cast<uint32>(std::countr_zero(bits));
+  }
+}
@@ -3,11 +3,53 @@
 #include "Events/Input/KeyboardEvent.hpp"
 #include "Events/Input/MouseButtonEvent.hpp"
 #include "Events/Input/MouseMoveEvent.hpp"
+#include "Events/Input/ScrollWheelEvent.hpp"
 
 namespace Krys
 {
-  InputManager::InputManager(Ptr<EventManager> eventManager) noexcept : _eventManager(eventManager)
+  InputManager::InputManager(Ptr<EventManager> eventManager) noexcept
+      : _actions(_keyboard, _mouse), _eventManager(eventManager)
   {
+    // Registered before anything else, so device state is up to date by the time other handlers see an event.
+    _eventManager->RegisterHandler<MouseMoveEvent>(
+      [this](const MouseMoveEvent &event)
+      {
+        OnInput(event);
+        _mouse._deltaX += event.DeltaX();
+        _mouse._deltaY += event.DeltaY();
+        _mouse._clientX = event.GetClientX();
+        _mouse._clientY = event.GetClientY();
+        return false;
+      });
+
+    _eventManager->RegisterHandler<MouseButtonEvent>(
+      [this](const MouseButtonEvent &event)
+      {
+        OnInput(event);
+        const bool wasDown = _mouse.IsButtonDown(event.GetButton());
+        _mouse.Update(event.GetButton(), event.GetState());
+        if (const bool isDown = _mouse.IsButtonDown(event.GetButton()); isDown != wasDown)
+          _actions.OnButton(event.GetButton(), isDown);
+        return false;
+      });
+
+    _eventManager->RegisterHandler<KeyboardEvent>(
+      [this](const KeyboardEvent &event)
+      {
+        OnInput(event);
+        const bool wasDown = _keyboard.IsKeyDown(event.GetKey());
+        _keyboard.Update(event.GetKey(), event.GetState());
+        if (const bool isDown = _keyboard.IsKeyDown(event.GetKey()); isDown != wasDown)
+          _actions.OnKey(event.GetKey(), isDown);
+        return false;
+      });
+
+    _eventManager->RegisterHandler<ScrollWheelEvent>(
+      [this](const ScrollWheelEvent &event)
+      {
+        OnInput(event);
+        return false;
+      });
   }
 
   InputManager::~InputManager() noexcept
@@ -17,58 +59,14 @@ namespace Krys
 
   void InputManager::PollDevices() noexcept
   {
-    ResetMouse();
-    ResetKeyboard();
-
-    while (!_events.empty())
-    {
-      auto &event = _events.front();
-      switch (event->GetEventType())
-      {
-        case SID("mouse-move-event"):
-        {
-          auto mouseMoveEvent = static_cast<MouseMoveEvent *>(event.get());
-          _mouse._deltaX += mouseMoveEvent->DeltaX();
-          _mouse._deltaY += mouseMoveEvent->DeltaY();
-          _mouse._clientX = mouseMoveEvent->GetClientX();
-          _mouse._clientY = mouseMoveEvent->GetClientY();
-        }
-        break;
-
-        case SID("mouse-button-event"):
-        {
-          auto mouseButtonEvent = static_cast<MouseButtonEvent *>(event.get());
-          switch (mouseButtonEvent->GetState())
-          {
-            case MouseButtonState::Pressed:  _mouse._pressed |= mouseButtonEvent->GetButton(); break;
-            case MouseButtonState::Released: _mouse._released |= mouseButtonEvent->GetButton(); break;
-            default:                         KRYS_ASSERT(false, "Unknown mouse button state"); break;
-          }
-        }
-        break;
-
-        case SID("keyboard-event"):
-        {
-          auto keyboardEvent = static_cast<KeyboardEvent *>(event.get());
-          switch (keyboardEvent->GetState())
-          {
-            case KeyState::Pressed:  _keyboard._pressed.emplace(keyboardEvent->GetKey()); break;
-            case KeyState::Held:     _keyboard._held.emplace(keyboardEvent->GetKey()); break;
-            case KeyState::Released: _keyboard._released.emplace(keyboardEvent->GetKey()); break;
-            default:                 KRYS_ASSERT(false, "Unknown key state"); break;
-          }
-        }
-        break;
-
-        default: break;
-      }
-
-      _eventManager->Enqueue(std::move(event));
-      _events.pop();
-    }
+    _mouse.BeginFrame();
+    _keyboard.BeginFrame();
+    _actions.BeginFrame();
+    _oldestInputTimestamp.reset();
 
-    for (auto &[_, device] : _customInputDevices)
-      device->PollDevice(_eventManager);
+    for (auto &[id, device] : _customInputDevices)
+      if (!_exclusiveDevice || id == *_exclusiveDevice)
+        device->PollDevice(_eventManager);
   }
 
   void InputManager::RegisterHID(const DeviceId id, Unique<HID> device) noexcept
@@ -77,6 +75,11 @@ namespace Krys
     _customInputDevices.emplace(id, std::move(device));
   }
 
+  void InputManager::SetExclusiveDevice(Nullable<DeviceId> id) noexcept
+  {
+    _exclusiveDevice = id;
+  }
+
   const Mouse &InputManager::GetMouse() const noexcept
   {
     return _mouse;
@@ -97,20 +100,24 @@ namespace Krys
     return nullptr;
   }
 
-  void InputManager::ResetMouse() noexcept
+  InputActionMap &InputManager::GetActions() noexcept
+  {
+    return _actions;
+  }
+
+  const InputActionMap &InputManager::GetActions() const noexcept
+  {
+    return _actions;
+  }
+
+  Nullable<int64> InputManager::GetOldestInputTimestamp() const noexcept
   {
-    _mouse._deltaX = 0.0f;
-    _mouse._deltaY = 0.0f;
-    _mouse._held |= _mouse._pressed;
-    _mouse._held &= ~_mouse._released;
-    _mouse._pressed = MouseButton::None;
-    _mouse._released = MouseButton::None;
+    return _oldestInputTimestamp;
   }
 
-  void InputManager::ResetKeyboard() noexcept
+  void InputManager::OnInput(const InputEvent &event) noexcept
   {
-    _keyboard._pressed.clear();
-    _keyboard._held.clear();
-    _keyboard._released.clear();
+    if (!_oldestInputTimestamp || event.GetTimestamp() < *_oldestInputTimestamp)
+      _oldestInputTimestamp = event.GetTimestamp();
   }
-}
+}
\ No newline at end of file
@@ -1,19 +1,59 @@
 #include "IO/Input/Keyboard.hpp"
+#include "Debug/Macros.hpp"
 
 namespace Krys
 {
   NO_DISCARD bool Krys::Keyboard::IsKeyPressed(Key key) const noexcept
   {
-    return _pressed.contains(key);
+    return _pressed.test(static_cast<size_t>(key));
   }
 
   NO_DISCARD bool Krys::Keyboard::IsKeyHeld(Key key) const noexcept
   {
-    return _held.contains(key);
+    const auto index = static_cast<size_t>(key);
+    return _down.test(index) && _previous.test(index);
   }
 
   NO_DISCARD bool Krys::Keyboard::WasKeyReleased(Key key) const noexcept
   {
-    return _released.contains(key);
+    return _released.test(static_cast<size_t>(key));
+  }
+
+  NO_DISCARD bool Krys::Keyboard::IsKeyDown(Key key) const noexcept
+  {
+    return _down.test(static_cast<size_t>(key));
+  }
+
+  NO_DISCARD const KeyBits &Krys::Keyboard::GetDownKeys() const noexcept
+  {
+    return _down;
+  }
+
+  void Keyboard::BeginFrame() noexcept
+  {
+    _previous = _down;
+    _pressed.reset();
+    _released.reset();
+  }
+
+  void Keyboard::Update(Key key, KeyState state) noexcept
+  {
+    const auto index = static_cast<size_t>(key);
+    switch (state)
+    {
+      case KeyState::Pressed:
+        _pressed.set(index);
+        _down.set(index);
+        break;
+      case KeyState::Held:
+        // Repeats only tell us the key is still down, which we already know unless the press was missed.
+        _down.set(index);
+        break;
+      case KeyState::Released:
+        _released.set(index);
+        _down.reset(index);
+        break;
+      default: KRYS_ASSERT(false, "Unknown key state"); break;
+    }
   }
 }
@@ -1,4 +1,5 @@
 #include "IO/Input/Mouse.hpp"
+#include "Debug/Macros.hpp"
 
 namespace Krys
 {
@@ -29,11 +30,43 @@ namespace Krys
 
   NO_DISCARD bool Mouse::IsButtonHeld(MouseButton button) const noexcept
   {
-    return (_held & button) == button;
+    return (_down & _previous & button) == button;
+  }
+
+  NO_DISCARD bool Mouse::IsButtonDown(MouseButton button) const noexcept
+  {
+    return (_down & button) == button;
   }
 
   NO_DISCARD bool Mouse::WasButtonReleased(MouseButton button) const noexcept
   {
     return (_released & button) == button;
   }
+  void Mouse::BeginFrame() noexcept
+  {
+    _deltaX = 0.0f;
+    _deltaY = 0.0f;
+    _previous = _down;
+    _pressed = MouseButton::None;
+    _released = MouseButton::None;
+  }
+
+  void Mouse::Update(MouseButton button, MouseButtonState state) noexcept
+  {
+    switch (state)
+    {
+      case MouseButtonState::Pressed:
+        _pressed |= button;
+        _down |= button;
+        break;
+      case MouseButtonState::Held:
+        _down |= button;
+        break;
+      case MouseButtonState::Released:
+        _released |= button;
+        _down &= ~button;
+        break;
+      default: KRYS_ASSERT(false, "Unknown mouse button state"); break;
+    }
+  }
 }
@@ -0,0 +1,398 @@
+#include "IO/Logger.hpp"
+#include "Base/Pointers.hpp"
+#include "Core/Platform.hpp"
+
+#include <fstream>
+#include <thread>
+
+namespace Krys
+{
+  std::atomic<uint8> Logger::_level {static_cast<uint8>(LogLevel::Debug)};
+  std::atomic<uint32> Logger::_categories {~0u};
+}
+
+namespace Krys::Impl
+{
+  /// @brief Owns the writer thread and the registry of per-thread queues.
+  class LogBackend
+  {
+  public:
+    NO_COPY_MOVE(LogBackend)
+
+    LogBackend() noexcept : _running(true), _writer([this]() { Run(); })
+    {
+    }
+
+    ~LogBackend() noexcept
+    {
+      Shutdown();
+    }
+
+    NO_DISCARD static LogBackend &Get() noexcept
+    {
+      static LogBackend backend;
+      return backend;
+    }
+
+    /// @brief Set once the backend has stopped, after which messages are written synchronously.
+    NO_DISCARD static bool IsShutDown() noexcept
+    {
+      return s_ShutDown.load(std::memory_order_acquire);
+    }
+
+    void Register(const Ref<LogQueue> &queue) noexcept
+    {
+      std::lock_guard<std::mutex> lock(_registryMutex);
+      queue->ThreadId = _nextThreadId++;
+      _queues.push_back(queue);
+    }
+
+    /// @brief Marks the calling thread as about to publish a record.
+    /// @returns False if the backend has shut down, in which case the record must not be published.
+    NO_DISCARD static bool BeginProducing() noexcept
+    {
+      // Paired with `Shutdown`, which sets the flag and then waits for the count: either this sees the flag,
+      // or `Shutdown` sees the count and waits for the record to be published before its final drain.
+      s_Producers.fetch_add(1, std::memory_order_seq_cst);
+      if (!s_ShutDown.load(std::memory_order_seq_cst))
+        return true;
+
+      EndProducing();
+      return false;
+    }
+
+    static void EndProducing() noexcept
+    {
+      s_Producers.fetch_sub(1, std::memory_order_release);
+    }
+
+    /// @brief Writes everything submitted before this call. Safe to call from any thread.
+    /// @details Anything submitted before this call has already been published, so a single pass over the
+    /// queues is enough. Draining until they are empty could go on forever while other threads keep logging.
+    void Flush() noexcept
+    {
+      std::lock_guard<std::mutex> lock(_drainMutex);
+      Drain();
+    }
+
+    void Shutdown() noexcept
+    {
+      if (s_ShutDown.exchange(true, std::memory_order_seq_cst))
+        return;
+
+      // The writer keeps draining while producers that got in before the flag finish, so none of them can be
+      // stuck waiting for space.
+      while (s_Producers.load(std::memory_order_acquire) != 0)
+        std::this_thread::yield();
+
+      _running.store(false, std::memory_order_release);
+      if (_writer.joinable())
+        _writer.join();
+
+      Flush();
+      CloseBinaryLog();
+    }
+
+    bool OpenBinaryLog(const stringview &path) noexcept
+    {
+      std::lock_guard<std::mutex> lock(_drainMutex);
+
+      // Anything logged before this call still goes to the previous output.
+      Drain();
+      CloseBinaryLogUnlocked();
+
+      _binaryLog.open(string {path}, std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!_binaryLog.is_open())
+        return false;
+
+      _formatIds.clear();
+      _binaryBuffer.insert(_binaryBuffer.end(), reinterpret_cast<const byte *>(BinaryLogMagic.data()),
+                           reinterpret_cast<const byte *>(BinaryLogMagic.data()) + BinaryLogMagic.size());
+      AppendLogBytes(_binaryBuffer, BinaryLogVersion);
+      AppendLogBytes(_binaryBuffer, Platform::GetTickFrequency());
+      FlushBinaryBuffer();
+      return true;
+    }
+
+    void CloseBinaryLog() noexcept
+    {
+      std::lock_guard<std::mutex> lock(_drainMutex);
+      Drain();
+      CloseBinaryLogUnlocked();
+    }
+
+  private:
+    struct FormatKey
+    {
+      const char *Format;
+      const LogArgsInfo *Args;
+
+      bool operator==(const FormatKey &) const noexcept = default;
+    };
+
+    struct FormatKeyHasher
+    {
+      NO_DISCARD size_t operator()(const FormatKey &key) const noexcept
+      {
+        return std::hash<const void *> {}(key.Format) ^ (std::hash<const void *> {}(key.Args) << 1);
+      }
+    };
+
+    void Run() noexcept
+    {
+      uint32 idleSpins = 0;
+      while (_running.load(std::memory_order_acquire))
+      {
+        bool wroteAnything;
+        {
+          std::lock_guard<std::mutex> lock(_drainMutex);
+          wroteAnything = Drain();
+        }
+
+        if (wroteAnything)
+          idleSpins = 0;
+        else if (++idleSpins < 64)
+          std::this_thread::yield();
+        else
+          Platform::Sleep(1);
+      }
+    }
+
+    /// @brief Writes every record currently published by every queue. `_drainMutex` must be held.
+    /// @returns True if anything was written.
+    bool Drain() noexcept
+    {
+      std::lock_guard<std::mutex> lock(_registryMutex);
+
+      bool wroteAnything = false;
+      for (auto it = _queues.begin(); it != _queues.end();)
+      {
+        auto &queue = **it;
+
+        // Only drain what's there now so a busy producer can't starve the others.
+        const size_t available = queue.Records.GetWriteCount() - queue.Records.GetReadCount();
+        for (size_t i = 0; i < available; i++)
+        {
+          Write(queue, *queue.Records.BeginRead());
+          queue.Records.EndRead();
+        }
+        wroteAnything |= available > 0;
+
+        if (queue.Retired.load(std::memory_order_acquire) && queue.Records.IsEmpty())
+          it = _queues.erase(it);
+        else
+          ++it;
+      }
+
+      if (!_buffer.empty())
+      {
+        Logger::Output(_buffer);
+        _buffer.clear();
+      }
+      FlushBinaryBuffer();
+
+      return wroteAnything;
+    }
+
+    void Write(const LogQueue &queue, LogRecord &record) noexcept
+    {
+      if (_binaryLog.is_open())
+        WriteBinary(queue, record);
+      else
+        WriteText(record);
+
+      record.ArgsInfo->Destroy(record.Storage);
+    }
+
+    void WriteText(const LogRecord &record) noexcept
+    {
+      if (!(record.Flags & LogRecordFlags::Raw))
+        _buffer += Logger::Prefix(record.Level, record.Flags);
+
+      record.ArgsInfo->Format(_buffer, record.Format, record.Storage);
+
+      if (!!(record.Flags & LogRecordFlags::NewLine))
+        _buffer += '\n';
+    }
+
+    void WriteBinary(const LogQueue &queue, const LogRecord &record) noexcept
+    {
+      static constexpr LogArgType FormattedMessageTypes[] = {LogArgType::String};
+      static constexpr LogArgsInfo FormattedMessage {nullptr, nullptr, nullptr, FormattedMessageTypes, 1};
+
+      // Arguments that can't be encoded are formatted here and stored as a single string.
+      const bool encodable = record.ArgsInfo->Encode != nullptr;
+      const FormatKey key = encodable ? FormatKey {record.Format.data(), record.ArgsInfo}
+                                      : FormatKey {"{}", &FormattedMessage};
+
+      auto it = _formatIds.find(key);
+      if (it == _formatIds.end())
+      {
+        it = _formatIds.emplace(key, static_cast<uint32>(_formatIds.size())).first;
+        const stringview format = encodable ? record.Format : stringview {"{}"};
+
+        AppendLogBytes(_binaryBuffer, static_cast<uint8>(BinaryLogEntry::Format));
+        AppendLogBytes(_binaryBuffer, it->second);
+        AppendLogBytes(_binaryBuffer, format);
+        AppendLogBytes(_binaryBuffer, key.Args->Count);
+        for (uint8 i = 0; i < key.Args->Count; i++)
+          AppendLogBytes(_binaryBuffer, static_cast<uint8>(key.Args->Types[i]));
+      }
+
+      AppendLogBytes(_binaryBuffer, static_cast<uint8>(BinaryLogEntry::Message));
+      AppendLogBytes(_binaryBuffer, it->second);
+      AppendLogBytes(_binaryBuffer, record.Timestamp);
+      AppendLogBytes(_binaryBuffer, queue.ThreadId);
+      AppendLogBytes(_binaryBuffer, static_cast<uint8>(record.Level));
+      AppendLogBytes(_binaryBuffer, static_cast<uint8>(record.Category));
+      AppendLogBytes(_binaryBuffer, static_cast<uint8>(record.Flags));
+
+      if (encodable)
+        record.ArgsInfo->Encode(_binaryBuffer, record.Storage);
+      else
+      {
+        string message;
+        record.ArgsInfo->Format(message, record.Format, record.Storage);
+        AppendLogBytes(_binaryBuffer, stringview {message});
+      }
+    }
+
+    void FlushBinaryBuffer() noexcept
+    {
+      if (_binaryBuffer.empty())
+        return;
+
+      if (_binaryLog.is_open())
+      {
+        _binaryLog.write(reinterpret_cast<const char *>(_binaryBuffer.data()), _binaryBuffer.size());
+        _binaryLog.flush();
+      }
+      _binaryBuffer.clear();
+    }
+
+    /// @brief `_drainMutex` must be held.
+    void CloseBinaryLogUnlocked() noexcept
+    {
+      FlushBinaryBuffer();
+      if (_binaryLog.is_open())
+        _binaryLog.close();
+    }
+
+  private:
+    static inline std::atomic<bool> s_ShutDown {false};
+
+    /// @brief Threads between `BeginRecord` and `EndRecord`.
+    static inline std::atomic<uint32> s_Producers {0};
+
+    std::mutex _registryMutex;
+    List<Ref<LogQueue>> _queues;
+    uint32 _nextThreadId {0};
+
+    /// @brief Serialises consumers so `Flush` can drain on the calling thread.
+    std::mutex _drainMutex;
+
+    /// @brief Formatted output, batched so the platform outputs see one write per drain.
+    string _buffer;
+
+    std::ofstream _binaryLog;
+    List<byte> _binaryBuffer;
+    Map<FormatKey, uint32, FormatKeyHasher> _formatIds;
+
+    std::atomic<bool> _running;
+    std::thread _writer;
+  };
+
+  /// @brief Registers the calling thread's queue on first use and retires it when the thread exits.
+  struct ThreadLogQueue
+  {
+    Ref<LogQueue> Queue;
+
+    ThreadLogQueue() noexcept : Queue(CreateRef<LogQueue>())
+    {
+      LogBackend::Get().Register(Queue);
+    }
+
+    ~ThreadLogQueue() noexcept
+    {
+      Queue->Retired.store(true, std::memory_order_release);
+    }
+  };
+
+  static LogQueue &GetThreadLogQueue() noexcept
+  {
+    thread_local ThreadLogQueue queue;
+    return *queue.Queue;
+  }
+}
+
+namespace Krys
+{
+  void Logger::SetLevel(LogLevel level) noexcept
+  {
+    _level.store(static_cast<uint8>(level), std::memory_order_relaxed);
+  }
+
+  LogLevel Logger::GetLevel() noexcept
+  {
+    return static_cast<LogLevel>(_level.load(std::memory_order_relaxed));
+  }
+
+  void Logger::SetCategoryEnabled(LogCategory category, bool enabled) noexcept
+  {
+    if (enabled)
+      _categories.fetch_or(ToBit(category), std::memory_order_relaxed);
+    else
+      _categories.fetch_and(~ToBit(category), std::memory_order_relaxed);
+  }
+
+  void Logger::Flush() noexcept
+  {
+    if (!Impl::LogBackend::IsShutDown())
+      Impl::LogBackend::Get().Flush();
+  }
+
+  void Logger::Shutdown() noexcept
+  {
+    if (!Impl::LogBackend::IsShutDown())
+      Impl::LogBackend::Get().Shutdown();
+  }
+
+  bool Logger::OpenBinaryLog(const stringview &path) noexcept
+  {
+    if (Impl::LogBackend::IsShutDown())
+      return false;
+    return Impl::LogBackend::Get().OpenBinaryLog(path);
+  }
+
+  void Logger::CloseBinaryLog() noexcept
+  {
+    if (!Impl::LogBackend::IsShutDown())
+      Impl::LogBackend::Get().CloseBinaryLog();
+  }
+
+  Impl::LogRecord *Logger::BeginRecord() noexcept
+  {
+    if (!Impl::LogBackend::BeginProducing())
+      return nullptr;
+
+    // The writer keeps running until every producer that got this far has published, so waiting for space
+    // can't deadlock with `Shutdown`.
+    auto &queue = Impl::GetThreadLogQueue();
+    Impl::LogRecord *record = queue.Records.BeginWrite();
+    while (record == nullptr)
+    {
+      // The writer is behind, wait for it rather than dropping messages.
+      std::this_thread::yield();
+      record = queue.Records.BeginWrite();
+    }
+
+    record->Timestamp = Platform::GetTicks();
+    return record;
+  }
+
+  void Logger::EndRecord() noexcept
+  {
+    Impl::GetThreadLogQueue().Records.EndWrite();
+    Impl::LogBackend::EndProducing();
+  }
+}
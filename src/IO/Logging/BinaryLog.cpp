@@ -0,0 +1,353 @@
+#include "IO/Logging/BinaryLog.hpp"
+#include "IO/Logger.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <variant>
+
+namespace Krys
+{
+  namespace
+  {
+    using namespace Impl;
+
+    using LogArgValue = std::variant<bool, char, int64, uint64, float32, float64, string, const void *>;
+
+    struct LogFormat
+    {
+      string Format;
+      List<LogArgType> Types;
+    };
+
+    /// @brief Bounds checked cursor over the contents of a binary log.
+    class LogCursor
+    {
+    public:
+      explicit LogCursor(const List<byte> &data) noexcept : _data(data)
+      {
+      }
+
+      NO_DISCARD bool IsEOS() const noexcept
+      {
+        return _offset >= _data.size();
+      }
+
+      template <IsArithmeticT T>
+      NO_DISCARD bool Read(T &value) noexcept
+      {
+        if (_data.size() - _offset < sizeof(T))
+          return false;
+
+        Array<byte, sizeof(T)> bytes;
+        std::memcpy(bytes.data(), _data.data() + _offset, sizeof(T));
+        _offset += sizeof(T);
+
+        if constexpr (std::is_same_v<T, bool>)
+          value = bytes[0] != byte {0};
+        else
+          value = Endian::Convert<T, Endian::Type::Little, Endian::Type::System>(std::bit_cast<T>(bytes));
+        return true;
+      }
+
+      NO_DISCARD bool Read(string &value) noexcept
+      {
+        uint32 length;
+        if (!Read(length) || _data.size() - _offset < length)
+          return false;
+
+        value.assign(reinterpret_cast<const char *>(_data.data() + _offset), length);
+        _offset += length;
+        return true;
+      }
+
+    private:
+      const List<byte> &_data;
+      size_t _offset {0};
+    };
+
+    template <typename TEncoded, typename TValue>
+    NO_DISCARD bool ReadAs(LogCursor &cursor, LogArgValue &value) noexcept
+    {
+      TEncoded encoded;
+      if (!cursor.Read(encoded))
+        return false;
+
+      value = static_cast<TValue>(encoded);
+      return true;
+    }
+
+    NO_DISCARD bool ReadArg(LogCursor &cursor, LogArgType type, LogArgValue &value) noexcept
+    {
+      switch (type)
+      {
+        case LogArgType::Bool:    return ReadAs<bool, bool>(cursor, value);
+        case LogArgType::Char:    return ReadAs<char, char>(cursor, value);
+        case LogArgType::Int8:    return ReadAs<int8, int64>(cursor, value);
+        case LogArgType::Int16:   return ReadAs<int16, int64>(cursor, value);
+        case LogArgType::Int32:   return ReadAs<int32, int64>(cursor, value);
+        case LogArgType::Int64:   return ReadAs<int64, int64>(cursor, value);
+        case LogArgType::UInt8:   return ReadAs<uint8, uint64>(cursor, value);
+        case LogArgType::UInt16:  return ReadAs<uint16, uint64>(cursor, value);
+        case LogArgType::UInt32:  return ReadAs<uint32, uint64>(cursor, value);
+        case LogArgType::UInt64:  return ReadAs<uint64, uint64>(cursor, value);
+        case LogArgType::Float32: return ReadAs<float32, float32>(cursor, value);
+        case LogArgType::Float64: return ReadAs<float64, float64>(cursor, value);
+        case LogArgType::String:
+        {
+          string text;
+          if (!cursor.Read(text))
+            return false;
+          value = std::move(text);
+          return true;
+        }
+        case LogArgType::Pointer:
+        {
+          uint64 address;
+          if (!cursor.Read(address))
+            return false;
+          value = reinterpret_cast<const void *>(static_cast<uintptr_t>(address));
+          return true;
+        }
+        default: return false;
+      }
+    }
+
+    /// @brief Resolves the argument id of a replacement field, which is the next argument if `id` is empty.
+    NO_DISCARD Expected<size_t> GetArgIndex(stringview id, size_t &nextArg, size_t argCount) noexcept
+    {
+      size_t index = nextArg++;
+      if (!id.empty())
+      {
+        index = 0;
+        for (char digit : id)
+        {
+          if (digit < '0' || digit > '9' || index > argCount)
+            return Unexpected<string>("Invalid argument id in replacement field");
+          index = index * 10 + static_cast<size_t>(digit - '0');
+        }
+      }
+
+      if (index >= argCount)
+        return Unexpected<string>("Replacement field refers to a missing argument");
+      return index;
+    }
+
+    /// @brief Replaces the nested replacement fields in `spec`, as in `{:{}.{}}`, with the width or precision
+    /// they refer to.
+    NO_DISCARD Expected<string> ResolveSpec(stringview spec, const List<LogArgValue> &args,
+                                            size_t &nextArg) noexcept
+    {
+      string resolved;
+      for (size_t i = 0; i < spec.size(); i++)
+      {
+        if (spec[i] != '{')
+        {
+          resolved += spec[i];
+          continue;
+        }
+
+        const size_t end = spec.find('}', i);
+        if (end == stringview::npos)
+          return Unexpected<string>("Unterminated nested replacement field");
+
+        auto index = GetArgIndex(spec.substr(i + 1, end - i - 1), nextArg, args.size());
+        if (!index)
+          return Unexpected<string>(index.error());
+
+        if (const auto *value = std::get_if<int64>(&args[*index]))
+          resolved += std::to_string(*value);
+        else if (const auto *value = std::get_if<uint64>(&args[*index]))
+          resolved += std::to_string(*value);
+        else
+          return Unexpected<string>("Width or precision argument isn't an integer");
+        i = end;
+      }
+
+      return resolved;
+    }
+
+    /// @brief Formats `args` using `format`. `std::vformat` needs the argument types at compile time, so each
+    /// replacement field is formatted on its own, with any nested width or precision fields filled in first.
+    /// @details The format and the argument types come from the file rather than the compiler, so a corrupt
+    /// or mismatched log can hold a spec that doesn't fit its argument. `std::vformat_to` throws for those,
+    /// which is turned into an error here rather than escaping `DecodeBinaryLog`.
+    NO_DISCARD Expected<string> FormatMessage(stringview format, const List<LogArgValue> &args) noexcept
+    {
+      string out;
+      size_t nextArg = 0;
+
+      for (size_t i = 0; i < format.size(); i++)
+      {
+        const char c = format[i];
+        if (c == '}')
+        {
+          if (i + 1 >= format.size() || format[i + 1] != '}')
+            return Unexpected<string>("Unmatched '}' in format");
+
+          out += c;
+          i++;
+          continue;
+        }
+        if (c != '{')
+        {
+          out += c;
+          continue;
+        }
+        if (i + 1 < format.size() && format[i + 1] == '{')
+        {
+          out += c;
+          i++;
+          continue;
+        }
+
+        // Nested fields can only appear in the spec, so the field ends at the '}' that closes it.
+        size_t end = i + 1;
+        for (size_t depth = 1; end < format.size(); end++)
+        {
+          if (format[end] == '{')
+            depth++;
+          else if (format[end] == '}' && --depth == 0)
+            break;
+        }
+        if (end >= format.size())
+          return Unexpected<string>("Unterminated replacement field");
+
+        const stringview field = format.substr(i + 1, end - i - 1);
+        const size_t colon = field.find(':');
+
+        // The field's own argument comes before any in its spec when they're numbered automatically.
+        auto index = GetArgIndex(field.substr(0, colon), nextArg, args.size());
+        if (!index)
+          return Unexpected<string>(index.error());
+
+        Expected<string> spec;
+        if (colon != stringview::npos)
+          spec = ResolveSpec(field.substr(colon), args, nextArg);
+        if (!spec)
+          return Unexpected<string>(spec.error());
+
+        const string single = "{" + *spec + "}";
+        try
+        {
+          std::visit([&](const auto &value)
+                     { std::vformat_to(std::back_inserter(out), single, std::make_format_args(value)); },
+                     args[*index]);
+        }
+        catch (const std::format_error &error)
+        {
+          return Unexpected<string>(
+            std::format("Invalid replacement field '{{{0}}}': {1}", field, error.what()));
+        }
+        i = end;
+      }
+
+      return out;
+    }
+  }
+
+  NO_DISCARD Expected<string> DecodeBinaryLog(const stringview &path) noexcept
+  {
+    std::ifstream file(string {path}, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+      return Unexpected<string>(std::format("Unable to open '{}'", path));
+
+    List<byte> data;
+    file.seekg(0, std::ios::end);
+    data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0, std::ios::beg);
+    file.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(data.size()));
+
+    LogCursor cursor(data);
+
+    Array<char, 4> magic;
+    for (auto &c : magic)
+      if (!cursor.Read(c))
+        return Unexpected<string>("Not a binary log");
+
+    uint16 version;
+    int64 frequency;
+    if (magic != BinaryLogMagic || !cursor.Read(version) || !cursor.Read(frequency))
+      return Unexpected<string>("Not a binary log");
+    if (version != BinaryLogVersion)
+      return Unexpected<string>(std::format("Unsupported binary log version {}", version));
+    if (frequency <= 0)
+      return Unexpected<string>("Invalid tick frequency");
+
+    Map<uint32, LogFormat> formats;
+    List<LogArgValue> args;
+    Nullable<int64> start;
+    string out;
+
+    while (!cursor.IsEOS())
+    {
+      uint8 kind;
+      uint32 id;
+      if (!cursor.Read(kind) || !cursor.Read(id))
+        return Unexpected<string>("Truncated entry");
+
+      if (kind == static_cast<uint8>(BinaryLogEntry::Format))
+      {
+        LogFormat format;
+        uint8 count;
+        if (!cursor.Read(format.Format) || !cursor.Read(count))
+          return Unexpected<string>("Truncated format entry");
+
+        for (uint8 i = 0; i < count; i++)
+        {
+          uint8 type;
+          if (!cursor.Read(type) || type > static_cast<uint8>(LogArgType::Pointer))
+            return Unexpected<string>("Invalid argument type");
+          format.Types.push_back(static_cast<LogArgType>(type));
+        }
+
+        formats[id] = std::move(format);
+        continue;
+      }
+
+      if (kind != static_cast<uint8>(BinaryLogEntry::Message))
+        return Unexpected<string>(std::format("Unknown entry kind {}", kind));
+
+      int64 ticks;
+      uint32 thread;
+      uint8 level, category, flags;
+      if (!cursor.Read(ticks) || !cursor.Read(thread) || !cursor.Read(level) || !cursor.Read(category)
+          || !cursor.Read(flags))
+        return Unexpected<string>("Truncated message entry");
+
+      auto it = formats.find(id);
+      if (it == formats.end())
+        return Unexpected<string>(std::format("Message refers to unknown format {}", id));
+
+      args.clear();
+      for (auto type : it->second.Types)
+      {
+        if (!ReadArg(cursor, type, args.emplace_back()))
+          return Unexpected<string>("Truncated message arguments");
+      }
+
+      // The arguments have been read, so a message that can't be formatted doesn't stop the rest of the log
+      // from being decoded.
+      auto message = FormatMessage(it->second.Format, args);
+      if (!message)
+        message = std::format("<unformattable message \"{0}\": {1}>", it->second.Format, message.error());
+
+      const auto recordFlags = static_cast<LogRecordFlags>(flags);
+      if (!(recordFlags & LogRecordFlags::Raw))
+      {
+        if (!start)
+          start = ticks;
+
+        const float64 seconds = static_cast<float64>(ticks - *start) / static_cast<float64>(frequency);
+        std::format_to(std::back_inserter(out), "{:>12.6f} [T{}] {}: ", seconds, thread,
+                       ToString(static_cast<LogLevel>(level)));
+      }
+
+      out += *message;
+      if (!!(recordFlags & LogRecordFlags::NewLine))
+        out += '\n';
+    }
+
+    return out;
+  }
+}
@@ -0,0 +1,285 @@
+#include "IO/Readers/BufferedReader.hpp"
+#include "IO/Logger.hpp"
+
+#include <algorithm>
+
+namespace Krys::IO
+{
+#pragma region Sources
+
+  StreamReadSource::StreamReadSource(const stringview &path) noexcept
+      : _stream(string(path), std::ios::in | std::ios::binary)
+  {
+    if (!_stream.is_open())
+    {
+      Logger::Error("IO: Unable to open '{0}'", path);
+      return;
+    }
+
+    _stream.seekg(0, std::ios::end);
+    _size = static_cast<size_t>(_stream.tellg());
+    _stream.seekg(0, std::ios::beg);
+  }
+
+  bool StreamReadSource::IsOpen() const noexcept
+  {
+    return _stream.is_open();
+  }
+
+  size_t StreamReadSource::GetSize() const noexcept
+  {
+    return _size;
+  }
+
+  size_t StreamReadSource::ReadAt(size_t offset, byte *data, size_t size) noexcept
+  {
+    if (offset >= _size)
+      return 0;
+
+    // Blocks are usually read back to back, so only seek when that isn't the case.
+    if (offset != _position)
+    {
+      _stream.clear();
+      _stream.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+    }
+
+    _stream.read(reinterpret_cast<char *>(data), static_cast<std::streamsize>(std::min(size, _size - offset)));
+    const auto read = static_cast<size_t>(_stream.gcount());
+    _position = offset + read;
+    return read;
+  }
+
+  MappedReadSource::MappedReadSource(const stringview &path) noexcept : _file(path)
+  {
+  }
+
+  MappedReadSource::MappedReadSource(MappedFile &&file) noexcept : _file(std::move(file))
+  {
+  }
+
+  bool MappedReadSource::IsOpen() const noexcept
+  {
+    return _file.IsOpen();
+  }
+
+  size_t MappedReadSource::GetSize() const noexcept
+  {
+    return _file.GetSize();
+  }
+
+  size_t MappedReadSource::ReadAt(size_t offset, byte *data, size_t size) noexcept
+  {
+    if (offset >= _file.GetSize())
+      return 0;
+
+    size = std::min(size, _file.GetSize() - offset);
+    std::memcpy(data, _file.GetData() + offset, size);
+    return size;
+  }
+
+  std::span<const byte> MappedReadSource::GetContiguous() const noexcept
+  {
+    return _file.GetSpan();
+  }
+
+  MemoryReadSource::MemoryReadSource(std::span<const byte> data) noexcept : _data(data)
+  {
+  }
+
+  bool MemoryReadSource::IsOpen() const noexcept
+  {
+    return true;
+  }
+
+  size_t MemoryReadSource::GetSize() const noexcept
+  {
+    return _data.size();
+  }
+
+  size_t MemoryReadSource::ReadAt(size_t offset, byte *data, size_t size) noexcept
+  {
+    if (offset >= _data.size())
+      return 0;
+
+    size = std::min(size, _data.size() - offset);
+    std::memcpy(data, _data.data() + offset, size);
+    return size;
+  }
+
+  std::span<const byte> MemoryReadSource::GetContiguous() const noexcept
+  {
+    return _data;
+  }
+
+#pragma endregion Sources
+
+#pragma region BufferedReader
+
+  BufferedReader::BufferedReader(const stringview &path) noexcept
+      : BufferedReader(CreateUnique<MappedReadSource>(path))
+  {
+  }
+
+  BufferedReader::BufferedReader(Unique<ReadSource> source, size_t blockSize) noexcept
+      : _source(std::move(source))
+  {
+    if (!_source->IsOpen())
+      return;
+
+    _size = _source->GetSize();
+    if (const auto contiguous = _source->GetContiguous(); contiguous.size() == _size && _size > 0)
+    {
+      _begin = _current = contiguous.data();
+      _end = _begin + contiguous.size();
+      return;
+    }
+
+    _block.resize(std::max<size_t>(blockSize, 64));
+    _begin = _current = _end = _block.data();
+  }
+
+  BufferedReader::BufferedReader(BufferedReader &&other) noexcept
+      : _source(std::move(other._source)), _block(std::move(other._block)),
+        _size(std::exchange(other._size, 0)), _begin(std::exchange(other._begin, nullptr)),
+        _current(std::exchange(other._current, nullptr)), _end(std::exchange(other._end, nullptr)),
+        _windowOffset(std::exchange(other._windowOffset, 0))
+  {
+  }
+
+  BufferedReader &BufferedReader::operator=(BufferedReader &&other) noexcept
+  {
+    if (this != &other)
+    {
+      _source = std::move(other._source);
+      _block = std::move(other._block);
+      _size = std::exchange(other._size, 0);
+      _begin = std::exchange(other._begin, nullptr);
+      _current = std::exchange(other._current, nullptr);
+      _end = std::exchange(other._end, nullptr);
+      _windowOffset = std::exchange(other._windowOffset, 0);
+    }
+    return *this;
+  }
+
+  bool BufferedReader::IsOpen() const noexcept
+  {
+    return _source && _source->IsOpen();
+  }
+
+  void BufferedReader::Seek(size_t position) noexcept
+  {
+    position = std::min(position, _size);
+    if (position >= _windowOffset && position <= _windowOffset + static_cast<size_t>(_end - _begin))
+    {
+      _current = _begin + (position - _windowOffset);
+      return;
+    }
+
+    // Outside the current block, the next read fetches a new one from here.
+    _windowOffset = position;
+    _begin = _current = _end = _block.data();
+  }
+
+  void BufferedReader::Skip(intmax_t offset) noexcept
+  {
+    const size_t position = GetPosition();
+    if (offset < 0)
+      Seek(position - std::min(position, static_cast<size_t>(-offset)));
+    else
+      Seek(position + std::min(GetRemaining(), static_cast<size_t>(offset)));
+  }
+
+  void BufferedReader::ReadBytes(byte *data, size_t size) noexcept
+  {
+    size_t available = static_cast<size_t>(_end - _current);
+    if (size <= available)
+    {
+      if (size > 0)
+        std::memcpy(data, _current, size);
+      _current += size;
+      return;
+    }
+
+    if (available > 0)
+    {
+      std::memcpy(data, _current, available);
+      _current = _end;
+      data += available;
+      size -= available;
+    }
+
+    size_t read = 0;
+    if (size >= _block.size())
+    {
+      // Large reads skip the block and go straight into the destination.
+      const size_t position = GetPosition();
+      read = _block.empty() ? 0 : _source->ReadAt(position, data, size);
+      Seek(position + read);
+    }
+    else if (Refill(1))
+    {
+      read = std::min(size, static_cast<size_t>(_end - _current));
+      std::memcpy(data, _current, read);
+      _current += read;
+    }
+
+    if (read < size)
+      std::memset(data + read, 0, size - read);
+  }
+
+  string BufferedReader::ReadLine() noexcept
+  {
+    string line;
+    while (_current != _end || Refill(1))
+    {
+      const auto *newline = static_cast<const byte *>(std::memchr(_current, '\n', _end - _current));
+      const auto *lineEnd = newline ? newline : _end;
+      line.append(reinterpret_cast<const char *>(_current), static_cast<size_t>(lineEnd - _current));
+      _current = lineEnd;
+
+      if (newline)
+      {
+        _current++;
+        break;
+      }
+    }
+    return line;
+  }
+
+  void BufferedReader::SkipLine() noexcept
+  {
+    while (_current != _end || Refill(1))
+    {
+      const auto *newline = static_cast<const byte *>(std::memchr(_current, '\n', _end - _current));
+      if (newline)
+      {
+        _current = newline + 1;
+        return;
+      }
+      _current = _end;
+    }
+  }
+
+  bool BufferedReader::Refill(size_t size) noexcept
+  {
+    if (static_cast<size_t>(_end - _current) >= size)
+      return true;
+
+    // In-memory sources are entirely in the window already, and a read can't be bigger than a block.
+    if (_block.empty() || size > _block.size())
+      return false;
+
+    // Keep the unread tail and append a new block after it.
+    const size_t position = GetPosition();
+    const size_t kept = static_cast<size_t>(_end - _current);
+    std::memmove(_block.data(), _current, kept);
+
+    const size_t read = _source->ReadAt(position + kept, _block.data() + kept, _block.size() - kept);
+    _windowOffset = position;
+    _begin = _current = _block.data();
+    _end = _begin + kept + read;
+    return kept + read >= size;
+  }
+
+#pragma endregion BufferedReader
+}
@@ -0,0 +1,300 @@
+#include "IO/VFS/PackFile.hpp"
+#include "Debug/Macros.hpp"
+#include "IO/Logger.hpp"
+#include "IO/Readers/MemoryReader.hpp"
+#include "IO/Writers/BufferedWriter.hpp"
+#include "Utils/Compression.hpp"
+#include "Utils/Hash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace
+{
+  using namespace Krys;
+  using namespace Krys::IO;
+
+  constexpr std::array Magic {byte {'K'}, byte {'P'}, byte {'A'}, byte {'K'}};
+  constexpr uint16 Version = 1;
+
+  /// @brief Magic, version, reserved, entry count and size of the names.
+  constexpr size_t HeaderSize = 16;
+
+  /// @brief Hash, offset, size, original size, name offset, name length, compression and reserved.
+  constexpr size_t EntrySize = 40;
+
+  /// @brief Files smaller than this aren't worth decompressing.
+  constexpr uint64 MinCompressedSize = 64;
+
+  /// @brief Largest size an LZ4 block can expand to per byte, used to reject corrupt sizes before
+  /// allocating for them.
+  constexpr uint64 MaxExpansion = 255;
+
+  NO_DISCARD static uint64 AlignOffset(uint64 offset) noexcept
+  {
+    return (offset + PackFile::EntryAlignment - 1) / PackFile::EntryAlignment * PackFile::EntryAlignment;
+  }
+
+  NO_DISCARD static uint64 HashName(stringview name) noexcept
+  {
+    return HashBytes(std::as_bytes(std::span(name)));
+  }
+
+  NO_DISCARD static Expected<void> Decode(std::span<const byte> file, List<PackEntry> &entries,
+                                          stringview &names) noexcept
+  {
+    if (file.size() < HeaderSize)
+      return Unexpected("File is too small");
+
+    MemoryReader reader(file);
+    const auto magic = reader.ReadSpan(Magic.size());
+    if (!std::equal(magic.begin(), magic.end(), Magic.begin(), Magic.end()))
+      return Unexpected("Invalid KPAK header");
+
+    if (reader.Read<uint16>() != Version)
+      return Unexpected("Unsupported KPAK version");
+
+    reader.Skip(sizeof(uint16));
+    const uint32 count = reader.Read<uint32>();
+    const uint32 namesSize = reader.Read<uint32>();
+    if (count > reader.GetRemaining() / EntrySize || namesSize > reader.GetRemaining() - count * EntrySize)
+      return Unexpected("Entry table is cropped");
+
+    const auto *namesBegin = reinterpret_cast<const char *>(file.data()) + HeaderSize + count * EntrySize;
+    names = stringview(namesBegin, namesSize);
+
+    entries.resize(count);
+    for (uint32 i = 0; i < count; i++)
+    {
+      auto &entry = entries[i];
+      entry.Hash = reader.Read<uint64>();
+      entry.Offset = reader.Read<uint64>();
+      entry.Size = reader.Read<uint64>();
+      entry.OriginalSize = reader.Read<uint64>();
+      entry.NameOffset = reader.Read<uint32>();
+      entry.NameLength = reader.Read<uint16>();
+      entry.Compression = static_cast<PackCompression>(reader.Read<uint8>());
+      reader.Skip(sizeof(uint8));
+
+      if (i > 0 && entry.Hash < entries[i - 1].Hash)
+        return Unexpected("Entry table is not sorted");
+      if (entry.NameOffset > namesSize || entry.NameLength > namesSize - entry.NameOffset)
+        return Unexpected("Entry name is cropped");
+      if (entry.Offset > file.size() || entry.Size > file.size() - entry.Offset)
+        return Unexpected("Entry is cropped");
+
+      switch (entry.Compression)
+      {
+        case PackCompression::None:
+          if (entry.Size != entry.OriginalSize || entry.Offset % PackFile::EntryAlignment != 0)
+            return Unexpected("Invalid stored entry");
+          break;
+        case PackCompression::LZ4:
+          if (entry.OriginalSize / MaxExpansion > entry.Size)
+            return Unexpected("Invalid compressed entry");
+          break;
+        default: return Unexpected("Unknown entry compression");
+      }
+    }
+
+    return {};
+  }
+
+  /// @brief A source that has been read, and compressed if that was worth it, ready to be written.
+  struct PreparedEntry
+  {
+    PackEntry Entry;
+    const PackSource *Source;
+    MappedFile File;
+    List<byte> Compressed;
+  };
+}
+
+namespace Krys::IO
+{
+  bool PackFile::Open(const stringview &path) noexcept
+  {
+    KRYS_SCOPED_PROFILER("PackFile::Open");
+
+    _file = nullptr;
+    _entries.clear();
+    _names = {};
+
+    auto file = CreateRef<MappedFile>(path);
+    if (!file->IsOpen())
+      return false;
+
+    if (auto result = Decode(file->GetSpan(), _entries, _names); !result)
+    {
+      Logger::Error("KPAK: {0} in '{1}'", result.error(), path);
+      _entries.clear();
+      _names = {};
+      return false;
+    }
+
+    _file = std::move(file);
+    return true;
+  }
+
+  const PackEntry *PackFile::Find(stringview name) const noexcept
+  {
+    const uint64 hash = HashName(name);
+    auto it = std::lower_bound(_entries.begin(), _entries.end(), hash,
+                               [](const PackEntry &entry, uint64 value) { return entry.Hash < value; });
+
+    // Different names can share a hash, so the names decide.
+    for (; it != _entries.end() && it->Hash == hash; ++it)
+    {
+      if (GetName(*it) == name)
+        return &*it;
+    }
+
+    return nullptr;
+  }
+
+  VirtualFile PackFile::Read(const PackEntry &entry) const noexcept
+  {
+    KRYS_ASSERT(IsOpen(), "PackFile: Reading from a pack that isn't open");
+
+    const auto data =
+      _file->GetSpan().subspan(static_cast<size_t>(entry.Offset), static_cast<size_t>(entry.Size));
+    if (entry.Compression == PackCompression::None)
+      return VirtualFile(_file, data);
+
+    List<byte> buffer(static_cast<size_t>(entry.OriginalSize));
+    if (!DecompressLZ4(data, buffer))
+    {
+      Logger::Error("KPAK: Entry '{0}' is corrupt", GetName(entry));
+      return {};
+    }
+
+    return VirtualFile(std::move(buffer));
+  }
+
+  stringview PackFile::GetName(const PackEntry &entry) const noexcept
+  {
+    return _names.substr(entry.NameOffset, entry.NameLength);
+  }
+
+  bool PackFile::Save(const string &path, const List<PackSource> &sources) noexcept
+  {
+    KRYS_SCOPED_PROFILER("PackFile::Save");
+
+    List<PreparedEntry> prepared(sources.size());
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+      const auto &source = sources[i];
+      auto &item = prepared[i];
+      if (source.Name.size() > std::numeric_limits<uint16>::max())
+      {
+        Logger::Error("KPAK: Name of '{0}' is too long", source.Path);
+        return false;
+      }
+
+      if (!item.File.Open(source.Path))
+      {
+        Logger::Error("KPAK: Unable to read '{0}'", source.Path);
+        return false;
+      }
+
+      item.Source = &source;
+      item.Entry.Hash = HashName(source.Name);
+      item.Entry.Size = item.Entry.OriginalSize = item.File.GetSize();
+      item.Entry.Compression = PackCompression::None;
+
+      // Compression only pays off if it saves more than decompressing costs.
+      if (source.Compress && item.File.GetSize() >= MinCompressedSize)
+      {
+        item.Compressed = CompressLZ4(item.File.GetSpan());
+        if (item.Compressed.size() <= item.File.GetSize() - item.File.GetSize() / 8)
+        {
+          item.Entry.Size = item.Compressed.size();
+          item.Entry.Compression = PackCompression::LZ4;
+        }
+        else
+          item.Compressed = {};
+      }
+    }
+
+    std::sort(prepared.begin(), prepared.end(),
+              [](const PreparedEntry &a, const PreparedEntry &b)
+              {
+                return a.Entry.Hash != b.Entry.Hash ? a.Entry.Hash < b.Entry.Hash
+                                                    : a.Source->Name < b.Source->Name;
+              });
+
+    string names;
+    for (size_t i = 0; i < prepared.size(); i++)
+    {
+      auto &entry = prepared[i].Entry;
+      const string &name = prepared[i].Source->Name;
+      if (i > 0 && prepared[i - 1].Source->Name == name)
+      {
+        Logger::Error("KPAK: '{0}' is added more than once", name);
+        return false;
+      }
+
+      entry.NameOffset = static_cast<uint32>(names.size());
+      entry.NameLength = static_cast<uint16>(name.size());
+      names += name;
+    }
+
+    uint64 offset = HeaderSize + EntrySize * prepared.size() + names.size();
+    for (auto &item : prepared)
+    {
+      if (item.Entry.Compression == PackCompression::None)
+        offset = AlignOffset(offset);
+
+      item.Entry.Offset = offset;
+      offset += item.Entry.Size;
+    }
+
+    BufferedWriter writer(path);
+    if (!writer.IsOpen())
+    {
+      Logger::Error("KPAK: Unable to open '{0}' for writing", path);
+      return false;
+    }
+
+    writer.WriteBytes(Magic);
+    writer.Write(Version);
+    writer.Write(uint16 {0});
+    writer.Write(static_cast<uint32>(prepared.size()));
+    writer.Write(static_cast<uint32>(names.size()));
+
+    for (const auto &item : prepared)
+    {
+      writer.Write(item.Entry.Hash);
+      writer.Write(item.Entry.Offset);
+      writer.Write(item.Entry.Size);
+      writer.Write(item.Entry.OriginalSize);
+      writer.Write(item.Entry.NameOffset);
+      writer.Write(item.Entry.NameLength);
+      writer.Write(static_cast<uint8>(item.Entry.Compression));
+      writer.Write(uint8 {0});
+    }
+
+    writer.WriteText(names);
+
+    static constexpr std::array<byte, EntryAlignment> Zeros {};
+    for (const auto &item : prepared)
+    {
+      const auto padding = static_cast<size_t>(item.Entry.Offset - writer.GetPosition());
+      writer.WriteBytes(std::span(Zeros).first(padding));
+
+      if (item.Entry.Compression == PackCompression::None)
+        writer.WriteBytes(item.File.GetSpan());
+      else
+        writer.WriteBytes(item.Compressed);
+    }
+
+    if (!writer.Flush() || writer.HasFailed())
+    {
+      Logger::Error("KPAK: Failed to write '{0}'", path);
+      return false;
+    }
+
+    return true;
+  }
+}
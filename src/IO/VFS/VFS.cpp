@@ -0,0 +1,175 @@
+#include "IO/VFS/VFS.hpp"
+#include "Debug/Macros.hpp"
+#include "IO/IO.hpp"
+#include "IO/Logger.hpp"
+#include "IO/VFS/PackFile.hpp"
+
+#include <algorithm>
+#include <format>
+#include <mutex>
+
+namespace
+{
+  using namespace Krys;
+  using namespace Krys::IO;
+
+  struct MountPoint
+  {
+    /// @brief The directory or pack, as it was mounted.
+    string Path;
+
+    /// @brief The mount point with a trailing '/', or empty for the root.
+    string Prefix;
+
+    /// @brief The pack, or nullptr if this is a directory.
+    Unique<PackFile> Pack;
+  };
+
+  struct Registry
+  {
+    std::mutex Mutex;
+
+    /// @brief In the order they were mounted. Lookups take a copy, so mounts can change while files are
+    /// being opened, and a mount is destroyed once nothing is looking through it.
+    List<Ref<const MountPoint>> Mounts;
+  };
+
+  NO_DISCARD static Registry &GetRegistry() noexcept
+  {
+    static Registry registry;
+    return registry;
+  }
+
+  NO_DISCARD static List<Ref<const MountPoint>> GetMounts() noexcept
+  {
+    auto &registry = GetRegistry();
+    std::lock_guard lock(registry.Mutex);
+    return registry.Mounts;
+  }
+
+  /// @brief Where a file was found. `Owner` keeps the mount alive while the file is opened.
+  struct Location
+  {
+    Ref<const MountPoint> Owner;
+    const PackEntry *Entry {nullptr};
+    string DiskPath;
+    bool Found {false};
+  };
+
+  NO_DISCARD static Location Locate(const stringview &path) noexcept
+  {
+    const string name = VFS::NormalisePath(path);
+    const auto mounts = GetMounts();
+    for (auto it = mounts.rbegin(); it != mounts.rend(); ++it)
+    {
+      const auto &mount = *it;
+      if (!name.starts_with(mount->Prefix))
+        continue;
+
+      const stringview relative = stringview(name).substr(mount->Prefix.size());
+      if (mount->Pack)
+      {
+        if (const auto *entry = mount->Pack->Find(relative))
+          return {mount, entry, {}, true};
+      }
+      else if (string diskPath = std::format("{0}/{1}", mount->Path, relative); PathExists(diskPath))
+        return {mount, nullptr, std::move(diskPath), true};
+    }
+
+    if (PathExists(path))
+      return {nullptr, nullptr, string(path), true};
+
+    return {};
+  }
+}
+
+namespace Krys::IO
+{
+  bool VFS::Mount(const stringview &path, const stringview &mountPoint) noexcept
+  {
+    KRYS_SCOPED_PROFILER("VFS::Mount");
+
+    auto mount = CreateRef<MountPoint>();
+    mount->Path = path;
+    mount->Prefix = NormalisePath(mountPoint);
+    if (!mount->Prefix.empty())
+      mount->Prefix += '/';
+
+    if (!PathExists(path))
+    {
+      Logger::Error("VFS: '{0}' does not exist", path);
+      return false;
+    }
+
+    if (!IsDirectory(path))
+    {
+      mount->Pack = CreateUnique<PackFile>(path);
+      if (!mount->Pack->IsOpen())
+        return false;
+    }
+
+    auto &registry = GetRegistry();
+    std::lock_guard lock(registry.Mutex);
+    registry.Mounts.push_back(std::move(mount));
+    return true;
+  }
+
+  bool VFS::Unmount(const stringview &path) noexcept
+  {
+    auto &registry = GetRegistry();
+    std::lock_guard lock(registry.Mutex);
+    return std::erase_if(registry.Mounts, [&](const auto &mount) { return mount->Path == path; }) > 0;
+  }
+
+  void VFS::UnmountAll() noexcept
+  {
+    auto &registry = GetRegistry();
+    std::lock_guard lock(registry.Mutex);
+    registry.Mounts.clear();
+  }
+
+  VirtualFile VFS::Open(const stringview &path) noexcept
+  {
+    KRYS_SCOPED_PROFILER("VFS::Open");
+
+    const auto location = Locate(path);
+    if (!location.Found)
+      return {};
+
+    if (location.Entry)
+      return location.Owner->Pack->Read(*location.Entry);
+
+    return VirtualFile(MappedFile(location.DiskPath));
+  }
+
+  bool VFS::Exists(const stringview &path) noexcept
+  {
+    return Locate(path).Found;
+  }
+
+  string VFS::NormalisePath(const stringview &path) noexcept
+  {
+    string result;
+    result.reserve(path.size());
+
+    size_t begin = 0;
+    while (begin <= path.size())
+    {
+      size_t end = path.find_first_of("/\\", begin);
+      if (end == stringview::npos)
+        end = path.size();
+
+      const stringview segment = path.substr(begin, end - begin);
+      if (!segment.empty() && segment != ".")
+      {
+        if (!result.empty())
+          result += '/';
+        result += segment;
+      }
+
+      begin = end + 1;
+    }
+
+    return result;
+  }
+}
@@ -0,0 +1,121 @@
+#include "IO/Writers/BufferedWriter.hpp"
+#include "IO/Logger.hpp"
+
+namespace Krys::IO
+{
+#pragma region Targets
+
+  StreamWriteTarget::StreamWriteTarget(const stringview &path) noexcept
+      : _stream(string(path), std::ios::out | std::ios::binary | std::ios::trunc)
+  {
+    if (!_stream.is_open())
+      Logger::Error("IO: Unable to open '{0}' for writing", path);
+  }
+
+  bool StreamWriteTarget::IsOpen() const noexcept
+  {
+    return _stream.is_open();
+  }
+
+  bool StreamWriteTarget::Write(const byte *data, size_t size) noexcept
+  {
+    _stream.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(size));
+    return !_stream.fail();
+  }
+
+  MemoryWriteTarget::MemoryWriteTarget(List<byte> &buffer) noexcept : _buffer(buffer)
+  {
+  }
+
+  bool MemoryWriteTarget::IsOpen() const noexcept
+  {
+    return true;
+  }
+
+  bool MemoryWriteTarget::Write(const byte *data, size_t size) noexcept
+  {
+    _buffer.insert(_buffer.end(), data, data + size);
+    return true;
+  }
+
+#pragma endregion Targets
+
+#pragma region BufferedWriter
+
+  BufferedWriter::BufferedWriter(const stringview &path) noexcept
+      : BufferedWriter(CreateUnique<StreamWriteTarget>(path))
+  {
+  }
+
+  BufferedWriter::BufferedWriter(Unique<WriteTarget> target, size_t blockSize) noexcept
+      : _target(std::move(target)), _block(std::max<size_t>(blockSize, 64))
+  {
+  }
+
+  BufferedWriter::BufferedWriter(BufferedWriter &&other) noexcept
+      : _target(std::move(other._target)), _block(std::move(other._block)),
+        _used(std::exchange(other._used, 0)), _flushed(std::exchange(other._flushed, 0)),
+        _failed(std::exchange(other._failed, false))
+  {
+  }
+
+  BufferedWriter &BufferedWriter::operator=(BufferedWriter &&other) noexcept
+  {
+    if (this != &other)
+    {
+      Flush();
+      _target = std::move(other._target);
+      _block = std::move(other._block);
+      _used = std::exchange(other._used, 0);
+      _flushed = std::exchange(other._flushed, 0);
+      _failed = std::exchange(other._failed, false);
+    }
+    return *this;
+  }
+
+  BufferedWriter::~BufferedWriter() noexcept
+  {
+    Flush();
+  }
+
+  bool BufferedWriter::IsOpen() const noexcept
+  {
+    return _target && _target->IsOpen();
+  }
+
+  void BufferedWriter::WriteBytes(std::span<const byte> bytes) noexcept
+  {
+    if (bytes.size() <= _block.size() - _used)
+    {
+      if (!bytes.empty())
+        std::memcpy(_block.data() + _used, bytes.data(), bytes.size());
+      _used += bytes.size();
+      return;
+    }
+
+    // Too big for what's left of the block, so send what we have and write large data directly.
+    Flush();
+    if (bytes.size() >= _block.size())
+    {
+      if (_target && !_target->Write(bytes.data(), bytes.size()))
+        _failed = true;
+      _flushed += bytes.size();
+      return;
+    }
+
+    std::memcpy(_block.data(), bytes.data(), bytes.size());
+    _used = bytes.size();
+  }
+
+  bool BufferedWriter::Flush() noexcept
+  {
+    if (_used > 0 && _target && !_target->Write(_block.data(), _used))
+      _failed = true;
+
+    _flushed += _used;
+    _used = 0;
+    return !_failed;
+  }
+
+#pragma endregion BufferedWriter
+}
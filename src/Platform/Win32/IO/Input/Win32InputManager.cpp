@@ -17,56 +17,60 @@ namespace Krys::Platform
   {
     static Set<WPARAM> pressed {};
 
+    // Another device has the input to itself (e.g. a replay), so leave these to Windows.
+    if (_exclusiveDevice)
+      return false;
+
     switch (message)
     {
       case WM_KEYDOWN:
-        _events.emplace(CreateUnique<KeyboardEvent>(
-          KeyCodeToEngineKey(wParam), pressed.contains(wParam) ? KeyState::Held : KeyState::Pressed));
+        _eventManager->Emplace<KeyboardEvent>(KeyCodeToEngineKey(wParam),
+                                              pressed.contains(wParam) ? KeyState::Held : KeyState::Pressed);
         pressed.emplace(wParam);
         break;
       case WM_KEYUP:
-        _events.emplace(CreateUnique<KeyboardEvent>(KeyCodeToEngineKey(wParam), KeyState::Released));
+        _eventManager->Emplace<KeyboardEvent>(KeyCodeToEngineKey(wParam), KeyState::Released);
         pressed.erase(wParam);
         break;
 
       case WM_LBUTTONDOWN:
-        _events.emplace(CreateUnique<MouseButtonEvent>(MouseButton::LEFT, MouseButtonState::Pressed));
+        _eventManager->Emplace<MouseButtonEvent>(MouseButton::LEFT, MouseButtonState::Pressed);
         break;
       case WM_LBUTTONUP:
-        _events.emplace(CreateUnique<MouseButtonEvent>(MouseButton::LEFT, MouseButtonState::Released));
+        _eventManager->Emplace<MouseButtonEvent>(MouseButton::LEFT, MouseButtonState::Released);
         break;
 
       case WM_RBUTTONDOWN:
-        _events.emplace(CreateUnique<MouseButtonEvent>(MouseButton::RIGHT, MouseButtonState::Pressed));
+        _eventManager->Emplace<MouseButtonEvent>(MouseButton::RIGHT, MouseButtonState::Pressed);
         break;
       case WM_RBUTTONUP:
-        _events.emplace(CreateUnique<MouseButtonEvent>(MouseButton::RIGHT, MouseButtonState::Released));
+        _eventManager->Emplace<MouseButtonEvent>(MouseButton::RIGHT, MouseButtonState::Released);
         break;
 
       case WM_MBUTTONDOWN:
-        _events.emplace(CreateUnique<MouseButtonEvent>(MouseButton::MIDDLE, MouseButtonState::Pressed));
+        _eventManager->Emplace<MouseButtonEvent>(MouseButton::MIDDLE, MouseButtonState::Pressed);
         break;
       case WM_MBUTTONUP:
-        _events.emplace(CreateUnique<MouseButtonEvent>(MouseButton::MIDDLE, MouseButtonState::Released));
+        _eventManager->Emplace<MouseButtonEvent>(MouseButton::MIDDLE, MouseButtonState::Released);
         break;
 
       case WM_XBUTTONDOWN:
       {
         const auto button =
           GET_XBUTTON_WPARAM(wParam) & XBUTTON1 ? MouseButton::THUMB_1 : MouseButton::THUMB_2;
-        _events.emplace(CreateUnique<MouseButtonEvent>(button, MouseButtonState::Pressed));
+        _eventManager->Emplace<MouseButtonEvent>(button, MouseButtonState::Pressed);
         break;
       }
       case WM_XBUTTONUP:
       {
         const auto button =
           GET_XBUTTON_WPARAM(wParam) & XBUTTON1 ? MouseButton::THUMB_1 : MouseButton::THUMB_2;
-        _events.emplace(CreateUnique<MouseButtonEvent>(button, MouseButtonState::Released));
+        _eventManager->Emplace<MouseButtonEvent>(button, MouseButtonState::Released);
         break;
       }
       case WM_MOUSEWHEEL:
-        _events.emplace(
-          CreateUnique<ScrollWheelEvent>(static_cast<float>(GET_WHEEL_DELTA_WPARAM(wParam)) / WHEEL_DELTA));
+        _eventManager->Emplace<ScrollWheelEvent>(static_cast<float>(GET_WHEEL_DELTA_WPARAM(wParam)) /
+                                                 WHEEL_DELTA);
         break;
 
       case WM_INPUT:
@@ -97,12 +101,12 @@ namespace Krys::Platform
             clientY = static_cast<float>(point.y);
           }
 
-          _events.emplace(CreateUnique<MouseMoveEvent>(x, y, clientX, clientY));
+          _eventManager->Emplace<MouseMoveEvent>(x, y, clientX, clientY);
         }
         else if ((raw.data.mouse.usButtonFlags & RI_MOUSE_WHEEL) == RI_MOUSE_WHEEL)
         {
           const auto delta = static_cast<float>(static_cast<uint16>(raw.data.mouse.usButtonData));
-          _events.emplace(CreateUnique<ScrollWheelEvent>(delta));
+          _eventManager->Emplace<ScrollWheelEvent>(delta);
         }
         break;
       }
@@ -7,13 +7,12 @@
 
 namespace Krys
 {
-  std::mutex Logger::_mu;
-  std::ofstream Logger::_logFile("engine-log.txt");
+  static std::ofstream s_LogFile("engine-log.txt");
 
   void Logger::Output(const string &message) noexcept
   {
     ::OutputDebugStringA(message.c_str());
-    if (_logFile.is_open())
-      _logFile << message;
+    if (s_LogFile.is_open())
+      s_LogFile << message;
   }
-}
\ No newline at end of file
+}
@@ -0,0 +1,72 @@
+#include "IO/Readers/MappedFile.hpp"
+#include "IO/Logger.hpp"
+
+#ifndef WIN32_LEAN_AND_MEAN
+  #define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+
+namespace Krys::IO
+{
+  bool MappedFile::Open(const stringview &path) noexcept
+  {
+    Close();
+
+    const string pathString(path);
+    HANDLE file = ::CreateFileA(pathString.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+      Logger::Error("IO: Unable to open '{0}' for mapping", path);
+      return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(file, &size))
+    {
+      Logger::Error("IO: Unable to get the size of '{0}'", path);
+      ::CloseHandle(file);
+      return false;
+    }
+
+    // Empty files can't be mapped, but they're still valid files.
+    if (size.QuadPart == 0)
+    {
+      ::CloseHandle(file);
+      _isOpen = true;
+      return true;
+    }
+
+    // The view keeps the mapping and the file alive, so neither handle is needed once it exists.
+    HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(file);
+    if (mapping == nullptr)
+    {
+      Logger::Error("IO: Unable to map '{0}'", path);
+      return false;
+    }
+
+    void *view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    ::CloseHandle(mapping);
+    if (view == nullptr)
+    {
+      Logger::Error("IO: Unable to map a view of '{0}'", path);
+      return false;
+    }
+
+    _data = static_cast<const byte *>(view);
+    _size = static_cast<size_t>(size.QuadPart);
+    _isOpen = true;
+    return true;
+  }
+
+  void MappedFile::Close() noexcept
+  {
+    if (_data)
+      ::UnmapViewOfFile(_data);
+
+    _data = nullptr;
+    _size = 0;
+    _isOpen = false;
+  }
+}
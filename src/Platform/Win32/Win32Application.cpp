@@ -19,6 +19,9 @@ namespace Krys
     Platform::Initialize();
 
     auto ctx = CreateUnique<ApplicationContext>(argc, argv, settings);
+    if (!settings.AssetCacheDirectory.empty())
+      ctx->_assetCache = CreateUnique<IO::AssetCache>(settings.AssetCacheDirectory);
+
     ctx->_eventManager = CreateUnique<EventManager>();
     {
       using namespace Platform;
@@ -31,12 +34,13 @@ namespace Krys
       ctx->_lightManager = CreateUnique<Gfx::LightManager>();
       ctx->_graphicsContext = CreateUnique<OpenGLGraphicsContext>();
       ctx->_meshManager = CreateUnique<OpenGLMeshManager>(ctx->_graphicsContext.get());
-      ctx->_textureManager = CreateUnique<OpenGLTextureManager>();
+      ctx->_textureManager = CreateUnique<OpenGLTextureManager>(ctx->_assetCache.get());
       ctx->_sceneGraphManager = CreateUnique<Gfx::SceneGraphManager>();
       ctx->_materialManager =
         CreateUnique<Gfx::MaterialManager>(ctx->_textureManager.get(), ctx->_graphicsContext.get());
-      ctx->_modelManager = CreateUnique<Gfx::ModelManager>(
-        ctx->_materialManager.get(), ctx->_meshManager.get(), ctx->_textureManager.get());
+      ctx->_modelManager =
+        CreateUnique<Gfx::ModelManager>(ctx->_materialManager.get(), ctx->_meshManager.get(),
+                                        ctx->_textureManager.get(), ctx->_assetCache.get());
       ctx->_renderTargetManager =
         CreateUnique<Gfx::RenderTargetManager>(ctx->_windowManager.get(), ctx->_textureManager.get());
 
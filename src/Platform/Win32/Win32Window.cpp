@@ -82,7 +82,7 @@ namespace Krys::Platform
     LRESULT result = 0;
     switch (message)
     {
-      case WM_CLOSE:     _eventManager->Enqueue(CreateUnique<QuitEvent>()); break;
+      case WM_CLOSE:     _eventManager->Emplace<QuitEvent>(); break;
       case WM_SETFOCUS:
       case WM_KILLFOCUS:
       case WM_CHAR:
@@ -0,0 +1,624 @@
+#include "Utils/Compression.hpp"
+#include "IO/Readers/BitReader.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace
+{
+  using namespace Krys;
+
+  constexpr size_t MinMatch = 4;
+
+  /// @brief The last match has to start this far from the end of the input, and the last bytes are always
+  /// literals, so decoders can copy in whole words without checking every byte.
+  constexpr size_t MatchFindLimit = 12;
+  constexpr size_t LastLiterals = 5;
+
+  constexpr size_t MaxOffset = 65'535;
+
+  /// @brief Size of the fixed copies the decompressor uses where it has room to overrun.
+  constexpr size_t WildCopy = 16;
+
+  constexpr uint32 HashBits = 16;
+
+  /// @brief How quickly the search skips ahead through data that doesn't match, e.g. already compressed.
+  constexpr uint32 SkipStrength = 6;
+
+  NO_DISCARD static uint32 Read32(const byte *data) noexcept
+  {
+    uint32 value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+  }
+
+  NO_DISCARD static uint32 Hash(uint32 sequence) noexcept
+  {
+    return (sequence * 2'654'435'761u) >> (32 - HashBits);
+  }
+
+  /// @brief Write the part of a length that doesn't fit in the token.
+  static void WriteLength(List<byte> &output, size_t length) noexcept
+  {
+    for (; length >= 255; length -= 255)
+      output.push_back(byte {255});
+    output.push_back(static_cast<byte>(length));
+  }
+
+  static void WriteSequence(List<byte> &output, const byte *literals, size_t literalLength, size_t offset,
+                            size_t matchLength) noexcept
+  {
+    const size_t matchCode = matchLength - MinMatch;
+    const size_t token = (std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(matchCode, 15);
+    output.push_back(static_cast<byte>(token));
+    if (literalLength >= 15)
+      WriteLength(output, literalLength - 15);
+
+    output.insert(output.end(), literals, literals + literalLength);
+    output.push_back(static_cast<byte>(offset & 0xFF));
+    output.push_back(static_cast<byte>(offset >> 8));
+    if (matchCode >= 15)
+      WriteLength(output, matchCode - 15);
+  }
+
+  static void WriteLastLiterals(List<byte> &output, const byte *literals, size_t literalLength) noexcept
+  {
+    output.push_back(static_cast<byte>(std::min<size_t>(literalLength, 15) << 4));
+    if (literalLength >= 15)
+      WriteLength(output, literalLength - 15);
+
+    output.insert(output.end(), literals, literals + literalLength);
+  }
+
+  /// @brief Read the part of a length that didn't fit in the token.
+  NO_DISCARD static bool ReadLength(const byte *&input, const byte *end, size_t &length) noexcept
+  {
+    uint8 value;
+    do
+    {
+      if (input == end)
+        return false;
+
+      value = static_cast<uint8>(*input++);
+      length += value;
+    } while (value == 255);
+
+    return true;
+  }
+
+  using DeflateReader = IO::BitReader<IO::BitOrder::LSBFirst>;
+
+  constexpr uint32 MaxCodeLength = 15;
+
+  constexpr uint32 EndOfBlock = 256;
+  constexpr uint32 LiteralLengthCodes = 288;
+  constexpr uint32 DistanceCodes = 32;
+  constexpr uint32 CodeLengthCodes = 19;
+
+  /// @brief Bits resolved by the first lookup. Longer codes take a second lookup in a subtable, which the
+  /// root entry for their prefix points to. Almost every code in real data fits in the root.
+  constexpr uint32 LiteralLengthRootBits = 10;
+  constexpr uint32 DistanceRootBits = 8;
+  constexpr uint32 CodeLengthRootBits = 7;
+
+  constexpr std::array<uint16, 29> LengthBase {3,  4,  5,  6,  7,  8,  9,   10,  11,  13,
+                                               15, 17, 19, 23, 27, 31, 35,  43,  51,  59,
+                                               67, 83, 99, 115, 131, 163, 195, 227, 258};
+  constexpr std::array<uint8, 29> LengthExtra {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                               2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+  constexpr std::array<uint16, 30> DistanceBase {1,     2,     3,     4,     5,     7,     9,     13,
+                                                 17,    25,    33,    49,    65,    97,    129,   193,
+                                                 257,   385,   513,   769,   1025,  1537,  2049,  3073,
+                                                 4097,  6145,  8193,  12289, 16385, 24577};
+  constexpr std::array<uint8, 30> DistanceExtra {0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+                                                 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+  /// @brief The order code length code lengths are stored in, most commonly used first.
+  constexpr std::array<uint8, CodeLengthCodes> CodeLengthOrder {16, 17, 18, 0, 8,  7, 9,  6, 10, 5,
+                                                                11, 4,  12, 3, 13, 2, 14, 1, 15};
+
+  /// @brief A lookup table entry: the symbol (or subtable offset) in the top 16 bits, the kind in bits 8-9
+  /// and the code length (or subtable index bits) in the bottom 8. Zero is an invalid entry, which is where
+  /// codes that an incomplete code set doesn't use end up.
+  enum HuffmanEntryKind : uint32
+  {
+    Invalid = 0,
+    Symbol = 1,
+    Subtable = 2
+  };
+
+  NO_DISCARD constexpr uint32 MakeHuffmanEntry(HuffmanEntryKind kind, uint32 value, uint32 bits) noexcept
+  {
+    return (value << 16) | (static_cast<uint32>(kind) << 8) | bits;
+  }
+
+  NO_DISCARD static uint32 ReverseBits(uint32 code, uint32 length) noexcept
+  {
+    uint32 result = 0;
+    for (uint32 i = 0; i < length; i++, code >>= 1)
+      result = (result << 1) | (code & 1);
+    return result;
+  }
+
+  /// @brief A canonical Huffman code, decoded with one table lookup for codes of up to `RootBits` bits.
+  struct HuffmanTable
+  {
+    List<uint32> Entries;
+    uint32 RootBits;
+
+    /// @brief Build the table from the code length of each symbol, where 0 means the symbol isn't used.
+    /// @returns False if the lengths describe more codes than there is room for.
+    NO_DISCARD bool Build(std::span<const uint8> lengths, uint32 rootBits) noexcept
+    {
+      RootBits = rootBits;
+
+      std::array<uint32, MaxCodeLength + 1> counts {};
+      for (const uint8 length : lengths)
+        counts[length]++;
+      counts[0] = 0;
+
+      int32 available = 1;
+      for (uint32 length = 1; length <= MaxCodeLength; length++)
+      {
+        available = (available << 1) - static_cast<int32>(counts[length]);
+        if (available < 0)
+          return false;
+      }
+
+      std::array<uint32, MaxCodeLength + 1> nextCode {};
+      for (uint32 length = 1, code = 0; length <= MaxCodeLength; length++)
+      {
+        code = (code + counts[length - 1]) << 1;
+        nextCode[length] = code;
+      }
+
+      // DEFLATE stores codes starting from their first bit, which the bit reader returns as the lowest, so
+      // tables are indexed by the reversed code.
+      List<uint32> codes(lengths.size());
+      std::array<uint8, 1u << LiteralLengthRootBits> subtableBits {};
+      const uint32 rootMask = (1u << rootBits) - 1;
+      for (size_t symbol = 0; symbol < lengths.size(); symbol++)
+      {
+        const uint32 length = lengths[symbol];
+        if (length == 0)
+          continue;
+
+        codes[symbol] = ReverseBits(nextCode[length]++, length);
+        if (length > rootBits)
+        {
+          auto &bits = subtableBits[codes[symbol] & rootMask];
+          bits = std::max<uint8>(bits, static_cast<uint8>(length - rootBits));
+        }
+      }
+
+      Entries.assign(size_t {1} << rootBits, 0);
+      for (uint32 prefix = 0; prefix <= rootMask; prefix++)
+      {
+        if (subtableBits[prefix] == 0)
+          continue;
+
+        const uint32 offset = static_cast<uint32>(Entries.size());
+        Entries[prefix] = MakeHuffmanEntry(Subtable, offset, subtableBits[prefix]);
+        Entries.resize(Entries.size() + (size_t {1} << subtableBits[prefix]), 0);
+      }
+
+      for (size_t symbol = 0; symbol < lengths.size(); symbol++)
+      {
+        const uint32 length = lengths[symbol];
+        if (length == 0)
+          continue;
+
+        // Every index whose low bits are the code gets the entry, whatever the bits after it are.
+        const uint32 entry = MakeHuffmanEntry(Symbol, static_cast<uint32>(symbol), length);
+        const uint32 code = codes[symbol];
+        if (length <= rootBits)
+        {
+          for (uint32 index = code; index <= rootMask; index += 1u << length)
+            Entries[index] = entry;
+        }
+        else
+        {
+          const uint32 pointer = Entries[code & rootMask];
+          const uint32 offset = pointer >> 16, bits = pointer & 0xFF;
+          for (uint32 index = code >> rootBits; index < (1u << bits); index += 1u << (length - rootBits))
+            Entries[offset + index] = entry;
+        }
+      }
+
+      return true;
+    }
+
+    /// @brief Read the next symbol from `reader`.
+    /// @returns False if the bits aren't a code in the table.
+    NO_DISCARD bool Decode(DeflateReader &reader, uint32 &symbol) const noexcept
+    {
+      const uint32 bits = static_cast<uint32>(reader.PeekBits(MaxCodeLength));
+      uint32 entry = Entries[bits & ((1u << RootBits) - 1)];
+      if (((entry >> 8) & 3) == Subtable)
+        entry = Entries[(entry >> 16) + ((bits >> RootBits) & ((1u << (entry & 0xFF)) - 1))];
+
+      if (((entry >> 8) & 3) != Symbol)
+        return false;
+
+      reader.ConsumeBits(entry & 0xFF);
+      symbol = entry >> 16;
+      return true;
+    }
+  };
+
+  /// @brief The codes fixed blocks use, which are the same for every stream, so they're built once.
+  struct FixedHuffmanTables
+  {
+    HuffmanTable LiteralLength;
+    HuffmanTable Distance;
+
+    FixedHuffmanTables() noexcept
+    {
+      std::array<uint8, LiteralLengthCodes> lengths {};
+      std::fill(lengths.begin(), lengths.begin() + 144, uint8 {8});
+      std::fill(lengths.begin() + 144, lengths.begin() + 256, uint8 {9});
+      std::fill(lengths.begin() + 256, lengths.begin() + 280, uint8 {7});
+      std::fill(lengths.begin() + 280, lengths.end(), uint8 {8});
+      (void)LiteralLength.Build(lengths, LiteralLengthRootBits);
+
+      std::array<uint8, DistanceCodes> distances;
+      distances.fill(5);
+      (void)Distance.Build(distances, DistanceRootBits);
+    }
+  };
+
+  NO_DISCARD static const FixedHuffmanTables &GetFixedHuffmanTables() noexcept
+  {
+    static const FixedHuffmanTables tables;
+    return tables;
+  }
+
+  NO_DISCARD static Expected<void> ReadDynamicTables(DeflateReader &reader, HuffmanTable &literalLength,
+                                                     HuffmanTable &distance) noexcept
+  {
+    const uint32 literalLengthCount = static_cast<uint32>(reader.ReadBits(5)) + 257;
+    const uint32 distanceCount = static_cast<uint32>(reader.ReadBits(5)) + 1;
+    const uint32 codeLengthCount = static_cast<uint32>(reader.ReadBits(4)) + 4;
+    if (literalLengthCount > 286 || distanceCount > 30)
+      return Unexpected("Too many codes in a dynamic block");
+
+    std::array<uint8, CodeLengthCodes> codeLengthLengths {};
+    for (uint32 i = 0; i < codeLengthCount; i++)
+      codeLengthLengths[CodeLengthOrder[i]] = static_cast<uint8>(reader.ReadBits(3));
+
+    HuffmanTable codeLengths;
+    if (!codeLengths.Build(codeLengthLengths, CodeLengthRootBits))
+      return Unexpected("Invalid code length code");
+
+    // Both sets of lengths are stored as one sequence, and repeats can run from one into the other.
+    std::array<uint8, LiteralLengthCodes + DistanceCodes> lengths {};
+    const uint32 total = literalLengthCount + distanceCount;
+    for (uint32 count = 0; count < total;)
+    {
+      uint32 symbol;
+      if (!codeLengths.Decode(reader, symbol))
+        return Unexpected("Invalid code length");
+
+      if (symbol < 16)
+      {
+        lengths[count++] = static_cast<uint8>(symbol);
+        continue;
+      }
+
+      uint8 value = 0;
+      uint32 repeat;
+      if (symbol == 16)
+      {
+        if (count == 0)
+          return Unexpected("Code length repeat without a previous length");
+        value = lengths[count - 1];
+        repeat = 3 + static_cast<uint32>(reader.ReadBits(2));
+      }
+      else if (symbol == 17)
+        repeat = 3 + static_cast<uint32>(reader.ReadBits(3));
+      else
+        repeat = 11 + static_cast<uint32>(reader.ReadBits(7));
+
+      if (repeat > total - count)
+        return Unexpected("Code length repeat is too long");
+
+      std::fill_n(lengths.begin() + count, repeat, value);
+      count += repeat;
+    }
+
+    if (lengths[EndOfBlock] == 0)
+      return Unexpected("Dynamic block has no end of block code");
+
+    if (!literalLength.Build(std::span(lengths).first(literalLengthCount), LiteralLengthRootBits)
+        || !distance.Build(std::span(lengths).subspan(literalLengthCount, distanceCount), DistanceRootBits))
+      return Unexpected("Invalid dynamic block code");
+
+    return {};
+  }
+
+  NO_DISCARD static Expected<void> InflateStored(DeflateReader &reader, byte *&out, byte *outEnd) noexcept
+  {
+    reader.AlignToByte();
+    const auto length = static_cast<uint16>(reader.ReadBits(16));
+    const auto complement = static_cast<uint16>(reader.ReadBits(16));
+    if (length != static_cast<uint16>(~complement))
+      return Unexpected("Stored block length is corrupt");
+
+    if (length > static_cast<size_t>(outEnd - out))
+      return Unexpected("Stream is larger than expected");
+    if (length * size_t {8} > reader.GetRemainingBits())
+      return Unexpected("Stored block is cropped");
+
+    reader.ReadBytes(out, length);
+    out += length;
+    return {};
+  }
+
+  NO_DISCARD static Expected<void> InflateCompressed(DeflateReader &reader, const HuffmanTable &literalLength,
+                                                     const HuffmanTable &distance, byte *begin, byte *&out,
+                                                     byte *outEnd) noexcept
+  {
+    while (true)
+    {
+      uint32 symbol;
+      if (!literalLength.Decode(reader, symbol))
+        return Unexpected("Invalid literal/length code");
+
+      if (symbol < EndOfBlock)
+      {
+        if (out == outEnd)
+          return Unexpected("Stream is larger than expected");
+        *out++ = static_cast<byte>(symbol);
+        continue;
+      }
+
+      if (symbol == EndOfBlock)
+        return {};
+
+      symbol -= EndOfBlock + 1;
+      if (symbol >= LengthBase.size())
+        return Unexpected("Invalid length code");
+
+      const size_t length = LengthBase[symbol] + static_cast<size_t>(reader.ReadBits(LengthExtra[symbol]));
+
+      uint32 distanceSymbol;
+      if (!distance.Decode(reader, distanceSymbol) || distanceSymbol >= DistanceBase.size())
+        return Unexpected("Invalid distance code");
+
+      const size_t offset =
+        DistanceBase[distanceSymbol] + static_cast<size_t>(reader.ReadBits(DistanceExtra[distanceSymbol]));
+      if (offset > static_cast<size_t>(out - begin))
+        return Unexpected("Distance is too far back");
+      if (length > static_cast<size_t>(outEnd - out))
+        return Unexpected("Stream is larger than expected");
+
+      // Copied in whole words when there's room past the match. Short offsets, which image data is full of,
+      // repeat a pattern shorter than a word: once a few repeats of it have been written byte by byte, each
+      // word can be copied from a whole number of repeats back, far enough not to overlap itself.
+      const byte *match = out - offset;
+      if (static_cast<size_t>(outEnd - out) >= length + sizeof(uint64))
+      {
+        size_t copied = 0, step = offset;
+        if (offset < sizeof(uint64))
+        {
+          step = offset * ((sizeof(uint64) + offset - 1) / offset);
+          for (; copied < std::min(step, length); copied++)
+            out[copied] = match[copied];
+        }
+
+        for (; copied < length; copied += sizeof(uint64))
+          std::memcpy(out + copied, out + copied - step, sizeof(uint64));
+      }
+      else
+      {
+        for (size_t copied = 0; copied < length; copied++)
+          out[copied] = match[copied];
+      }
+
+      out += length;
+    }
+  }
+}
+
+namespace Krys
+{
+  List<byte> CompressLZ4(std::span<const byte> bytes) noexcept
+  {
+    List<byte> output;
+    output.reserve(bytes.size() / 2 + 16);
+
+    const byte *begin = bytes.data();
+    const byte *end = begin + bytes.size();
+    const byte *anchor = begin;
+    if (bytes.size() < MatchFindLimit + 1)
+    {
+      WriteLastLiterals(output, anchor, bytes.size());
+      return output;
+    }
+
+    // Positions of the last sequence seen with each hash. Zero means none yet, as a match can't be at the
+    // start of the input anyway (there would be nothing before it to copy from).
+    List<uint32> table(size_t {1} << HashBits, 0);
+
+    const byte *matchLimit = end - MatchFindLimit;
+    const byte *current = begin + 1;
+    while (current < matchLimit)
+    {
+      // Find a match, looking further apart the longer it goes without one.
+      const byte *match = nullptr;
+      uint32 attempts = 1 << SkipStrength;
+      while (current < matchLimit)
+      {
+        const uint32 sequence = Read32(current);
+        uint32 &slot = table[Hash(sequence)];
+        const byte *candidate = begin + slot;
+        slot = static_cast<uint32>(current - begin);
+
+        if (candidate != begin && static_cast<size_t>(current - candidate) <= MaxOffset
+            && Read32(candidate) == sequence)
+        {
+          match = candidate;
+          break;
+        }
+
+        current += attempts++ >> SkipStrength;
+      }
+
+      if (!match)
+        break;
+
+      // Extend the match backwards over literals that also match, then forwards.
+      while (current > anchor && match > begin && current[-1] == match[-1])
+      {
+        current--;
+        match--;
+      }
+
+      const byte *matchEnd = current + MinMatch;
+      const byte *extendLimit = end - LastLiterals;
+      while (matchEnd < extendLimit && *matchEnd == match[matchEnd - current])
+        matchEnd++;
+
+      WriteSequence(output, anchor, static_cast<size_t>(current - anchor),
+                    static_cast<size_t>(current - match), static_cast<size_t>(matchEnd - current));
+
+      // Index a position inside the match so the next search has something nearby to find.
+      table[Hash(Read32(matchEnd - 2))] = static_cast<uint32>(matchEnd - 2 - begin);
+
+      current = matchEnd;
+      anchor = current;
+    }
+
+    WriteLastLiterals(output, anchor, static_cast<size_t>(end - anchor));
+    return output;
+  }
+
+  bool DecompressLZ4(std::span<const byte> block, std::span<byte> output) noexcept
+  {
+    const byte *input = block.data();
+    const byte *inputEnd = input + block.size();
+    byte *out = output.data();
+    byte *outEnd = out + output.size();
+
+    while (input < inputEnd)
+    {
+      const uint8 token = static_cast<uint8>(*input++);
+
+      size_t literalLength = token >> 4;
+      if (literalLength == 15 && !ReadLength(input, inputEnd, literalLength))
+        return false;
+
+      if (literalLength > static_cast<size_t>(inputEnd - input)
+          || literalLength > static_cast<size_t>(outEnd - out))
+        return false;
+
+      // Most runs are short, so they're copied as one fixed size block when there's room past them, which
+      // is much cheaper than a copy of variable size. Whatever is copied past the run is overwritten later.
+      if (literalLength <= WildCopy && static_cast<size_t>(inputEnd - input) >= WildCopy
+          && static_cast<size_t>(outEnd - out) >= WildCopy)
+        std::memcpy(out, input, WildCopy);
+      else
+        std::memcpy(out, input, literalLength);
+
+      input += literalLength;
+      out += literalLength;
+
+      // The last sequence is only literals.
+      if (input == inputEnd)
+        break;
+
+      if (inputEnd - input < 2)
+        return false;
+
+      const size_t offset = static_cast<size_t>(input[0]) | (static_cast<size_t>(input[1]) << 8);
+      input += 2;
+      if (offset == 0 || offset > static_cast<size_t>(out - output.data()))
+        return false;
+
+      size_t matchLength = (token & 15u);
+      if (matchLength == 15 && !ReadLength(input, inputEnd, matchLength))
+        return false;
+
+      matchLength += MinMatch;
+      if (matchLength > static_cast<size_t>(outEnd - out))
+        return false;
+
+      // A match can overlap what it produces, e.g. an offset of 1 repeats one byte, so it's copied in steps
+      // no longer than the offset, each of which reads only what's already been written.
+      const byte *match = out - offset;
+      if (offset >= WildCopy && static_cast<size_t>(outEnd - out) >= matchLength + WildCopy)
+      {
+        for (size_t copied = 0; copied < matchLength; copied += WildCopy)
+          std::memcpy(out + copied, match + copied, WildCopy);
+      }
+      else
+      {
+        for (size_t copied = 0; copied < matchLength; copied += offset)
+          std::memcpy(out + copied, match + copied, std::min(offset, matchLength - copied));
+      }
+
+      out += matchLength;
+    }
+
+    return out == outEnd;
+  }
+
+  Expected<size_t> InflateZlib(std::span<const byte> stream, std::span<byte> output) noexcept
+  {
+    if (stream.size() < 2)
+      return Unexpected("Stream is too small");
+
+    // The header is a compression method and window size, then flags whose check bits make the two bytes
+    // a multiple of 31.
+    const uint32 method = static_cast<uint32>(stream[0]), flags = static_cast<uint32>(stream[1]);
+    if ((method & 15) != 8 || (method >> 4) > 7)
+      return Unexpected("Not a DEFLATE stream");
+    if (((method << 8) | flags) % 31 != 0)
+      return Unexpected("Corrupt zlib header");
+    if (flags & 0x20)
+      return Unexpected("Preset dictionaries aren't supported");
+
+    DeflateReader reader(stream.subspan(2));
+    byte *begin = output.data();
+    byte *out = begin;
+    byte *outEnd = begin + output.size();
+
+    HuffmanTable literalLength, distance;
+    bool final = false;
+    while (!final)
+    {
+      final = reader.ReadBit();
+      const auto type = static_cast<uint32>(reader.ReadBits(2));
+
+      Expected<void> result;
+      switch (type)
+      {
+        case 0: result = InflateStored(reader, out, outEnd); break;
+        case 1:
+        {
+          const auto &fixed = GetFixedHuffmanTables();
+          result = InflateCompressed(reader, fixed.LiteralLength, fixed.Distance, begin, out, outEnd);
+          break;
+        }
+        case 2:
+          result = ReadDynamicTables(reader, literalLength, distance);
+          if (result)
+            result = InflateCompressed(reader, literalLength, distance, begin, out, outEnd);
+          break;
+        default: return Unexpected("Invalid block type");
+      }
+
+      if (!result)
+        return Unexpected(result.error());
+
+      // Reading past the end only produces zeros, so a cropped stream is caught here rather than in the
+      // middle of a block.
+      if (reader.HasOverrun())
+        return Unexpected("Stream is cropped");
+    }
+
+    // The Adler-32 checksum that follows isn't checked: corrupt data still can't write outside `output`.
+    return static_cast<size_t>(out - begin);
+  }
+}
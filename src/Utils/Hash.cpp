@@ -0,0 +1,93 @@
+#include "Utils/Hash.hpp"
+
+#include <bit>
+#include <cstring>
+
+namespace
+{
+  using namespace Krys;
+
+  constexpr uint64 Prime1 = 0x9E37'79B1'85EB'CA87;
+  constexpr uint64 Prime2 = 0xC2B2'AE3D'27D4'EB4F;
+  constexpr uint64 Prime3 = 0x1656'67B1'9E37'79F9;
+  constexpr uint64 Prime4 = 0x85EB'CA77'C2B2'AE63;
+  constexpr uint64 Prime5 = 0x27D4'EB2F'1656'67C5;
+
+  NO_DISCARD static uint64 Read64(const byte *data) noexcept
+  {
+    uint64 value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+  }
+
+  NO_DISCARD static uint32 Read32(const byte *data) noexcept
+  {
+    uint32 value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+  }
+
+  NO_DISCARD static uint64 Round(uint64 accumulator, uint64 input) noexcept
+  {
+    accumulator += input * Prime2;
+    return std::rotl(accumulator, 31) * Prime1;
+  }
+
+  NO_DISCARD static uint64 MergeRound(uint64 hash, uint64 accumulator) noexcept
+  {
+    hash ^= Round(0, accumulator);
+    return hash * Prime1 + Prime4;
+  }
+}
+
+namespace Krys
+{
+  uint64 HashBytes(std::span<const byte> bytes, uint64 seed) noexcept
+  {
+    // Words are read as little-endian, which every platform we target is.
+    const byte *data = bytes.data();
+    const byte *end = data + bytes.size();
+    uint64 hash;
+
+    if (bytes.size() >= 32)
+    {
+      // Four independent lanes, so the multiplies of consecutive words can overlap.
+      uint64 lanes[4] = {seed + Prime1 + Prime2, seed + Prime2, seed, seed - Prime1};
+      for (; end - data >= 32; data += 32)
+      {
+        lanes[0] = Round(lanes[0], Read64(data));
+        lanes[1] = Round(lanes[1], Read64(data + 8));
+        lanes[2] = Round(lanes[2], Read64(data + 16));
+        lanes[3] = Round(lanes[3], Read64(data + 24));
+      }
+
+      hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12)
+           + std::rotl(lanes[3], 18);
+      for (uint64 lane : lanes)
+        hash = MergeRound(hash, lane);
+    }
+    else
+      hash = seed + Prime5;
+
+    hash += bytes.size();
+
+    for (; end - data >= 8; data += 8)
+      hash = std::rotl(hash ^ Round(0, Read64(data)), 27) * Prime1 + Prime4;
+
+    if (end - data >= 4)
+    {
+      hash = std::rotl(hash ^ (Read32(data) * Prime1), 23) * Prime2 + Prime3;
+      data += 4;
+    }
+
+    for (; data < end; data++)
+      hash = std::rotl(hash ^ (static_cast<uint64>(*data) * Prime5), 11) * Prime1;
+
+    hash ^= hash >> 33;
+    hash *= Prime2;
+    hash ^= hash >> 29;
+    hash *= Prime3;
+    hash ^= hash >> 32;
+    return hash;
+  }
+}
@@ -0,0 +1,62 @@
+#include "MTL/Histogram.hpp"
+#include "tests/__utils__/Expect.hpp"
+
+namespace Krys::Tests
+{
+  using namespace Krys::MTL;
+
+  template <uint32 Bits = 6>
+  constexpr Histogram<Bits> MakeHistogram(uint64 first, uint64 last, uint64 step = 1) noexcept
+  {
+    Histogram<Bits> histogram;
+    for (uint64 value = first; value <= last; value += step)
+      histogram.Add(value);
+    return histogram;
+  }
+
+  static void Test_Histogram_Empty()
+  {
+    constexpr Histogram<> histogram;
+    KRYS_EXPECT_EQUAL("Empty count", histogram.GetCount(), 0ull);
+    KRYS_EXPECT_EQUAL("Empty percentile", histogram.GetPercentile(50.0), 0ull);
+    KRYS_EXPECT_EQUAL("Empty mean", histogram.GetMean(), 0.0);
+  }
+
+  static void Test_Histogram_Exact()
+  {
+    // Values below 2^SubBucketBits are stored exactly.
+    constexpr auto histogram = MakeHistogram(1, 50);
+    KRYS_EXPECT_EQUAL("Exact count", histogram.GetCount(), 50ull);
+    KRYS_EXPECT_EQUAL("Exact min", histogram.GetMin(), 1ull);
+    KRYS_EXPECT_EQUAL("Exact max", histogram.GetMax(), 50ull);
+    KRYS_EXPECT_EQUAL("Exact p50", histogram.GetPercentile(50.0), 25ull);
+    KRYS_EXPECT_EQUAL("Exact p90", histogram.GetPercentile(90.0), 45ull);
+    KRYS_EXPECT_EQUAL("Exact p100", histogram.GetPercentile(100.0), 50ull);
+    KRYS_EXPECT_EQUAL("Exact mean", histogram.GetMean(), 25.5);
+  }
+
+  static void Test_Histogram_Bucketed()
+  {
+    // 1'000 .. 100'000 in steps of 1'000: p50 is 50'000, p95 is 95'000, p99 is 99'000.
+    constexpr auto histogram = MakeHistogram(1'000, 100'000, 1'000);
+    KRYS_EXPECT_NEAR("Bucketed p50", histogram.GetPercentile(50.0), 50'000ull, 50'000ull / 32);
+    KRYS_EXPECT_NEAR("Bucketed p95", histogram.GetPercentile(95.0), 95'000ull, 95'000ull / 32);
+    KRYS_EXPECT_NEAR("Bucketed p99", histogram.GetPercentile(99.0), 99'000ull, 99'000ull / 32);
+    KRYS_EXPECT_EQUAL("Bucketed max", histogram.GetMax(), 100'000ull);
+    KRYS_EXPECT_EQUAL("Bucketed min", histogram.GetPercentile(0.0), 1'000ull);
+  }
+
+  static void Test_Histogram_Reset()
+  {
+    constexpr auto histogram = []()
+    {
+      auto h = MakeHistogram(1, 10);
+      h.Reset();
+      h.Add(7, 3);
+      return h;
+    }();
+    KRYS_EXPECT_EQUAL("Reset count", histogram.GetCount(), 3ull);
+    KRYS_EXPECT_EQUAL("Reset p50", histogram.GetPercentile(50.0), 7ull);
+    KRYS_EXPECT_EQUAL("Reset min", histogram.GetMin(), 7ull);
+  }
+}
@@ -0,0 +1,168 @@
+#include "Base/Endian.hpp"
+#include "Bench.hpp"
+#include "IO/Image/BMP.hpp"
+#include "IO/Readers/MappedFile.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <iostream>
+
+#include "stb_image.h"
+
+namespace
+{
+  using namespace Krys;
+
+  struct Sample
+  {
+    string Name;
+    List<byte> File;
+    uint64 Pixels;
+  };
+
+  /// @brief Build a 24-bit BMP large enough to be decoded in bands across threads.
+  NO_DISCARD static List<byte> CreateLargeBMP(uint32 width, uint32 height) noexcept
+  {
+    List<byte> pixels(size_t {width} * height * 3);
+    for (size_t i = 0; i < pixels.size(); i++)
+      pixels[i] = static_cast<byte>(i * 31 + (i >> 9));
+    return Bench::EncodeBMP(width, height, 3, pixels);
+  }
+
+  NO_DISCARD static bool LoadsWithStb(const List<byte> &file, uint64 &pixels) noexcept
+  {
+    int width, height, channels;
+    if (!stbi_info_from_memory(reinterpret_cast<const stbi_uc *>(file.data()), static_cast<int>(file.size()),
+                               &width, &height, &channels))
+      return false;
+
+    pixels = static_cast<uint64>(width) * static_cast<uint64>(height);
+    return true;
+  }
+
+  NO_DISCARD static uint64 DecodeWithBMP(const Sample &sample) noexcept
+  {
+    IO::BufferedReader reader(CreateUnique<IO::MemoryReadSource>(std::span<const byte>(sample.File)));
+    auto image = IO::BMP().Load(reader);
+    return image ? image->Data.size() : 0;
+  }
+
+  NO_DISCARD static uint64 DecodeWithStb(const Sample &sample) noexcept
+  {
+    int width, height, channels;
+    const auto *file = reinterpret_cast<const stbi_uc *>(sample.File.data());
+    stbi_uc *pixels =
+      stbi_load_from_memory(file, static_cast<int>(sample.File.size()), &width, &height, &channels, 0);
+    if (!pixels)
+      return 0;
+
+    stbi_image_free(pixels);
+    return static_cast<uint64>(width) * static_cast<uint64>(height) * static_cast<uint64>(channels);
+  }
+
+  static void Report(stringview name, uint64 pixels, double ms) noexcept
+  {
+    const double rate = ms > 0.0 ? static_cast<double>(pixels) / (ms * 1000.0) : 0.0;
+    std::cout << std::format("  {0:<10} {1:>10.2f} ms {2:>10.1f} Mpixels/s\n", name, ms, rate);
+  }
+}
+
+namespace Krys::Bench
+{
+  List<byte> EncodeBMP(uint32 width, uint32 height, uint8 channels, std::span<const byte> pixels) noexcept
+  {
+    const uint32 rowSize = ((width * channels * 8 + 31) / 32) * 4;
+    const uint32 offset = 14 + 40; // file header + BITMAPINFOHEADER
+
+    List<byte> file;
+    const auto write = [&file](auto value)
+    {
+      const auto little = Endian::Convert<decltype(value), Endian::Type::System, Endian::Type::Little>(value);
+      const size_t position = file.size();
+      file.resize(position + sizeof(value));
+      std::memcpy(file.data() + position, &little, sizeof(value));
+    };
+
+    write(uint16 {0x4D42});
+    write(offset + rowSize * height);
+    write(uint32 {0});
+    write(offset);
+
+    write(uint32 {40});
+    write(static_cast<int32>(width));
+    write(static_cast<int32>(height));
+    write(uint16 {1});
+    write(static_cast<uint16>(channels * 8));
+    write(uint32 {0});
+    write(rowSize * height);
+    write(int32 {2835});
+    write(int32 {2835});
+    write(uint32 {0});
+    write(uint32 {0});
+
+    // Bottom-up, with each pixel stored as BGR(A).
+    file.resize(offset + size_t {rowSize} * height);
+    for (uint32 y = 0; y < height; y++)
+    {
+      const byte *source = pixels.data() + size_t {height - 1 - y} * width * channels;
+      byte *destination = file.data() + offset + size_t {y} * rowSize;
+      for (uint32 x = 0; x < width; x++, source += channels, destination += channels)
+      {
+        std::memcpy(destination, source, channels);
+        std::swap(destination[0], destination[2]);
+      }
+    }
+    return file;
+  }
+
+  int BMPDecoding(const List<string> &args) noexcept
+  {
+    const uint32 iterations = std::max(GetCount(args, 0, 20), 1u);
+    const string directory = args.size() > 1 ? args[1] : "data/test-images/BMP/valid";
+
+    // Only files both decoders accept are timed; stb rejects RLE and some bitfield layouts.
+    List<Sample> samples;
+    uint64 skipped = 0;
+    std::error_code error;
+    for (const auto &entry : std::filesystem::directory_iterator(directory, error))
+    {
+      IO::MappedFile file(entry.path().string());
+      if (!entry.is_regular_file() || !file.IsOpen())
+        continue;
+
+      const auto data = file.GetSpan();
+      Sample sample {entry.path().filename().string(), List<byte>(data.begin(), data.end()), 0};
+      if (!LoadsWithStb(sample.File, sample.Pixels) || DecodeWithBMP(sample) == 0)
+      {
+        skipped++;
+        continue;
+      }
+      samples.push_back(std::move(sample));
+    }
+
+    Sample large {"generated 24bpp 4096x4096", CreateLargeBMP(4096, 4096), uint64 {4096} * 4096};
+
+    uint64 pixels = 0;
+    for (const auto &sample : samples)
+      pixels += sample.Pixels;
+
+    std::cout << std::format("{0}: {1} files both decoders accept, {2} skipped, x {3}\n", directory,
+                             samples.size(), skipped, iterations);
+    Report("BMP", pixels * iterations, Time([&] {
+             for (uint32 i = 0; i < iterations; i++)
+               for (const auto &sample : samples)
+                 Consume(DecodeWithBMP(sample));
+           }));
+    Report("stb_image", pixels * iterations, Time([&] {
+             for (uint32 i = 0; i < iterations; i++)
+               for (const auto &sample : samples)
+                 Consume(DecodeWithStb(sample));
+           }));
+
+    std::cout << std::format("{0}\n", large.Name);
+    Report("BMP", large.Pixels, Time([&] { Consume(DecodeWithBMP(large)); }));
+    Report("stb_image", large.Pixels, Time([&] { Consume(DecodeWithStb(large)); }));
+    return 0;
+  }
+}
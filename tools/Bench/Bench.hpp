@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Base/Attributes.hpp"
+#include "Base/Types.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <span>
+
+namespace Krys::Bench
+{
+  /// @brief Results have to go somewhere observable, otherwise the work that produced them can be optimised
+  /// away.
+  inline volatile uint64 Sink = 0;
+
+  inline void Consume(uint64 value) noexcept
+  {
+    Sink = Sink + value;
+  }
+
+  /// @brief Run `function` `repeats` times.
+  /// @returns The fastest run in milliseconds, which is the least disturbed by everything else going on.
+  template <typename TFunction>
+  NO_DISCARD double Time(TFunction &&function, uint32 repeats = 5) noexcept
+  {
+    double best = 1e30;
+    for (uint32 i = 0; i < repeats; i++)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      function();
+      const auto end = std::chrono::steady_clock::now();
+      best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+  }
+
+  /// @brief Throughput in MB/s of processing `bytes` in `ms` milliseconds.
+  NO_DISCARD inline double GetThroughput(uint64 bytes, double ms) noexcept
+  {
+    return ms > 0.0 ? static_cast<double>(bytes) / (ms * 1000.0) : 0.0;
+  }
+
+  /// @brief Parse the count at `args[index]`, or use `fallback` if it isn't there or isn't a number.
+  NO_DISCARD inline uint32 GetCount(const List<string> &args, size_t index, uint32 fallback) noexcept
+  {
+    uint32 value = fallback;
+    if (index < args.size())
+      std::from_chars(args[index].data(), args[index].data() + args[index].size(), value);
+    return value;
+  }
+
+  /// @brief Encode `pixels`, 3 (RGB) or 4 (RGBA) channels with the top row first, as an uncompressed BMP.
+  NO_DISCARD List<byte> EncodeBMP(uint32 width, uint32 height, uint8 channels,
+                                  std::span<const byte> pixels) noexcept;
+
+  /// @brief Compare the asynchronous logger against a copy of the synchronous one it replaced.
+  int Logging(const List<string> &args) noexcept;
+
+  /// @brief Compare reading every file under some directories through streams against memory mappings.
+  int MappedFiles(const List<string> &args) noexcept;
+
+  /// @brief Compare the buffered bit reader and writer against copies of the bit-at-a-time ones they
+  /// replaced, on the pixel arrays of palette BMPs.
+  int Bits(const List<string> &args) noexcept;
+
+  /// @brief Compare `Endian::ConvertArray` against swapping one element at a time, for each element size.
+  int EndianConversion(const List<string> &args) noexcept;
+
+  /// @brief Compare the BMP decoder against stb_image on the BMP test suite and on a large generated image.
+  int BMPDecoding(const List<string> &args) noexcept;
+
+  /// @brief Compare the PNG decoder against stb_image on the repo's PNGs, after checking they produce the
+  /// same pixels, and `PNG::LoadMany` against loading the same files one at a time.
+  int PNGDecoding(const List<string> &args) noexcept;
+
+  /// @brief Compare encoding and decoding QOI against decoding the same pixels as PNG and BMP, on the repo's
+  /// RGB and RGBA PNGs, after checking QOI round-trips them.
+  int QOICoding(const List<string> &args) noexcept;
+
+  /// @brief Compress the repo's textures to each BC format at each quality preset, then decompress them on
+  /// the CPU, printing how fast each was compressed and its PSNR.
+  int BCEncoding(const List<string> &args) noexcept;
+
+  /// @brief Time the PNM and PAM decoders on the PNM test images and on large generated files of every
+  /// type, ASCII and binary, at 8 and 16 bits.
+  int PNMDecoding(const List<string> &args) noexcept;
+}
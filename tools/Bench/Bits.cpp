@@ -0,0 +1,259 @@
+#include "Bench.hpp"
+#include "IO/Readers/BitReader.hpp"
+#include "IO/Readers/MappedFile.hpp"
+#include "IO/Writers/BitWriter.hpp"
+#include "Utils/Bytes.hpp"
+
+#include <bitset>
+#include <format>
+#include <iostream>
+
+namespace
+{
+  using namespace Krys;
+
+  /// @brief The bit reader as it was before it was buffered: one byte at a time, one bit at a time.
+  class OldBitReader
+  {
+  public:
+    explicit OldBitReader(const List<byte> *buffer) noexcept : _buffer(buffer)
+    {
+    }
+
+    NO_DISCARD bool ReadBit() noexcept
+    {
+      if (_bitIndex == 0)
+        _currentByte = static_cast<uint8>(_buffer->at(_byteIndex++));
+
+      bool bit = (_currentByte >> (7 - _bitIndex)) & 1;
+      _bitIndex = (_bitIndex + 1) % 8;
+
+      return bit;
+    }
+
+    NO_DISCARD byte ReadBits(uint32 length) noexcept
+    {
+      byte value {};
+      for (uint32 i = 0; i < length; i++)
+      {
+        bool bit = ReadBit();
+        value |= static_cast<byte>(bit) << (length - i - 1);
+      }
+
+      return value;
+    }
+
+  private:
+    const List<byte> *_buffer;
+    uint8 _currentByte {0};
+    size_t _bitIndex {0};
+    size_t _byteIndex {0};
+  };
+
+  /// @brief The bit writer as it was before it was buffered: a `std::bitset` flushed one byte at a time.
+  class OldBitWriter
+  {
+    static constexpr size_t BitsetSize = 8 * sizeof(byte);
+
+  public:
+    explicit OldBitWriter(List<byte> *buffer) noexcept : _buffer(buffer)
+    {
+    }
+
+    ~OldBitWriter() noexcept
+    {
+      Flush();
+    }
+
+    void Write(bool bit) noexcept
+    {
+      _bitset.set(static_cast<size_t>(_bitIndex), bit);
+      if (--_bitIndex < 0)
+        Flush();
+    }
+
+    void Write(uint8 value, uint32 length) noexcept
+    {
+      for (int i = static_cast<int>(length) - 1; i >= 0; i--)
+      {
+        bool bit = ((value >> i) & 1) != 0;
+        Write(bit);
+      }
+    }
+
+    void Flush() noexcept
+    {
+      if (_bitIndex == static_cast<int>(BitsetSize) - 1)
+        return;
+
+      _buffer->push_back(static_cast<byte>(_bitset.to_ullong()));
+      _bitset.reset();
+      _bitIndex = static_cast<int>(BitsetSize) - 1;
+    }
+
+  private:
+    std::bitset<BitsetSize> _bitset {0};
+    int _bitIndex {static_cast<int>(BitsetSize) - 1};
+    List<byte> *_buffer;
+  };
+
+  /// @brief The pixel array of a palette BMP, with rows padded to 4 bytes.
+  struct PaletteImage
+  {
+    uint32 Width, Height, BitsPerPixel;
+    size_t RowSize;
+    List<byte> Pixels;
+  };
+
+  NO_DISCARD static bool LoadPaletteImage(const string &path, PaletteImage &image) noexcept
+  {
+    IO::MappedFile file(path);
+    if (!file.IsOpen() || file.GetSize() < 30)
+      return false;
+
+    const byte *data = file.GetData();
+    const auto offset = Bytes::AsNumeric<uint32, Endian::Type::Little>(data + 10);
+    const auto width = Bytes::AsNumeric<int32, Endian::Type::Little>(data + 18);
+    const auto height = Bytes::AsNumeric<int32, Endian::Type::Little>(data + 22);
+    const auto bitsPerPixel = Bytes::AsNumeric<uint16, Endian::Type::Little>(data + 28);
+    if (width <= 0 || height == 0 || (bitsPerPixel != 1 && bitsPerPixel != 2 && bitsPerPixel != 4))
+      return false;
+
+    image.Width = static_cast<uint32>(width);
+    image.Height = static_cast<uint32>(height < 0 ? -height : height);
+    image.BitsPerPixel = bitsPerPixel;
+    image.RowSize = ((image.Width * image.BitsPerPixel + 31) / 32) * 4;
+
+    const size_t size = image.RowSize * image.Height;
+    if (offset > file.GetSize() || size > file.GetSize() - offset)
+      return false;
+
+    image.Pixels.assign(data + offset, data + offset + size);
+    return true;
+  }
+
+  /// @brief Sum the palette indices the way the BMP loader used to: copy each row, then read it bit by bit.
+  NO_DISCARD static uint64 ReadOld(const PaletteImage &image) noexcept
+  {
+    uint64 sum = 0;
+    for (uint32 y = 0; y < image.Height; y++)
+    {
+      const auto begin = image.Pixels.begin() + static_cast<ptrdiff_t>(y * image.RowSize);
+      List<byte> row(begin, begin + static_cast<ptrdiff_t>(image.RowSize));
+      OldBitReader reader(&row);
+      for (uint32 x = 0; x < image.Width; x++)
+        sum += std::to_integer<uint64>(reader.ReadBits(image.BitsPerPixel));
+    }
+    return sum;
+  }
+
+  NO_DISCARD static uint64 ReadNew(const PaletteImage &image) noexcept
+  {
+    uint64 sum = 0;
+    IO::BitReader reader;
+    for (uint32 y = 0; y < image.Height; y++)
+    {
+      reader.SetBuffer(std::span(image.Pixels).subspan(y * image.RowSize, image.RowSize));
+      for (uint32 x = 0; x < image.Width; x++)
+        sum += reader.ReadBits(image.BitsPerPixel);
+    }
+    return sum;
+  }
+
+  static void WriteIndex(OldBitWriter &writer, uint8 index, uint32 bits) noexcept
+  {
+    writer.Write(index, bits);
+  }
+
+  static void WriteIndex(IO::BitWriter<> &writer, uint8 index, uint32 bits) noexcept
+  {
+    writer.WriteBits(index, bits);
+  }
+
+  /// @brief Pack the palette indices back into rows, the way an encoder would.
+  template <typename TWriter>
+  NO_DISCARD static List<byte> Write(const PaletteImage &image) noexcept
+  {
+    // Both writers pad the last byte of a row on flush, so only the padding past that is added here.
+    const size_t used = (static_cast<size_t>(image.Width) * image.BitsPerPixel + 7) / 8;
+
+    List<byte> output;
+    output.reserve(image.Pixels.size());
+    {
+      TWriter writer(&output);
+      IO::BitReader reader;
+      for (uint32 y = 0; y < image.Height; y++)
+      {
+        reader.SetBuffer(std::span(image.Pixels).subspan(y * image.RowSize, image.RowSize));
+        for (uint32 x = 0; x < image.Width; x++)
+          WriteIndex(writer, static_cast<uint8>(reader.ReadBits(image.BitsPerPixel)), image.BitsPerPixel);
+
+        writer.Flush();
+        output.resize(output.size() + image.RowSize - used);
+      }
+    }
+    return output;
+  }
+
+  static void Report(stringview name, uint64 pixels, double ms) noexcept
+  {
+    const double rate = ms > 0.0 ? static_cast<double>(pixels) / (ms * 1000.0) : 0.0;
+    std::cout << std::format("  {0:<12} {1:>10.2f} ms {2:>10.1f} Mpixels/s\n", name, ms, rate);
+  }
+}
+
+namespace Krys::Bench
+{
+  int Bits(const List<string> &args) noexcept
+  {
+    const uint32 iterations = std::max(GetCount(args, 0, 200), 1u);
+    List<string> paths(args.size() > 1 ? args.begin() + 1 : args.end(), args.end());
+    if (paths.empty())
+      paths = {"data/test-images/BMP/valid/1bpp-320x240.bmp", "data/test-images/BMP/valid/4bpp-320x240.bmp"};
+
+    for (const auto &path : paths)
+    {
+      PaletteImage image;
+      if (!LoadPaletteImage(path, image))
+      {
+        std::cerr << std::format("'{0}' isn't a 1, 2 or 4 bit palette BMP.\n", path);
+        return 1;
+      }
+
+      if (ReadOld(image) != ReadNew(image))
+      {
+        std::cerr << std::format("'{0}': the readers disagree.\n", path);
+        return 1;
+      }
+
+      if (Write<OldBitWriter>(image) != image.Pixels || Write<IO::BitWriter<>>(image) != image.Pixels)
+      {
+        std::cerr << std::format("'{0}': the writers didn't reproduce the pixel array.\n", path);
+        return 1;
+      }
+
+      const uint64 pixels = uint64 {image.Width} * image.Height * iterations;
+      std::cout << std::format("{0} ({1}x{2}, {3} bpp) x {4}\n", path, image.Width, image.Height,
+                               image.BitsPerPixel, iterations);
+
+      Report("read old", pixels, Time([&] {
+               for (uint32 i = 0; i < iterations; i++)
+                 Consume(ReadOld(image));
+             }));
+      Report("read new", pixels, Time([&] {
+               for (uint32 i = 0; i < iterations; i++)
+                 Consume(ReadNew(image));
+             }));
+      Report("write old", pixels, Time([&] {
+               for (uint32 i = 0; i < iterations; i++)
+                 Consume(Write<OldBitWriter>(image).size());
+             }));
+      Report("write new", pixels, Time([&] {
+               for (uint32 i = 0; i < iterations; i++)
+                 Consume(Write<IO::BitWriter<>>(image).size());
+             }));
+    }
+
+    return 0;
+  }
+}
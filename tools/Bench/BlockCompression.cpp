@@ -0,0 +1,117 @@
+#include "Bench.hpp"
+#include "Graphics/Textures/BlockCompression.hpp"
+#include "IO/Images.hpp"
+
+#include <cmath>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+namespace
+{
+  using namespace Krys;
+  using namespace Krys::Gfx;
+
+  struct Format
+  {
+    stringview Name;
+    TextureCompression Compression;
+
+    /// @brief How many of the decompressed RGBA channels hold what was compressed.
+    uint32 Channels;
+  };
+
+  constexpr Format Formats[] = {
+    {"BC1", TextureCompression::BC1, 3}, {"BC3", TextureCompression::BC3, 4},
+    {"BC4", TextureCompression::BC4, 1}, {"BC5", TextureCompression::BC5, 2},
+    {"BC7", TextureCompression::BC7, 4},
+  };
+
+  constexpr std::pair<stringview, CompressionQuality> Qualities[] = {
+    {"Fast", CompressionQuality::Fast},
+    {"Balanced", CompressionQuality::Balanced},
+    {"Best", CompressionQuality::Best},
+  };
+
+  struct TopDownSettings
+  {
+    static constexpr bool FlipImageVerticallyOnLoad = false;
+    static constexpr uint8 DesiredChannels = 0;
+  };
+
+  /// @brief PSNR in dB of `decompressed`, RGBA, against `image` over the channels both of them have, or
+  /// infinity if they're identical. Grey images are only compared on red, which is where every format keeps
+  /// them.
+  NO_DISCARD static double GetPSNR(const IO::Image &image, std::span<const byte> decompressed,
+                                   uint32 formatChannels) noexcept
+  {
+    const uint32 channels = image.Channels == 1 ? 1 : std::min<uint32>(formatChannels, image.Channels);
+    const size_t pixels = size_t {image.Width} * image.Height;
+
+    double error = 0.0;
+    for (size_t i = 0; i < pixels; i++)
+      for (uint32 c = 0; c < channels; c++)
+      {
+        const double difference = std::to_integer<int>(image.Data[i * image.Channels + c])
+                                  - std::to_integer<int>(decompressed[i * 4 + c]);
+        error += difference * difference;
+      }
+
+    const double mse = error / static_cast<double>(pixels * channels);
+    return mse > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / mse) : std::numeric_limits<double>::infinity();
+  }
+}
+
+namespace Krys::Bench
+{
+  int BCEncoding(const List<string> &args) noexcept
+  {
+    List<string> directories(args.begin(), args.end());
+    if (directories.empty())
+      directories = {"data/textures", "data/cubemaps/space-skybox", "data/models/backpack"};
+
+    std::cout << std::format("{0} hardware threads\n", std::thread::hardware_concurrency());
+    for (const auto &directory : directories)
+    {
+      std::error_code error;
+      for (const auto &entry : std::filesystem::directory_iterator(directory, error))
+      {
+        if (!entry.is_regular_file())
+          continue;
+
+        const string path = entry.path().generic_string();
+        auto loaded = IO::LoadImage<TopDownSettings>(path);
+        if (!loaded)
+          continue;
+
+        const auto &image = *loaded;
+        const uint64 pixels = uint64 {image.Width} * image.Height;
+        std::cout << std::format("{0} ({1}x{2}, {3} channels)\n", path, image.Width, image.Height,
+                                 image.Channels);
+
+        // Compression is slow enough at the higher presets that a single run is representative.
+        for (const auto &format : Formats)
+          for (const auto &[name, quality] : Qualities)
+          {
+            List<byte> blocks;
+            const auto compress = [&]
+            {
+              blocks = Gfx::BlockCompression::Compress(image.Data, image.Width, image.Height, image.Channels,
+                                                       format.Compression, quality);
+            };
+            const double ms = Time(compress, 1);
+
+            const auto decompressed =
+              Gfx::BlockCompression::Decompress(blocks, image.Width, image.Height, format.Compression);
+            const double rate = ms > 0.0 ? static_cast<double>(pixels) / (ms * 1000.0) : 0.0;
+            std::cout << std::format("  {0} {1:<8} {2:>10.2f} ms {3:>8.2f} MP/s {4:>6.2f} dB\n", format.Name,
+                                     name, ms, rate, GetPSNR(image, decompressed, format.Channels));
+          }
+      }
+    }
+
+    return 0;
+  }
+}
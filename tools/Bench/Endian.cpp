@@ -0,0 +1,89 @@
+#include "Base/Endian.hpp"
+#include "Bench.hpp"
+
+#include <cstring>
+#include <format>
+#include <iostream>
+
+namespace
+{
+  using namespace Krys;
+
+  /// @brief Swap one element at a time, the way bulk reads and writes converted before `ConvertArray`.
+  template <typename T>
+  static void ConvertScalar(const T *source, void *destination, size_t count) noexcept
+  {
+    for (size_t i = 0; i < count; i++)
+    {
+      const T value = Endian::Convert<T, Endian::Type::Big, Endian::Type::Little>(source[i]);
+      std::memcpy(static_cast<byte *>(destination) + i * sizeof(T), &value, sizeof(T));
+    }
+  }
+
+  static void Report(stringview name, uint64 bytes, double ms) noexcept
+  {
+    const double throughput = Bench::GetThroughput(bytes, ms) / 1000.0;
+    std::cout << std::format("  {0:<24} {1:>10.2f} ms {2:>8.2f} GB/s\n", name, ms, throughput);
+  }
+
+  template <typename T>
+  static bool Run(stringview name, size_t size, uint32 iterations) noexcept
+  {
+    const size_t count = size / sizeof(T);
+    List<T> source(count), scalar(count), vector(count);
+    for (size_t i = 0; i < count; i++)
+      source[i] = static_cast<T>(i * 0x9E3779B97F4A7C15ull);
+
+    // Offset by a byte so the destination is unaligned, as it is when writing into a byte buffer.
+    List<byte> unaligned(count * sizeof(T) + 1);
+
+    ConvertScalar(source.data(), scalar.data(), count);
+    Endian::ConvertArray<T, Endian::Type::Big, Endian::Type::Little>(source.data(), vector.data(), count);
+    if (scalar != vector)
+    {
+      std::cerr << std::format("{0}: ConvertArray disagrees with the scalar loop.\n", name);
+      return false;
+    }
+
+    const uint64 bytes = uint64 {count} * sizeof(T) * iterations;
+    std::cout << std::format("{0} x {1}\n", name, count);
+
+    Report("scalar", bytes, Bench::Time([&] {
+             for (uint32 i = 0; i < iterations; i++)
+               ConvertScalar(source.data(), scalar.data(), count);
+             Bench::Consume(static_cast<uint64>(scalar[count / 2]));
+           }));
+    Report("ConvertArray", bytes, Bench::Time([&] {
+             for (uint32 i = 0; i < iterations; i++)
+               Endian::ConvertArray<T, Endian::Type::Big, Endian::Type::Little>(source.data(), vector.data(),
+                                                                                count);
+             Bench::Consume(static_cast<uint64>(vector[count / 2]));
+           }));
+    Report("ConvertArray (in place)", bytes, Bench::Time([&] {
+             for (uint32 i = 0; i < iterations; i++)
+               Endian::ConvertArray<T, Endian::Type::Big, Endian::Type::Little>(std::span<T>(vector));
+             Bench::Consume(static_cast<uint64>(vector[count / 2]));
+           }));
+    Report("ConvertArray (unaligned)", bytes, Bench::Time([&] {
+             for (uint32 i = 0; i < iterations; i++)
+               Endian::ConvertArray<T, Endian::Type::Big, Endian::Type::Little>(source.data(),
+                                                                                unaligned.data() + 1, count);
+             Bench::Consume(std::to_integer<uint64>(unaligned[count / 2]));
+           }));
+    return true;
+  }
+}
+
+namespace Krys::Bench
+{
+  int EndianConversion(const List<string> &args) noexcept
+  {
+    const size_t size = size_t {std::max(GetCount(args, 0, 16), 1u)} * 1024 * 1024;
+    const uint32 iterations = std::max(GetCount(args, 1, 20), 1u);
+    std::cout << std::format("{0} MiB x {1}\n", size / (1024 * 1024), iterations);
+
+    const bool passed = Run<uint16>("uint16", size, iterations) && Run<uint32>("uint32", size, iterations) &&
+                        Run<uint64>("uint64", size, iterations);
+    return passed ? 0 : 1;
+  }
+}
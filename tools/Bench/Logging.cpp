@@ -0,0 +1,139 @@
+#include "Bench.hpp"
+#include "IO/Logger.hpp"
+
+#include <atomic>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#ifndef WIN32_LEAN_AND_MEAN
+  #define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+
+namespace
+{
+  using namespace Krys;
+  using Clock = std::chrono::steady_clock;
+
+  /// @brief The logger as it was before it went asynchronous: the message is formatted on the calling
+  /// thread, then written to the debugger and a file under a lock.
+  class SyncLogger
+  {
+  public:
+    template <typename... Args>
+    void Info(std::format_string<Args...> fmt, Args &&...args) noexcept
+    {
+      const string message =
+        ToString(LogLevel::Info) + ": " + std::format(fmt, std::forward<Args>(args)...) + '\n';
+
+      std::lock_guard<std::mutex> lock(_mutex);
+      ::OutputDebugStringA(message.c_str());
+      if (_file.is_open())
+        _file << message;
+    }
+
+    void Flush() noexcept
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _file.flush();
+    }
+
+  private:
+    std::mutex _mutex;
+    std::ofstream _file {"bench-sync-log.txt"};
+  };
+
+  struct RunResult
+  {
+    /// @brief From the first message until everything has been written.
+    double TotalMs;
+
+    /// @brief How long each call took on the thread that made it, sorted.
+    List<float> LatenciesNs;
+  };
+
+  /// @brief Log `messages` messages from each of `threads` threads, all starting at once.
+  template <typename TLog, typename TFlush>
+  static RunResult Run(uint32 threads, uint32 messages, TLog &&log, TFlush &&flush) noexcept
+  {
+    List<List<float>> latencies(threads, List<float>(messages));
+    std::atomic<uint32> ready {0};
+    std::atomic<bool> start {false};
+
+    List<std::thread> workers;
+    for (uint32 t = 0; t < threads; t++)
+      workers.emplace_back(
+        [&, t]()
+        {
+          ready.fetch_add(1, std::memory_order_release);
+          while (!start.load(std::memory_order_acquire))
+            std::this_thread::yield();
+
+          auto &samples = latencies[t];
+          for (uint32 i = 0; i < messages; i++)
+          {
+            const auto before = Clock::now();
+            log(t, i);
+            samples[i] = std::chrono::duration<float, std::nano>(Clock::now() - before).count();
+          }
+        });
+
+    while (ready.load(std::memory_order_acquire) != threads)
+      std::this_thread::yield();
+
+    const auto begin = Clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto &worker : workers)
+      worker.join();
+    flush();
+    const auto end = Clock::now();
+
+    RunResult result {std::chrono::duration<double, std::milli>(end - begin).count(), {}};
+    for (const auto &samples : latencies)
+      result.LatenciesNs.insert(result.LatenciesNs.end(), samples.begin(), samples.end());
+    std::ranges::sort(result.LatenciesNs);
+    return result;
+  }
+
+  static void Print(stringview name, const RunResult &result) noexcept
+  {
+    const auto &latencies = result.LatenciesNs;
+    const double count = static_cast<double>(latencies.size());
+    const auto percentile = [&](double p)
+    { return latencies[std::min(latencies.size() - 1, static_cast<size_t>(p * count))]; };
+
+    std::cout << std::format("{0:<13} {1:>10.0f} messages/s, caller p50 {2:.0f} ns, p99 {3:.0f} ns, "
+                             "p99.9 {4:.0f} ns, max {5:.0f} ns\n",
+                             name, count / result.TotalMs * 1000.0, percentile(0.5), percentile(0.99),
+                             percentile(0.999), latencies.back());
+  }
+}
+
+namespace Krys::Bench
+{
+  int Logging(const List<string> &args) noexcept
+  {
+    const uint32 threads = std::max(GetCount(args, 0, 4), 1u);
+    const uint32 messages = std::max(GetCount(args, 1, 100'000), 1u);
+    std::cout << std::format("{0} threads x {1} messages\n", threads, messages);
+
+    SyncLogger sync;
+    Print("synchronous", Run(
+                           threads, messages,
+                           [&](uint32 thread, uint32 i)
+                           { sync.Info("Frame {0} on worker {1}: {2} entities in {3:.3f} ms", i, thread,
+                                       i * 7u, i * 0.001); },
+                           [&]() { sync.Flush(); }));
+
+    Print("asynchronous", Run(
+                            threads, messages,
+                            [](uint32 thread, uint32 i)
+                            { Krys::Logger::Info("Frame {0} on worker {1}: {2} entities in {3:.3f} ms", i,
+                                                 thread, i * 7u, i * 0.001); },
+                            []() { Krys::Logger::Flush(); }));
+    return 0;
+  }
+}
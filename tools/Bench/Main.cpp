@@ -0,0 +1,47 @@
+#include "Bench.hpp"
+
+#include <format>
+#include <iostream>
+
+namespace
+{
+  using namespace Krys;
+
+  struct Benchmark
+  {
+    stringview Name;
+    stringview Arguments;
+    int (*Run)(const List<string> &args) noexcept;
+  };
+
+  constexpr Benchmark Benchmarks[] = {
+    {"logging", "[threads] [messages per thread]", &Bench::Logging},
+    {"mapped-files", "[directories...]", &Bench::MappedFiles},
+    {"bits", "[iterations] [palette BMPs...]", &Bench::Bits},
+    {"endian", "[MiB] [iterations]", &Bench::EndianConversion},
+    {"bmp", "[iterations] [directory]", &Bench::BMPDecoding},
+    {"png", "[iterations] [directories...]", &Bench::PNGDecoding},
+    {"qoi", "[iterations] [directories...]", &Bench::QOICoding},
+    {"bc", "[directories...]", &Bench::BCEncoding},
+    {"pnm", "[width] [height] [directory]", &Bench::PNMDecoding},
+  };
+
+  static void PrintUsage() noexcept
+  {
+    std::cerr << "Usage:\n";
+    for (const auto &benchmark : Benchmarks)
+      std::cerr << std::format("  KrystalBench {0} {1}\n", benchmark.Name, benchmark.Arguments);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  const List<string> args(argv + 1, argv + argc);
+  if (!args.empty())
+    for (const auto &benchmark : Benchmarks)
+      if (args[0] == benchmark.Name)
+        return benchmark.Run(List<string>(args.begin() + 1, args.end()));
+
+  PrintUsage();
+  return 1;
+}
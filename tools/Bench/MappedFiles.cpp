@@ -0,0 +1,108 @@
+#include "Bench.hpp"
+#include "IO/IO.hpp"
+#include "IO/Readers/BufferedReader.hpp"
+#include "IO/Readers/FileReader.hpp"
+#include "IO/Readers/MappedFile.hpp"
+
+#include <filesystem>
+#include <format>
+#include <iostream>
+
+namespace
+{
+  using namespace Krys;
+
+  /// @brief Sum a file as little endian `uint32`s, the way the loaders read headers and pixel data.
+  static uint64 SumWithFileReader(const string &path, size_t size) noexcept
+  {
+    IO::FileReader reader(path);
+    reader.Open(true);
+
+    uint64 sum = 0;
+    for (size_t i = 0; i + sizeof(uint32) <= size; i += sizeof(uint32))
+      sum += reader.ReadBytes<uint32>();
+    return sum;
+  }
+
+  static uint64 SumWithBufferedReader(Unique<IO::ReadSource> source) noexcept
+  {
+    IO::BufferedReader reader(std::move(source));
+
+    uint64 sum = 0;
+    while (reader.GetRemaining() >= sizeof(uint32))
+      sum += reader.Read<uint32>();
+    return sum;
+  }
+
+  static uint64 SumBytes(stringview text) noexcept
+  {
+    uint64 sum = 0;
+    for (const char c : text)
+      sum += static_cast<uint8>(c);
+    return sum;
+  }
+
+  static void Report(stringview name, uint64 bytes, double ms) noexcept
+  {
+    const double throughput = Bench::GetThroughput(bytes, ms);
+    std::cout << std::format("{0:<36} {1:>10.2f} ms {2:>10.1f} MB/s\n", name, ms, throughput);
+  }
+}
+
+namespace Krys::Bench
+{
+  int MappedFiles(const List<string> &args) noexcept
+  {
+    List<string> directories(args.begin(), args.end());
+    if (directories.empty())
+      directories = {"data/test-images", "data/models"};
+
+    List<std::pair<string, size_t>> files;
+    uint64 bytes = 0;
+    for (const auto &directory : directories)
+    {
+      std::error_code error;
+      for (const auto &entry : std::filesystem::recursive_directory_iterator(directory, error))
+        if (entry.is_regular_file())
+        {
+          const auto size = static_cast<size_t>(entry.file_size());
+          files.emplace_back(entry.path().string(), size);
+          bytes += size;
+        }
+    }
+
+    if (files.empty())
+    {
+      std::cerr << "No files found.\n";
+      return 1;
+    }
+
+    std::cout << std::format("{0} files, {1} bytes\n\n", files.size(), bytes);
+
+    // Whole files as text, the way shaders and OBJ models were loaded.
+    Report("IO::ReadFileText", bytes, Time([&] {
+             for (const auto &[path, size] : files)
+               Consume(SumBytes(IO::ReadFileText(path)));
+           }));
+    Report("IO::MappedFile::GetText", bytes, Time([&] {
+             for (const auto &[path, size] : files)
+               Consume(SumBytes(IO::MappedFile(path).GetText()));
+           }));
+
+    // Numeric reads, the way the image loaders decode headers and pixel data.
+    Report("IO::FileReader::ReadBytes<uint32>", bytes, Time([&] {
+             for (const auto &[path, size] : files)
+               Consume(SumWithFileReader(path, size));
+           }));
+    Report("IO::BufferedReader (stream)", bytes, Time([&] {
+             for (const auto &[path, size] : files)
+               Consume(SumWithBufferedReader(CreateUnique<IO::StreamReadSource>(path)));
+           }));
+    Report("IO::BufferedReader (mapped)", bytes, Time([&] {
+             for (const auto &[path, size] : files)
+               Consume(SumWithBufferedReader(CreateUnique<IO::MappedReadSource>(path)));
+           }));
+
+    return 0;
+  }
+}
@@ -0,0 +1,149 @@
+#include "Bench.hpp"
+#include "IO/Image/PNG.hpp"
+#include "IO/Readers/MappedFile.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <thread>
+
+#include "stb_image.h"
+
+namespace
+{
+  using namespace Krys;
+
+  struct Sample
+  {
+    string Path;
+    List<byte> File;
+    uint64 Pixels;
+  };
+
+  /// @brief Check the decoder produces exactly what stb does for `sample`, logging why if it doesn't.
+  NO_DISCARD static bool MatchesStb(Sample &sample) noexcept
+  {
+    stbi_set_flip_vertically_on_load(false);
+
+    int width, height, channels;
+    const auto *file = reinterpret_cast<const stbi_uc *>(sample.File.data());
+    stbi_uc *pixels =
+      stbi_load_from_memory(file, static_cast<int>(sample.File.size()), &width, &height, &channels, 0);
+    auto image = IO::PNG().Load(std::span<const byte>(sample.File));
+
+    bool matches = pixels && image;
+    if (matches)
+    {
+      const size_t size =
+        static_cast<size_t>(width) * static_cast<size_t>(height) * static_cast<size_t>(channels);
+      matches = image->Width == static_cast<uint32>(width) && image->Height == static_cast<uint32>(height)
+                && image->Channels == channels && image->Data.size() == size
+                && std::memcmp(image->Data.data(), pixels, size) == 0;
+      sample.Pixels = static_cast<uint64>(width) * static_cast<uint64>(height);
+    }
+
+    stbi_image_free(pixels);
+    if (!matches)
+      std::cerr << std::format("'{0}': the decoders disagree.\n", sample.Path);
+    return matches;
+  }
+
+  NO_DISCARD static uint64 DecodeWithPNG(const Sample &sample) noexcept
+  {
+    auto image = IO::PNG().Load(std::span<const byte>(sample.File));
+    return image ? image->Data.size() : 0;
+  }
+
+  NO_DISCARD static uint64 DecodeWithStb(const Sample &sample) noexcept
+  {
+    int width, height, channels;
+    const auto *file = reinterpret_cast<const stbi_uc *>(sample.File.data());
+    stbi_uc *pixels =
+      stbi_load_from_memory(file, static_cast<int>(sample.File.size()), &width, &height, &channels, 0);
+    if (!pixels)
+      return 0;
+
+    stbi_image_free(pixels);
+    return static_cast<uint64>(width) * static_cast<uint64>(height) * static_cast<uint64>(channels);
+  }
+
+  static void Report(stringview name, uint64 pixels, double ms) noexcept
+  {
+    const double rate = ms > 0.0 ? static_cast<double>(pixels) / (ms * 1000.0) : 0.0;
+    std::cout << std::format("  {0:<16} {1:>10.2f} ms {2:>10.1f} Mpixels/s\n", name, ms, rate);
+  }
+}
+
+namespace Krys::Bench
+{
+  int PNGDecoding(const List<string> &args) noexcept
+  {
+    const uint32 iterations = std::max(GetCount(args, 0, 5), 1u);
+    List<string> directories(args.size() > 1 ? args.begin() + 1 : args.end(), args.end());
+    if (directories.empty())
+      directories = {"data/cubemaps/space-skybox", "data/models/backpack", "data/textures"};
+
+    List<Sample> samples;
+    for (const auto &directory : directories)
+    {
+      std::error_code error;
+      for (const auto &entry : std::filesystem::directory_iterator(directory, error))
+      {
+        IO::MappedFile file(entry.path().string());
+        if (!entry.is_regular_file() || !file.IsOpen() || !IO::PNG::IsPNG(file.GetSpan()))
+          continue;
+
+        const auto data = file.GetSpan();
+        samples.push_back({entry.path().generic_string(), List<byte>(data.begin(), data.end()), 0});
+      }
+    }
+
+    if (samples.empty())
+    {
+      std::cerr << "No PNGs found.\n";
+      return 1;
+    }
+
+    for (auto &sample : samples)
+      if (!MatchesStb(sample))
+        return 1;
+
+    std::cout << std::format("{0} PNGs, identical to stb_image, x {1}\n", samples.size(), iterations);
+    for (const auto &sample : samples)
+    {
+      std::cout << std::format("{0} ({1} bytes)\n", sample.Path, sample.File.size());
+      Report("PNG", sample.Pixels * iterations, Time([&] {
+               for (uint32 i = 0; i < iterations; i++)
+                 Consume(DecodeWithPNG(sample));
+             }));
+      Report("stb_image", sample.Pixels * iterations, Time([&] {
+               for (uint32 i = 0; i < iterations; i++)
+                 Consume(DecodeWithStb(sample));
+             }));
+    }
+
+    // LoadMany goes through the VFS like a real load, so it's compared against loading each path in turn.
+    List<string> paths;
+    uint64 pixels = 0;
+    for (const auto &sample : samples)
+    {
+      paths.push_back(sample.Path);
+      pixels += sample.Pixels;
+    }
+
+    std::cout << std::format("All {0} by path, {1} hardware threads\n", paths.size(),
+                             std::thread::hardware_concurrency());
+    Report("PNG::Load", pixels, Time([&] {
+             for (const auto &path : paths)
+               if (auto image = IO::PNG().Load(path))
+                 Consume(image->Data.size());
+           }));
+    Report("PNG::LoadMany", pixels, Time([&] {
+             for (const auto &image : IO::PNG::LoadMany(paths))
+               if (image)
+                 Consume(image->Data.size());
+           }));
+    return 0;
+  }
+}
@@ -0,0 +1,200 @@
+#include "Bench.hpp"
+#include "IO/Image/PAM.hpp"
+#include "IO/Image/PNM.hpp"
+#include "IO/Readers/MappedFile.hpp"
+
+#include <charconv>
+#include <filesystem>
+#include <format>
+#include <iostream>
+
+namespace
+{
+  using namespace Krys;
+
+  struct Sample
+  {
+    string Name;
+    List<byte> File;
+    uint64 Pixels;
+  };
+
+  /// @brief Generates Netpbm files of every kind with the same pseudo-random content.
+  class Generator
+  {
+  public:
+    Generator(uint32 width, uint32 height) noexcept : _width(width), _height(height)
+    {
+    }
+
+    /// @brief A PNM of `type` ('1' to '6') with `channels` samples per pixel up to `maxValue`.
+    NO_DISCARD List<byte> CreatePNM(char type, uint32 channels, uint32 maxValue) const noexcept
+    {
+      List<byte> file;
+      const bool bitmap = type == '1' || type == '4';
+      Append(file, bitmap ? std::format("P{0}\n{1} {2}\n", type, _width, _height)
+                          : std::format("P{0}\n{1} {2}\n{3}\n", type, _width, _height, maxValue));
+
+      const bool ascii = type <= '3';
+      if (type == '4')
+        AppendPackedBits(file);
+      else
+        AppendSamples(file, channels, bitmap ? 1 : maxValue, ascii);
+      return file;
+    }
+
+    /// @brief A PAM with `depth` samples per pixel up to `maxValue`, of `tupleType`.
+    NO_DISCARD List<byte> CreatePAM(uint32 depth, uint32 maxValue, stringview tupleType) const noexcept
+    {
+      List<byte> file;
+      Append(file, std::format("P7\nWIDTH {0}\nHEIGHT {1}\nDEPTH {2}\nMAXVAL {3}\nTUPLTYPE {4}\nENDHDR\n",
+                               _width, _height, depth, maxValue, tupleType));
+      AppendSamples(file, depth, maxValue, false);
+      return file;
+    }
+
+  private:
+    static void Append(List<byte> &file, stringview text) noexcept
+    {
+      const auto *begin = reinterpret_cast<const byte *>(text.data());
+      file.insert(file.end(), begin, begin + text.size());
+    }
+
+    NO_DISCARD uint32 GetSample(size_t index, uint32 maxValue) const noexcept
+    {
+      const uint64 value = (index * 0x9E3779B97F4A7C15ull) >> 40;
+      return static_cast<uint32>(value % (uint64 {maxValue} + 1));
+    }
+
+    /// @brief Rows of samples as text, one row per line, or as big endian binary of 1 or 2 bytes each.
+    void AppendSamples(List<byte> &file, uint32 channels, uint32 maxValue, bool ascii) const noexcept
+    {
+      const size_t count = size_t {_width} * _height * channels;
+      const size_t rowLength = size_t {_width} * channels;
+      file.reserve(file.size() + count * (ascii ? 6 : (maxValue > 255 ? 2 : 1)));
+
+      for (size_t i = 0; i < count; i++)
+      {
+        const uint32 sample = GetSample(i, maxValue);
+        if (ascii)
+        {
+          char text[12];
+          const auto end = std::to_chars(text, text + sizeof(text) - 1, sample).ptr;
+          *end = (i + 1) % rowLength == 0 ? '\n' : ' ';
+          Append(file, stringview(text, static_cast<size_t>(end - text + 1)));
+        }
+        else if (maxValue > 255)
+        {
+          file.push_back(static_cast<byte>(sample >> 8));
+          file.push_back(static_cast<byte>(sample));
+        }
+        else
+          file.push_back(static_cast<byte>(sample));
+      }
+    }
+
+    /// @brief PBM rows of bits, most significant first, each padded to a whole byte.
+    void AppendPackedBits(List<byte> &file) const noexcept
+    {
+      const size_t rowSize = (size_t {_width} + 7) / 8;
+      for (uint32 y = 0; y < _height; y++)
+      {
+        const size_t row = file.size();
+        file.resize(row + rowSize);
+        for (uint32 x = 0; x < _width; x++)
+          if (GetSample(size_t {y} * _width + x, 1))
+            file[row + x / 8] |= static_cast<byte>(0x80 >> (x % 8));
+      }
+    }
+
+    uint32 _width, _height;
+  };
+
+  /// @brief Decode `file` with whichever of the PNM and PAM decoders handles it.
+  /// @returns The number of bytes decoded, or 0 if it failed.
+  NO_DISCARD static uint64 Decode(std::span<const byte> file) noexcept
+  {
+    IO::BufferedReader reader(CreateUnique<IO::MemoryReadSource>(file));
+    if (file.size() > 1 && file[1] == byte {'7'})
+    {
+      auto image = IO::PAM().Load(reader);
+      return image ? image->Data.size() : 0;
+    }
+
+    auto image = IO::PNM().Load(reader);
+    return image ? image->Data.size() : 0;
+  }
+
+  static void Report(const Sample &sample, double ms) noexcept
+  {
+    const double rate = ms > 0.0 ? static_cast<double>(sample.Pixels) / (ms * 1000.0) : 0.0;
+    std::cout << std::format("  {0:<24} {1:>12} bytes {2:>10.2f} ms {3:>8.1f} MB/s {4:>8.1f} Mpixels/s\n",
+                             sample.Name, sample.File.size(), ms,
+                             Bench::GetThroughput(sample.File.size(), ms), rate);
+  }
+}
+
+namespace Krys::Bench
+{
+  int PNMDecoding(const List<string> &args) noexcept
+  {
+    const uint32 width = std::max(GetCount(args, 0, 4000), 1u);
+    const uint32 height = std::max(GetCount(args, 1, 3000), 1u);
+    const string directory = args.size() > 2 ? args[2] : "data/test-images/PNM";
+
+    List<Sample> files;
+    std::error_code error;
+    for (const auto &entry : std::filesystem::directory_iterator(directory, error))
+    {
+      IO::MappedFile file(entry.path().string());
+      if (!entry.is_regular_file() || !file.IsOpen())
+        continue;
+
+      const auto data = file.GetSpan();
+      files.push_back({entry.path().filename().string(), List<byte>(data.begin(), data.end()), 0});
+    }
+
+    const Generator generator(width, height);
+    const uint64 pixels = uint64 {width} * height;
+    List<Sample> generated {
+      {"P1 (ASCII bitmap)", generator.CreatePNM('1', 1, 1), pixels},
+      {"P2 (ASCII grey)", generator.CreatePNM('2', 1, 255), pixels},
+      {"P2 (ASCII grey, 16-bit)", generator.CreatePNM('2', 1, 65535), pixels},
+      {"P3 (ASCII RGB)", generator.CreatePNM('3', 3, 255), pixels},
+      {"P4 (bitmap)", generator.CreatePNM('4', 1, 1), pixels},
+      {"P5 (grey)", generator.CreatePNM('5', 1, 255), pixels},
+      {"P5 (grey, max 1000)", generator.CreatePNM('5', 1, 1000), pixels},
+      {"P5 (grey, 16-bit)", generator.CreatePNM('5', 1, 65535), pixels},
+      {"P6 (RGB)", generator.CreatePNM('6', 3, 255), pixels},
+      {"P6 (RGB, 16-bit)", generator.CreatePNM('6', 3, 65535), pixels},
+      {"P7 (RGB_ALPHA)", generator.CreatePAM(4, 255, "RGB_ALPHA"), pixels},
+      {"P7 (GRAYSCALE, 16-bit)", generator.CreatePAM(1, 65535, "GRAYSCALE"), pixels},
+    };
+
+    for (const auto *samples : {&files, &generated})
+      for (const auto &sample : *samples)
+        if (Decode(sample.File) == 0)
+        {
+          std::cerr << std::format("'{0}' failed to decode.\n", sample.Name);
+          return 1;
+        }
+
+    // The files are only a few bytes each, so they're decoded many times over to be measurable.
+    constexpr uint32 FileIterations = 10000;
+    std::cout << std::format("{0}: {1} files x {2}\n", directory, files.size(), FileIterations);
+    for (const auto &sample : files)
+    {
+      const double ms = Time([&] {
+        for (uint32 i = 0; i < FileIterations; i++)
+          Consume(Decode(sample.File));
+      });
+      std::cout << std::format("  {0:<24} {1:>10.4f} ms per decode\n", sample.Name, ms / FileIterations);
+    }
+
+    std::cout << std::format("Generated {0}x{1}\n", width, height);
+    for (const auto &sample : generated)
+      Report(sample, Time([&] { Consume(Decode(sample.File)); }));
+
+    return 0;
+  }
+}
@@ -0,0 +1,119 @@
+#include "Bench.hpp"
+#include "IO/Image/BMP.hpp"
+#include "IO/Image/PNG.hpp"
+#include "IO/Image/QOI.hpp"
+#include "IO/Readers/BufferedReader.hpp"
+#include "IO/Readers/MappedFile.hpp"
+
+#include <filesystem>
+#include <format>
+#include <iostream>
+
+namespace
+{
+  using namespace Krys;
+
+  /// @brief One image in each of the formats being compared.
+  struct Sample
+  {
+    string Path;
+    IO::QOIHeader Header;
+    IO::ImageData Pixels;
+    List<byte> PNG;
+    List<byte> QOI;
+    List<byte> BMP;
+  };
+
+  NO_DISCARD static uint64 DecodeBMP(std::span<const byte> file) noexcept
+  {
+    IO::BufferedReader reader(CreateUnique<IO::MemoryReadSource>(file));
+    auto image = IO::BMP().Load(reader);
+    return image ? image->Data.size() : 0;
+  }
+
+  static void Report(stringview name, uint64 pixels, double ms) noexcept
+  {
+    const double rate = ms > 0.0 ? static_cast<double>(pixels) / (ms * 1000.0) : 0.0;
+    std::cout << std::format("  {0:<12} {1:>10.2f} ms {2:>10.1f} Mpixels/s\n", name, ms, rate);
+  }
+}
+
+namespace Krys::Bench
+{
+  int QOICoding(const List<string> &args) noexcept
+  {
+    const uint32 iterations = std::max(GetCount(args, 0, 5), 1u);
+    List<string> directories(args.size() > 1 ? args.begin() + 1 : args.end(), args.end());
+    if (directories.empty())
+      directories = {"data/cubemaps/space-skybox", "data/textures"};
+
+    // The repo's images are PNGs, so each one is decoded and encoded again as QOI and BMP to compare them on
+    // the same pixels.
+    List<Sample> samples;
+    for (const auto &directory : directories)
+    {
+      std::error_code error;
+      for (const auto &entry : std::filesystem::directory_iterator(directory, error))
+      {
+        IO::MappedFile file(entry.path().string());
+        if (!entry.is_regular_file() || !file.IsOpen() || !IO::PNG::IsPNG(file.GetSpan()))
+          continue;
+
+        auto image = IO::PNG().Load(file.GetSpan());
+        if (!image || image->Channels < 3)
+          continue;
+
+        Sample &sample = samples.emplace_back();
+        sample.Path = entry.path().generic_string();
+        sample.Header = {image->Width, image->Height, image->Channels};
+        sample.Pixels = std::move(image->Data);
+        sample.PNG.assign(file.GetSpan().begin(), file.GetSpan().end());
+        sample.QOI = IO::QOI::Encode(sample.Header, sample.Pixels);
+        sample.BMP = EncodeBMP(image->Width, image->Height, image->Channels, sample.Pixels);
+
+        auto decoded = IO::QOI().Load(std::span<const byte>(sample.QOI));
+        if (!decoded || decoded->Data != sample.Pixels)
+        {
+          std::cerr << std::format("'{0}': QOI didn't round-trip.\n", sample.Path);
+          return 1;
+        }
+      }
+    }
+
+    if (samples.empty())
+    {
+      std::cerr << "No RGB or RGBA PNGs found.\n";
+      return 1;
+    }
+
+    std::cout << std::format("{0} images, x {1}\n", samples.size(), iterations);
+    for (const auto &sample : samples)
+    {
+      const uint64 pixels = uint64 {sample.Header.Width} * sample.Header.Height * iterations;
+      std::cout << std::format("{0} ({1}x{2}, {3} channels): PNG {4} bytes, QOI {5} bytes, BMP {6} bytes\n",
+                               sample.Path, sample.Header.Width, sample.Header.Height, sample.Header.Channels,
+                               sample.PNG.size(), sample.QOI.size(), sample.BMP.size());
+
+      Report("QOI encode", pixels, Time([&] {
+               for (uint32 i = 0; i < iterations; i++)
+                 Consume(IO::QOI::Encode(sample.Header, sample.Pixels).size());
+             }));
+      Report("QOI decode", pixels, Time([&] {
+               for (uint32 i = 0; i < iterations; i++)
+                 if (auto image = IO::QOI().Load(std::span<const byte>(sample.QOI)))
+                   Consume(image->Data.size());
+             }));
+      Report("PNG decode", pixels, Time([&] {
+               for (uint32 i = 0; i < iterations; i++)
+                 if (auto image = IO::PNG().Load(std::span<const byte>(sample.PNG)))
+                   Consume(image->Data.size());
+             }));
+      Report("BMP decode", pixels, Time([&] {
+               for (uint32 i = 0; i < iterations; i++)
+                 Consume(DecodeBMP(sample.BMP));
+             }));
+    }
+
+    return 0;
+  }
+}
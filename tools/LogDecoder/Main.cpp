@@ -0,0 +1,48 @@
+#include "Base/Types.hpp"
+#include "IO/Logging/BinaryLog.hpp"
+
+#include <format>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+  using namespace Krys;
+
+  constexpr stringview Usage = "Usage:\n"
+                               "  KrystalLogDecoder <binary log> [output]\n"
+                               "Writes the decoded log to output, or to the console if there isn't one.\n";
+}
+
+int main(int argc, char **argv)
+{
+  const List<string> args(argv + 1, argv + argc);
+  if (args.empty() || args.size() > 2)
+  {
+    std::cerr << Usage;
+    return 1;
+  }
+
+  const auto text = DecodeBinaryLog(args[0]);
+  if (!text)
+  {
+    std::cerr << std::format("Unable to decode '{0}': {1}\n", args[0], text.error());
+    return 1;
+  }
+
+  if (args.size() == 1)
+  {
+    std::cout << *text;
+    return 0;
+  }
+
+  std::ofstream output(args[1], std::ios::out | std::ios::binary | std::ios::trunc);
+  output.write(text->data(), static_cast<std::streamsize>(text->size()));
+  if (!output)
+  {
+    std::cerr << std::format("Unable to write '{0}'\n", args[1]);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,144 @@
+#include "Base/Types.hpp"
+#include "IO/VFS/PackFile.hpp"
+#include "IO/VFS/VFS.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <iostream>
+
+namespace
+{
+  using namespace Krys;
+  using namespace Krys::IO;
+  namespace fs = std::filesystem;
+
+  /// @brief Where `ReadAll` leaves what it read, so the reads can't be optimised away.
+  volatile uint64 Sink = 0;
+
+  /// @brief Formats used in place from the mapped pack, so compressing them would defeat their purpose.
+  constexpr std::array StoredExtensions {stringview {".ktex"}, stringview {".kmdl"}};
+
+  constexpr stringview Usage = "Usage:\n"
+                               "  KrystalPacker pack <directory> <output.kpak>\n"
+                               "  KrystalPacker list <pack.kpak>\n"
+                               "  KrystalPacker bench <directory> <pack.kpak>\n";
+
+  static int Pack(const string &directory, const string &output) noexcept
+  {
+    std::error_code error;
+    List<PackSource> sources;
+    for (const auto &item : fs::recursive_directory_iterator(directory, error))
+    {
+      if (!item.is_regular_file(error))
+        continue;
+
+      const string extension = item.path().extension().string();
+      PackSource &source = sources.emplace_back();
+      source.Name = fs::relative(item.path(), directory, error).generic_string();
+      source.Path = item.path().string();
+      source.Compress = std::ranges::find(StoredExtensions, extension) == StoredExtensions.end();
+    }
+
+    if (error)
+    {
+      std::cerr << std::format("Unable to read '{0}': {1}\n", directory, error.message());
+      return 1;
+    }
+
+    if (!PackFile::Save(output, sources))
+      return 1;
+
+    PackFile pack(output);
+    uint64 original = 0, stored = 0;
+    size_t compressed = 0;
+    for (const auto &entry : pack.GetEntries())
+    {
+      original += entry.OriginalSize;
+      stored += entry.Size;
+      compressed += entry.Compression != PackCompression::None ? 1 : 0;
+    }
+
+    std::cout << std::format("Packed {0} files ({1} compressed) from {2} to {3} bytes, {4} bytes on disk.\n",
+                             pack.GetEntries().size(), compressed, original, stored, fs::file_size(output));
+    return 0;
+  }
+
+  static int ListEntries(const string &path) noexcept
+  {
+    PackFile pack(path);
+    if (!pack.IsOpen())
+      return 1;
+
+    for (const auto &entry : pack.GetEntries())
+      std::cout << std::format("{0:>12} {1:>12} {2:<5} {3}\n", entry.OriginalSize, entry.Size,
+                               entry.Compression == PackCompression::None ? "" : "LZ4", pack.GetName(entry));
+    return 0;
+  }
+
+  /// @brief Open every file in the pack through the VFS, touching all of its contents, and return how long
+  /// it took in milliseconds, including the mount.
+  static double ReadAll(const string &mount, const List<string> &names) noexcept
+  {
+    const auto start = std::chrono::steady_clock::now();
+    VFS::UnmountAll();
+    VFS::Mount(mount);
+
+    uint64 sum = 0;
+    for (const auto &name : names)
+    {
+      const auto file = VFS::Open(name);
+      for (const byte value : file.GetSpan())
+        sum += static_cast<uint8>(value);
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    VFS::UnmountAll();
+
+    Sink = Sink + sum;
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+  }
+
+  /// @brief Compare loading everything in the pack from it and from the directory it was made from. The
+  /// first pass is cold only if neither has been read since the OS last dropped its file cache, e.g. after
+  /// a reboot; the second is always warm.
+  static int Bench(const string &directory, const string &path) noexcept
+  {
+    List<string> names;
+    {
+      PackFile pack(path);
+      if (!pack.IsOpen())
+        return 1;
+
+      for (const auto &entry : pack.GetEntries())
+        names.emplace_back(pack.GetName(entry));
+    }
+
+    std::cout << std::format("{0} files\n", names.size());
+    for (const char *pass : {"first", "second"})
+    {
+      const double loose = ReadAll(directory, names);
+      const double packed = ReadAll(path, names);
+      std::cout << std::format("{0} pass: loose {1:.2f} ms, packed {2:.2f} ms\n", pass, loose, packed);
+    }
+
+    return 0;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  const List<string> args(argv + 1, argv + argc);
+  if (args.size() == 3 && args[0] == "pack")
+    return Pack(args[1], args[2]);
+  if (args.size() == 2 && args[0] == "list")
+    return ListEntries(args[1]);
+  if (args.size() == 3 && args[0] == "bench")
+    return Bench(args[1], args[2]);
+
+  std::cerr << Usage;
+  return 1;
+}